@@ -101,6 +101,8 @@ public:
 
     Status init_buffer() { return _csv_reader->init_buff(); }
 
+    void set_enable_simd_tokenizer(bool enable) { _csv_reader->set_enable_simd_tokenizer(enable); }
+
     Status get_all_v1(int64_t& read_row_cnt) {
         CSVReader::Record record;
         Status st = Status::OK();
@@ -183,7 +185,7 @@ using namespace starrocks;
 int main(int argc, char** argv) {
     if (argc < 3) {
         std::cout << "Usage: " << argv[0] << " [file]"
-                  << " [parser_version]" << std::endl;
+                  << " [parser_version: v1|v2|v2_scalar]" << std::endl;
         exit(1);
     }
     std::string filename = argv[1];
@@ -210,6 +212,8 @@ int main(int argc, char** argv) {
     if (version == "v1") {
         st = scanner->get_all_v1(read_row_cnt);
     } else {
+        // v2_scalar parses with the byte-by-byte state machine only, to compare with the SIMD tokenizer.
+        scanner->set_enable_simd_tokenizer(version != "v2_scalar");
         st = scanner->get_all_v2(read_row_cnt);
     }
     if (!st.ok() && !st.is_end_of_file()) {
@@ -0,0 +1,116 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <benchmark/benchmark.h>
+
+#include <memory>
+#include <random>
+
+#include "column/binary_column.h"
+#include "column/column_helper.h"
+#include "exprs/function_context.h"
+#include "exprs/string_functions.h"
+
+namespace starrocks {
+
+static constexpr int kNumRows = 4096;
+
+// Generate |num_rows| random strings of [min_len, max_len] chars, a quarter of which are 3-byte utf8 chars if
+// |utf8| is true
+static ColumnPtr gen_string_column(int num_rows, int min_len, int max_len, bool utf8) {
+    static const std::string alphabet = "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789 ";
+    static const std::string utf8_char = "\xe4\xb8\xad";
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<int> len_dist(min_len, max_len);
+    std::uniform_int_distribution<int> char_dist(0, alphabet.size() - 1);
+    auto column = BinaryColumn::create();
+    std::string str;
+    for (int i = 0; i < num_rows; i++) {
+        str.clear();
+        int len = len_dist(rng);
+        for (int j = 0; j < len; j++) {
+            if (utf8 && (rng() & 3) == 0) {
+                str.append(utf8_char);
+            } else {
+                str.push_back(alphabet[char_dist(rng)]);
+            }
+        }
+        column->append(Slice(str));
+    }
+    return column;
+}
+
+using StringFunction = StatusOr<ColumnPtr> (*)(FunctionContext*, const Columns&);
+
+static void do_bench(benchmark::State& state, StringFunction fn, const Columns& columns) {
+    std::unique_ptr<FunctionContext> ctx(FunctionContext::create_test_context());
+    size_t bytes = columns[0]->byte_size();
+    for (auto _ : state) {
+        auto result = fn(ctx.get(), columns);
+        benchmark::DoNotOptimize(result);
+    }
+    state.SetItemsProcessed(state.iterations() * columns[0]->size());
+    state.SetBytesProcessed(state.iterations() * bytes);
+}
+
+// Args: max length of strings, whether there are utf8 chars
+static ColumnPtr gen_string_column(benchmark::State& state) {
+    return gen_string_column(kNumRows, 0, state.range(0), state.range(1));
+}
+
+static void BM_lower(benchmark::State& state) {
+    do_bench(state, &StringFunctions::lower, {gen_string_column(state)});
+}
+
+static void BM_upper(benchmark::State& state) {
+    do_bench(state, &StringFunctions::upper, {gen_string_column(state)});
+}
+
+static void BM_char_length(benchmark::State& state) {
+    do_bench(state, &StringFunctions::utf8_length, {gen_string_column(state)});
+}
+
+static void BM_reverse(benchmark::State& state) {
+    do_bench(state, &StringFunctions::reverse, {gen_string_column(state)});
+}
+
+static void BM_substring(benchmark::State& state) {
+    do_bench(state, &StringFunctions::substring,
+             {gen_string_column(state), ColumnHelper::create_const_column<TYPE_INT>(3, kNumRows),
+              ColumnHelper::create_const_column<TYPE_INT>(10, kNumRows)});
+}
+
+static void BM_instr(benchmark::State& state) {
+    do_bench(state, &StringFunctions::instr,
+             {gen_string_column(state), ColumnHelper::create_const_column<TYPE_VARCHAR>(Slice("xyz"), kNumRows)});
+}
+
+static void StringArgs(benchmark::internal::Benchmark* b) {
+    for (int64_t max_len : {16, 64, 256}) {
+        for (int64_t utf8 : {0, 1}) {
+            b->Args({max_len, utf8});
+        }
+    }
+}
+
+BENCHMARK(BM_lower)->Apply(StringArgs);
+BENCHMARK(BM_upper)->Apply(StringArgs);
+BENCHMARK(BM_char_length)->Apply(StringArgs);
+BENCHMARK(BM_reverse)->Apply(StringArgs);
+BENCHMARK(BM_substring)->Apply(StringArgs);
+BENCHMARK(BM_instr)->Apply(StringArgs);
+
+} // namespace starrocks
+
+BENCHMARK_MAIN();
@@ -16,7 +16,10 @@
 
 #include <fmt/format.h>
 
+#ifdef WITH_BLOCK_CACHE
 #include "block_cache/fb_cachelib.h"
+#endif
+#include "block_cache/local_cache.h"
 #include "common/config.h"
 #include "common/logging.h"
 #include "common/statusor.h"
@@ -24,9 +27,7 @@
 
 namespace starrocks {
 
-BlockCache::BlockCache() {
-    _kv_cache = std::make_unique<FbCacheLib>();
-}
+BlockCache::BlockCache() = default;
 
 BlockCache* BlockCache::instance() {
     static BlockCache cache;
@@ -35,8 +36,21 @@ BlockCache* BlockCache::instance() {
 
 Status BlockCache::init(const CacheOptions& options) {
     // TODO: check block size limit
+    if (options.engine == "cachelib") {
+#ifdef WITH_BLOCK_CACHE
+        _kv_cache = std::make_unique<FbCacheLib>();
+#else
+        return Status::NotSupported("the binary is built without cachelib, use the local block cache engine instead");
+#endif
+    } else if (options.engine == "local") {
+        _kv_cache = std::make_unique<LocalCache>();
+    } else {
+        return Status::InvalidArgument(strings::Substitute("unknown block cache engine $0", options.engine));
+    }
     _block_size = options.block_size;
-    return _kv_cache->init(options);
+    RETURN_IF_ERROR(_kv_cache->init(options));
+    _initialized = true;
+    return Status::OK();
 }
 
 Status BlockCache::write_cache(const CacheKey& cache_key, off_t offset, size_t size, const char* buffer,
@@ -99,6 +113,10 @@ Status BlockCache::remove_cache(const CacheKey& cache_key, off_t offset, size_t
 }
 
 Status BlockCache::shutdown() {
+    if (!_kv_cache) {
+        return Status::OK();
+    }
+    _initialized = false;
     return _kv_cache->shutdown();
 }
 
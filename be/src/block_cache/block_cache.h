@@ -49,10 +49,16 @@ public:
 
     size_t block_size() const { return _block_size; }
 
+    // Whether the instance has been initialized successfully and can be used.
+    bool is_initialized() const { return _initialized; }
+
+    KvCache* kv_cache() { return _kv_cache.get(); }
+
 private:
     BlockCache();
 
     size_t _block_size = 0;
+    bool _initialized = false;
     std::unique_ptr<KvCache> _kv_cache;
 };
 
@@ -33,6 +33,8 @@ struct CacheOptions {
     // advanced
     size_t block_size;
     bool checksum;
+    // the KvCache implementation, "local" or "cachelib"
+    std::string engine = "local";
 };
 
 } // namespace starrocks
@@ -0,0 +1,516 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "block_cache/local_cache.h"
+
+#include <fcntl.h>
+#include <fmt/format.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+#include <iterator>
+#include <limits>
+
+#include "common/logging.h"
+#include "common/statusor.h"
+#include "gutil/strings/fastmem.h"
+#include "util/coding.h"
+#include "util/crc32c.h"
+#include "util/lru_cache.h"
+#include "util/threadpool.h"
+
+namespace starrocks {
+
+static constexpr size_t kSlotAlignment = 4096;
+
+static Status io_error(const std::string& context, int err_number) {
+    return Status::IOError(fmt::format("{}: {}", context, std::strerror(err_number)));
+}
+
+static Status pread_fully(int fd, char* buf, size_t count, off_t offset, size_t* bytes_read) {
+    size_t done = 0;
+    while (done < count) {
+        ssize_t res = ::pread(fd, buf + done, count - done, offset + done);
+        if (res < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return io_error("pread block cache file", errno);
+        }
+        if (res == 0) {
+            break;
+        }
+        done += res;
+    }
+    *bytes_read = done;
+    return Status::OK();
+}
+
+static Status pwrite_fully(int fd, const char* buf, size_t count, off_t offset) {
+    size_t done = 0;
+    while (done < count) {
+        ssize_t res = ::pwrite(fd, buf + done, count - done, offset + done);
+        if (res < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return io_error("pwrite block cache file", errno);
+        }
+        done += res;
+    }
+    return Status::OK();
+}
+
+static void delete_mem_block(const CacheKey& key, void* value) {
+    delete reinterpret_cast<std::string*>(value);
+}
+
+struct SlotHeader {
+    uint32_t data_crc = 0;
+    uint32_t block_size = 0;
+    uint32_t data_size = 0;
+    Slice key;
+};
+
+static uint32_t slot_header_crc(const char* header, size_t key_size) {
+    return crc32c::Value(header + 8, LocalCache::kSlotFixedHeaderSize - 8 + key_size);
+}
+
+static void encode_slot_header(const SlotHeader& header, char* buf) {
+    auto* p = reinterpret_cast<uint8_t*>(buf);
+    encode_fixed32_le(p, LocalCache::kSlotMagic);
+    encode_fixed32_le(p + 8, header.data_crc);
+    encode_fixed32_le(p + 12, header.block_size);
+    encode_fixed32_le(p + 16, header.data_size);
+    encode_fixed32_le(p + 20, header.key.size);
+    memcpy(buf + LocalCache::kSlotFixedHeaderSize, header.key.data, header.key.size);
+    encode_fixed32_le(p + 4, slot_header_crc(buf, header.key.size));
+}
+
+// Return false if |buf| is not a valid slot header.
+static bool decode_slot_header(const char* buf, SlotHeader* header) {
+    const auto* p = reinterpret_cast<const uint8_t*>(buf);
+    if (decode_fixed32_le(p) != LocalCache::kSlotMagic) {
+        return false;
+    }
+    uint32_t key_size = decode_fixed32_le(p + 20);
+    if (key_size > LocalCache::kMaxKeySize) {
+        return false;
+    }
+    if (decode_fixed32_le(p + 4) != slot_header_crc(buf, key_size)) {
+        return false;
+    }
+    header->data_crc = decode_fixed32_le(p + 8);
+    header->block_size = decode_fixed32_le(p + 12);
+    header->data_size = decode_fixed32_le(p + 16);
+    header->key = Slice(buf + LocalCache::kSlotFixedHeaderSize, key_size);
+    return header->data_size <= header->block_size;
+}
+
+LocalCache::LocalCache() = default;
+
+LocalCache::~LocalCache() {
+    (void)shutdown();
+}
+
+Status LocalCache::init(const CacheOptions& options) {
+    if (options.block_size == 0 || options.block_size > std::numeric_limits<uint32_t>::max()) {
+        return Status::InvalidArgument(fmt::format("invalid block size {}", options.block_size));
+    }
+    _block_size = options.block_size;
+    _slot_size = kSlotHeaderSize + (_block_size + kSlotAlignment - 1) / kSlotAlignment * kSlotAlignment;
+    _checksum = options.checksum;
+
+    if (options.mem_space_size > 0) {
+        _mem_cache.reset(new_lru_cache(options.mem_space_size));
+    }
+
+    for (const auto& dir : options.disk_spaces) {
+        DiskFile file;
+        RETURN_IF_ERROR(_open_disk_file(dir, &file));
+        if (file.num_slots > 0) {
+            _files.push_back(std::move(file));
+        }
+    }
+
+    if (!_files.empty()) {
+        RETURN_IF_ERROR(ThreadPoolBuilder("block_cache_flush")
+                                .set_min_threads(1)
+                                .set_max_threads(std::max<int>(1, _files.size() * 2))
+                                .set_max_queue_size(256)
+                                .build(&_flush_pool));
+    }
+    LOG(INFO) << "init local block cache, block size: " << _block_size << ", memory: " << options.mem_space_size
+              << ", disk slots: " << _slots.size() << ", recovered blocks: " << _index.size();
+    return Status::OK();
+}
+
+Status LocalCache::_open_disk_file(const DirSpace& dir, DiskFile* file) {
+    file->path = dir.path + "/" + kDataFileName;
+    file->first_slot = _slots.size();
+    file->num_slots = dir.size / _slot_size;
+    if (file->num_slots == 0) {
+        LOG(WARNING) << "disk space of block cache is too small, path: " << dir.path << ", size: " << dir.size;
+        return Status::OK();
+    }
+
+    int fd = ::open(file->path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+    if (fd < 0) {
+        return io_error(file->path, errno);
+    }
+    struct stat st;
+    if (::fstat(fd, &st) != 0 || ::ftruncate(fd, static_cast<off_t>(file->num_slots) * _slot_size) != 0) {
+        int err = errno;
+        ::close(fd);
+        return io_error(file->path, err);
+    }
+    file->fd = fd;
+
+    _slots.resize(_slots.size() + file->num_slots);
+    uint32_t num_recoverable = std::min<uint64_t>(st.st_size / _slot_size, file->num_slots);
+    _recover_slots(*file, num_recoverable);
+    return Status::OK();
+}
+
+void LocalCache::_recover_slots(const DiskFile& file, uint32_t num_recoverable) {
+    std::unique_ptr<char[]> buf(new char[kSlotHeaderSize]);
+    for (uint32_t i = file.num_slots; i > 0; i--) {
+        uint32_t slot_id = file.first_slot + i - 1;
+        Slot& slot = _slots[slot_id];
+        SlotHeader header;
+        size_t bytes_read = 0;
+        if (i <= num_recoverable &&
+            pread_fully(file.fd, buf.get(), kSlotHeaderSize, static_cast<off_t>(i - 1) * _slot_size, &bytes_read)
+                    .ok() &&
+            bytes_read == kSlotHeaderSize && decode_slot_header(buf.get(), &header) &&
+            header.block_size == _block_size && _index.count(header.key.to_string()) == 0) {
+            slot.key = header.key.to_string();
+            slot.state = SlotState::READY;
+            slot.verified = false;
+            _index.emplace(slot.key, slot_id);
+            _lru.push_back(slot_id);
+            slot.lru_pos = std::prev(_lru.end());
+        } else {
+            _free_slots.push_back(slot_id);
+        }
+    }
+}
+
+Status LocalCache::write_cache(const std::string& key, const char* value, size_t size, size_t ttl_seconds) {
+    if (size > _block_size) {
+        return Status::InvalidArgument(fmt::format("block size {} exceeds the limit {}", size, _block_size));
+    }
+    if (key.size() > kMaxKeySize) {
+        return Status::InvalidArgument(fmt::format("cache key size {} exceeds the limit {}", key.size(), kMaxKeySize));
+    }
+    if (_mem_cache) {
+        _insert_mem(key, value, size);
+    }
+    if (_files.empty()) {
+        return Status::OK();
+    }
+
+    uint32_t slot_id;
+    {
+        std::lock_guard l(_mutex);
+        auto iter = _index.find(key);
+        if (iter != _index.end()) {
+            if (_slots[iter->second].state == SlotState::WRITING) {
+                // the same block is being written
+                return Status::OK();
+            }
+            _drop_slot_locked(iter->second);
+        }
+        auto res = _allocate_slot_locked();
+        if (!res.ok()) {
+            // all the slots are being written or read, keep the block in memory only
+            return Status::OK();
+        }
+        slot_id = res.value();
+        Slot& slot = _slots[slot_id];
+        slot.key = key;
+        slot.state = SlotState::WRITING;
+        slot.verified = true;
+        _index.emplace(key, slot_id);
+    }
+
+    // The block is written to disk asynchronously, so that the reader populating the cache is not blocked.
+    auto data = std::make_shared<std::string>(value, size);
+    Status st = _flush_pool->submit_func([this, slot_id, key, data]() { _write_disk(slot_id, key, *data); });
+    if (!st.ok()) {
+        VLOG(2) << "skip writing block to disk cache: " << st;
+        std::lock_guard l(_mutex);
+        _drop_slot_locked(slot_id);
+        _free_slot_locked(slot_id);
+    }
+    return Status::OK();
+}
+
+void LocalCache::_insert_mem(const std::string& key, const char* value, size_t size) {
+    auto* block = new std::string(value, size);
+    Cache::Handle* handle = _mem_cache->insert(key, block, size, delete_mem_block);
+    if (handle != nullptr) {
+        _mem_cache->release(handle);
+    }
+}
+
+void LocalCache::_write_disk(uint32_t slot_id, const std::string& key, const std::string& data) {
+    std::string buf(kSlotHeaderSize + data.size(), '\0');
+    SlotHeader header;
+    header.data_crc = crc32c::Value(data.data(), data.size());
+    header.block_size = _block_size;
+    header.data_size = data.size();
+    header.key = Slice(key);
+    encode_slot_header(header, buf.data());
+    strings::memcpy_inlined(buf.data() + kSlotHeaderSize, data.data(), data.size());
+
+    Status st = pwrite_fully(_file_of(slot_id).fd, buf.data(), buf.size(), _slot_offset(slot_id));
+    if (!st.ok()) {
+        LOG(WARNING) << "write block to disk cache failed: " << st;
+    }
+
+    std::lock_guard l(_mutex);
+    Slot& slot = _slots[slot_id];
+    DCHECK(slot.state == SlotState::WRITING);
+    if (!st.ok() || slot.removed) {
+        _drop_slot_locked(slot_id);
+        if (st.ok()) {
+            (void)_invalidate_slot(slot_id);
+        }
+        _free_slot_locked(slot_id);
+        return;
+    }
+    slot.state = SlotState::READY;
+    _lru.push_front(slot_id);
+    slot.lru_pos = _lru.begin();
+}
+
+StatusOr<size_t> LocalCache::read_cache(const std::string& key, char* value, size_t off, size_t size) {
+    if (_mem_cache) {
+        Cache::Handle* handle = _mem_cache->lookup(key);
+        if (handle != nullptr) {
+            const auto* block = reinterpret_cast<const std::string*>(_mem_cache->value(handle));
+            if (off + size > block->size()) {
+                _mem_cache->release(handle);
+                return Status::InvalidArgument(
+                        fmt::format("read range [{}, {}) exceeds the block size {}", off, off + size, block->size()));
+            }
+            strings::memcpy_inlined(value, block->data() + off, size);
+            _mem_cache->release(handle);
+            _mem_hits.fetch_add(1, std::memory_order_relaxed);
+            return size;
+        }
+    }
+
+    uint32_t slot_id;
+    {
+        std::lock_guard l(_mutex);
+        auto iter = _index.find(key);
+        if (iter == _index.end() || _slots[iter->second].state != SlotState::READY) {
+            _misses.fetch_add(1, std::memory_order_relaxed);
+            return Status::NotFound("block not found in local cache");
+        }
+        slot_id = iter->second;
+        Slot& slot = _slots[slot_id];
+        slot.pins++;
+        _lru.splice(_lru.begin(), _lru, slot.lru_pos);
+    }
+    auto res = _read_disk(slot_id, key, value, off, size);
+    _unpin_slot(slot_id);
+    return res;
+}
+
+StatusOr<size_t> LocalCache::_read_disk(uint32_t slot_id, const std::string& key, char* value, size_t off,
+                                        size_t size) {
+    std::unique_ptr<char[]> buf(new char[_slot_size]);
+    size_t bytes_read = 0;
+    RETURN_IF_ERROR(pread_fully(_file_of(slot_id).fd, buf.get(), _slot_size, _slot_offset(slot_id), &bytes_read));
+
+    SlotHeader header;
+    bool valid = bytes_read >= kSlotHeaderSize && decode_slot_header(buf.get(), &header) &&
+                 header.block_size == _block_size && header.key == Slice(key) &&
+                 bytes_read >= kSlotHeaderSize + header.data_size;
+    const char* data = buf.get() + kSlotHeaderSize;
+    if (valid) {
+        bool verified;
+        {
+            std::lock_guard l(_mutex);
+            verified = _slots[slot_id].verified;
+        }
+        if (_checksum || !verified) {
+            valid = crc32c::Value(data, header.data_size) == header.data_crc;
+            if (valid && !verified) {
+                std::lock_guard l(_mutex);
+                _slots[slot_id].verified = true;
+            }
+        }
+    }
+    if (!valid) {
+        LOG(WARNING) << "found corrupted block in disk cache, file: " << _file_of(slot_id).path
+                     << ", slot: " << slot_id;
+        _corruptions.fetch_add(1, std::memory_order_relaxed);
+        std::lock_guard l(_mutex);
+        _drop_slot_locked(slot_id);
+        return Status::NotFound("block in local cache is corrupted");
+    }
+
+    if (off + size > header.data_size) {
+        return Status::InvalidArgument(
+                fmt::format("read range [{}, {}) exceeds the block size {}", off, off + size, header.data_size));
+    }
+    strings::memcpy_inlined(value, data + off, size);
+    if (_mem_cache) {
+        _insert_mem(key, data, header.data_size);
+    }
+    _disk_hits.fetch_add(1, std::memory_order_relaxed);
+    return size;
+}
+
+Status LocalCache::remove_cache(const std::string& key) {
+    if (_mem_cache) {
+        _mem_cache->erase(key);
+    }
+    std::lock_guard l(_mutex);
+    auto iter = _index.find(key);
+    if (iter != _index.end()) {
+        _drop_slot_locked(iter->second);
+    }
+    return Status::OK();
+}
+
+StatusOr<uint32_t> LocalCache::_allocate_slot_locked() {
+    if (!_free_slots.empty()) {
+        uint32_t slot_id = _free_slots.back();
+        _free_slots.pop_back();
+        return slot_id;
+    }
+    for (auto iter = _lru.rbegin(); iter != _lru.rend(); ++iter) {
+        uint32_t slot_id = *iter;
+        Slot& slot = _slots[slot_id];
+        if (slot.pins > 0) {
+            continue;
+        }
+        // The slot is overwritten right away, a torn write is detected by the data crc when the slot
+        // is recovered.
+        _index.erase(slot.key);
+        _lru.erase(slot.lru_pos);
+        slot.key.clear();
+        slot.state = SlotState::FREE;
+        return slot_id;
+    }
+    return Status::ResourceBusy("no free slot in local cache");
+}
+
+void LocalCache::_drop_slot_locked(uint32_t slot_id) {
+    Slot& slot = _slots[slot_id];
+    if (slot.removed) {
+        return;
+    }
+    auto iter = _index.find(slot.key);
+    if (iter != _index.end() && iter->second == slot_id) {
+        _index.erase(iter);
+    }
+    if (slot.state == SlotState::WRITING) {
+        // the writer frees the slot once it finishes
+        slot.removed = true;
+        return;
+    }
+    DCHECK(slot.state == SlotState::READY);
+    _lru.erase(slot.lru_pos);
+    if (slot.pins > 0) {
+        slot.removed = true;
+        return;
+    }
+    (void)_invalidate_slot(slot_id);
+    _free_slot_locked(slot_id);
+}
+
+void LocalCache::_free_slot_locked(uint32_t slot_id) {
+    Slot& slot = _slots[slot_id];
+    slot.key.clear();
+    slot.state = SlotState::FREE;
+    slot.pins = 0;
+    slot.removed = false;
+    slot.verified = true;
+    _free_slots.push_back(slot_id);
+}
+
+void LocalCache::_unpin_slot(uint32_t slot_id) {
+    std::lock_guard l(_mutex);
+    Slot& slot = _slots[slot_id];
+    DCHECK_GT(slot.pins, 0);
+    if (--slot.pins == 0 && slot.removed) {
+        (void)_invalidate_slot(slot_id);
+        _free_slot_locked(slot_id);
+    }
+}
+
+// Clear the magic of the slot, so that a removed block is not recovered after restart.
+Status LocalCache::_invalidate_slot(uint32_t slot_id) {
+    char zeros[4] = {0};
+    return pwrite_fully(_file_of(slot_id).fd, zeros, sizeof(zeros), _slot_offset(slot_id));
+}
+
+const LocalCache::DiskFile& LocalCache::_file_of(uint32_t slot_id) const {
+    for (const auto& file : _files) {
+        if (slot_id < file.first_slot + file.num_slots) {
+            return file;
+        }
+    }
+    CHECK(false) << "invalid slot id " << slot_id;
+    return _files.back();
+}
+
+off_t LocalCache::_slot_offset(uint32_t slot_id) const {
+    return static_cast<off_t>(slot_id - _file_of(slot_id).first_slot) * _slot_size;
+}
+
+void LocalCache::wait_for_flush() {
+    if (_flush_pool) {
+        _flush_pool->wait();
+    }
+}
+
+size_t LocalCache::mem_usage() const {
+    return _mem_cache ? _mem_cache->get_memory_usage() : 0;
+}
+
+size_t LocalCache::disk_block_count() const {
+    std::lock_guard l(_mutex);
+    return _lru.size();
+}
+
+Status LocalCache::shutdown() {
+    if (_flush_pool) {
+        _flush_pool->wait();
+        _flush_pool->shutdown();
+        _flush_pool.reset();
+    }
+    Status st;
+    for (auto& file : _files) {
+        if (file.fd < 0) {
+            continue;
+        }
+        if (::fsync(file.fd) != 0) {
+            st.update(io_error(file.path, errno));
+        }
+        ::close(file.fd);
+        file.fd = -1;
+    }
+    return st;
+}
+
+} // namespace starrocks
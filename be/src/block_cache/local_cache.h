@@ -0,0 +1,154 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <atomic>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "block_cache/kv_cache.h"
+#include "common/status.h"
+
+namespace starrocks {
+
+class Cache;
+class ThreadPool;
+
+// LocalCache is a KvCache built on the local memory and disks only, it has no third-party dependency.
+//
+// The memory tier is a LRU cache of whole blocks. The disk tier splits every disk space into fixed-size
+// slots, one block per slot, and evicts the least recently used slot when there is no free one.
+// Blocks are written to the memory tier synchronously and to the disk tier by a background thread, so
+// populating the cache never blocks the reader on a disk write.
+//
+// The slot format is as follows:
+//
+//    <magic>       [32-bit]
+//    <header_crc>  [32-bit] crc32c of all the following header fields and the key
+//    <data_crc>    [32-bit] crc32c of the block data
+//    <block_size>  [32-bit] the configured block size when the slot was written
+//    <data_size>   [32-bit]
+//    <key_size>    [32-bit]
+//    <key>
+//    <padding>     up to kSlotHeaderSize bytes
+//    <data>        up to block_size bytes
+//
+// Every slot describes itself, so the index is rebuilt by scanning the slot headers when the cache is
+// opened again and the cached blocks survive restarts. A slot recovered this way is verified against
+// its data crc on its first read even if checksum is disabled, which guards against torn writes.
+class LocalCache : public KvCache {
+public:
+    static constexpr uint32_t kSlotMagic = 0x53424331; // "SBC1"
+    static constexpr size_t kSlotHeaderSize = 4096;
+    static constexpr size_t kSlotFixedHeaderSize = 24;
+    static constexpr size_t kMaxKeySize = kSlotHeaderSize - kSlotFixedHeaderSize;
+    static constexpr const char* kDataFileName = "local_cache_data";
+
+    LocalCache();
+    ~LocalCache() override;
+
+    Status init(const CacheOptions& options) override;
+
+    Status write_cache(const std::string& key, const char* value, size_t size, size_t ttl_seconds) override;
+
+    StatusOr<size_t> read_cache(const std::string& key, char* value, size_t off, size_t size) override;
+
+    Status remove_cache(const std::string& key) override;
+
+    Status shutdown() override;
+
+    // Block until all the pending disk writes are finished.
+    void wait_for_flush();
+
+    size_t mem_usage() const;
+    // Number of blocks cached on disk.
+    size_t disk_block_count() const;
+    size_t disk_slot_count() const { return _slots.size(); }
+
+    int64_t mem_hit_count() const { return _mem_hits.load(std::memory_order_relaxed); }
+    int64_t disk_hit_count() const { return _disk_hits.load(std::memory_order_relaxed); }
+    int64_t miss_count() const { return _misses.load(std::memory_order_relaxed); }
+    int64_t corruption_count() const { return _corruptions.load(std::memory_order_relaxed); }
+
+private:
+    enum class SlotState : uint8_t { FREE, WRITING, READY };
+
+    struct Slot {
+        std::string key;
+        SlotState state = SlotState::FREE;
+        // the slot is read by some threads and must not be reused
+        uint32_t pins = 0;
+        // the key has been removed while the slot is written or read
+        bool removed = false;
+        // the data crc has been checked since the slot was recovered
+        bool verified = true;
+        std::list<uint32_t>::iterator lru_pos;
+    };
+
+    struct DiskFile {
+        std::string path;
+        int fd = -1;
+        uint32_t first_slot = 0;
+        uint32_t num_slots = 0;
+    };
+
+    Status _open_disk_file(const DirSpace& dir, DiskFile* file);
+    void _recover_slots(const DiskFile& file, uint32_t num_recoverable);
+
+    void _insert_mem(const std::string& key, const char* value, size_t size);
+    void _write_disk(uint32_t slot_id, const std::string& key, const std::string& data);
+    StatusOr<size_t> _read_disk(uint32_t slot_id, const std::string& key, char* value, size_t off, size_t size);
+
+    // Return a slot for a new block, evict the least recently used one if there is no free slot.
+    // REQUIRES: _mutex is held
+    StatusOr<uint32_t> _allocate_slot_locked();
+    // Drop the block in |slot_id|, the slot is freed once nobody reads it.
+    // REQUIRES: _mutex is held
+    void _drop_slot_locked(uint32_t slot_id);
+    // REQUIRES: _mutex is held
+    void _free_slot_locked(uint32_t slot_id);
+    void _unpin_slot(uint32_t slot_id);
+
+    const DiskFile& _file_of(uint32_t slot_id) const;
+    off_t _slot_offset(uint32_t slot_id) const;
+    Status _invalidate_slot(uint32_t slot_id);
+
+    size_t _block_size = 0;
+    size_t _slot_size = 0;
+    bool _checksum = false;
+
+    std::unique_ptr<Cache> _mem_cache;
+
+    mutable std::mutex _mutex;
+    std::vector<DiskFile> _files;
+    std::vector<Slot> _slots;
+    std::unordered_map<std::string, uint32_t> _index;
+    // front is the most recently used
+    std::list<uint32_t> _lru;
+    std::vector<uint32_t> _free_slots;
+
+    std::unique_ptr<ThreadPool> _flush_pool;
+
+    std::atomic<int64_t> _mem_hits{0};
+    std::atomic<int64_t> _disk_hits{0};
+    std::atomic<int64_t> _misses{0};
+    std::atomic<int64_t> _corruptions{0};
+};
+
+} // namespace starrocks
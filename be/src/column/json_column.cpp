@@ -24,6 +24,129 @@ void JsonColumn::append_datum(const Datum& datum) {
     append(datum.get<JsonValue*>());
 }
 
+void JsonColumn::set_flat_column(const std::string& path, LogicalType type, ColumnPtr column) {
+    DCHECK(column->is_nullable());
+    for (auto& flat : _flat_columns) {
+        if (flat.path == path) {
+            flat.type = type;
+            flat.column = std::move(column);
+            return;
+        }
+    }
+    _flat_columns.push_back(FlatColumn{path, type, std::move(column)});
+}
+
+ColumnPtr JsonColumn::get_flat_column(const std::string& path, LogicalType* type) const {
+    for (const auto& flat : _flat_columns) {
+        if (flat.path == path) {
+            if (flat.column->size() != size()) {
+                return nullptr;
+            }
+            *type = flat.type;
+            return flat.column;
+        }
+    }
+    return nullptr;
+}
+
+void JsonColumn::append(const JsonValue* object) {
+    _flat_columns.clear();
+    SuperClass::append(object);
+}
+
+void JsonColumn::append(JsonValue&& object) {
+    _flat_columns.clear();
+    SuperClass::append(std::move(object));
+}
+
+void JsonColumn::append(const Column& src, size_t offset, size_t count) {
+    _flat_columns.clear();
+    SuperClass::append(src, offset, count);
+}
+
+void JsonColumn::append_selective(const Column& src, const uint32_t* indexes, uint32_t from, uint32_t size) {
+    _flat_columns.clear();
+    SuperClass::append_selective(src, indexes, from, size);
+}
+
+void JsonColumn::append_value_multiple_times(const Column& src, uint32_t index, uint32_t size) {
+    _flat_columns.clear();
+    SuperClass::append_value_multiple_times(src, index, size);
+}
+
+void JsonColumn::append_value_multiple_times(const void* value, size_t count) {
+    _flat_columns.clear();
+    SuperClass::append_value_multiple_times(value, count);
+}
+
+bool JsonColumn::append_strings(const Buffer<Slice>& strs) {
+    _flat_columns.clear();
+    return SuperClass::append_strings(strs);
+}
+
+void JsonColumn::append_default() {
+    _flat_columns.clear();
+    SuperClass::append_default();
+}
+
+void JsonColumn::append_default(size_t count) {
+    _flat_columns.clear();
+    SuperClass::append_default(count);
+}
+
+void JsonColumn::deserialize_and_append_batch(Buffer<Slice>& srcs, size_t chunk_size) {
+    _flat_columns.clear();
+    SuperClass::deserialize_and_append_batch(srcs, chunk_size);
+}
+
+void JsonColumn::resize(size_t n) {
+    _flat_columns.clear();
+    SuperClass::resize(n);
+}
+
+void JsonColumn::assign(size_t n, size_t idx) {
+    _flat_columns.clear();
+    SuperClass::assign(n, idx);
+}
+
+void JsonColumn::remove_first_n_values(size_t count) {
+    _flat_columns.clear();
+    SuperClass::remove_first_n_values(count);
+}
+
+void JsonColumn::fill_default(const Filter& filter) {
+    _flat_columns.clear();
+    SuperClass::fill_default(filter);
+}
+
+Status JsonColumn::update_rows(const Column& src, const uint32_t* indexes) {
+    _flat_columns.clear();
+    return SuperClass::update_rows(src, indexes);
+}
+
+size_t JsonColumn::filter_range(const Filter& filter, size_t from, size_t to) {
+    for (auto& flat : _flat_columns) {
+        if (flat.column->size() != size()) {
+            continue;
+        }
+        if (flat.column.use_count() > 1) {
+            flat.column = flat.column->clone();
+        }
+        flat.column->filter_range(filter, from, to);
+    }
+    return SuperClass::filter_range(filter, from, to);
+}
+
+void JsonColumn::swap_column(Column& rhs) {
+    std::swap(_flat_columns, down_cast<JsonColumn&>(rhs)._flat_columns);
+    SuperClass::swap_column(rhs);
+}
+
+void JsonColumn::reset_column() {
+    _flat_columns.clear();
+    SuperClass::reset_column();
+}
+
 int JsonColumn::compare_at(size_t left_idx, size_t right_idx, const starrocks::Column& rhs,
                            int nan_direction_hint) const {
     JsonValue* x = get_object(left_idx);
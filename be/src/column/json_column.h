@@ -14,9 +14,13 @@
 
 #pragma once
 
+#include <string>
+#include <vector>
+
 #include "column/column.h"
 #include "column/object_column.h"
 #include "column/vectorized_fwd.h"
+#include "types/logical_type.h"
 #include "util/json.h"
 
 namespace starrocks {
@@ -49,7 +53,44 @@ public:
     uint32_t serialize_size(size_t idx) const override;
     uint32_t serialize(size_t idx, uint8_t* pos) override;
 
+    // The flat columns are the typed columns of the top-level keys read along with the JSON values from a
+    // segment, see JsonMetaPB.flat_paths, so that the functions extracting a key don't need to parse the JSON.
+    // They are kept by `filter_range` only, and dropped by any other modification of this column.
+    // |column| is a nullable column of |type|, NULL if the key is missing.
+    void set_flat_column(const std::string& path, LogicalType type, ColumnPtr column);
+    // Return nullptr if there is no flat column of |path| aligned with the JSON values.
+    ColumnPtr get_flat_column(const std::string& path, LogicalType* type) const;
+    bool has_flat_columns() const { return !_flat_columns.empty(); }
+    void clear_flat_columns() { _flat_columns.clear(); }
+
+    using SuperClass::append;
+    void append(const JsonValue* object);
+    void append(JsonValue&& object);
+    void append(const Column& src, size_t offset, size_t count) override;
+    void append_selective(const Column& src, const uint32_t* indexes, uint32_t from, uint32_t size) override;
+    void append_value_multiple_times(const Column& src, uint32_t index, uint32_t size) override;
+    void append_value_multiple_times(const void* value, size_t count) override;
+    bool append_strings(const Buffer<Slice>& strs) override;
+    void append_default() override;
+    void append_default(size_t count) override;
+    void deserialize_and_append_batch(Buffer<Slice>& srcs, size_t chunk_size) override;
+    void resize(size_t n) override;
+    void assign(size_t n, size_t idx) override;
+    void remove_first_n_values(size_t count) override;
+    void fill_default(const Filter& filter) override;
+    Status update_rows(const Column& src, const uint32_t* indexes) override;
+    size_t filter_range(const Filter& filter, size_t from, size_t to) override;
+    void swap_column(Column& rhs) override;
+    void reset_column() override;
+
 private:
+    struct FlatColumn {
+        std::string path;
+        LogicalType type;
+        ColumnPtr column;
+    };
+
+    std::vector<FlatColumn> _flat_columns;
 };
 
 } // namespace starrocks
@@ -284,6 +284,9 @@ CONF_Int64(index_stream_cache_capacity, "10737418240");
 CONF_mString(storage_page_cache_limit, "20%");
 // whether to disable page cache feature in storage
 CONF_Bool(disable_storage_page_cache, "false");
+// Eviction policy of the storage page cache, "lru" or "slru".
+// "slru" is a scan-resistant segmented LRU, which keeps frequently accessed pages when large scans run.
+CONF_String(storage_page_cache_eviction_policy, "lru");
 // whether to disable column pool
 CONF_Bool(disable_column_pool, "false");
 
@@ -309,6 +312,11 @@ CONF_mInt32(update_compaction_check_interval_seconds, "60");
 CONF_mInt32(update_compaction_num_threads_per_disk, "1");
 CONF_Int32(update_compaction_per_tablet_min_interval_seconds, "120"); // 2min
 CONF_mInt64(max_update_compaction_num_singleton_deltas, "1000");
+// The primary keys of the output rows of a primary key table compaction are collected while merging, as long as
+// they take at most this many bytes, so that applying the compaction need not read them back from the output
+// segments. While they are split by output segment, both copies are alive, so keep it around the size of the keys of
+// a single segment. 0 disables it.
+CONF_mInt64(update_compaction_merged_keys_max_bytes, "134217728");
 
 CONF_mInt32(repair_compaction_interval_seconds, "600"); // 10 min
 
@@ -326,6 +334,15 @@ CONF_mInt64(min_cmumulative_compaction_failure_interval_sec, "30"); // 30s
 // This config can be set to 0, which means to forbid any compaction, for some special cases.
 CONF_mInt32(max_compaction_concurrency, "-1");
 
+// The I/O bytes per second of all the compaction tasks, and the number of CPU cores they may keep busy.
+// 0 means no limit. The primary key compactions are throttled ahead of cumulative, then base compactions.
+CONF_mInt64(compaction_max_io_bytes_per_second, "0");
+CONF_mDouble(compaction_max_cpu_cores, "0");
+// When at least this number of queries are running, base compactions are paused and the other compactions
+// run with `compaction_busy_throttle_ratio` of the above limits. 0 disables it.
+CONF_mInt32(compaction_busy_query_num, "0");
+CONF_mDouble(compaction_busy_throttle_ratio, "0.3");
+
 // Threshold to logging compaction trace, in seconds.
 CONF_mInt32(compaction_trace_threshold, "60");
 
@@ -333,6 +350,18 @@ CONF_mInt32(compaction_trace_threshold, "60");
 // If the number of schema columns is greater than this,
 // the columns will be divided into groups for vertical compaction.
 CONF_Int64(vertical_compaction_max_columns_per_group, "5");
+// Max number of non-key column groups merged concurrently by one vertical compaction task.
+// The read chunks of the concurrent groups share compaction_memory_limit_per_worker, but every group also
+// keeps its own segment readers and column writers, so the peak memory of a task still grows with it.
+// 1 means the column groups are merged one by one.
+CONF_Int32(vertical_compaction_max_parallel_column_groups, "1");
+
+// If the input rowsets of a compaction have no delete predicate and their segments do not overlap on the
+// first sort key column, the output rowset is built by linking the input segment files without decoding them.
+CONF_mBool(enable_compaction_link_segments, "true");
+// Only the segments whose size is at least this ratio of max_segment_file_size are linked, the smaller ones are
+// rewritten into larger segments.
+CONF_mDouble(compaction_link_segment_min_size_ratio, "0.5");
 
 CONF_Bool(enable_event_based_compaction_framework, "true");
 
@@ -375,6 +404,31 @@ CONF_Int32(be_exit_after_disk_write_hang_second, "60");
 CONF_Double(dictionary_encoding_ratio, "0.7");
 // The minimum chunk size for dictionary encoding speculation
 CONF_Int32(dictionary_speculate_min_chunk_size, "10000");
+// Evaluate the predicates on a dictionary encoded string column, whose data pages are not all dictionary
+// encoded, against its dictionary while reading the data pages, only the selected rows are materialized.
+CONF_mBool(enable_dict_page_predicate_pushdown, "true");
+// Extract the top-level keys appearing in most of the JSON values of a segment into typed columns
+// while writing the segment, so that extracting these keys doesn't need to parse the JSON values.
+CONF_mBool(enable_json_flat, "false");
+// The number of the leading JSON values of a segment sampled to choose the keys to extract
+CONF_mInt32(json_flat_sample_rows, "1024");
+// A key is extracted only if it appears with the same type in at least this ratio of the sampled values
+CONF_mDouble(json_flat_min_key_ratio, "0.8");
+// The maximum number of the keys extracted from a JSON column of a segment
+CONF_mInt32(json_flat_max_columns, "20");
+// Evaluate the identical sub-expressions of the projections of a project operator only once per chunk.
+CONF_mBool(enable_common_sub_expr_extraction, "true");
+// A function is only evaluated on the rows needed, e.g. the rows passing the previous conjuncts, if the ratio of
+// these rows is at most this value, otherwise it's evaluated on all the rows to save the cost of selecting the rows.
+CONF_mDouble(expr_selective_evaluation_ratio, "0.5");
+// Skip the rows which can't match the constant regex of regexp_extract and regexp_replace by Hyperscan, so that
+// RE2 only runs on the rows which may match.
+CONF_mBool(enable_regexp_hyperscan_prefilter, "true");
+// Reorder the conjuncts of an operator by their sampled cost per row and selectivity, the cheap and selective ones
+// are evaluated first.
+CONF_mBool(enable_adaptive_conjuncts_order, "true");
+// The conjuncts of an operator are sampled on one chunk in every this number of chunks.
+CONF_mInt32(adaptive_conjuncts_order_sample_period, "32");
 
 // The maximum amount of data that can be processed by a stream load
 CONF_mInt64(streaming_load_max_mb, "10240");
@@ -382,6 +436,14 @@ CONF_mInt64(streaming_load_max_mb, "10240");
 // Therefore, it is necessary to limit the maximum number of
 // such data when using stream load to prevent excessive memory consumption.
 CONF_mInt64(streaming_load_max_batch_size_mb, "100");
+// The number of scanners parsing a single plain CSV stream load in parallel. The stream is cut into
+// blocks of complete rows of about 'stream_load_parse_block_size' bytes, 1 means no intra-file parallelism.
+CONF_mInt32(stream_load_parse_parallelism, "1");
+CONF_mInt64(stream_load_parse_block_size, "4194304");
+// Whether the rows parsed in parallel are sent to the table sink in the order of the stream. The order
+// matters if a later row should overwrite an earlier one with the same key. The pipeline engine can't keep
+// the order across its scan operators, so a pipeline stream load is only parsed in parallel if it's false.
+CONF_mBool(stream_load_parse_keep_order, "true");
 // The alive time of a TabletsChannel.
 // If the channel does not receive any data till this time,
 // the channel will be removed.
@@ -494,6 +556,10 @@ CONF_Int32(memory_max_alignment, "16");
 
 // write buffer size before flush
 CONF_mInt64(write_buffer_size, "104857600");
+// The memtable of a table with aggregate, unique or primary keys switches from sorting its buffered rows to
+// grouping them with a hash table once at least this ratio of the rows of a sorted run is merged away, and
+// then also merges the aggregated runs with each other to absorb more rows before a flush. 0 disables it.
+CONF_mDouble(memtable_hash_aggregate_dup_ratio, "0.5");
 
 // Following 2 configs limit the memory consumption of load process on a Backend.
 // eg: memory limit to 80% of mem limit config but up to 100GB(default)
@@ -503,6 +569,9 @@ CONF_mInt64(write_buffer_size, "104857600");
 CONF_Int64(load_process_max_memory_limit_bytes, "107374182400"); // 100GB
 CONF_Int32(load_process_max_memory_limit_percent, "30");         // 30%
 CONF_Bool(enable_new_load_on_memory_limit_exceeded, "false");
+// The active memtables of all the loads on a Backend are flushed, largest first, once their total size
+// exceeds this percent of the load memory limit. 0 disables it.
+CONF_mInt32(load_write_buffer_soft_limit_percent, "70");
 CONF_Int64(compaction_max_memory_limit, "-1");
 CONF_Int32(compaction_max_memory_limit_percent, "100");
 CONF_Int64(compaction_memory_limit_per_worker, "2147483648"); // 2GB
@@ -664,6 +733,12 @@ CONF_mInt16(storage_format_version, "2");
 // 1 for LZ4_NULL
 CONF_mInt16(null_encoding, "0");
 
+// IMPORTANT NOTE: enabling this config requires all BEs to be upgraded to a version which supports
+// ADAPTIVE_ENCODING, otherwise segments written by this BE can not be read by the old ones.
+// If true, integer/date/datetime columns without an explicit encoding choose the encoding of every data page
+// by trial-encoding a sample of its values, instead of always using the default encoding of the type.
+CONF_mBool(enable_adaptive_page_encoding, "false");
+
 // Do pre-aggregate if effect great than the factor, factor range:[1-100].
 CONF_Int16(pre_aggregate_factor, "80");
 
@@ -794,6 +869,8 @@ CONF_mBool(aws_sdk_logging_trace_enabled, "false");
 CONF_mInt64(experimental_s3_max_single_part_size, "16777216");
 // default: 16MB
 CONF_mInt64(experimental_s3_min_upload_part_size, "16777216");
+// The max number of the parts of an S3 object uploaded concurrently.
+CONF_mInt32(experimental_s3_max_concurrent_part_uploads, "4");
 
 CONF_Int64(max_load_dop, "16");
 
@@ -827,11 +904,23 @@ CONF_String(starlet_cache_dir, "");
 #endif
 
 CONF_Int64(lake_metadata_cache_limit, /*2GB=*/"2147483648");
+// Eviction policy of the lake metadata cache, "lru" or "slru".
+CONF_String(lake_metadata_cache_eviction_policy, "lru");
 CONF_Int64(lake_gc_metadata_max_versions, "10");
 CONF_Int64(lake_gc_metadata_check_interval, /*30 minutes=*/"1800");
 CONF_Int64(lake_gc_segment_check_interval, /*60 minutes=*/"3600");
 // This value should be much larger than the maximum timeout of loading/compaction/schema change jobs.
 CONF_Int64(lake_gc_segment_expire_seconds, /*3 days=*/"259200");
+// The local directory the input segments of lake compaction tasks are downloaded into before merging them.
+// Empty means the input segments are read remotely.
+CONF_mString(lake_compaction_staging_dir, "");
+// The max total size of the input segments downloaded by all the lake compaction tasks, the segments beyond it
+// are read remotely.
+CONF_mInt64(lake_compaction_staging_max_bytes, /*10GB=*/"10737418240");
+// The number of the input segments downloaded concurrently by a lake compaction task.
+CONF_mInt32(lake_compaction_download_parallelism, "8");
+// The max number of threads downloading the input segments of all the lake compaction tasks.
+CONF_Int32(lake_compaction_download_threads, "16");
 
 CONF_mBool(dependency_librdkafka_debug_enable, "false");
 
@@ -889,6 +978,11 @@ CONF_String(block_cache_meta_path, "${STARROCKS_HOME}/block_cache/");
 CONF_Int64(block_cache_block_size, "1048576");  // 1MB
 CONF_Int64(block_cache_mem_size, "2147483648"); // 2GB
 CONF_Bool(block_cache_checksum_enable, "true");
+// The implementation of block cache, "local" is the built-in memory and disk cache, "cachelib" is only
+// available if the binary is built with WITH_BLOCK_CACHE.
+CONF_String(block_cache_engine, "local");
+// Whether to cache the segment files of lake tablets in block cache.
+CONF_mBool(block_cache_lake_segment_enable, "false");
 
 CONF_mInt64(l0_l1_merge_ratio, "10");
 CONF_mInt64(l0_max_file_size, "209715200"); // 200MB
@@ -97,6 +97,10 @@ public:
     virtual bool accept_empty_scan_ranges() const { return true; }
 
     virtual bool stream_data_source() const { return false; }
+
+    // The number of data sources reading the only scan range of |scan_ranges| together in the pipeline engine,
+    // which share the work of the scan range through this provider. 1 means the scan range is read by one data source.
+    virtual int data_sources_per_scan_range(const std::vector<TScanRangeParams>& scan_ranges) { return 1; }
 };
 using DataSourceProviderPtr = std::unique_ptr<DataSourceProvider>;
 
@@ -14,12 +14,15 @@
 
 #include "connector/file_connector.h"
 
+#include "common/config.h"
 #include "exec/csv_scanner.h"
 #include "exec/exec_node.h"
 #include "exec/json_scanner.h"
 #include "exec/orc_scanner.h"
 #include "exec/parquet_scanner.h"
 #include "exprs/expr.h"
+#include "gutil/casts.h"
+#include "runtime/stream_load/stream_load_pipe.h"
 
 namespace starrocks::connector {
 
@@ -37,8 +40,38 @@ DataSourcePtr FileDataSourceProvider::create_data_source(const TScanRange& scan_
     return std::make_unique<FileDataSource>(this, scan_range);
 }
 
+FileDataSourceProvider::~FileDataSourceProvider() = default;
+
+int FileDataSourceProvider::data_sources_per_scan_range(const std::vector<TScanRangeParams>& scan_ranges) {
+    int parallelism = config::stream_load_parse_parallelism;
+    if (parallelism <= 1 || config::stream_load_parse_keep_order || scan_ranges.size() != 1 ||
+        !CSVScanner::is_splittable_stream_load(scan_ranges[0].scan_range.broker_scan_range)) {
+        return 1;
+    }
+    _split_stream_load = true;
+    return parallelism;
+}
+
+StatusOr<StreamLoadPipeSplitter*> FileDataSourceProvider::_get_stream_splitter(RuntimeState* state,
+                                                                              const TBrokerScanRange& scan_range) {
+    if (!_split_stream_load) {
+        return nullptr;
+    }
+    std::lock_guard<std::mutex> l(_stream_splitter_lock);
+    if (_stream_splitter == nullptr && _stream_splitter_status.ok()) {
+        auto res = CSVScanner::create_stream_splitter(state, scan_range);
+        if (res.ok()) {
+            _stream_splitter = std::move(res).value();
+        } else {
+            _stream_splitter_status = res.status();
+        }
+    }
+    RETURN_IF_ERROR(_stream_splitter_status);
+    return _stream_splitter.get();
+}
+
 // ================================
-FileDataSource::FileDataSource(const FileDataSourceProvider* provider, const TScanRange& scan_range)
+FileDataSource::FileDataSource(FileDataSourceProvider* provider, const TScanRange& scan_range)
         : _provider(provider), _scan_range(scan_range.broker_scan_range) {
     // remove range desc with empty file
     _scan_range.ranges.clear();
@@ -81,6 +114,10 @@ Status FileDataSource::_create_scanner() {
         return Status::InternalError("Failed to create scanner");
     }
     RETURN_IF_ERROR(_scanner->open());
+    ASSIGN_OR_RETURN(auto splitter, _provider->_get_stream_splitter(_runtime_state, _scan_range));
+    if (splitter != nullptr) {
+        down_cast<CSVScanner*>(_scanner.get())->set_stream_splitter(splitter);
+    }
     return Status::OK();
 }
 
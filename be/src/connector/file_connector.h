@@ -14,10 +14,16 @@
 
 #pragma once
 
+#include <mutex>
+
 #include "column/vectorized_fwd.h"
 #include "connector/connector.h"
 #include "exec/file_scanner.h"
 
+namespace starrocks {
+class StreamLoadPipeSplitter;
+}
+
 namespace starrocks::connector {
 
 class FileConnector final : public Connector {
@@ -35,7 +41,7 @@ class FileDataSourceProvider;
 
 class FileDataSourceProvider final : public DataSourceProvider {
 public:
-    ~FileDataSourceProvider() override = default;
+    ~FileDataSourceProvider() override;
     friend class FileDataSource;
     FileDataSourceProvider(ConnectorScanNode* scan_node, const TPlanNode& plan_node);
     DataSourcePtr create_data_source(const TScanRange& scan_range) override;
@@ -43,16 +49,30 @@ public:
     bool insert_local_exchange_operator() const override { return true; }
     bool accept_empty_scan_ranges() const override { return false; }
 
+    // A single plain CSV stream load is parsed by stream_load_parse_parallelism data sources, which take the
+    // blocks of complete rows cut by a shared splitter. The order of the rows in the stream is not kept across
+    // the data sources, so it's parsed by one data source if stream_load_parse_keep_order is set.
+    int data_sources_per_scan_range(const std::vector<TScanRangeParams>& scan_ranges) override;
+
 protected:
+    // Return the splitter shared by the data sources of the stream load of |scan_range|, or nullptr if the
+    // scan range is read by one data source.
+    StatusOr<StreamLoadPipeSplitter*> _get_stream_splitter(RuntimeState* state, const TBrokerScanRange& scan_range);
+
     ConnectorScanNode* _scan_node;
     const TFileScanNode _file_scan_node;
+
+    bool _split_stream_load = false;
+    std::mutex _stream_splitter_lock;
+    std::unique_ptr<StreamLoadPipeSplitter> _stream_splitter;
+    Status _stream_splitter_status;
 };
 
 class FileDataSource final : public DataSource {
 public:
     ~FileDataSource() override = default;
 
-    FileDataSource(const FileDataSourceProvider* provider, const TScanRange& scan_range);
+    FileDataSource(FileDataSourceProvider* provider, const TScanRange& scan_range);
     Status open(RuntimeState* state) override;
     void close(RuntimeState* state) override;
     Status get_next(RuntimeState* state, ChunkPtr* chunk) override;
@@ -63,7 +83,7 @@ public:
     int64_t cpu_time_spent() const override;
 
 private:
-    const FileDataSourceProvider* _provider;
+    FileDataSourceProvider* _provider;
     mutable TBrokerScanRange _scan_range;
 
     // =========================
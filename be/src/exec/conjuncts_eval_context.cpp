@@ -0,0 +1,101 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "exec/conjuncts_eval_context.h"
+
+#include <fmt/format.h>
+
+#include <algorithm>
+
+#include "common/compiler_util.h"
+#include "common/config.h"
+#include "common/logging.h"
+
+namespace starrocks {
+
+// The first chunks are all sampled to find a good order soon
+static constexpr int64_t kWarmupChunks = 4;
+
+double ConjunctsEvalContext::ConjunctStats::rank() const {
+    if (!sampled()) {
+        // evaluate the conjuncts not sampled yet first, so that they are sampled on the next chunk
+        return 0;
+    }
+    // a conjunct filtering out nothing is put at the end whatever its cost
+    return cost_per_row() / std::max(1 - selectivity(), 1e-3);
+}
+
+void ConjunctsEvalContext::_reset(const std::vector<ExprContext*>& conjuncts) {
+    _conjuncts = conjuncts;
+    _ordered_conjuncts = conjuncts;
+    _stats.assign(conjuncts.size(), ConjunctStats());
+    for (size_t i = 0; i < _stats.size(); i++) {
+        _stats[i].index = i;
+    }
+    _num_chunks = 0;
+}
+
+const std::vector<ExprContext*>& ConjunctsEvalContext::ordered_conjuncts(const std::vector<ExprContext*>& conjuncts,
+                                                                         bool* sampling) {
+    if (UNLIKELY(_conjuncts != conjuncts)) {
+        _reset(conjuncts);
+    }
+    int64_t period = std::max(config::adaptive_conjuncts_order_sample_period, 1);
+    *sampling = _num_chunks < kWarmupChunks || _num_chunks % period == 0;
+    _num_chunks++;
+    return _ordered_conjuncts;
+}
+
+void ConjunctsEvalContext::update(size_t pos, size_t input_rows, size_t output_rows, int64_t time_ns) {
+    DCHECK_LT(pos, _stats.size());
+    if (input_rows == 0) {
+        return;
+    }
+    // the older samples are decayed so that the order follows the changes of the data
+    auto& stats = _stats[pos];
+    stats.input_rows = stats.input_rows / 2 + input_rows;
+    stats.output_rows = stats.output_rows / 2 + output_rows;
+    stats.time_ns = stats.time_ns / 2 + time_ns;
+}
+
+void ConjunctsEvalContext::reorder() {
+    std::vector<ConjunctStats> stats = _stats;
+    std::stable_sort(stats.begin(), stats.end(),
+                     [](const ConjunctStats& lhs, const ConjunctStats& rhs) { return lhs.rank() < rhs.rank(); });
+    bool changed = false;
+    for (size_t i = 0; i < stats.size(); i++) {
+        if (stats[i].index != _stats[i].index) {
+            changed = true;
+            _ordered_conjuncts[i] = _conjuncts[stats[i].index];
+        }
+    }
+    if (changed) {
+        _stats = std::move(stats);
+        _num_reorders++;
+    }
+}
+
+std::string ConjunctsEvalContext::debug_string() const {
+    std::string result;
+    for (const auto& stats : _stats) {
+        if (!result.empty()) {
+            result.append(", ");
+        }
+        result.append(fmt::format("#{}(selectivity={:.2f}, cost={:.2f}ns/row)", stats.index, stats.selectivity(),
+                                  stats.cost_per_row()));
+    }
+    return result;
+}
+
+} // namespace starrocks
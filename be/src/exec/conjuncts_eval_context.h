@@ -0,0 +1,76 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace starrocks {
+
+class ExprContext;
+
+// ConjunctsEvalContext keeps the order in which the conjuncts of an operator are evaluated. The cost per row and
+// the selectivity of each conjunct are sampled on one chunk in every `adaptive_conjuncts_order_sample_period`
+// chunks, and the conjuncts are reordered by them, the cheap and selective ones first, so that the following
+// conjuncts are evaluated on fewer rows.
+//
+// It's not thread-safe, each operator owns its own one.
+class ConjunctsEvalContext {
+public:
+    struct ConjunctStats {
+        // the index of the conjunct in the original conjuncts
+        size_t index = 0;
+        // the decayed sums of the sampled rows and time
+        double input_rows = 0;
+        double output_rows = 0;
+        double time_ns = 0;
+
+        bool sampled() const { return input_rows > 0; }
+        double selectivity() const { return sampled() ? output_rows / input_rows : 1; }
+        double cost_per_row() const { return sampled() ? time_ns / input_rows : 0; }
+        // the cost to filter out a row, the lower the earlier to evaluate
+        double rank() const;
+    };
+
+    // Return the conjuncts in the order to evaluate the next chunk, |*sampling| is set to whether the statistics
+    // of the conjuncts should be sampled on this chunk by update().
+    const std::vector<ExprContext*>& ordered_conjuncts(const std::vector<ExprContext*>& conjuncts, bool* sampling);
+
+    // Update the statistics of the |pos|-th conjunct in the current order, which is evaluated on |input_rows| rows
+    // taking |time_ns|, and |output_rows| of them pass it.
+    void update(size_t pos, size_t input_rows, size_t output_rows, int64_t time_ns);
+
+    // Reorder the conjuncts by their statistics, called after a chunk is sampled.
+    void reorder();
+
+    const std::vector<ConjunctStats>& stats() const { return _stats; }
+    int64_t num_reorders() const { return _num_reorders; }
+
+    // e.g. "#2(selectivity=0.10, cost=2.50ns/row), #0(selectivity=0.80, cost=1.00ns/row)"
+    std::string debug_string() const;
+
+private:
+    void _reset(const std::vector<ExprContext*>& conjuncts);
+
+    std::vector<ExprContext*> _conjuncts;
+    std::vector<ExprContext*> _ordered_conjuncts;
+    // in the same order as _ordered_conjuncts
+    std::vector<ConjunctStats> _stats;
+    int64_t _num_chunks = 0;
+    int64_t _num_reorders = 0;
+};
+
+} // namespace starrocks
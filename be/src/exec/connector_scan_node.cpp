@@ -20,6 +20,7 @@
 #include "common/config.h"
 #include "exec/pipeline/scan/chunk_buffer_limiter.h"
 #include "exec/pipeline/scan/connector_scan_operator.h"
+#include "exec/pipeline/scan/morsel.h"
 #include "exec/stream/scan/stream_scan_operator.h"
 #include "runtime/current_thread.h"
 #include "runtime/exec_env.h"
@@ -576,6 +577,25 @@ Status ConnectorScanNode::set_scan_ranges(const std::vector<TScanRangeParams>& s
     return Status::OK();
 }
 
+StatusOr<pipeline::MorselQueuePtr> ConnectorScanNode::convert_scan_range_to_morsel_queue(
+        const std::vector<TScanRangeParams>& scan_ranges, int node_id, int32_t pipeline_dop,
+        bool enable_tablet_internal_parallel, TTabletInternalParallelMode::type tablet_internal_parallel_mode,
+        size_t num_total_scan_ranges) {
+    int num_data_sources = _data_source_provider->data_sources_per_scan_range(scan_ranges);
+    if (num_data_sources <= 1) {
+        return ScanNode::convert_scan_range_to_morsel_queue(scan_ranges, node_id, pipeline_dop,
+                                                            enable_tablet_internal_parallel,
+                                                            tablet_internal_parallel_mode, num_total_scan_ranges);
+    }
+    // Every morsel creates a data source of the same scan range.
+    DCHECK_EQ(1, scan_ranges.size());
+    pipeline::Morsels morsels;
+    for (int i = 0; i < num_data_sources; i++) {
+        morsels.emplace_back(std::make_unique<pipeline::ScanMorsel>(node_id, scan_ranges[0]));
+    }
+    return std::make_unique<pipeline::FixedMorselQueue>(std::move(morsels));
+}
+
 bool ConnectorScanNode::accept_empty_scan_ranges() const {
     return _data_source_provider->accept_empty_scan_ranges();
 }
@@ -14,12 +14,19 @@
 
 #include "exec/csv_scanner.h"
 
+#include <sstream>
+
 #include "column/chunk.h"
 #include "column/column_helper.h"
 #include "column/hash_set.h"
+#include "common/config.h"
 #include "fs/fs.h"
 #include "gutil/strings/substitute.h"
+#include "io/array_input_stream.h"
+#include "runtime/exec_env.h"
 #include "runtime/runtime_state.h"
+#include "runtime/stream_load/load_stream_mgr.h"
+#include "runtime/stream_load/stream_load_pipe.h"
 #include "util/utf8_check.h"
 
 namespace starrocks {
@@ -172,7 +179,9 @@ StatusOr<ChunkPtr> CSVScanner::get_next() {
     src_chunk->reserve(chunk_capacity);
 
     do {
-        if (_curr_reader == nullptr && ++_curr_file_index < _scan_range.ranges.size()) {
+        if (_curr_reader == nullptr && _stream_splitter != nullptr) {
+            RETURN_IF_ERROR(_open_next_block());
+        } else if (_curr_reader == nullptr && ++_curr_file_index < _scan_range.ranges.size()) {
             std::shared_ptr<SequentialFile> file;
             const TBrokerRangeDesc& range_desc = _scan_range.ranges[_curr_file_index];
             Status st = create_sequential_file(range_desc, _scan_range.broker_addresses[0], _scan_range.params, &file);
@@ -222,6 +231,7 @@ StatusOr<ChunkPtr> CSVScanner::get_next() {
         if (!status.ok()) {
             if (status.is_end_of_file()) {
                 _curr_reader = nullptr;
+                _block_finished = (_stream_splitter != nullptr);
                 DCHECK_EQ(0, src_chunk->num_rows());
             } else if (status.is_time_out()) {
                 // if timeout happens at the beginning of reading src_chunk, we return the error state
@@ -237,10 +247,67 @@ StatusOr<ChunkPtr> CSVScanner::get_next() {
         fill_columns_from_path(src_chunk, _num_fields_in_csv, _scan_range.ranges[_curr_file_index].columns_from_path,
                                src_chunk->num_rows());
         ASSIGN_OR_RETURN(chunk, materialize(nullptr, src_chunk));
-    } while ((chunk)->num_rows() == 0);
+    } while ((chunk)->num_rows() == 0 && !_block_finished);
     return std::move(chunk);
 }
 
+bool CSVScanner::is_splittable_stream_load(const TBrokerScanRange& scan_range) {
+    const TBrokerScanRangeParams& params = scan_range.params;
+    if (scan_range.ranges.size() != 1) {
+        return false;
+    }
+    const TBrokerRangeDesc& range_desc = scan_range.ranges[0];
+    if (range_desc.file_type != TFileType::FILE_STREAM || range_desc.format_type != TFileFormatType::FORMAT_CSV_PLAIN) {
+        return false;
+    }
+    // The rows can't be found without parsing the fields if a row delimiter may be enclosed or escaped.
+    if ((params.__isset.enclose && params.enclose != 0) || (params.__isset.escape && params.escape != 0)) {
+        return false;
+    }
+    if (params.__isset.multi_row_delimiter && params.multi_row_delimiter.size() != 1) {
+        return false;
+    }
+    // Routine load reads the pipe without blocking and resumes the read later.
+    if (params.__isset.non_blocking_read && params.non_blocking_read) {
+        return false;
+    }
+    return true;
+}
+
+StatusOr<std::unique_ptr<StreamLoadPipeSplitter>> CSVScanner::create_stream_splitter(
+        RuntimeState* state, const TBrokerScanRange& scan_range) {
+    DCHECK(is_splittable_stream_load(scan_range));
+    const TBrokerScanRangeParams& params = scan_range.params;
+    const TBrokerRangeDesc& range_desc = scan_range.ranges[0];
+    auto pipe = state->exec_env()->load_stream_mgr()->get(range_desc.load_id);
+    if (pipe == nullptr) {
+        std::stringstream ss("Invalid or outdated load id ");
+        range_desc.load_id.printTo(ss);
+        return Status::InternalError(std::string(ss.str()));
+    }
+    char row_delimiter = params.__isset.multi_row_delimiter ? params.multi_row_delimiter[0] : params.row_delimiter;
+    return std::make_unique<StreamLoadPipeSplitter>(std::move(pipe), row_delimiter,
+                                                    config::stream_load_parse_block_size);
+}
+
+Status CSVScanner::_open_next_block() {
+    ASSIGN_OR_RETURN(_curr_block, _stream_splitter->next_block(&_curr_block_seq));
+    auto stream = std::make_shared<io::ArrayInputStream>(_curr_block->ptr + _curr_block->pos, _curr_block->remaining());
+    auto file = std::make_shared<SequentialFile>(std::move(stream), "stream-load-block");
+    // all the blocks are cut from the only range of the stream load
+    _curr_file_index = 0;
+    _block_finished = false;
+    _curr_reader = std::make_unique<ScannerCSVReader>(file, _parse_options);
+    _curr_reader->set_counter(_counter);
+    if (_curr_block_seq == 0) {
+        for (int64_t i = 0; i < _parse_options.skip_header; i++) {
+            CSVReader::Record dummy;
+            RETURN_IF_ERROR(_curr_reader->next_record(&dummy));
+        }
+    }
+    return Status::OK();
+}
+
 Status CSVScanner::_parse_csv_v2(Chunk* chunk) {
     const int capacity = _state->chunk_size();
     DCHECK_EQ(0, chunk->num_rows());
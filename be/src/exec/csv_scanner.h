@@ -21,11 +21,13 @@
 #include "exec/file_scanner.h"
 #include "formats/csv/converter.h"
 #include "formats/csv/csv_reader.h"
+#include "util/byte_buffer.h"
 #include "util/logging.h"
 #include "util/raw_container.h"
 
 namespace starrocks {
 class SequentialFile;
+class StreamLoadPipeSplitter;
 }
 
 namespace starrocks {
@@ -44,6 +46,21 @@ public:
     // For test
     void use_v2(bool use_v2) { _use_v2 = use_v2; }
 
+    // Whether the only range of |scan_range| is a plain CSV stream load whose rows can be found without parsing
+    // the fields, so that it can be cut into blocks of complete rows and parsed by several scanners.
+    static bool is_splittable_stream_load(const TBrokerScanRange& scan_range);
+    // Create the splitter of the stream load of |scan_range|, which must be splittable.
+    static StatusOr<std::unique_ptr<StreamLoadPipeSplitter>> create_stream_splitter(
+            RuntimeState* state, const TBrokerScanRange& scan_range);
+
+    // Parse the blocks of |splitter| instead of the files of the scan range. Every block is parsed into
+    // its own chunks, and at least one chunk, which may be empty, is returned for each block.
+    void set_stream_splitter(StreamLoadPipeSplitter* splitter) { _stream_splitter = splitter; }
+    // The sequence number of the block which the last returned chunk is parsed from.
+    int64_t current_block_seq() const { return _curr_block_seq; }
+    // Whether the last returned chunk is the last one of its block.
+    bool block_finished() const { return _block_finished; }
+
 private:
     class ScannerCSVReader : public CSVReader {
     public:
@@ -63,6 +80,8 @@ private:
 
     ChunkPtr _create_chunk(const std::vector<SlotDescriptor*>& slots);
 
+    Status _open_next_block();
+
     Status _parse_csv(Chunk* chunk);
     Status _parse_csv_v2(Chunk* chunk);
 
@@ -82,6 +101,11 @@ private:
     bool _use_v2;
     CSVReader::Fields fields;
     CSVRow row;
+
+    StreamLoadPipeSplitter* _stream_splitter = nullptr;
+    ByteBufferPtr _curr_block;
+    int64_t _curr_block_seq = -1;
+    bool _block_finished = false;
 };
 
 } // namespace starrocks
@@ -42,6 +42,7 @@
 #include "column/column_helper.h"
 #include "column/vectorized_fwd.h"
 #include "common/compiler_util.h"
+#include "common/config.h"
 #include "common/object_pool.h"
 #include "common/status.h"
 #include "exec/aggregate/aggregate_blocking_node.h"
@@ -50,6 +51,7 @@
 #include "exec/aggregate/distinct_streaming_node.h"
 #include "exec/analytic_node.h"
 #include "exec/assert_num_rows_node.h"
+#include "exec/conjuncts_eval_context.h"
 #include "exec/connector_scan_node.h"
 #include "exec/cross_join_node.h"
 #include "exec/dict_decode_node.h"
@@ -81,6 +83,7 @@
 #include "simd/simd.h"
 #include "util/debug_util.h"
 #include "util/runtime_profile.h"
+#include "util/time.h"
 
 namespace starrocks {
 
@@ -675,7 +678,8 @@ Status ExecNode::eval_conjuncts(const std::vector<ExprContext*>& ctxs, Chunk* ch
     Filter* raw_filter = filter.get();
 
     for (auto* ctx : ctxs) {
-        ASSIGN_OR_RETURN(ColumnPtr column, ctx->evaluate(chunk));
+        // only the rows passing the previous conjuncts need to be evaluated
+        ASSIGN_OR_RETURN(ColumnPtr column, ctx->evaluate(chunk, raw_filter->data()));
         size_t true_count = ColumnHelper::count_true_with_notnull(column);
 
         if (true_count == column->size()) {
@@ -710,6 +714,62 @@ Status ExecNode::eval_conjuncts(const std::vector<ExprContext*>& ctxs, Chunk* ch
     return Status::OK();
 }
 
+Status ExecNode::eval_conjuncts(const std::vector<ExprContext*>& ctxs, Chunk* chunk, FilterPtr* filter_ptr,
+                                bool apply_filter, ConjunctsEvalContext* eval_context) {
+    if (eval_context == nullptr || ctxs.size() < 2 || !config::enable_adaptive_conjuncts_order) {
+        return eval_conjuncts(ctxs, chunk, filter_ptr, apply_filter);
+    }
+    DCHECK(chunk != nullptr);
+    if (chunk->num_rows() == 0) {
+        return Status::OK();
+    }
+    bool sampling = false;
+    const auto& ordered_ctxs = eval_context->ordered_conjuncts(ctxs, &sampling);
+    if (!sampling) {
+        return eval_conjuncts(ordered_ctxs, chunk, filter_ptr, apply_filter);
+    }
+
+    // evaluate the conjuncts one by one to sample the rows passing each of them and the time taken
+    if (!apply_filter) {
+        DCHECK(filter_ptr) << "Must provide a filter if not apply it directly";
+    }
+    TRY_CATCH_ALLOC_SCOPE_START()
+    FilterPtr filter(new Filter(chunk->num_rows(), 1));
+    if (filter_ptr != nullptr) {
+        *filter_ptr = filter;
+    }
+    Filter* raw_filter = filter.get();
+    size_t input_rows = chunk->num_rows();
+    bool all_zero = false;
+    for (size_t i = 0; i < ordered_ctxs.size() && !all_zero; i++) {
+        int64_t start_ns = MonotonicNanos();
+        ASSIGN_OR_RETURN(ColumnPtr column, ordered_ctxs[i]->evaluate(chunk, raw_filter->data()));
+        int64_t time_ns = MonotonicNanos() - start_ns;
+        size_t true_count = ColumnHelper::count_true_with_notnull(column);
+        if (true_count == 0) {
+            all_zero = true;
+        } else if (true_count != column->size()) {
+            ColumnHelper::merge_two_filters(column, raw_filter, &all_zero);
+        }
+        size_t output_rows = all_zero ? 0 : SIMD::count_nonzero(*raw_filter);
+        eval_context->update(i, input_rows, output_rows, time_ns);
+        input_rows = output_rows;
+    }
+    eval_context->reorder();
+
+    if (all_zero) {
+        if (apply_filter) {
+            chunk->set_num_rows(0);
+        } else {
+            filter->assign(filter->size(), 0);
+        }
+    } else if (apply_filter) {
+        chunk->filter(*raw_filter);
+    }
+    TRY_CATCH_ALLOC_SCOPE_END()
+    return Status::OK();
+}
+
 StatusOr<size_t> ExecNode::eval_conjuncts_into_filter(const std::vector<ExprContext*>& ctxs, Chunk* chunk,
                                                       Filter* filter) {
     // No need to do expression if none rows
@@ -55,6 +55,7 @@
 
 namespace starrocks {
 
+class ConjunctsEvalContext;
 class Expr;
 class ExprContext;
 class ObjectPool;
@@ -169,6 +170,10 @@ public:
     // then running filter on chunk.
     static Status eval_conjuncts(const std::vector<ExprContext*>& ctxs, Chunk* chunk, FilterPtr* filter_ptr = nullptr,
                                  bool apply_filter = true);
+    // Same as above, but the conjuncts are evaluated in the order kept by |eval_context|, which is adjusted by
+    // the statistics sampled on the chunks. |eval_context| may be nullptr.
+    static Status eval_conjuncts(const std::vector<ExprContext*>& ctxs, Chunk* chunk, FilterPtr* filter_ptr,
+                                 bool apply_filter, ConjunctsEvalContext* eval_context);
     static StatusOr<size_t> eval_conjuncts_into_filter(const std::vector<ExprContext*>& ctxs, Chunk* chunk,
                                                        Filter* filter);
 
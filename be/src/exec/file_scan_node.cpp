@@ -18,14 +18,17 @@
 #include <sstream>
 
 #include "column/chunk.h"
+#include "common/config.h"
 #include "exec/csv_scanner.h"
 #include "exec/json_scanner.h"
 #include "exec/orc_scanner.h"
 #include "exec/parquet_scanner.h"
 #include "exprs/expr.h"
 #include "fs/fs.h"
+#include "gutil/casts.h"
 #include "runtime/current_thread.h"
 #include "runtime/runtime_state.h"
+#include "runtime/stream_load/stream_load_pipe.h"
 #include "util/defer_op.h"
 #include "util/runtime_profile.h"
 #include "util/thread.h"
@@ -89,13 +92,83 @@ Status FileScanNode::_start_scanners() {
     {
         std::unique_lock<std::mutex> l(_chunk_queue_lock);
 
-        _num_running_scanners = 1;
-        _scanner_threads.emplace_back(&FileScanNode::_scanner_worker, this, 0, _scan_ranges.size());
-        Thread::set_thread_name(_scanner_threads.back(), "file_scanner");
+        int num_scanners = 1;
+        int parallelism = config::stream_load_parse_parallelism;
+        if (parallelism > 1) {
+            _stream_splitter = _create_stream_splitter();
+        }
+        if (_stream_splitter != nullptr) {
+            num_scanners = parallelism;
+            _keep_block_order = config::stream_load_parse_keep_order;
+        }
+        _num_running_scanners = num_scanners;
+        for (int i = 0; i < num_scanners; i++) {
+            _scanner_threads.emplace_back(&FileScanNode::_scanner_worker, this, 0, _scan_ranges.size());
+            Thread::set_thread_name(_scanner_threads.back(), "file_scanner");
+        }
     }
     return Status::OK();
 }
 
+std::unique_ptr<StreamLoadPipeSplitter> FileScanNode::_create_stream_splitter() {
+    if (_scan_ranges.size() != 1) {
+        return nullptr;
+    }
+    const TBrokerScanRange& scan_range = _scan_ranges[0].scan_range.broker_scan_range;
+    if (!CSVScanner::is_splittable_stream_load(scan_range)) {
+        return nullptr;
+    }
+    auto res = CSVScanner::create_stream_splitter(runtime_state(), scan_range);
+    if (!res.ok()) {
+        // The scanner will report the error.
+        return nullptr;
+    }
+    return std::move(res).value();
+}
+
+bool FileScanNode::_is_queue_full(int64_t block_seq) const {
+    if (block_seq > _next_block_seq) {
+        // The chunks of a later block must not take the room of the current block.
+        size_t num_chunks = _chunk_queue.size() + _num_pending_chunks;
+        return num_chunks >= _max_queue_size || (_cur_mem_usage >= _max_mem_usage && num_chunks > 0);
+    }
+    // stop pushing more batch if
+    // 1. too many batches in queue, or
+    // 2. at least one batch in queue and memory exceed limit.
+    return _chunk_queue.size() >= _max_queue_size || (_cur_mem_usage >= _max_mem_usage && !_chunk_queue.empty());
+}
+
+void FileScanNode::_push_chunk(int64_t block_seq, ChunkPtr chunk) {
+    _cur_mem_usage += chunk->memory_usage();
+    if (block_seq > _next_block_seq) {
+        _pending_block_chunks[block_seq].push_back(std::move(chunk));
+        _num_pending_chunks++;
+    } else {
+        _chunk_queue.push_back(std::move(chunk));
+    }
+}
+
+void FileScanNode::_finish_block(int64_t block_seq) {
+    {
+        std::lock_guard<std::mutex> l(_chunk_queue_lock);
+        _finished_blocks.insert(block_seq);
+        while (_finished_blocks.erase(_next_block_seq) > 0) {
+            _next_block_seq++;
+            auto iter = _pending_block_chunks.find(_next_block_seq);
+            if (iter != _pending_block_chunks.end()) {
+                _num_pending_chunks -= iter->second.size();
+                for (auto& chunk : iter->second) {
+                    _chunk_queue.push_back(std::move(chunk));
+                }
+                _pending_block_chunks.erase(iter);
+            }
+        }
+    }
+    _queue_reader_cond.notify_one();
+    // The scanner of the new current block may wait for room in the queue.
+    _queue_writer_cond.notify_all();
+}
+
 Status FileScanNode::get_next(RuntimeState* state, ChunkPtr* chunk, bool* eos) {
     SCOPED_TIMER(_runtime_profile->total_time_counter());
     // check if CANCELLED.
@@ -181,10 +254,13 @@ Status FileScanNode::close(RuntimeState* state) {
     for (auto& _scanner_thread : _scanner_threads) {
         _scanner_thread.join();
     }
+    _stream_splitter.reset();
 
     while (!_chunk_queue.empty()) {
         _chunk_queue.pop_front();
     }
+    _pending_block_chunks.clear();
+    _num_pending_chunks = 0;
     _cur_mem_usage = 0;
 
     return ExecNode::close(state);
@@ -226,6 +302,12 @@ Status FileScanNode::_scanner_scan(const TBrokerScanRange& scan_range, const std
     DeferOp scanner_close([&scanner] { return scanner->close(); });
     RETURN_IF_ERROR(scanner->open());
 
+    CSVScanner* block_scanner = nullptr;
+    if (_stream_splitter != nullptr) {
+        block_scanner = down_cast<CSVScanner*>(scanner.get());
+        block_scanner->set_stream_splitter(_stream_splitter.get());
+    }
+
     while (true) {
         RETURN_IF_CANCELLED(runtime_state());
         // If we have finished all works
@@ -238,6 +320,7 @@ Status FileScanNode::_scanner_scan(const TBrokerScanRange& scan_range, const std
             return res.status();
         }
         ChunkPtr temp_chunk = std::move(res.value());
+        int64_t block_seq = _keep_block_order ? block_scanner->current_block_seq() : -1;
 
         size_t before_rows = temp_chunk->num_rows();
 
@@ -256,11 +339,7 @@ Status FileScanNode::_scanner_scan(const TBrokerScanRange& scan_range, const std
         if (temp_chunk->num_rows() > 0) {
             std::unique_lock<std::mutex> l(_chunk_queue_lock);
             while (_process_status.ok() && !_scan_finished.load() && !runtime_state()->is_cancelled() &&
-                   // stop pushing more batch if
-                   // 1. too many batches in queue, or
-                   // 2. at least one batch in queue and memory exceed limit.
-                   (_chunk_queue.size() >= _max_queue_size ||
-                    (_cur_mem_usage >= _max_mem_usage && !_chunk_queue.empty()))) {
+                   _is_queue_full(block_seq)) {
                 _queue_writer_cond.wait_for(l, std::chrono::seconds(1));
             }
             // Process already set failed, so we just return OK
@@ -276,12 +355,14 @@ Status FileScanNode::_scanner_scan(const TBrokerScanRange& scan_range, const std
                 return Status::Cancelled("Cancelled FileScanNode::scanner_scan");
             }
             // Queue size Must be smaller than _max_queue_size
-            _cur_mem_usage += temp_chunk->memory_usage();
-            _chunk_queue.push_back(std::move(temp_chunk));
+            _push_chunk(block_seq, std::move(temp_chunk));
 
             // Notify reader to
             _queue_reader_cond.notify_one();
         }
+        if (block_seq >= 0 && block_scanner->block_finished()) {
+            _finish_block(block_seq);
+        }
     }
 
     return Status::OK();
@@ -16,7 +16,10 @@
 
 #include <atomic>
 #include <condition_variable>
+#include <deque>
+#include <map>
 #include <mutex>
+#include <set>
 #include <thread>
 #include <vector>
 
@@ -30,6 +33,7 @@ namespace starrocks {
 
 class RuntimeState;
 struct ScannerCounter;
+class StreamLoadPipeSplitter;
 
 class FileScanNode final : public ScanNode {
 public:
@@ -71,6 +75,17 @@ private:
     // Create scanners to do scan job
     Status _start_scanners();
 
+    // Return a splitter if the only range is a stream load which can be parsed by several scanners.
+    std::unique_ptr<StreamLoadPipeSplitter> _create_stream_splitter();
+
+    // Whether a chunk of |block_seq| must wait for room in the queue, -1 means the order doesn't matter.
+    // NOTE: Must hold the mutex of this scan node
+    bool _is_queue_full(int64_t block_seq) const;
+    // NOTE: Must hold the mutex of this scan node
+    void _push_chunk(int64_t block_seq, ChunkPtr chunk);
+    // All the chunks of |block_seq| have been pushed.
+    void _finish_block(int64_t block_seq);
+
     // One scanner worker, This scanner will handle 'length' ranges start from start_idx
     void _scanner_worker(int start_idx, int length);
 
@@ -103,6 +118,17 @@ private:
 
     std::vector<std::thread> _scanner_threads;
 
+    // Set if a single stream load is parsed by several scanners, every scanner parses the blocks
+    // of complete rows cut by the splitter.
+    std::unique_ptr<StreamLoadPipeSplitter> _stream_splitter;
+    // Whether the chunks are returned in the order of the blocks they are parsed from.
+    bool _keep_block_order = false;
+    // The chunks of the blocks after |_next_block_seq|, which can't be returned yet.
+    std::map<int64_t, std::deque<ChunkPtr>> _pending_block_chunks;
+    size_t _num_pending_chunks = 0;
+    std::set<int64_t> _finished_blocks;
+    int64_t _next_block_seq = 0;
+
     // Profile information
     RuntimeProfile::Counter* _wait_scanner_timer = nullptr;
     RuntimeProfile::Counter* _scanner_total_timer = nullptr;
@@ -100,6 +100,28 @@ void Operator::close(RuntimeState* state) {
         _runtime_in_filter_num_counter->set((int64_t)runtime_in_filters().size());
         _runtime_bloom_filter_num_counter->set((int64_t)rf_bloom_filters->size());
     }
+    if (_conjuncts_reorder_counter != nullptr) {
+        int64_t num_reorders = 0;
+        std::string orders;
+        auto add_order = [&](const ConjunctsEvalContext& context) {
+            if (context.stats().empty()) {
+                return;
+            }
+            num_reorders += context.num_reorders();
+            if (!orders.empty()) {
+                orders += "; ";
+            }
+            orders += context.debug_string();
+        };
+        add_order(_conjuncts_eval_context);
+        for (const auto& [_, context] : _other_conjuncts_eval_contexts) {
+            add_order(context);
+        }
+        if (!orders.empty()) {
+            _conjuncts_reorder_counter->set(num_reorders);
+            _common_metrics->add_info_string("ConjunctsOrder", orders);
+        }
+    }
     // Pipeline do not need the built in total time counter
     // Reset here to discard assignments from Analytor, Aggregator, etc.
     _runtime_profile->total_time_counter()->set(0L);
@@ -153,7 +175,8 @@ Status Operator::eval_conjuncts_and_in_filters(const std::vector<ExprContext*>&
         auto before = chunk->num_rows();
         _conjuncts_input_counter->update(before);
         RETURN_IF_ERROR(
-                starrocks::ExecNode::eval_conjuncts(_cached_conjuncts_and_in_filters, chunk, filter, apply_filter));
+                starrocks::ExecNode::eval_conjuncts(_cached_conjuncts_and_in_filters, chunk, filter, apply_filter,
+                                                    &_conjuncts_eval_context));
         auto after = chunk->num_rows();
         _conjuncts_output_counter->update(after);
     }
@@ -173,7 +196,8 @@ Status Operator::eval_conjuncts(const std::vector<ExprContext*>& conjuncts, Chun
         SCOPED_TIMER(_conjuncts_timer);
         size_t before = chunk->num_rows();
         _conjuncts_input_counter->update(before);
-        RETURN_IF_ERROR(starrocks::ExecNode::eval_conjuncts(conjuncts, chunk, filter));
+        RETURN_IF_ERROR(starrocks::ExecNode::eval_conjuncts(conjuncts, chunk, filter, true,
+                                                            &_other_conjuncts_eval_contexts[&conjuncts]));
         size_t after = chunk->num_rows();
         _conjuncts_output_counter->update(after);
     }
@@ -223,6 +247,7 @@ void Operator::_init_conjuct_counters() {
         _conjuncts_timer = ADD_TIMER(_common_metrics, "ConjunctsTime");
         _conjuncts_input_counter = ADD_COUNTER(_common_metrics, "ConjunctsInputRows", TUnit::UNIT);
         _conjuncts_output_counter = ADD_COUNTER(_common_metrics, "ConjunctsOutputRows", TUnit::UNIT);
+        _conjuncts_reorder_counter = ADD_COUNTER(_common_metrics, "ConjunctsReorderNum", TUnit::UNIT);
     }
 }
 
@@ -14,8 +14,11 @@
 
 #pragma once
 
+#include <unordered_map>
+
 #include "column/vectorized_fwd.h"
 #include "common/statusor.h"
+#include "exec/conjuncts_eval_context.h"
 #include "exec/pipeline/runtime_filter_types.h"
 #include "exprs/runtime_filter_bank.h"
 #include "gutil/casts.h"
@@ -159,7 +162,8 @@ public:
     Status eval_conjuncts_and_in_filters(const std::vector<ExprContext*>& conjuncts, Chunk* chunk,
                                          FilterPtr* filter = nullptr, bool apply_filter = true);
 
-    // Evaluate conjuncts without cache
+    // Evaluate conjuncts without cache, the order of each list of |conjuncts| is kept separately, so |conjuncts|
+    // should be a member of the operator rather than a temporary.
     Status eval_conjuncts(const std::vector<ExprContext*>& conjuncts, Chunk* chunk, FilterPtr* filter = nullptr);
 
     // equal to ExecNode::eval_join_runtime_filters, is used to apply bloom-filters to Operators.
@@ -242,6 +246,11 @@ protected:
     std::vector<ExprContext*> _cached_conjuncts_and_in_filters;
 
     RuntimeBloomFilterEvalContext _bloom_filter_eval_context;
+    // for the conjuncts evaluated by eval_conjuncts_and_in_filters()
+    ConjunctsEvalContext _conjuncts_eval_context;
+    // for the conjuncts evaluated by eval_conjuncts(), keyed by the list, since an operator may evaluate several
+    // lists in turn, e.g. the join conjuncts and the other conjuncts of a nested loop join
+    std::unordered_map<const std::vector<ExprContext*>*, ConjunctsEvalContext> _other_conjuncts_eval_contexts;
 
     // Common metrics
     RuntimeProfile::Counter* _total_timer = nullptr;
@@ -261,6 +270,7 @@ protected:
     RuntimeProfile::Counter* _conjuncts_timer = nullptr;
     RuntimeProfile::Counter* _conjuncts_input_counter = nullptr;
     RuntimeProfile::Counter* _conjuncts_output_counter = nullptr;
+    RuntimeProfile::Counter* _conjuncts_reorder_counter = nullptr;
 
     // Some extra cpu cost of this operator that not accounted by pipeline driver,
     // such as OlapScanOperator( use separated IO thread to execute the IO task)
@@ -14,6 +14,7 @@
 
 #include "exec/project_node.h"
 
+#include <algorithm>
 #include <cstring>
 #include <memory>
 #include <set>
@@ -25,12 +26,14 @@
 #include "column/column_helper.h"
 #include "column/nullable_column.h"
 #include "column/vectorized_fwd.h"
+#include "common/config.h"
 #include "common/global_types.h"
 #include "common/status.h"
 #include "exec/pipeline/limit_operator.h"
 #include "exec/pipeline/pipeline_builder.h"
 #include "exec/pipeline/project_operator.h"
 #include "exprs/column_ref.h"
+#include "exprs/common_sub_expr_extractor.h"
 #include "exprs/expr.h"
 #include "exprs/expr_context.h"
 #include "glog/logging.h"
@@ -292,12 +295,55 @@ void ProjectNode::push_down_join_runtime_filter(RuntimeState* state, RuntimeFilt
     }
 }
 
+void ProjectNode::_extract_common_sub_exprs(RuntimeState* state) {
+    // the result columns of the common sub-expressions are appended to the input chunks, so their slots
+    // mustn't conflict with any slot of the query
+    SlotId next_slot_id = 0;
+    std::vector<TupleDescriptor*> tuple_descs;
+    state->desc_tbl().get_tuple_descs(&tuple_descs);
+    for (const auto* tuple_desc : tuple_descs) {
+        for (const auto* slot_desc : tuple_desc->slots()) {
+            next_slot_id = std::max(next_slot_id, slot_desc->id() + 1);
+        }
+    }
+    for (SlotId slot_id : _slot_ids) {
+        next_slot_id = std::max(next_slot_id, slot_id + 1);
+    }
+
+    std::vector<ExprContext*> expr_ctxs = _expr_ctxs;
+    std::vector<ExprContext*> common_sub_expr_ctxs = _common_sub_expr_ctxs;
+    auto status = extract_common_sub_exprs(_pool, next_slot_id, &_expr_ctxs, &_common_sub_slot_ids,
+                                           &_common_sub_expr_ctxs);
+    if (!status.ok()) {
+        LOG(WARNING) << "failed to extract the common sub-expressions of project node " << id() << ": " << status;
+    }
+
+    // the contexts replaced by the rewritten copies have been prepared, and are not closed by anyone else
+    std::set<ExprContext*> new_ctxs(_expr_ctxs.begin(), _expr_ctxs.end());
+    new_ctxs.insert(_common_sub_expr_ctxs.begin(), _common_sub_expr_ctxs.end());
+    std::vector<ExprContext*> replaced_ctxs;
+    for (ExprContext* ctx : expr_ctxs) {
+        if (new_ctxs.count(ctx) == 0) {
+            replaced_ctxs.emplace_back(ctx);
+        }
+    }
+    for (ExprContext* ctx : common_sub_expr_ctxs) {
+        if (new_ctxs.count(ctx) == 0) {
+            replaced_ctxs.emplace_back(ctx);
+        }
+    }
+    Expr::close(replaced_ctxs, state);
+}
+
 pipeline::OpFactories ProjectNode::decompose_to_pipeline(pipeline::PipelineBuilderContext* context) {
     using namespace pipeline;
     OpFactories operators = _children[0]->decompose_to_pipeline(context);
     // Create a shared RefCountedRuntimeFilterCollector
     auto&& rc_rf_probe_collector = std::make_shared<RcRfProbeCollector>(1, std::move(this->runtime_filter_collector()));
 
+    if (config::enable_common_sub_expr_extraction) {
+        _extract_common_sub_exprs(context->runtime_state());
+    }
     operators.emplace_back(std::make_shared<ProjectOperatorFactory>(
             context->next_operator_id(), id(), std::move(_slot_ids), std::move(_expr_ctxs),
             std::move(_type_is_nullable), std::move(_common_sub_slot_ids), std::move(_common_sub_expr_ctxs)));
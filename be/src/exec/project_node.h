@@ -43,6 +43,9 @@ public:
             pipeline::PipelineBuilderContext* context) override;
 
 private:
+    // Extract the identical sub-expressions of the projections into the common sub-expressions
+    void _extract_common_sub_exprs(RuntimeState* state);
+
     std::vector<SlotId> _slot_ids;
     std::vector<ExprContext*> _expr_ctxs;
     std::vector<bool> _type_is_nullable;
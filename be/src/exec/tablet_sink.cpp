@@ -818,6 +818,12 @@ Status OlapTableSink::init(const TDataSink& t_sink, RuntimeState* state) {
     if (table_sink.__isset.enable_replicated_storage) {
         _enable_replicated_storage = table_sink.enable_replicated_storage;
     }
+    // The colocate mv index load sends the rows to all the replicas, so it only uses the replicated storage
+    // if the table enables it.
+    if (_colocate_mv_index && table_sink.__isset.replicated_storage_for_bulk_load &&
+        table_sink.replicated_storage_for_bulk_load) {
+        _enable_replicated_storage = false;
+    }
     _schema = std::make_shared<OlapTableSchemaParam>();
     RETURN_IF_ERROR(_schema->init(table_sink.schema));
     _vectorized_partition = _pool->add(new OlapTablePartitionParam(_schema, table_sink.partition));
@@ -14,6 +14,11 @@
 
 #pragma once
 
+#include <algorithm>
+#include <functional>
+#include <utility>
+#include <vector>
+
 #include "column/object_column.h"
 #include "column/vectorized_fwd.h"
 #include "exprs/agg/aggregate.h"
@@ -22,6 +27,37 @@
 
 namespace starrocks {
 
+// Union the bitmaps of the rows [start, start + size) of |column| into |bitmap| at once.
+inline void union_bitmap_rows(BitmapValue* bitmap, const BitmapColumn* column, size_t start, size_t size) {
+    std::vector<const BitmapValue*> values(size);
+    for (size_t i = 0; i < size; ++i) {
+        values[i] = column->get_object(start + i);
+    }
+    bitmap->fast_union(values);
+}
+
+// Union the bitmap of each row of |column| into the state of the row, the bitmaps of
+// the same state in the chunk are collected to be unioned at once.
+inline void union_bitmap_rows_by_state(const BitmapColumn* column, size_t chunk_size, size_t state_offset,
+                                       AggDataPtr* states) {
+    std::vector<std::pair<AggDataPtr, const BitmapValue*>> rows(chunk_size);
+    for (size_t i = 0; i < chunk_size; ++i) {
+        rows[i] = {states[i] + state_offset, column->get_object(i)};
+    }
+    std::sort(rows.begin(), rows.end(),
+              [](const auto& lhs, const auto& rhs) { return std::less<AggDataPtr>()(lhs.first, rhs.first); });
+
+    std::vector<const BitmapValue*> values;
+    for (size_t i = 0; i < chunk_size;) {
+        AggDataPtr state = rows[i].first;
+        values.clear();
+        for (; i < chunk_size && rows[i].first == state; ++i) {
+            values.emplace_back(rows[i].second);
+        }
+        reinterpret_cast<BitmapValue*>(state)->fast_union(values);
+    }
+}
+
 class BitmapUnionAggregateFunction final
         : public AggregateFunctionBatchHelper<BitmapValue, BitmapUnionAggregateFunction> {
 public:
@@ -36,6 +72,26 @@ public:
         this->data(state) |= *(col->get_object(row_num));
     }
 
+    void update_batch(FunctionContext* ctx, size_t chunk_size, size_t state_offset, const Column** columns,
+                      AggDataPtr* states) const override {
+        union_bitmap_rows_by_state(down_cast<const BitmapColumn*>(columns[0]), chunk_size, state_offset, states);
+    }
+
+    void update_batch_single_state(FunctionContext* ctx, size_t chunk_size, const Column** columns,
+                                   AggDataPtr __restrict state) const override {
+        union_bitmap_rows(&this->data(state), down_cast<const BitmapColumn*>(columns[0]), 0, chunk_size);
+    }
+
+    void merge_batch(FunctionContext* ctx, size_t chunk_size, size_t state_offset, const Column* column,
+                     AggDataPtr* states) const override {
+        union_bitmap_rows_by_state(down_cast<const BitmapColumn*>(column), chunk_size, state_offset, states);
+    }
+
+    void merge_batch_single_state(FunctionContext* ctx, AggDataPtr __restrict state, const Column* column, size_t start,
+                                  size_t size) const override {
+        union_bitmap_rows(&this->data(state), down_cast<const BitmapColumn*>(column), start, size);
+    }
+
     void serialize_to_column(FunctionContext* ctx, ConstAggDataPtr __restrict state, Column* to) const override {
         auto* col = down_cast<BitmapColumn*>(to);
         auto& bitmap = const_cast<BitmapValue&>(this->data(state));
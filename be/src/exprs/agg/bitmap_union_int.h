@@ -18,6 +18,7 @@
 #include "column/type_traits.h"
 #include "column/vectorized_fwd.h"
 #include "exprs/agg/aggregate.h"
+#include "exprs/agg/bitmap_union.h"
 #include "gutil/casts.h"
 #include "types/bitmap_value.h"
 
@@ -36,12 +37,63 @@ public:
         }
     }
 
+    // The values of the same state in the chunk are collected to be added in bulk, in ascending order.
+    void update_batch(FunctionContext* ctx, size_t chunk_size, size_t state_offset, const Column** columns,
+                      AggDataPtr* states) const override {
+        DCHECK((*columns[0]).is_numeric());
+        if constexpr (std::is_integral_v<T>) {
+            const auto& data = static_cast<const InputColumnType&>(*columns[0]).get_data();
+            std::vector<std::pair<AggDataPtr, uint64_t>> rows(chunk_size);
+            for (size_t i = 0; i < chunk_size; ++i) {
+                rows[i] = {states[i] + state_offset, data[i]};
+            }
+            std::sort(rows.begin(), rows.end(), [](const auto& lhs, const auto& rhs) {
+                if (lhs.first != rhs.first) {
+                    return std::less<AggDataPtr>()(lhs.first, rhs.first);
+                }
+                return lhs.second < rhs.second;
+            });
+
+            std::vector<uint64_t> values;
+            for (size_t i = 0; i < chunk_size;) {
+                AggDataPtr state = rows[i].first;
+                values.clear();
+                for (; i < chunk_size && rows[i].first == state; ++i) {
+                    values.emplace_back(rows[i].second);
+                }
+                this->data(state).add_many(values.size(), values.data());
+            }
+        }
+    }
+
+    void update_batch_single_state(FunctionContext* ctx, size_t chunk_size, const Column** columns,
+                                   AggDataPtr __restrict state) const override {
+        DCHECK((*columns[0]).is_numeric());
+        if constexpr (std::is_integral_v<T>) {
+            const auto& data = static_cast<const InputColumnType&>(*columns[0]).get_data();
+            std::vector<uint64_t> values(data.begin(), data.begin() + chunk_size);
+            this->data(state).add_many(values.size(), values.data());
+        }
+    }
+
     void merge(FunctionContext* ctx, const Column* column, AggDataPtr __restrict state, size_t row_num) const override {
         DCHECK(column->is_object());
         const auto* col = down_cast<const BitmapColumn*>(column);
         this->data(state) |= *(col->get_object(row_num));
     }
 
+    void merge_batch(FunctionContext* ctx, size_t chunk_size, size_t state_offset, const Column* column,
+                     AggDataPtr* states) const override {
+        DCHECK(column->is_object());
+        union_bitmap_rows_by_state(down_cast<const BitmapColumn*>(column), chunk_size, state_offset, states);
+    }
+
+    void merge_batch_single_state(FunctionContext* ctx, AggDataPtr __restrict state, const Column* column, size_t start,
+                                  size_t size) const override {
+        DCHECK(column->is_object());
+        union_bitmap_rows(&this->data(state), down_cast<const BitmapColumn*>(column), start, size);
+    }
+
     void serialize_to_column(FunctionContext* ctx, ConstAggDataPtr __restrict state, Column* to) const override {
         auto* col = down_cast<BitmapColumn*>(to);
         auto& value = const_cast<BitmapValue&>(this->data(state));
@@ -17,8 +17,10 @@
 #include <algorithm>
 #include <cstring>
 #include <limits>
+#include <memory>
 #include <string>
 #include <type_traits>
+#include <vector>
 
 #include "column/array_column.h"
 #include "column/binary_column.h"
@@ -34,6 +36,8 @@
 #include "gutil/casts.h"
 #include "runtime/mem_pool.h"
 #include "thrift/protocol/TJSONProtocol.h"
+#include "types/bitmap_value.h"
+#include "util/coding.h"
 #include "util/phmap/phmap_dump.h"
 #include "util/slice.h"
 
@@ -271,6 +275,192 @@ struct DistinctAggregateStateV2<PT, SumPT, FixedLengthPTGuard<PT>> {
 template <LogicalType PT, LogicalType SumPT>
 struct DistinctAggregateStateV2<PT, SumPT, StringPTGuard<PT>> : public DistinctAggregateState<PT, SumPT> {};
 
+VALUE_GUARD(LogicalType, AdaptiveDistinctPTGuard, pt_is_adaptive_distinct, TYPE_TINYINT, TYPE_SMALLINT, TYPE_INT,
+            TYPE_BIGINT)
+
+// The states of the types other than integers are the same as V2, but are serialized by serialize_to().
+template <LogicalType PT, LogicalType SumPT, typename = guard::Guard>
+struct DistinctAggregateStateV3 : public DistinctAggregateStateV2<PT, SumPT> {
+    void serialize_to(BinaryColumn::Bytes* bytes) const {
+        size_t old_size = bytes->size();
+        bytes->resize(old_size + this->serialize_size());
+        this->serialize(bytes->data() + old_size);
+    }
+};
+
+// The distinct integers are kept in a hash set while they are few or sparse, and the hash set is converted to a
+// roaring bitmap once it's large and its keys are dense, which takes a few bytes per key instead of more than 16.
+// A hash set is serialized as a sorted run of delta-encoded keys and a bitmap in its own format, so that a dense
+// state is small to be exchanged, and a serialized bitmap is merged by a union of bitmaps.
+template <LogicalType PT, LogicalType SumPT>
+struct DistinctAggregateStateV3<PT, SumPT, AdaptiveDistinctPTGuard<PT>> {
+    using T = RunTimeCppType<PT>;
+    using MyHashSet = HashSet<T>;
+    static constexpr size_t item_size = phmap::item_serialize_size<MyHashSet>::value;
+
+    // the first byte of the serialized data
+    enum Encoding : uint8_t { SORTED_RUN = 1, BITMAP = 2 };
+    // the size of a hash set is checked on every power of two from this size
+    static constexpr size_t MIN_SIZE_OF_BITMAP = 4096;
+    // the keys are dense if the average gap between two adjacent keys is at most this, then a container of the
+    // bitmap, covering 65536 values, holds 64 keys on average
+    static constexpr uint64_t MAX_AVERAGE_GAP_OF_BITMAP = 1024;
+    // the size of the bitmap is computed from all its containers, so it's only checked once per this many keys
+    static constexpr uint32_t BITMAP_SIZE_CHECK_INTERVAL = 1024;
+
+    // The memory of the bitmap is counted by the growth of its size in bytes.
+    size_t update(T key) {
+        if (bitmap != nullptr) {
+            return _add_to_bitmap(key);
+        }
+        auto pair = set.insert(key);
+        return pair.second ? _on_new_key(key) : 0;
+    }
+
+    size_t update_with_hash([[maybe_unused]] MemPool* mempool, T key, size_t hash) {
+        if (bitmap != nullptr) {
+            return _add_to_bitmap(key);
+        }
+        auto pair = set.emplace_with_hash(hash, key);
+        return pair.second ? _on_new_key(key) : 0;
+    }
+
+    void prefetch(T key) { set.prefetch(key); }
+
+    int64_t disctint_count() const { return bitmap != nullptr ? bitmap->cardinality() : set.size(); }
+
+    void serialize_to(BinaryColumn::Bytes* bytes) const {
+        size_t old_size = bytes->size();
+        if (bitmap != nullptr) {
+            size_t bitmap_size = bitmap->getSizeInBytes();
+            size_t size = std::max(1 + bitmap_size, MIN_SIZE_OF_HASH_SET_SERIALIZED_DATA);
+            bytes->resize(old_size + size);
+            uint8_t* dst = bytes->data() + old_size;
+            dst[0] = BITMAP;
+            bitmap->write(reinterpret_cast<char*>(dst + 1));
+            memset(dst + 1 + bitmap_size, 0, size - 1 - bitmap_size);
+            return;
+        }
+
+        std::vector<uint64_t> keys;
+        keys.reserve(set.size());
+        for (auto& key : set) {
+            keys.emplace_back(to_bitmap_key(key));
+        }
+        std::sort(keys.begin(), keys.end());
+        // an encoded varint64 takes 10 bytes at most
+        size_t max_size = std::max(1 + 10 * (keys.size() + 1), MIN_SIZE_OF_HASH_SET_SERIALIZED_DATA);
+        bytes->resize(old_size + max_size);
+        uint8_t* begin = bytes->data() + old_size;
+        uint8_t* dst = begin;
+        *dst++ = SORTED_RUN;
+        dst = encode_varint64(dst, keys.size());
+        uint64_t last_key = 0;
+        for (uint64_t key : keys) {
+            dst = encode_varint64(dst, key - last_key);
+            last_key = key;
+        }
+        size_t size = std::max(static_cast<size_t>(dst - begin), MIN_SIZE_OF_HASH_SET_SERIALIZED_DATA);
+        memset(dst, 0, begin + size - dst);
+        bytes->resize(old_size + size);
+    }
+
+    size_t serialize_size() const {
+        BinaryColumn::Bytes bytes;
+        serialize_to(&bytes);
+        return bytes.size();
+    }
+
+    void serialize(uint8_t* dst) const {
+        BinaryColumn::Bytes bytes;
+        serialize_to(&bytes);
+        memcpy(dst, bytes.data(), bytes.size());
+    }
+
+    size_t deserialize_and_merge(const uint8_t* src, size_t len) {
+        if (src[0] == BITMAP) {
+            BitmapValue other(Slice(src + 1, len - 1));
+            if (bitmap != nullptr) {
+                *bitmap |= other;
+                return _update_bitmap_bytes();
+            }
+            return _convert_to_bitmap(std::move(other));
+        }
+
+        DCHECK_EQ(SORTED_RUN, src[0]);
+        const uint8_t* end = src + len;
+        uint64_t num_keys = 0;
+        src = decode_varint64_ptr(src + 1, end, &num_keys);
+        size_t mem_usage = 0;
+        uint64_t key = 0;
+        for (uint64_t i = 0; i < num_keys; i++) {
+            uint64_t delta = 0;
+            src = decode_varint64_ptr(src, end, &delta);
+            DCHECK(src != nullptr);
+            key += delta;
+            mem_usage += update(from_bitmap_key(key));
+        }
+        return mem_usage;
+    }
+
+    static uint64_t to_bitmap_key(T key) { return static_cast<uint64_t>(static_cast<int64_t>(key)); }
+    static T from_bitmap_key(uint64_t key) { return static_cast<T>(static_cast<int64_t>(key)); }
+
+    MyHashSet set;
+    // not null once converted from |set|, and |set| is empty then
+    std::unique_ptr<BitmapValue> bitmap;
+
+private:
+    size_t _on_new_key(T key) {
+        _min_key = std::min<int64_t>(_min_key, key);
+        _max_key = std::max<int64_t>(_max_key, key);
+        size_t size = set.size();
+        if (size >= MIN_SIZE_OF_BITMAP && (size & (size - 1)) == 0 &&
+            (static_cast<uint64_t>(_max_key) - static_cast<uint64_t>(_min_key)) / size <= MAX_AVERAGE_GAP_OF_BITMAP) {
+            return item_size + _convert_to_bitmap(BitmapValue());
+        }
+        return item_size;
+    }
+
+    size_t _add_to_bitmap(T key) {
+        bitmap->add(to_bitmap_key(key));
+        if (++_num_unchecked_keys < BITMAP_SIZE_CHECK_INTERVAL) {
+            return 0;
+        }
+        return _update_bitmap_bytes();
+    }
+
+    // Return the growth of the bitmap since the last check. The memory counted for the hash set isn't given
+    // back on the conversion, as the memory usage is only ever increased.
+    size_t _update_bitmap_bytes() {
+        _num_unchecked_keys = 0;
+        size_t bytes = bitmap->getSizeInBytes();
+        if (bytes <= _bitmap_bytes) {
+            return 0;
+        }
+        size_t delta = bytes - _bitmap_bytes;
+        _bitmap_bytes = bytes;
+        return delta;
+    }
+
+    size_t _convert_to_bitmap(BitmapValue&& other) {
+        std::vector<uint64_t> keys;
+        keys.reserve(set.size());
+        for (auto& key : set) {
+            keys.emplace_back(to_bitmap_key(key));
+        }
+        bitmap = std::make_unique<BitmapValue>(keys);
+        *bitmap |= other;
+        MyHashSet().swap(set);
+        return _update_bitmap_bytes();
+    }
+
+    size_t _bitmap_bytes = 0;
+    uint32_t _num_unchecked_keys = 0;
+    int64_t _min_key = std::numeric_limits<int64_t>::max();
+    int64_t _max_key = std::numeric_limits<int64_t>::min();
+};
+
 // Dear god this template class as template parameter kills me!
 template <LogicalType PT, LogicalType SumPT,
           template <LogicalType X, LogicalType Y, typename = guard::Guard> class TDistinctAggState,
@@ -462,6 +652,18 @@ template <LogicalType PT, AggDistinctType DistinctType, typename T = RunTimeCppT
 class DecimalDistinctAggregateFunction
         : public TDistinctAggregateFunction<PT, TYPE_DECIMAL128, DistinctAggregateStateV2, DistinctType, T> {};
 
+// Only COUNT is supported, whose states are serialized once instead of sizing them first.
+template <LogicalType PT, AggDistinctType DistinctType, typename T = RunTimeCppType<PT>>
+class DistinctAggregateFunctionV3 final
+        : public TDistinctAggregateFunction<PT, SumResultPT<PT>, DistinctAggregateStateV3, DistinctType, T> {
+public:
+    void serialize_to_column(FunctionContext* ctx, ConstAggDataPtr __restrict state, Column* to) const override {
+        auto* column = down_cast<BinaryColumn*>(to);
+        this->data(state).serialize_to(&column->get_bytes());
+        column->get_offset().emplace_back(column->get_bytes().size());
+    }
+};
+
 // now we only support String
 struct DictMergeState : DistinctAggregateStateV2<TYPE_VARCHAR, SumResultPT<TYPE_VARCHAR>> {
     DictMergeState() = default;
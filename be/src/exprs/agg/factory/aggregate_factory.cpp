@@ -102,7 +102,7 @@ static const AggregateFunction* get_function(const std::string& name, LogicalTyp
         if (name == "multi_distinct_sum") {
             func_name = "multi_distinct_sum2";
         } else if (name == "multi_distinct_count") {
-            func_name = "multi_distinct_count2";
+            func_name = func_version > 4 ? "multi_distinct_count3" : "multi_distinct_count2";
         }
     }
 
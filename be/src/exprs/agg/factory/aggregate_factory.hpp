@@ -92,6 +92,8 @@ public:
     static AggregateFunctionPtr MakeCountDistinctAggregateFunction();
     template <LogicalType PT>
     static AggregateFunctionPtr MakeCountDistinctAggregateFunctionV2();
+    template <LogicalType PT>
+    static AggregateFunctionPtr MakeCountDistinctAggregateFunctionV3();
 
     template <LogicalType PT>
     static AggregateFunctionPtr MakeGroupConcatAggregateFunction();
@@ -227,6 +229,11 @@ AggregateFunctionPtr AggregateFactory::MakeCountDistinctAggregateFunctionV2() {
     return std::make_shared<DistinctAggregateFunctionV2<PT, AggDistinctType::COUNT>>();
 }
 
+template <LogicalType PT>
+AggregateFunctionPtr AggregateFactory::MakeCountDistinctAggregateFunctionV3() {
+    return std::make_shared<DistinctAggregateFunctionV3<PT, AggDistinctType::COUNT>>();
+}
+
 template <LogicalType PT>
 AggregateFunctionPtr AggregateFactory::MakeGroupConcatAggregateFunction() {
     return std::make_shared<GroupConcatAggregateFunction<PT>>();
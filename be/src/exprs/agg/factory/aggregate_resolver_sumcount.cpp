@@ -56,10 +56,13 @@ struct DistinctDispatcher {
         if constexpr (pt_is_aggregate<pt> || pt_is_string<pt>) {
             using DistinctState = DistinctAggregateState<pt, SumResultPT<pt>>;
             using DistinctState2 = DistinctAggregateStateV2<pt, SumResultPT<pt>>;
+            using DistinctState3 = DistinctAggregateStateV3<pt, SumResultPT<pt>>;
             resolver->add_aggregate_mapping<pt, TYPE_BIGINT, DistinctState>(
                     "multi_distinct_count", false, AggregateFactory::MakeCountDistinctAggregateFunction<pt>());
             resolver->add_aggregate_mapping<pt, TYPE_BIGINT, DistinctState2>(
                     "multi_distinct_count2", false, AggregateFactory::MakeCountDistinctAggregateFunctionV2<pt>());
+            resolver->add_aggregate_mapping<pt, TYPE_BIGINT, DistinctState3>(
+                    "multi_distinct_count3", false, AggregateFactory::MakeCountDistinctAggregateFunctionV3<pt>());
 
             resolver->add_aggregate_mapping<pt, SumResultPT<pt>, DistinctState>(
                     "multi_distinct_sum", false, AggregateFactory::MakeSumDistinctAggregateFunction<pt>());
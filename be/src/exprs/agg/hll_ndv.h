@@ -21,6 +21,7 @@
 #include "exprs/agg/aggregate.h"
 #include "gutil/casts.h"
 #include "types/hll.h"
+#include "util/coding.h"
 
 namespace starrocks {
 
@@ -57,40 +58,37 @@ public:
         }
     }
 
+    void update_batch_single_state(FunctionContext* ctx, size_t chunk_size, const Column** columns,
+                                   AggDataPtr __restrict state) const override {
+        std::vector<uint64_t> hash_values;
+        _hash_column(columns[0], 0, chunk_size, &hash_values);
+        this->data(state).update_batch(hash_values.data(), hash_values.size());
+    }
+
     void update_batch_single_state_with_frame(FunctionContext* ctx, AggDataPtr __restrict state, const Column** columns,
                                               int64_t peer_group_start, int64_t peer_group_end, int64_t frame_start,
                                               int64_t frame_end) const override {
-        const ColumnType* column = down_cast<const ColumnType*>(columns[0]);
+        std::vector<uint64_t> hash_values;
+        _hash_column(columns[0], frame_start, frame_end, &hash_values);
+        this->data(state).update_batch(hash_values.data(), hash_values.size());
+    }
 
-        if constexpr (pt_is_string<PT>) {
-            uint64_t value = 0;
-            for (size_t i = frame_start; i < frame_end; ++i) {
-                Slice s = column->get_slice(i);
-                value = HashUtil::murmur_hash64A(s.data, s.size, HashUtil::MURMUR_SEED);
-
-                if (value != 0) {
-                    this->data(state).update(value);
-                }
-            }
-        } else {
-            uint64_t value = 0;
-            const auto& v = column->get_data();
-            for (size_t i = frame_start; i < frame_end; ++i) {
-                value = HashUtil::murmur_hash64A(&v[i], sizeof(v[i]), HashUtil::MURMUR_SEED);
+    void merge(FunctionContext* ctx, const Column* column, AggDataPtr __restrict state, size_t row_num) const override {
+        DCHECK(column->is_binary());
 
-                if (value != 0) {
-                    this->data(state).update(value);
-                }
-            }
-        }
+        const auto* hll_column = down_cast<const BinaryColumn*>(column);
+        this->data(state).deserialize_and_merge(hll_column->get_slice(row_num));
     }
 
-    void merge(FunctionContext* ctx, const Column* column, AggDataPtr __restrict state, size_t row_num) const override {
+    void merge_batch_single_state(FunctionContext* ctx, AggDataPtr __restrict state, const Column* column, size_t start,
+                                  size_t size) const override {
         DCHECK(column->is_binary());
 
         const auto* hll_column = down_cast<const BinaryColumn*>(column);
-        HyperLogLog hll(hll_column->get(row_num).get_slice());
-        this->data(state).merge(hll);
+        auto& hll = this->data(state);
+        for (size_t i = start; i < start + size; ++i) {
+            hll.deserialize_and_merge(hll_column->get_slice(i));
+        }
     }
 
     void get_values(FunctionContext* ctx, ConstAggDataPtr __restrict state, Column* dst, size_t start,
@@ -125,28 +123,26 @@ public:
         bytes.reserve(chunk_size * 10);
         result->get_offset().resize(chunk_size + 1);
 
+        // Each row is serialized as an explicit HLL value of its hash, or an empty one if the hash is 0,
+        // without building the HLL value.
+        std::vector<uint64_t> hash_values(chunk_size);
+        _hash_column(column, 0, chunk_size, hash_values.data());
+
         size_t old_size = bytes.size();
-        uint64_t value = 0;
+        bytes.resize(old_size + chunk_size * (2 + sizeof(uint64_t)));
+        uint8_t* ptr = bytes.data() + old_size;
         for (size_t i = 0; i < chunk_size; ++i) {
-            HyperLogLog hll;
-            if constexpr (pt_is_string<PT>) {
-                Slice s = column->get_slice(i);
-                value = HashUtil::murmur_hash64A(s.data, s.size, HashUtil::MURMUR_SEED);
+            if (hash_values[i] != 0) {
+                *ptr++ = HLL_DATA_EXPLICIT;
+                *ptr++ = 1;
+                encode_fixed64_le(ptr, hash_values[i]);
+                ptr += sizeof(uint64_t);
             } else {
-                auto v = column->get_data()[i];
-                value = HashUtil::murmur_hash64A(&v, sizeof(v), HashUtil::MURMUR_SEED);
+                *ptr++ = HLL_DATA_EMPTY;
             }
-            if (value != 0) {
-                hll.update(value);
-            }
-
-            size_t new_size = old_size + hll.max_serialized_size();
-            bytes.resize(new_size);
-            hll.serialize(bytes.data() + old_size);
-
-            result->get_offset()[i + 1] = new_size;
-            old_size = new_size;
+            result->get_offset()[i + 1] = ptr - bytes.data();
         }
+        bytes.resize(ptr - bytes.data());
     }
 
     void finalize_to_column(FunctionContext* ctx __attribute__((unused)), ConstAggDataPtr __restrict state,
@@ -171,6 +167,35 @@ public:
             return "ndv";
         }
     }
+
+private:
+    // Hash the rows [from, to) of |column| to |hash_values|
+    static void _hash_column(const Column* column, size_t from, size_t to, uint64_t* hash_values) {
+        const auto* data_column = down_cast<const ColumnType*>(column);
+        if constexpr (pt_is_string<PT>) {
+            for (size_t i = from; i < to; ++i) {
+                Slice s = data_column->get_slice(i);
+                hash_values[i - from] = HashUtil::murmur_hash64A(s.data, s.size, HashUtil::MURMUR_SEED);
+            }
+        } else {
+            const auto& v = data_column->get_data();
+            for (size_t i = from; i < to; ++i) {
+                hash_values[i - from] = HashUtil::murmur_hash64A(&v[i], sizeof(v[i]), HashUtil::MURMUR_SEED);
+            }
+        }
+    }
+
+    // Hash the rows [from, to) of |column| to |hash_values|, skipping the hashes of 0
+    static void _hash_column(const Column* column, size_t from, size_t to, std::vector<uint64_t>* hash_values) {
+        hash_values->resize(to - from);
+        _hash_column(column, from, to, hash_values->data());
+        size_t size = 0;
+        for (uint64_t value : *hash_values) {
+            (*hash_values)[size] = value;
+            size += (value != 0);
+        }
+        hash_values->resize(size);
+    }
 };
 
 } // namespace starrocks
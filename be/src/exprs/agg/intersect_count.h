@@ -89,14 +89,14 @@ public:
         // based on NullableAggregateFunctionVariadic.
         const InputColumnType* key_column = down_cast<const InputColumnType*>(columns[1]);
 
-        auto bimtap_value = bitmap_column->get_pool()[row_num];
+        const auto& bitmap_value = bitmap_column->get_pool()[row_num];
         auto key_value = key_column->get_data()[row_num];
 
         if constexpr (PT != TYPE_VARCHAR && PT != TYPE_CHAR) {
-            intersect.update(key_value, bimtap_value);
+            intersect.update(key_value, bitmap_value);
         } else {
             std::string key(key_value.data, key_value.size);
-            intersect.update(key, bimtap_value);
+            intersect.update(key, bitmap_value);
         }
     }
 
@@ -148,14 +148,14 @@ public:
         for (int i = 0; i < chunk_size; ++i) {
             BitmapIntersect<BitmapRuntimeCppType<PT>> intersect_per_row(intersect);
 
-            auto bimtap_value = bitmap_column->get_pool()[i];
+            const auto& bitmap_value = bitmap_column->get_pool()[i];
             auto key_value = key_column->get_data()[i];
 
             if constexpr (PT != TYPE_VARCHAR && PT != TYPE_CHAR) {
-                intersect_per_row.update(key_value, bimtap_value);
+                intersect_per_row.update(key_value, bitmap_value);
             } else {
                 std::string key(key_value.data, key_value.size);
-                intersect_per_row.update(key, bimtap_value);
+                intersect_per_row.update(key, bitmap_value);
             }
 
             new_size += intersect_per_row.size();
@@ -23,6 +23,7 @@
 #include "column/type_traits.h"
 #include "column/vectorized_fwd.h"
 #include "common/object_pool.h"
+#include "exprs/expr_selection.h"
 #include "gutil/casts.h"
 #include "simd/mulselector.h"
 #include "types/logical_type_infra.h"
@@ -68,10 +69,14 @@ public:
     }
 
     StatusOr<ColumnPtr> evaluate_checked(ExprContext* context, Chunk* chunk) override {
+        return evaluate_with_filter(context, chunk, nullptr);
+    }
+
+    StatusOr<ColumnPtr> evaluate_with_filter(ExprContext* context, Chunk* chunk, uint8_t* filter) override {
         if (_has_case_expr) {
-            return evaluate_case(context, chunk);
+            return evaluate_case(context, chunk, filter);
         } else {
-            return evaluate_no_case(context, chunk);
+            return evaluate_no_case(context, chunk, filter);
         }
     }
 
@@ -96,15 +101,16 @@ private:
     //   If ALL `WHEN` is null, return NULL
     //   If `CASE` equals `WHEN`, return `THEN`
     //   If `CASE` can't match ANY `WHEN`, return NULL
-    StatusOr<ColumnPtr> evaluate_case(ExprContext* context, Chunk* chunk) {
+    StatusOr<ColumnPtr> evaluate_case(ExprContext* context, Chunk* chunk, uint8_t* filter) {
         ColumnPtr else_column = nullptr;
         if (!_has_else_expr) {
             else_column = ColumnHelper::create_const_null_column(chunk != nullptr ? chunk->num_rows() : 1);
         } else {
-            ASSIGN_OR_RETURN(else_column, _children[_children.size() - 1]->evaluate_checked(context, chunk));
+            ASSIGN_OR_RETURN(else_column,
+                             _children[_children.size() - 1]->evaluate_with_filter(context, chunk, filter));
         }
 
-        ASSIGN_OR_RETURN(ColumnPtr case_column, _children[0]->evaluate_checked(context, chunk));
+        ASSIGN_OR_RETURN(ColumnPtr case_column, _children[0]->evaluate_with_filter(context, chunk, filter));
         if (ColumnHelper::count_nulls(case_column) == case_column->size()) {
             return else_column->clone();
         }
@@ -124,14 +130,14 @@ private:
         then_viewers.reserve(loop_end);
 
         for (int i = 1; i < loop_end; i += 2) {
-            ASSIGN_OR_RETURN(ColumnPtr when_column, _children[i]->evaluate_checked(context, chunk));
+            ASSIGN_OR_RETURN(ColumnPtr when_column, _children[i]->evaluate_with_filter(context, chunk, filter));
 
             // skip if all null
             if (ColumnHelper::count_nulls(when_column) == when_column->size()) {
                 continue;
             }
 
-            ASSIGN_OR_RETURN(ColumnPtr then_column, _children[i + 1]->evaluate_checked(context, chunk));
+            ASSIGN_OR_RETURN(ColumnPtr then_column, _children[i + 1]->evaluate_with_filter(context, chunk, filter));
 
             when_viewers.emplace_back(when_column);
             then_viewers.emplace_back(then_column);
@@ -207,14 +213,10 @@ private:
     //  Special CASE-WHEN statment, and `WHEN` clause must be boolean.
     //  If all `WHEN` is null/false, return NULL
     //  If `WHEN` is not null and true, return `THEN`
-    StatusOr<ColumnPtr> evaluate_no_case(ExprContext* context, Chunk* chunk) {
-        ColumnPtr else_column = nullptr;
-        if (!_has_else_expr) {
-            else_column = ColumnHelper::create_const_null_column(chunk != nullptr ? chunk->num_rows() : 1);
-        } else {
-            ASSIGN_OR_RETURN(else_column, _children[_children.size() - 1]->evaluate_checked(context, chunk));
-        }
-
+    //
+    //  Each `WHEN` is only evaluated on the rows not matching the previous ones, and each `THEN` is only
+    //  evaluated on the rows matching its `WHEN`.
+    StatusOr<ColumnPtr> evaluate_no_case(ExprContext* context, Chunk* chunk, uint8_t* filter) {
         int loop_end = _children.size() - 1;
 
         Columns when_columns;
@@ -229,20 +231,30 @@ private:
         std::vector<ColumnViewer<ResultType>> then_viewers;
         then_viewers.reserve(loop_end);
 
+        // the rows not matching any `WHEN` yet
+        uint8_t* remaining = filter;
+        Filter remaining_selection;
+        Filter next_remaining_selection;
+        Filter then_selection;
+        bool all_matched = false;
         for (int i = 0; i < loop_end; i += 2) {
-            ASSIGN_OR_RETURN(ColumnPtr when_column, _children[i]->evaluate_checked(context, chunk));
+            ASSIGN_OR_RETURN(ColumnPtr when_column, _children[i]->evaluate_with_filter(context, chunk, remaining));
 
-            size_t trues_count = ColumnHelper::count_true_with_notnull(when_column);
+            size_t trues_count =
+                    select_by_boolean_column(remaining, when_column, BooleanSelectMode::kTrue, &then_selection);
 
             // skip if all false or all null
             if (trues_count == 0) {
                 continue;
             }
 
-            ASSIGN_OR_RETURN(ColumnPtr then_column, _children[i + 1]->evaluate_checked(context, chunk));
+            ASSIGN_OR_RETURN(ColumnPtr then_column,
+                             _children[i + 1]->evaluate_with_filter(context, chunk, then_selection.data()));
 
+            size_t remaining_count = select_by_boolean_column(remaining, when_column, BooleanSelectMode::kNotTrue,
+                                                              &next_remaining_selection);
             // direct return if first when is all true
-            if (when_viewers.empty() && trues_count == when_column->size()) {
+            if (when_viewers.empty() && remaining_count == 0) {
                 return then_column->clone();
             }
 
@@ -251,6 +263,24 @@ private:
 
             when_viewers.emplace_back(when_column);
             then_viewers.emplace_back(then_column);
+
+            if (remaining_count == 0) {
+                all_matched = true;
+                break;
+            }
+            remaining_selection.swap(next_remaining_selection);
+            remaining = remaining_selection.data();
+        }
+
+        ColumnPtr else_column = nullptr;
+        if (all_matched) {
+            // no row takes `ELSE`, any column of the result type is fine
+            else_column = then_columns.back();
+        } else if (!_has_else_expr) {
+            else_column = ColumnHelper::create_const_null_column(chunk != nullptr ? chunk->num_rows() : 1);
+        } else {
+            ASSIGN_OR_RETURN(else_column,
+                             _children[_children.size() - 1]->evaluate_with_filter(context, chunk, remaining));
         }
 
         if (when_viewers.empty()) {
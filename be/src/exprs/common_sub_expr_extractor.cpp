@@ -0,0 +1,249 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "exprs/common_sub_expr_extractor.h"
+
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "common/object_pool.h"
+#include "exprs/column_ref.h"
+#include "exprs/expr.h"
+#include "exprs/expr_context.h"
+#include "exprs/function_call_expr.h"
+#include "exprs/literal.h"
+
+namespace starrocks {
+
+// The keys of the visited sub-trees, the key of a sub-tree is empty if it can't be shared
+using SubTreeKeys = std::unordered_map<const Expr*, std::string>;
+
+// The key of a literal is its exact value, debug_string() isn't enough as it rounds the floating values
+static std::string literal_key(const VectorizedLiteral* literal) {
+    const ColumnPtr& value = literal->value();
+    std::string bytes(value->serialize_size(0), '\0');
+    value->serialize(0, reinterpret_cast<uint8_t*>(bytes.data()));
+    std::string key = "literal";
+    for (char c : bytes) {
+        key.append(fmt::format("{:02x}", static_cast<uint8_t>(c)));
+    }
+    return key;
+}
+
+static const std::string& compute_key(Expr* expr, SubTreeKeys* keys) {
+    std::string key;
+    switch (expr->node_type()) {
+    case TExprNodeType::SLOT_REF:
+        if (auto* ref = dynamic_cast<ColumnRef*>(expr); ref != nullptr) {
+            key = fmt::format("slot{}", ref->slot_id());
+        }
+        break;
+    case TExprNodeType::BOOL_LITERAL:
+    case TExprNodeType::INT_LITERAL:
+    case TExprNodeType::LARGE_INT_LITERAL:
+    case TExprNodeType::FLOAT_LITERAL:
+    case TExprNodeType::DECIMAL_LITERAL:
+    case TExprNodeType::DATE_LITERAL:
+    case TExprNodeType::STRING_LITERAL:
+    case TExprNodeType::BINARY_LITERAL:
+    case TExprNodeType::NULL_LITERAL:
+        if (auto* literal = dynamic_cast<VectorizedLiteral*>(expr); literal != nullptr) {
+            key = literal_key(literal);
+        }
+        break;
+    case TExprNodeType::COMPUTE_FUNCTION_CALL:
+    case TExprNodeType::FUNCTION_CALL:
+        // if, ifnull, coalesce and so on are not VectorizedFunctionCallExpr, and UDFs are not known to be pure
+        if (auto* fn = dynamic_cast<VectorizedFunctionCallExpr*>(expr);
+            fn != nullptr && fn->fn().binary_type == TFunctionBinaryType::BUILTIN && fn->fn().__isset.fid &&
+            !fn->is_returning_random_value()) {
+            key = fmt::format("fn{}", fn->fn().fid);
+        }
+        break;
+    case TExprNodeType::CAST_EXPR:
+        key = "cast";
+        break;
+    case TExprNodeType::ARITHMETIC_EXPR:
+    case TExprNodeType::BINARY_PRED:
+        key = fmt::format("op{}", static_cast<int>(expr->op()));
+        break;
+    default:
+        break;
+    }
+
+    if (!key.empty()) {
+        key.append(":").append(expr->type().debug_string()).append("(");
+        for (int i = 0; i < expr->get_num_children(); i++) {
+            const std::string& child_key = compute_key(expr->get_child(i), keys);
+            if (child_key.empty()) {
+                key.clear();
+                break;
+            }
+            key.append(i == 0 ? "" : ",").append(child_key);
+        }
+        if (!key.empty()) {
+            key.append(")");
+        }
+    }
+    return (*keys)[expr] = std::move(key);
+}
+
+// Return the key of the largest sub-tree appearing more than once in |roots|, the roots themselves included,
+// or an empty string if there isn't any.
+static std::string find_shared_key(const std::vector<Expr*>& roots, SubTreeKeys* keys) {
+    keys->clear();
+    for (Expr* root : roots) {
+        compute_key(root, keys);
+    }
+    std::unordered_map<std::string, int> counts;
+    for (const auto& [expr, key] : *keys) {
+        if (key.empty() || expr->get_num_children() == 0 || expr->is_constant()) {
+            continue;
+        }
+        counts[key]++;
+    }
+    // the key of a sub-tree is longer than the keys of all its sub-trees, so the outermost identical sub-trees
+    // are extracted first
+    std::string shared_key;
+    for (const auto& [key, count] : counts) {
+        if (count > 1 && (key.size() > shared_key.size() || (key.size() == shared_key.size() && key < shared_key))) {
+            shared_key = key;
+        }
+    }
+    return shared_key;
+}
+
+// Replace the sub-trees of |expr| identified by |key| with the references to |slot_id|, the first one replaced
+// is returned by |extracted|
+static void replace_sub_trees(ObjectPool* pool, Expr* expr, const std::string& key, const SubTreeKeys& keys,
+                              SlotId slot_id, Expr** extracted) {
+    std::vector<Expr*> children = expr->children();
+    bool replaced = false;
+    for (auto& child : children) {
+        auto iter = keys.find(child);
+        if (iter == keys.end()) {
+            continue;
+        }
+        if (iter->second == key) {
+            if (*extracted == nullptr) {
+                *extracted = child;
+            }
+            child = pool->add(new ColumnRef(child->type(), slot_id));
+            replaced = true;
+        } else {
+            replace_sub_trees(pool, child, key, keys, slot_id, extracted);
+        }
+    }
+    if (replaced) {
+        expr->clear_children();
+        for (Expr* child : children) {
+            expr->add_child(child);
+        }
+    }
+}
+
+Status extract_common_sub_exprs(ObjectPool* pool, SlotId next_slot_id, std::vector<ExprContext*>* expr_ctxs,
+                                std::vector<SlotId>* common_sub_slot_ids,
+                                std::vector<ExprContext*>* common_sub_expr_ctxs) {
+    DCHECK_EQ(common_sub_slot_ids->size(), common_sub_expr_ctxs->size());
+    std::vector<Expr*> roots;
+    for (ExprContext* ctx : *common_sub_expr_ctxs) {
+        roots.emplace_back(ctx->root());
+    }
+    for (ExprContext* ctx : *expr_ctxs) {
+        roots.emplace_back(ctx->root());
+    }
+    SubTreeKeys keys;
+    if (find_shared_key(roots, &keys).empty()) {
+        return Status::OK();
+    }
+
+    // the new slots mustn't conflict with any slot referenced, including the arguments of lambda functions
+    std::vector<SlotId> referenced_slot_ids(common_sub_slot_ids->begin(), common_sub_slot_ids->end());
+    for (Expr* root : roots) {
+        root->get_slot_ids(&referenced_slot_ids);
+    }
+    for (SlotId slot_id : referenced_slot_ids) {
+        next_slot_id = std::max(next_slot_id, slot_id + 1);
+    }
+
+    for (auto& root : roots) {
+        root = Expr::copy(pool, root);
+    }
+    // the roots are laid out as the common sub-expressions, the exprs and then the extracted sub-trees, and
+    // a root identical to another sub-tree is replaced as a whole, e.g. f(x) in `SELECT f(x), f(x) + 1`
+    const size_t num_common_roots = common_sub_expr_ctxs->size();
+    const size_t num_expr_roots = expr_ctxs->size();
+    std::vector<SlotId> common_slot_ids(*common_sub_slot_ids);
+    for (std::string key = find_shared_key(roots, &keys); !key.empty(); key = find_shared_key(roots, &keys)) {
+        SlotId slot_id = next_slot_id++;
+        Expr* extracted = nullptr;
+        for (auto& root : roots) {
+            if (keys.at(root) == key) {
+                if (extracted == nullptr) {
+                    extracted = root;
+                }
+                root = pool->add(new ColumnRef(root->type(), slot_id));
+            } else {
+                replace_sub_trees(pool, root, key, keys, slot_id, &extracted);
+            }
+        }
+        DCHECK(extracted != nullptr);
+        common_slot_ids.emplace_back(slot_id);
+        roots.emplace_back(extracted);
+    }
+    std::vector<Expr*> common_roots(roots.begin(), roots.begin() + num_common_roots);
+    common_roots.insert(common_roots.end(), roots.begin() + num_common_roots + num_expr_roots, roots.end());
+    std::vector<Expr*> expr_roots(roots.begin() + num_common_roots, roots.begin() + num_common_roots + num_expr_roots);
+
+    // order the common sub-expressions by their references to each other, keeping the original order otherwise
+    std::unordered_set<SlotId> pending_slot_ids(common_slot_ids.begin(), common_slot_ids.end());
+    std::vector<bool> ordered(common_roots.size(), false);
+    std::vector<SlotId> ordered_slot_ids;
+    std::vector<ExprContext*> ordered_ctxs;
+    while (ordered_ctxs.size() < common_roots.size()) {
+        size_t num_ordered = ordered_ctxs.size();
+        for (size_t i = 0; i < common_roots.size(); i++) {
+            if (ordered[i]) {
+                continue;
+            }
+            std::vector<SlotId> slot_ids;
+            common_roots[i]->get_slot_ids(&slot_ids);
+            if (std::any_of(slot_ids.begin(), slot_ids.end(),
+                            [&](SlotId slot_id) { return pending_slot_ids.count(slot_id) > 0; })) {
+                continue;
+            }
+            ordered[i] = true;
+            pending_slot_ids.erase(common_slot_ids[i]);
+            ordered_slot_ids.emplace_back(common_slot_ids[i]);
+            ordered_ctxs.emplace_back(pool->add(new ExprContext(common_roots[i])));
+        }
+        if (ordered_ctxs.size() == num_ordered) {
+            return Status::InternalError("common sub-expressions reference each other circularly");
+        }
+    }
+
+    *common_sub_slot_ids = std::move(ordered_slot_ids);
+    *common_sub_expr_ctxs = std::move(ordered_ctxs);
+    for (size_t i = 0; i < expr_roots.size(); i++) {
+        (*expr_ctxs)[i] = pool->add(new ExprContext(expr_roots[i]));
+    }
+    return Status::OK();
+}
+
+} // namespace starrocks
@@ -0,0 +1,44 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <vector>
+
+#include "common/global_types.h"
+#include "common/status.h"
+
+namespace starrocks {
+
+class ExprContext;
+class ObjectPool;
+
+// Extract the identical sub-trees appearing more than once in |expr_ctxs| and |common_sub_expr_ctxs|, e.g.
+// get_json_string(j, '$.a') in `SELECT upper(get_json_string(j, '$.a')), get_json_string(j, '$.a') = 'x'`,
+// into new common sub-expressions, so that they are evaluated once per chunk and their result columns are
+// referenced by the slots starting from |next_slot_id|.
+//
+// Only the sub-trees of builtin functions returning the same values for the same arguments, casts, arithmetic
+// expressions and binary predicates, on columns and literals, are extracted, and the sub-trees under the
+// expressions not evaluating all of their children, e.g. CASE and AND, are left as they are.
+//
+// The exprs must not be prepared. Nothing is changed if there isn't any identical sub-tree, otherwise the
+// rewritten copies of the exprs are returned, the original ones are left unchanged since they may be referenced
+// elsewhere, e.g. by runtime filters, and |common_sub_expr_ctxs| are ordered so that each one is evaluated
+// after the ones it references.
+Status extract_common_sub_exprs(ObjectPool* pool, SlotId next_slot_id, std::vector<ExprContext*>* expr_ctxs,
+                                std::vector<SlotId>* common_sub_slot_ids,
+                                std::vector<ExprContext*>* common_sub_expr_ctxs);
+
+} // namespace starrocks
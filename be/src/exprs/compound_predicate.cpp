@@ -16,6 +16,7 @@
 
 #include "common/object_pool.h"
 #include "exprs/binary_function.h"
+#include "exprs/expr_selection.h"
 #include "exprs/predicate.h"
 #include "exprs/unary_function.h"
 
@@ -44,15 +45,19 @@ class VectorizedAndCompoundPredicate final : public Predicate {
 public:
     DEFINE_COMPOUND_CONSTRUCT(VectorizedAndCompoundPredicate);
     StatusOr<ColumnPtr> evaluate_checked(ExprContext* context, Chunk* ptr) override {
-        ASSIGN_OR_RETURN(auto l, _children[0]->evaluate_checked(context, ptr));
-        int l_falses = ColumnHelper::count_false_with_notnull(l);
+        return evaluate_with_filter(context, ptr, nullptr);
+    }
+
+    StatusOr<ColumnPtr> evaluate_with_filter(ExprContext* context, Chunk* ptr, uint8_t* filter) override {
+        ASSIGN_OR_RETURN(auto l, _children[0]->evaluate_with_filter(context, ptr, filter));
 
-        // left all false and not null
-        if (l_falses == l->size()) {
+        // the right is only evaluated on the rows where the left isn't false
+        Filter selection;
+        if (select_by_boolean_column(filter, l, BooleanSelectMode::kNotFalse, &selection) == 0) {
             return l->clone();
         }
 
-        ASSIGN_OR_RETURN(auto r, _children[1]->evaluate_checked(context, ptr));
+        ASSIGN_OR_RETURN(auto r, _children[1]->evaluate_with_filter(context, ptr, selection.data()));
 
         return VectorizedLogicPredicateBinaryFunction<AndNullImpl, AndImpl>::template evaluate<TYPE_BOOLEAN>(l, r);
     }
@@ -76,15 +81,19 @@ class VectorizedOrCompoundPredicate final : public Predicate {
 public:
     DEFINE_COMPOUND_CONSTRUCT(VectorizedOrCompoundPredicate);
     StatusOr<ColumnPtr> evaluate_checked(ExprContext* context, Chunk* ptr) override {
-        ASSIGN_OR_RETURN(auto l, _children[0]->evaluate_checked(context, ptr));
+        return evaluate_with_filter(context, ptr, nullptr);
+    }
+
+    StatusOr<ColumnPtr> evaluate_with_filter(ExprContext* context, Chunk* ptr, uint8_t* filter) override {
+        ASSIGN_OR_RETURN(auto l, _children[0]->evaluate_with_filter(context, ptr, filter));
 
-        int l_trues = ColumnHelper::count_true_with_notnull(l);
-        // left all true and not null
-        if (l_trues == l->size()) {
+        // the right is only evaluated on the rows where the left isn't true
+        Filter selection;
+        if (select_by_boolean_column(filter, l, BooleanSelectMode::kNotTrue, &selection) == 0) {
             return l->clone();
         }
 
-        ASSIGN_OR_RETURN(auto r, _children[1]->evaluate_checked(context, ptr));
+        ASSIGN_OR_RETURN(auto r, _children[1]->evaluate_with_filter(context, ptr, selection.data()));
 
         return VectorizedLogicPredicateBinaryFunction<OrNullImpl, OrImpl>::template evaluate<TYPE_BOOLEAN>(l, r);
     }
@@ -23,6 +23,7 @@
 #include "column/type_traits.h"
 #include "column/vectorized_fwd.h"
 #include "common/object_pool.h"
+#include "exprs/expr_selection.h"
 #include "gutil/casts.h"
 #include "runtime/types.h"
 #include "simd/selector.h"
@@ -165,19 +166,30 @@ public:
     DEFINE_CLASS_CONSTRUCT_FN(VectorizedIfExpr);
 
     StatusOr<ColumnPtr> evaluate_checked(ExprContext* context, Chunk* ptr) override {
-        ASSIGN_OR_RETURN(auto bhs, _children[0]->evaluate_checked(context, ptr));
-        int true_count = ColumnHelper::count_true_with_notnull(bhs);
+        return evaluate_with_filter(context, ptr, nullptr);
+    }
+
+    StatusOr<ColumnPtr> evaluate_with_filter(ExprContext* context, Chunk* ptr, uint8_t* filter) override {
+        ASSIGN_OR_RETURN(auto bhs, _children[0]->evaluate_with_filter(context, ptr, filter));
 
-        ASSIGN_OR_RETURN(auto lhs, _children[1]->evaluate_checked(context, ptr));
-        if (true_count == bhs->size()) {
+        // each branch is only evaluated on the rows taking it
+        Filter then_selection;
+        Filter else_selection;
+        size_t then_count = select_by_boolean_column(filter, bhs, BooleanSelectMode::kTrue, &then_selection);
+        size_t else_count = select_by_boolean_column(filter, bhs, BooleanSelectMode::kNotTrue, &else_selection);
+
+        if (else_count == 0) {
+            ASSIGN_OR_RETURN(auto lhs, _children[1]->evaluate_with_filter(context, ptr, then_selection.data()));
             return lhs->clone();
         }
 
-        ASSIGN_OR_RETURN(auto rhs, _children[2]->evaluate_checked(context, ptr));
-        if (true_count == 0) {
+        ASSIGN_OR_RETURN(auto rhs, _children[2]->evaluate_with_filter(context, ptr, else_selection.data()));
+        if (then_count == 0) {
             return rhs->clone();
         }
 
+        ASSIGN_OR_RETURN(auto lhs, _children[1]->evaluate_with_filter(context, ptr, then_selection.data()));
+
         if (lhs->only_null() && rhs->only_null()) {
             return lhs->clone();
         }
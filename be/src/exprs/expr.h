@@ -195,6 +195,9 @@ public:
 
     // TODO: check error in expression and return error status, instead of return null column
     virtual StatusOr<ColumnPtr> evaluate_checked(ExprContext* context, Chunk* ptr) = 0;
+    // Evaluate the rows selected by |filter|, one byte per row, while the results of the other rows are
+    // undefined, e.g. a conjunct only needs to be evaluated on the rows passing the previous ones.
+    // nullptr selects all the rows. By default, all the rows are evaluated. See exprs/expr_selection.h.
     virtual StatusOr<ColumnPtr> evaluate_with_filter(ExprContext* context, Chunk* ptr, uint8_t* filter);
 
     // TODO:(murphy) remove this unchecked evaluate
@@ -0,0 +1,106 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include "column/column_helper.h"
+#include "column/nullable_column.h"
+#include "simd/simd.h"
+
+namespace starrocks {
+
+// The selections passed to Expr::evaluate_with_filter: a selection is a byte per row, 1 for the rows to be
+// evaluated, and nullptr selects all the rows.
+
+enum class BooleanSelectMode {
+    kTrue,     // the rows which are true
+    kNotTrue,  // the rows which are false or null
+    kNotFalse, // the rows which are true or null
+};
+
+// Set |selection| to the rows selected by |filter| whose values of the boolean |column| match |mode|.
+// Return the number of the rows selected.
+inline size_t select_by_boolean_column(const uint8_t* filter, const ColumnPtr& column, BooleanSelectMode mode,
+                                       Filter* selection) {
+    const size_t num_rows = column->size();
+    if (column->only_null() || column->is_constant()) {
+        bool is_null = column->only_null();
+        bool value = !is_null && ColumnHelper::get_const_value<TYPE_BOOLEAN>(column);
+        bool selected = mode == BooleanSelectMode::kTrue       ? (!is_null && value)
+                        : mode == BooleanSelectMode::kNotTrue ? (is_null || !value)
+                                                              : (is_null || value);
+        if (filter != nullptr && selected) {
+            selection->assign(filter, filter + num_rows);
+        } else {
+            selection->assign(num_rows, selected);
+        }
+    } else {
+        const uint8_t* nulls = nullptr;
+        const uint8_t* values = nullptr;
+        if (column->is_nullable()) {
+            const auto* nullable_column = ColumnHelper::as_raw_column<NullableColumn>(column);
+            nulls = nullable_column->null_column_data().data();
+            values = ColumnHelper::cast_to_raw<TYPE_BOOLEAN>(nullable_column->data_column())->get_data().data();
+        } else {
+            values = ColumnHelper::cast_to_raw<TYPE_BOOLEAN>(column)->get_data().data();
+        }
+        selection->resize(num_rows);
+        uint8_t* __restrict sel = selection->data();
+        switch (mode) {
+        case BooleanSelectMode::kTrue:
+            for (size_t i = 0; i < num_rows; i++) {
+                sel[i] = values[i] != 0;
+            }
+            if (nulls != nullptr) {
+                for (size_t i = 0; i < num_rows; i++) {
+                    sel[i] &= !nulls[i];
+                }
+            }
+            break;
+        case BooleanSelectMode::kNotTrue:
+            for (size_t i = 0; i < num_rows; i++) {
+                sel[i] = values[i] == 0;
+            }
+            if (nulls != nullptr) {
+                for (size_t i = 0; i < num_rows; i++) {
+                    sel[i] |= nulls[i];
+                }
+            }
+            break;
+        case BooleanSelectMode::kNotFalse:
+            for (size_t i = 0; i < num_rows; i++) {
+                sel[i] = values[i] != 0;
+            }
+            if (nulls != nullptr) {
+                for (size_t i = 0; i < num_rows; i++) {
+                    sel[i] |= nulls[i];
+                }
+            }
+            break;
+        }
+        if (filter != nullptr) {
+            for (size_t i = 0; i < num_rows; i++) {
+                sel[i] &= filter[i];
+            }
+        }
+    }
+    return SIMD::count_nonzero(*selection);
+}
+
+// Return the number of the rows selected by |filter| among |num_rows| rows
+inline size_t count_selected(const uint8_t* filter, size_t num_rows) {
+    return filter == nullptr ? num_rows : SIMD::count_nonzero(filter, num_rows);
+}
+
+} // namespace starrocks
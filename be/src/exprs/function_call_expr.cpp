@@ -17,10 +17,13 @@
 #include "column/chunk.h"
 #include "column/column_helper.h"
 #include "column/const_column.h"
+#include "column/json_column.h"
 #include "column/vectorized_fwd.h"
+#include "common/config.h"
 #include "exprs/anyval_util.h"
 #include "exprs/builtin_functions.h"
 #include "exprs/expr_context.h"
+#include "exprs/expr_selection.h"
 #include "gutil/strings/substitute.h"
 #include "runtime/current_thread.h"
 #include "runtime/user_function_cache.h"
@@ -59,9 +62,7 @@ Status VectorizedFunctionCallExpr::prepare(starrocks::RuntimeState* state, starr
     //  for varargs in vectorized engine?
     _fn_context_index = context->register_func(state, return_type, args_types);
 
-    _is_returning_random_value = _fn.fid == 10300 /* rand */ || _fn.fid == 10301 /* random */ ||
-                                 _fn.fid == 10302 /* rand */ || _fn.fid == 10303 /* random */ ||
-                                 _fn.fid == 100015 /* uuid */ || _fn.fid == 100016 /* uniq_id */;
+    _is_returning_random_value = is_returning_random_value();
 
     return Status::OK();
 }
@@ -118,6 +119,11 @@ void VectorizedFunctionCallExpr::close(starrocks::RuntimeState* state, starrocks
     Expr::close(state, context, scope);
 }
 
+bool VectorizedFunctionCallExpr::is_returning_random_value() const {
+    return _fn.fid == 10300 /* rand */ || _fn.fid == 10301 /* random */ || _fn.fid == 10302 /* rand */ ||
+           _fn.fid == 10303 /* random */ || _fn.fid == 100015 /* uuid */ || _fn.fid == 100016 /* uniq_id */;
+}
+
 bool VectorizedFunctionCallExpr::is_constant() const {
     if (_is_returning_random_value) {
         return false;
@@ -126,14 +132,63 @@ bool VectorizedFunctionCallExpr::is_constant() const {
     return Expr::is_constant();
 }
 
+// Return the rows of |column| at |rows|
+static ColumnPtr select_rows(const ColumnPtr& column, const Buffer<uint32_t>& rows) {
+    if (column->is_constant()) {
+        return ConstColumn::create(down_cast<const ConstColumn*>(column.get())->data_column(), rows.size());
+    }
+    ColumnPtr selected = column->clone_empty();
+    selected->append_selective(*column, rows);
+    return selected;
+}
+
+// The flat columns of a JSON column are more efficient than the selected JSON values, see JsonColumn
+static bool has_flat_json_column(const ColumnPtr& column) {
+    const auto* json_column = dynamic_cast<const JsonColumn*>(ColumnHelper::get_data_column(column.get()));
+    return json_column != nullptr && json_column->has_flat_columns();
+}
+
 StatusOr<ColumnPtr> VectorizedFunctionCallExpr::evaluate_checked(starrocks::ExprContext* context, Chunk* ptr) {
+    return evaluate_with_filter(context, ptr, nullptr);
+}
+
+StatusOr<ColumnPtr> VectorizedFunctionCallExpr::evaluate_with_filter(starrocks::ExprContext* context, Chunk* ptr,
+                                                                     uint8_t* filter) {
     FunctionContext* fn_ctx = context->fn_context(_fn_context_index);
 
+    // Evaluate the function only on the rows selected if they are few enough, which saves the cost of the
+    // expensive functions, e.g. regexp and JSON functions, on the rows which are not needed.
+    bool evaluate_selected = false;
+    if (filter != nullptr && ptr != nullptr && !_children.empty() && !_is_returning_random_value) {
+        size_t num_selected = count_selected(filter, ptr->num_rows());
+        if (num_selected == 0) {
+            return ColumnHelper::create_const_null_column(ptr->num_rows());
+        }
+        evaluate_selected = num_selected <= ptr->num_rows() * config::expr_selective_evaluation_ratio;
+    }
+
     Columns args;
     args.reserve(_children.size());
     for (Expr* child : _children) {
-        ColumnPtr column = EVALUATE_NULL_IF_ERROR(context, child, ptr);
-        args.emplace_back(column);
+        auto status_or_column = context->evaluate(child, ptr, filter);
+        if (status_or_column.ok()) {
+            args.emplace_back(std::move(status_or_column).value());
+        } else {
+            args.emplace_back(ColumnHelper::create_const_null_column(ptr == nullptr ? 1 : ptr->num_rows()));
+        }
+        evaluate_selected &= !has_flat_json_column(args.back());
+    }
+
+    Buffer<uint32_t> selected_rows;
+    if (evaluate_selected) {
+        for (uint32_t i = 0; i < ptr->num_rows(); i++) {
+            if (filter[i]) {
+                selected_rows.emplace_back(i);
+            }
+        }
+        for (auto& arg : args) {
+            arg = select_rows(arg, selected_rows);
+        }
     }
 
     if (_is_returning_random_value) {
@@ -146,7 +201,7 @@ StatusOr<ColumnPtr> VectorizedFunctionCallExpr::evaluate_checked(starrocks::Expr
 
 #ifndef NDEBUG
     if (ptr != nullptr) {
-        size_t size = ptr->num_rows();
+        size_t size = evaluate_selected ? selected_rows.size() : ptr->num_rows();
         // Ensure all columns have the same size
         for (const ColumnPtr& c : args) {
             CHECK_EQ(size, c->size());
@@ -163,6 +218,20 @@ StatusOr<ColumnPtr> VectorizedFunctionCallExpr::evaluate_checked(starrocks::Expr
     }
     RETURN_IF_ERROR(result);
 
+    if (evaluate_selected && !result.value()->is_constant()) {
+        // expand the results to all the rows, the rows not selected take the result of any selected row
+        Buffer<uint32_t> indexes(ptr->num_rows());
+        uint32_t index = 0;
+        const auto max_index = static_cast<uint32_t>(selected_rows.size() - 1);
+        for (uint32_t i = 0; i < ptr->num_rows(); i++) {
+            indexes[i] = std::min(index, max_index);
+            index += filter[i] != 0;
+        }
+        ColumnPtr expanded = result.value()->clone_empty();
+        expanded->append_selective(*result.value(), indexes);
+        result = std::move(expanded);
+    }
+
     // For no args function call (pi, e)
     if (result.value()->is_constant() && ptr != nullptr) {
         result.value()->resize(ptr->num_rows());
@@ -28,6 +28,9 @@ public:
 
     Expr* clone(ObjectPool* pool) const override { return pool->add(new VectorizedFunctionCallExpr(*this)); }
 
+    // Whether the function returns different values for the same arguments, e.g. rand() and uuid()
+    bool is_returning_random_value() const;
+
 protected:
     Status prepare(RuntimeState* state, ExprContext* context) override;
 
@@ -39,6 +42,8 @@ protected:
 
     StatusOr<ColumnPtr> evaluate_checked(ExprContext* context, Chunk* ptr) override;
 
+    StatusOr<ColumnPtr> evaluate_with_filter(ExprContext* context, Chunk* ptr, uint8_t* filter) override;
+
 private:
     const FunctionDescriptor* _fn_desc;
 
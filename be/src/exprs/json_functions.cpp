@@ -22,10 +22,14 @@
 #include "column/column_builder.h"
 #include "column/column_helper.h"
 #include "column/column_viewer.h"
+#include "column/json_column.h"
+#include "column/nullable_column.h"
+#include "column/type_traits.h"
 #include "common/status.h"
 #include "exprs/function_context.h"
 #include "exprs/jsonpath.h"
 #include "glog/logging.h"
+#include "gutil/casts.h"
 #include "gutil/strings/escaping.h"
 #include "gutil/strings/substitute.h"
 #include "util/json.h"
@@ -453,8 +457,90 @@ static Status _convert_json_slice(const vpack::Slice& slice, ColumnBuilder<Resul
     return Status::OK();
 }
 
+// Return the key if |path| selects a top-level key of the JSON values like `$.a`, or nullptr otherwise
+static const std::string* top_level_key_of(const JsonPath& path) {
+    // the first piece is the root, and ignored when extracting
+    if (path.paths.size() != 2) {
+        return nullptr;
+    }
+    const JsonPathPiece& piece = path.paths[1];
+    if (piece.key.empty() || piece.key == "$" || piece.array_selector->type != NONE) {
+        return nullptr;
+    }
+    return &piece.key;
+}
+
+// Convert the values of a flat column of |FlatType| to |ResultType| the same way as `_convert_json_slice`
+// converts the JSON values, return nullptr if they would not be converted the same way.
+template <LogicalType FlatType, LogicalType ResultType>
+static ColumnPtr _convert_flat_column(const Column& json_column, const NullableColumn& flat_column) {
+    constexpr bool supported = ResultType == TYPE_JSON || (ResultType == TYPE_INT && FlatType == TYPE_BIGINT) ||
+                               (ResultType == TYPE_DOUBLE && FlatType != TYPE_VARCHAR) ||
+                               (ResultType == TYPE_VARCHAR && FlatType == TYPE_VARCHAR);
+    if constexpr (!supported) {
+        return nullptr;
+    } else {
+        size_t num_rows = json_column.size();
+        const auto& values = down_cast<const RunTimeColumnType<FlatType>*>(flat_column.data_column().get())->get_data();
+        const auto& nulls = flat_column.null_column()->get_data();
+        const NullColumn* json_nulls = nullptr;
+        if (json_column.is_nullable()) {
+            json_nulls = down_cast<const NullableColumn&>(json_column).null_column().get();
+        }
+        ColumnBuilder<ResultType> result(num_rows);
+        for (size_t row = 0; row < num_rows; ++row) {
+            if (nulls[row] || (json_nulls != nullptr && json_nulls->get_data()[row])) {
+                result.append_null();
+            } else if constexpr (ResultType != TYPE_JSON) {
+                result.append(static_cast<RunTimeCppType<ResultType>>(values[row]));
+            } else if constexpr (FlatType == TYPE_BIGINT) {
+                result.append(JsonValue::from_int(values[row]));
+            } else if constexpr (FlatType == TYPE_DOUBLE) {
+                result.append(JsonValue::from_double(values[row]));
+            } else {
+                result.append(JsonValue::from_string(values[row]));
+            }
+        }
+        return result.build(false);
+    }
+}
+
+// Extract a top-level key from the flat column read along with the JSON values, which avoids parsing them.
+// Return nullptr if there is no such flat column.
+template <LogicalType ResultType>
+static ColumnPtr _json_query_flat_column(const JsonPath& path, const ColumnPtr& json_column) {
+    const std::string* key = top_level_key_of(path);
+    if (key == nullptr || json_column->is_constant()) {
+        return nullptr;
+    }
+    const auto* json_data = down_cast<const JsonColumn*>(ColumnHelper::get_data_column(json_column.get()));
+    LogicalType flat_type;
+    ColumnPtr flat_column = json_data->get_flat_column(*key, &flat_type);
+    if (flat_column == nullptr) {
+        return nullptr;
+    }
+    const auto& flat_nullable = down_cast<const NullableColumn&>(*flat_column);
+    switch (flat_type) {
+    case TYPE_BIGINT:
+        return _convert_flat_column<TYPE_BIGINT, ResultType>(*json_column, flat_nullable);
+    case TYPE_DOUBLE:
+        return _convert_flat_column<TYPE_DOUBLE, ResultType>(*json_column, flat_nullable);
+    case TYPE_VARCHAR:
+        return _convert_flat_column<TYPE_VARCHAR, ResultType>(*json_column, flat_nullable);
+    default:
+        return nullptr;
+    }
+}
+
 template <LogicalType ResultType>
 StatusOr<ColumnPtr> JsonFunctions::_json_query_impl(FunctionContext* context, const Columns& columns) {
+    auto* prepared_path = reinterpret_cast<JsonPath*>(context->get_function_state(FunctionContext::FRAGMENT_LOCAL));
+    if (prepared_path != nullptr) {
+        if (auto result = _json_query_flat_column<ResultType>(*prepared_path, columns[0]); result != nullptr) {
+            return result;
+        }
+    }
+
     auto num_rows = columns[0]->size();
     auto json_viewer = ColumnViewer<TYPE_JSON>(columns[0]);
     auto path_viewer = ColumnViewer<TYPE_VARCHAR>(columns[1]);
@@ -27,7 +27,9 @@
 #include "column/column_viewer.h"
 #include "column/nullable_column.h"
 #include "common/compiler_util.h"
+#include "common/config.h"
 #include "common/constexpr.h"
+#include "common/logging.h"
 #include "common/status.h"
 #include "exprs/binary_function.h"
 #include "exprs/math_functions.h"
@@ -1559,12 +1561,35 @@ StatusOr<ColumnPtr> StringFunctions::length(FunctionContext* context, const Colu
     return VectorizedStrictUnaryFunction<lengthImpl>::evaluate<TYPE_VARCHAR, TYPE_INT>(columns[0]);
 }
 
-DEFINE_UNARY_FN_WITH_IMPL(utf8LengthImpl, str) {
-    return utf8_len(str.data, str.data + str.size);
-}
+struct Utf8LengthFunction {
+    template <LogicalType Type, LogicalType ResultType>
+    static inline ColumnPtr evaluate(const ColumnPtr& column) {
+        auto* src = down_cast<BinaryColumn*>(column.get());
+        const auto& src_bytes = src->get_bytes();
+        const auto& src_offsets = src->get_offset();
+        const auto num_rows = src->size();
+
+        auto result = RunTimeColumnType<TYPE_INT>::create();
+        result->resize(num_rows);
+        auto* lengths = result->get_data().data();
+        // the length of an ascii string is its size, so the whole bytes are checked at once, and only the strings
+        // of a column with non-ascii chars are counted one by one.
+        if (validate_ascii_fast((const char*)src_bytes.data(), src_bytes.size())) {
+            for (size_t i = 0; i < num_rows; ++i) {
+                lengths[i] = src_offsets[i + 1] - src_offsets[i];
+            }
+        } else {
+            const char* data = (const char*)src_bytes.data();
+            for (size_t i = 0; i < num_rows; ++i) {
+                lengths[i] = utf8_len(data + src_offsets[i], data + src_offsets[i + 1]);
+            }
+        }
+        return result;
+    }
+};
 
 StatusOr<ColumnPtr> StringFunctions::utf8_length(FunctionContext* context, const starrocks::Columns& columns) {
-    return VectorizedStrictUnaryFunction<utf8LengthImpl>::evaluate<TYPE_VARCHAR, TYPE_INT>(columns[0]);
+    return VectorizedUnaryFunction<Utf8LengthFunction>::evaluate<TYPE_VARCHAR, TYPE_INT>(columns[0]);
 }
 
 template <char CA, char CZ>
@@ -1581,6 +1606,20 @@ static inline void vectorized_toggle_case(const Bytes* src, Bytes* dst) {
     char* begin = (char*)(src->data());
     char* end = (char*)(begin + size);
     char* src_ptr = begin;
+#if defined(__AVX2__)
+    static constexpr int AVX2_BYTES = sizeof(__m256i);
+    const char* avx2_end = begin + (size & ~(AVX2_BYTES - 1));
+    const auto avx2_a_minus1 = _mm256_set1_epi8(CA - 1);
+    const auto avx2_z_plus1 = _mm256_set1_epi8(CZ + 1);
+    const auto avx2_flips = _mm256_set1_epi8(32);
+
+    for (; src_ptr < avx2_end; src_ptr += AVX2_BYTES, dst_ptr += AVX2_BYTES) {
+        auto bytes = _mm256_loadu_si256((const __m256i*)src_ptr);
+        auto masks = _mm256_and_si256(_mm256_cmpgt_epi8(bytes, avx2_a_minus1),
+                                      _mm256_cmpgt_epi8(avx2_z_plus1, bytes));
+        _mm256_storeu_si256((__m256i*)dst_ptr, _mm256_xor_si256(bytes, _mm256_and_si256(masks, avx2_flips)));
+    }
+#endif
 #if defined(__SSE2__)
     static constexpr int SSE2_BYTES = sizeof(__m128i);
     const char* sse2_end = begin + (size & ~(SSE2_BYTES - 1));
@@ -1588,7 +1627,7 @@ static inline void vectorized_toggle_case(const Bytes* src, Bytes* dst) {
     const auto z_plus1 = _mm_set1_epi8(CZ + 1);
     const auto flips = _mm_set1_epi8(32);
 
-    for (; src_ptr > sse2_end; src_ptr += SSE2_BYTES, dst_ptr += SSE2_BYTES) {
+    for (; src_ptr < sse2_end; src_ptr += SSE2_BYTES, dst_ptr += SSE2_BYTES) {
         auto bytes = _mm_loadu_si128((const __m128i*)src_ptr);
         // the i-th byte of masks is set to 0xff if the corresponding byte is
         // between a..z when computing upper function (A..Z when computing lower function),
@@ -2514,6 +2553,63 @@ int StringFunctions::index_of(const char* source, int source_count, const char*
     return -1;
 }
 
+// The Hyperscan database compiled from a constant regex in the prefilter mode, which matches a superset of the
+// strings matching the regex, so that RE2 only runs on the rows which may match. It's compiled once per fragment
+// and shared by all the drivers.
+struct RegexpPrefilterState {
+    hs_database_t* database = nullptr;
+    // the scratch space cloned by each scan, since the prefilter may be used by multiple threads at the same time
+    hs_scratch_t* scratch = nullptr;
+
+    ~RegexpPrefilterState() {
+        if (scratch != nullptr) {
+            hs_free_scratch(scratch);
+        }
+        if (database != nullptr) {
+            hs_free_database(database);
+        }
+    }
+};
+
+class RegexpPrefilterScanner {
+public:
+    explicit RegexpPrefilterScanner(const RegexpPrefilterState* prefilter) {
+        if (prefilter != nullptr && hs_clone_scratch(prefilter->scratch, &_scratch) == HS_SUCCESS) {
+            _database = prefilter->database;
+        }
+    }
+
+    ~RegexpPrefilterScanner() {
+        if (_scratch != nullptr) {
+            hs_free_scratch(_scratch);
+        }
+    }
+
+    // Return false if |str| can't match the regex
+    bool may_match(const Slice& str) {
+        if (_database == nullptr) {
+            return true;
+        }
+        bool matched = false;
+        // Use &_DUMMY_STRING_FOR_EMPTY_PATTERN instead of nullptr to avoid crash.
+        const char* data = str.size > 0 ? str.data : &StringFunctions::_DUMMY_STRING_FOR_EMPTY_PATTERN;
+        auto status = hs_scan(
+                _database, data, str.size, 0, _scratch,
+                [](unsigned int id, unsigned long long from, unsigned long long to, unsigned int flags,
+                   void* ctx) -> int {
+                    *((bool*)ctx) = true;
+                    return 1;
+                },
+                &matched);
+        DCHECK(status == HS_SUCCESS || status == HS_SCAN_TERMINATED) << " status: " << status;
+        return matched || (status != HS_SUCCESS && status != HS_SCAN_TERMINATED);
+    }
+
+private:
+    hs_database_t* _database = nullptr;
+    hs_scratch_t* _scratch = nullptr;
+};
+
 struct StringFunctionsState {
     using DriverMap = phmap::parallel_flat_hash_map<int32_t, std::unique_ptr<re2::RE2>, phmap::Hash<int32_t>,
                                                     phmap::EqualTo<int32_t>, phmap::Allocator<int32_t>,
@@ -2536,6 +2632,9 @@ struct StringFunctionsState {
     // one scratch space per thread, or concurrent caller, is required
     hs_scratch_t* scratch = nullptr;
 
+    // the prefilter of the constant regex shared by the fragment, nullptr if there isn't any
+    const RegexpPrefilterState* prefilter = nullptr;
+
     StringFunctionsState() : regex(), options() {}
 
     // Implement a driver-local regex, to avoid lock contention on the RE2::cache_mutex
@@ -2591,13 +2690,47 @@ Status StringFunctions::hs_compile_and_alloc_scratch(const std::string& pattern,
     return Status::OK();
 }
 
+// Compile the prefilter of the constant regex for the fragment, RE2 is used on all the rows if it can't be compiled
+static void regexp_prefilter_prepare(FunctionContext* context) {
+    if (!config::enable_regexp_hyperscan_prefilter || !context->is_notnull_constant_column(1)) {
+        return;
+    }
+    auto column = context->get_constant_column(1);
+    std::string pattern = ColumnHelper::get_const_value<TYPE_VARCHAR>(column).to_string();
+    // hs_compile takes a null-terminated pattern
+    if (pattern.empty() || pattern.find('\0') != std::string::npos) {
+        return;
+    }
+
+    auto state = std::make_unique<RegexpPrefilterState>();
+    hs_compile_error_t* compile_err = nullptr;
+    if (hs_compile(pattern.c_str(),
+                   HS_FLAG_PREFILTER | HS_FLAG_ALLOWEMPTY | HS_FLAG_DOTALL | HS_FLAG_UTF8 | HS_FLAG_SINGLEMATCH,
+                   HS_MODE_BLOCK, nullptr, &state->database, &compile_err) != HS_SUCCESS) {
+        VLOG(2) << "Unable to compile the prefilter of regex: " << pattern << ": " << compile_err->message;
+        hs_free_compile_error(compile_err);
+        return;
+    }
+    if (hs_alloc_scratch(state->database, &state->scratch) != HS_SUCCESS) {
+        VLOG(2) << "Unable to allocate the scratch space of the prefilter of regex: " << pattern;
+        return;
+    }
+    context->set_function_state(FunctionContext::FRAGMENT_LOCAL, state.release());
+}
+
 Status StringFunctions::regexp_extract_prepare(FunctionContext* context, FunctionContext::FunctionStateScope scope) {
+    if (scope == FunctionContext::FRAGMENT_LOCAL) {
+        regexp_prefilter_prepare(context);
+        return Status::OK();
+    }
     if (scope != FunctionContext::THREAD_LOCAL) {
         return Status::OK();
     }
 
     auto* state = new StringFunctionsState();
     context->set_function_state(scope, state);
+    state->prefilter = reinterpret_cast<RegexpPrefilterState*>(
+            context->get_function_state(FunctionContext::FRAGMENT_LOCAL));
 
     state->options = std::make_unique<re2::RE2::Options>();
     state->options->set_log_errors(false);
@@ -2626,12 +2759,18 @@ Status StringFunctions::regexp_extract_prepare(FunctionContext* context, Functio
 }
 
 Status StringFunctions::regexp_replace_prepare(FunctionContext* context, FunctionContext::FunctionStateScope scope) {
+    if (scope == FunctionContext::FRAGMENT_LOCAL) {
+        regexp_prefilter_prepare(context);
+        return Status::OK();
+    }
     if (scope != FunctionContext::THREAD_LOCAL) {
         return Status::OK();
     }
 
     auto* state = new StringFunctionsState();
     context->set_function_state(scope, state);
+    state->prefilter = reinterpret_cast<RegexpPrefilterState*>(
+            context->get_function_state(FunctionContext::FRAGMENT_LOCAL));
 
     state->options = std::make_unique<re2::RE2::Options>();
     state->options->set_log_errors(false);
@@ -2675,6 +2814,10 @@ Status StringFunctions::regexp_close(FunctionContext* context, FunctionContext::
         auto* state =
                 reinterpret_cast<StringFunctionsState*>(context->get_function_state(FunctionContext::THREAD_LOCAL));
         delete state;
+    } else if (scope == FunctionContext::FRAGMENT_LOCAL) {
+        auto* state =
+                reinterpret_cast<RegexpPrefilterState*>(context->get_function_state(FunctionContext::FRAGMENT_LOCAL));
+        delete state;
     }
     return Status::OK();
 }
@@ -2728,9 +2871,11 @@ static ColumnPtr regexp_extract_general(FunctionContext* context, re2::RE2::Opti
     return result.build(ColumnHelper::is_all_const(columns));
 }
 
-static ColumnPtr regexp_extract_const(re2::RE2* const_re, const Columns& columns) {
+static ColumnPtr regexp_extract_const(re2::RE2* const_re, const RegexpPrefilterState* prefilter,
+                                      const Columns& columns) {
     auto content_viewer = ColumnViewer<TYPE_VARCHAR>(columns[0]);
     auto field_viewer = ColumnViewer<TYPE_BIGINT>(columns[2]);
+    RegexpPrefilterScanner prefilter_scanner(prefilter);
 
     auto size = columns[0]->size();
     ColumnBuilder<TYPE_VARCHAR> result(size);
@@ -2753,6 +2898,10 @@ static ColumnPtr regexp_extract_const(re2::RE2* const_re, const Columns& columns
         }
 
         auto str_value = content_viewer.value(row);
+        if (!prefilter_scanner.may_match(str_value)) {
+            result.append(Slice("", 0));
+            continue;
+        }
         re2::StringPiece str_sp(str_value.get_data(), str_value.get_size());
         std::vector<re2::StringPiece> matches(max_matches);
         bool success = const_re->Match(str_sp, 0, str_value.get_size(), re2::RE2::UNANCHORED, &matches[0], max_matches);
@@ -2773,7 +2922,7 @@ StatusOr<ColumnPtr> StringFunctions::regexp_extract(FunctionContext* context, co
 
     if (state->const_pattern) {
         re2::RE2* const_re = state->get_or_prepare_regex();
-        return regexp_extract_const(const_re, columns);
+        return regexp_extract_const(const_re, state->prefilter, columns);
     }
 
     re2::RE2::Options* options = state->options.get();
@@ -2812,9 +2961,11 @@ static ColumnPtr regexp_replace_general(FunctionContext* context, re2::RE2::Opti
     return result.build(ColumnHelper::is_all_const(columns));
 }
 
-static ColumnPtr regexp_replace_const(re2::RE2* const_re, const Columns& columns) {
+static ColumnPtr regexp_replace_const(re2::RE2* const_re, const RegexpPrefilterState* prefilter,
+                                      const Columns& columns) {
     auto str_viewer = ColumnViewer<TYPE_VARCHAR>(columns[0]);
     auto rpl_viewer = ColumnViewer<TYPE_VARCHAR>(columns[2]);
+    RegexpPrefilterScanner prefilter_scanner(prefilter);
 
     auto size = columns[0]->size();
     ColumnBuilder<TYPE_VARCHAR> result(size);
@@ -2825,9 +2976,14 @@ static ColumnPtr regexp_replace_const(re2::RE2* const_re, const Columns& columns
             continue;
         }
 
+        auto str_value = str_viewer.value(row);
+        if (!prefilter_scanner.may_match(str_value)) {
+            // nothing to replace
+            result.append(str_value);
+            continue;
+        }
         auto rpl_value = rpl_viewer.value(row);
         re2::StringPiece rpl_str = re2::StringPiece(rpl_value.get_data(), rpl_value.get_size());
-        auto str_value = str_viewer.value(row);
         re2::StringPiece str_str = re2::StringPiece(str_value.get_data(), str_value.get_size());
         result_str.clear();
         re2::RE2::GlobalReplace(str_str, *const_re, rpl_str, result_str);
@@ -2912,7 +3068,7 @@ StatusOr<ColumnPtr> StringFunctions::regexp_replace(FunctionContext* context, co
             return regexp_replace_use_hyperscan(state, columns);
         } else {
             re2::RE2* const_re = state->get_or_prepare_regex();
-            return regexp_replace_const(const_re, columns);
+            return regexp_replace_const(const_re, state->prefilter, columns);
         }
     }
 
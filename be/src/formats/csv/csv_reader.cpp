@@ -16,6 +16,8 @@
 
 #include <unordered_set>
 
+#include "formats/csv/csv_structural_index.h"
+
 namespace starrocks {
 
 using Field = Slice;
@@ -170,6 +172,14 @@ Status CSVReader::more_rows() {
     }
     _escape_data.clear();
     _escape_pos.clear();
+    if (_enable_simd_tokenizer && _row_delimiter_length == 1 && _column_delimiter_length == 1) {
+        size_t num_rows = 0;
+        RETURN_IF_ERROR(_tokenize_rows(&num_rows));
+        if (num_rows > 0) {
+            return Status::OK();
+        }
+        // No complete row in the buffer, let the state machine read more data.
+    }
     ParseState curState = START;
     ParseState preState = curState;
     // parsed_start and parsed_end record a row at the start and end of the buff.
@@ -506,6 +516,210 @@ Status CSVReader::more_rows() {
     }
 }
 
+void CSVReader::_push_column(const char* data, size_t column_start, size_t column_end, size_t delimiter_length,
+                             bool is_enclose_column) {
+    bool is_escape_column = false;
+    // The column has an escape and needs to be stripped of the escape character and copied to a separate storage space.
+    if (UNLIKELY(!_column_escape_pos.empty())) {
+        is_escape_column = true;
+        size_t new_column_start = _escape_data.size();
+        size_t from = column_start;
+        for (size_t pos : _column_escape_pos) {
+            _escape_data.insert(_escape_data.end(), data + from, data + pos);
+            from = pos + 1;
+        }
+        _escape_data.insert(_escape_data.end(), data + from, data + column_end);
+        _column_escape_pos.clear();
+        column_start = new_column_start;
+        column_end = _escape_data.size();
+        data = _escape_data.data();
+    }
+    // Remove the delimiter, and the last enclose character of an enclosed column.
+    size_t length = column_end - delimiter_length - column_start - is_enclose_column;
+    if (UNLIKELY(_parse_options.trim_space) && length > 0) {
+        std::pair<const char*, size_t> newPos = trim(data + column_start, length);
+        _columns.emplace_back(newPos.first - data, newPos.second, is_escape_column);
+    } else {
+        _columns.emplace_back(column_start, length, is_escape_column);
+    }
+}
+
+// Unlike the state machine of `more_rows`, which inspects the buffer byte by byte, `_tokenize_rows` asks the
+// structural index for the next delimiter, enclose or escape character, and skips all the bytes before it at
+// once. The state transitions on the structural characters are exactly the same as `more_rows`.
+Status CSVReader::_tokenize_rows(size_t* num_rows) {
+    const char row_delimiter = _parse_options.row_delimiter[0];
+    const char column_delimiter = _parse_options.column_delimiter[0];
+    const char escape = _parse_options.escape;
+    const char enclose = _parse_options.enclose;
+    const bool trim_space = _parse_options.trim_space;
+    const char* data = _buff.base_ptr();
+    const size_t end = _buff.limit_offset();
+    CSVStructuralIndex index(data, _buff.position_offset(), end, {row_delimiter, column_delimiter, escape, enclose});
+
+    *num_rows = 0;
+    size_t pos = _buff.position_offset();
+    while (true) {
+        const size_t row_start = pos;
+        ParseState state = START;
+        ParseState pre_state = START;
+        size_t column_start = pos;
+        bool is_enclose_column = false;
+        bool row_end = false;
+        _columns.clear();
+        _column_escape_pos.clear();
+
+// We do not get the complete row, leave it to the state machine.
+#define RETURN_IF_REACH_END()    \
+    if (UNLIKELY(pos >= end)) {  \
+        _columns.clear();        \
+        return Status::OK();     \
+    }
+
+        while (!row_end) {
+            switch (state) {
+            case START: {
+                if (UNLIKELY(trim_space)) {
+                    while (pos < end && data[pos] == ' ') {
+                        pos++;
+                    }
+                }
+                RETURN_IF_REACH_END()
+                column_start = pos;
+                const char c = data[pos];
+                if (UNLIKELY(c == row_delimiter)) {
+                    pos++;
+                    row_end = true;
+                } else if (UNLIKELY(c == column_delimiter)) {
+                    pos++;
+                    _push_column(data, column_start, pos, 1, is_enclose_column);
+                    is_enclose_column = false;
+                } else if (UNLIKELY(c == escape)) {
+                    pre_state = ORDINARY;
+                    state = ESCAPE;
+                    _column_escape_pos.push_back(pos);
+                    pos++;
+                } else if (UNLIKELY(c == enclose)) {
+                    pos++;
+                    RETURN_IF_REACH_END()
+                    column_start = pos;
+                    if (data[pos] != enclose) {
+                        state = ENCLOSE;
+                        is_enclose_column = true;
+                        break;
+                    }
+                    // ""something
+                    // We need to determine whether the column is empty or escaped.
+                    pos++;
+                    RETURN_IF_REACH_END()
+                    if (data[pos] == row_delimiter) {
+                        pos++;
+                        is_enclose_column = true;
+                        row_end = true;
+                    } else if (data[pos] == column_delimiter) {
+                        pos++;
+                        _push_column(data, column_start, pos, 1, true);
+                        is_enclose_column = false;
+                    } else {
+                        state = ORDINARY;
+                    }
+                } else {
+                    state = ORDINARY;
+                    pos++;
+                }
+                break;
+            }
+            case ORDINARY: {
+                pos = index.next(pos);
+                RETURN_IF_REACH_END()
+                const char c = data[pos];
+                if (c == row_delimiter) {
+                    pos++;
+                    row_end = true;
+                } else if (c == column_delimiter) {
+                    pos++;
+                    _push_column(data, column_start, pos, 1, is_enclose_column);
+                    is_enclose_column = false;
+                    state = START;
+                } else if (c == escape) {
+                    pre_state = ORDINARY;
+                    state = ESCAPE;
+                    _column_escape_pos.push_back(pos);
+                    pos++;
+                } else {
+                    DCHECK_EQ(enclose, c);
+                    pre_state = ORDINARY;
+                    state = ENCLOSE_ESCAPE;
+                    _column_escape_pos.push_back(pos);
+                    pos++;
+                }
+                break;
+            }
+            case ENCLOSE: {
+                pos = index.next(pos);
+                RETURN_IF_REACH_END()
+                const char c = data[pos];
+                if (c == enclose) {
+                    pos++;
+                    RETURN_IF_REACH_END()
+                    if (data[pos] == enclose) {
+                        pre_state = ENCLOSE;
+                        state = ENCLOSE_ESCAPE;
+                        _column_escape_pos.push_back(pos - 1);
+                    } else {
+                        state = ORDINARY;
+                    }
+                } else if (c == escape) {
+                    pre_state = ENCLOSE;
+                    state = ESCAPE;
+                    _column_escape_pos.push_back(pos);
+                    pos++;
+                } else {
+                    // delimiters in an enclosed column
+                    pos++;
+                }
+                break;
+            }
+            case ENCLOSE_ESCAPE:
+                RETURN_IF_REACH_END()
+                state = pre_state;
+                pos++;
+                break;
+            case ESCAPE: {
+                RETURN_IF_REACH_END()
+                const char c = data[pos];
+                if (c == enclose || c == escape || c == row_delimiter || c == column_delimiter) {
+                    state = pre_state;
+                } else {
+                    state = ORDINARY;
+                }
+                pos++;
+                break;
+            }
+            default:
+                return Status::NotSupported("Not supported state when csv parsing");
+            }
+        }
+#undef RETURN_IF_REACH_END
+
+        _parsed_bytes += pos - row_start;
+        _buff.set_position_offset(pos);
+        // For empty row, skip it.
+        if (UNLIKELY(_columns.empty() && pos - 1 - column_start == 0)) {
+            continue;
+        }
+        _push_column(data, column_start, pos, 1, is_enclose_column);
+        CSVRow& row = _csv_buff.emplace();
+        row.columns = _columns;
+        row.parsed_start = row_start;
+        row.parsed_end = pos;
+        (*num_rows)++;
+        if (UNLIKELY(_limit > 0 && _parsed_bytes > _limit)) {
+            return Status::EndOfFile("Reached limit");
+        }
+    }
+}
+
 Status CSVReader::next_record(CSVRow& row) {
     row.columns.clear();
     if (_csv_buff.empty()) {
@@ -517,11 +731,8 @@ Status CSVReader::next_record(CSVRow& row) {
     if (UNLIKELY(_csv_buff.empty())) {
         return Status::EndOfFile("Reached limit");
     }
-    const CSVRow newRow = _csv_buff.front();
+    row = std::move(_csv_buff.front());
     _csv_buff.pop();
-    row.columns = newRow.columns;
-    row.parsed_start = newRow.parsed_start;
-    row.parsed_end = newRow.parsed_end;
 
     return Status::OK();
 }
@@ -585,17 +796,18 @@ void CSVReader::split_record(const Record& record, Fields* columns) const {
     const size_t size = record.size;
 
     if (_column_delimiter_length == 1) {
-        for (size_t i = 0; i < size; ++i, ++ptr) {
-            if (*ptr == _parse_options.column_delimiter[0]) {
-                if (_parse_options.trim_space) {
-                    std::pair<const char*, size_t> newPos = trim(value, ptr - value);
-                    columns->emplace_back(newPos.first, newPos.second);
-                } else {
-                    columns->emplace_back(value, ptr - value);
-                }
-                value = ptr + 1;
+        const std::array<char, 1> delimiter{_parse_options.column_delimiter[0]};
+        for_each_structural_char(record.data, size, delimiter, [&](size_t i) {
+            ptr = record.data + i;
+            if (_parse_options.trim_space) {
+                std::pair<const char*, size_t> newPos = trim(value, ptr - value);
+                columns->emplace_back(newPos.first, newPos.second);
+            } else {
+                columns->emplace_back(value, ptr - value);
             }
-        }
+            value = ptr + 1;
+        });
+        ptr = record.data + size;
     } else {
         const auto* const base = ptr;
 
@@ -199,6 +199,10 @@ public:
     // For benchmark, we need to separate io from parsing.
     Status init_buff() { return _fill_buffer(); }
 
+    // Whether to parse rows with the SIMD structural index when both delimiters are single bytes,
+    // otherwise the rows are always parsed by the byte-by-byte state machine.
+    void set_enable_simd_tokenizer(bool enable) { _enable_simd_tokenizer = enable; }
+
 protected:
     CSVParseOptions _parse_options;
     size_t _row_delimiter_length;
@@ -215,8 +219,18 @@ private:
     Status _expand_buffer();
     Status _expand_buffer_loosely();
 
+    // Parse all the complete rows in the buffer into `_csv_buff` with the structural index, set |num_rows|
+    // to the number of rows parsed. The rows are parsed with the same semantics as the state machine of
+    // `more_rows`, and the incomplete row at the end of the buffer is left to it.
+    Status _tokenize_rows(size_t* num_rows);
+    void _push_column(const char* data, size_t column_start, size_t column_end, size_t delimiter_length,
+                      bool is_enclose_column);
+
     size_t _parsed_bytes = 0;
     size_t _limit = 0;
+    bool _enable_simd_tokenizer = true;
+    // positions of the escape characters of the column being parsed by `_tokenize_rows`, ascending.
+    std::vector<size_t> _column_escape_pos;
 };
 
 } // namespace starrocks
@@ -0,0 +1,135 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#ifdef __AVX2__
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace starrocks {
+
+// Call |visitor| with the offset of every byte in [data, data + size) which is equal to one of |chars|,
+// in ascending order.
+// The bytes are classified 32 (AVX2) or 16 (SSE2) at a time, so the cost is mostly independent of the
+// number of bytes between two matches.
+template <size_t N, typename Visitor>
+inline void for_each_structural_char(const char* data, size_t size, const std::array<char, N>& chars,
+                                     Visitor&& visitor) {
+    size_t i = 0;
+#ifdef __AVX2__
+    __m256i patterns[N];
+    for (size_t k = 0; k < N; k++) {
+        patterns[k] = _mm256_set1_epi8(chars[k]);
+    }
+    for (; i + 32 <= size; i += 32) {
+        __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+        __m256i matched = _mm256_cmpeq_epi8(block, patterns[0]);
+        for (size_t k = 1; k < N; k++) {
+            matched = _mm256_or_si256(matched, _mm256_cmpeq_epi8(block, patterns[k]));
+        }
+        auto mask = static_cast<uint32_t>(_mm256_movemask_epi8(matched));
+        while (mask != 0) {
+            visitor(i + __builtin_ctz(mask));
+            mask &= mask - 1;
+        }
+    }
+#elif defined(__SSE2__)
+    __m128i patterns[N];
+    for (size_t k = 0; k < N; k++) {
+        patterns[k] = _mm_set1_epi8(chars[k]);
+    }
+    for (; i + 16 <= size; i += 16) {
+        __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        __m128i matched = _mm_cmpeq_epi8(block, patterns[0]);
+        for (size_t k = 1; k < N; k++) {
+            matched = _mm_or_si128(matched, _mm_cmpeq_epi8(block, patterns[k]));
+        }
+        auto mask = static_cast<uint32_t>(_mm_movemask_epi8(matched));
+        while (mask != 0) {
+            visitor(i + __builtin_ctz(mask));
+            mask &= mask - 1;
+        }
+    }
+#endif
+    for (; i < size; i++) {
+        for (size_t k = 0; k < N; k++) {
+            if (data[i] == chars[k]) {
+                visitor(i);
+                break;
+            }
+        }
+    }
+}
+
+// CSVStructuralIndex lists the positions of the structural characters (delimiters, enclose and escape)
+// of a buffer, so that a parser can jump from one structural character to the next one instead of
+// inspecting every byte.
+// The buffer is indexed lazily window by window, to bound the memory used by the index and to avoid
+// indexing the bytes after the last complete row.
+class CSVStructuralIndex {
+public:
+    static constexpr size_t kWindowSize = 64 * 1024;
+
+    // |data| is the base of the buffer, the positions are offsets from it. Only [begin, end) is indexed.
+    CSVStructuralIndex(const char* data, size_t begin, size_t end, const std::array<char, 4>& chars)
+            : _data(data), _end(end), _indexed_end(begin), _chars(chars) {}
+
+    // Return the position of the first structural character at or after |pos|, or the end of the
+    // buffer if there is none. |pos| must not be less than the one of the previous call.
+    size_t next(size_t pos) {
+        if (pos >= _end) {
+            return _end;
+        }
+        while (true) {
+            while (_cursor < _positions.size() && _positions[_cursor] < pos) {
+                _cursor++;
+            }
+            if (_cursor < _positions.size()) {
+                return _positions[_cursor];
+            }
+            if (_indexed_end >= _end) {
+                return _end;
+            }
+            _index_next_window(std::max(pos, _indexed_end));
+        }
+    }
+
+private:
+    void _index_next_window(size_t begin) {
+        _positions.clear();
+        _cursor = 0;
+        size_t end = std::min(begin + kWindowSize, _end);
+        for_each_structural_char(_data + begin, end - begin, _chars,
+                                 [&](size_t offset) { _positions.push_back(begin + offset); });
+        _indexed_end = end;
+    }
+
+    const char* _data;
+    const size_t _end;
+    size_t _indexed_end;
+    const std::array<char, 4> _chars;
+    std::vector<size_t> _positions;
+    size_t _cursor = 0;
+};
+
+} // namespace starrocks
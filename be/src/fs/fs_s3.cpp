@@ -426,7 +426,8 @@ StatusOr<std::unique_ptr<WritableFile>> S3FileSystem::new_writable_file(const Wr
     auto client = new_s3client(uri, _options);
     auto ostream = std::make_unique<io::S3OutputStream>(std::move(client), uri.bucket(), uri.key(),
                                                         config::experimental_s3_max_single_part_size,
-                                                        config::experimental_s3_min_upload_part_size);
+                                                        config::experimental_s3_min_upload_part_size,
+                                                        config::experimental_s3_max_concurrent_part_uploads);
     return std::make_unique<OutputStreamAdapter>(std::move(ostream), fname);
 }
 
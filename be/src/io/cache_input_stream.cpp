@@ -26,25 +26,33 @@
 
 namespace starrocks::io {
 
-CacheInputStream::CacheInputStream(std::string filename, std::shared_ptr<SeekableInputStream> stream)
-        : _filename(std::move(filename)), _stream(std::move(stream)), _offset(0) {
-    _size = _stream->get_size().value();
-#ifdef WITH_BLOCK_CACHE
+StatusOr<std::unique_ptr<CacheInputStream>> CacheInputStream::create(std::string filename,
+                                                                      std::shared_ptr<SeekableInputStream> stream) {
+    ASSIGN_OR_RETURN(auto size, stream->get_size());
+    return std::unique_ptr<CacheInputStream>(new CacheInputStream(std::move(filename), std::move(stream), size));
+}
+
+CacheInputStream::CacheInputStream(std::string filename, std::shared_ptr<SeekableInputStream> stream, int64_t size)
+        : _filename(std::move(filename)), _stream(std::move(stream)), _offset(0), _size(size) {
     // _cache_key = _filename;
     // use hash(filename) as cache key.
     _cache_key.resize(16);
     char* data = _cache_key.data();
-    uint64_t hash_value = HashUtil::hash64(filename.data(), filename.size(), 0);
+    uint64_t hash_value = HashUtil::hash64(_filename.data(), _filename.size(), 0);
     memcpy(data, &hash_value, sizeof(hash_value));
     int64_t file_size = _size;
     memcpy(data + 8, &file_size, sizeof(file_size));
     _buffer.reserve(BlockCache::instance()->block_size());
-#endif
 }
 
-#ifdef WITH_BLOCK_CACHE
 StatusOr<int64_t> CacheInputStream::read(void* out, int64_t count) {
     BlockCache* cache = BlockCache::instance();
+    if (!cache->is_initialized()) {
+        int64_t load_size = std::min(count, _size - _offset);
+        RETURN_IF_ERROR(_stream->read_at_fully(_offset, out, load_size));
+        _offset += load_size;
+        return load_size;
+    }
     count = std::min(_size - _offset, count);
     const int64_t BLOCK_SIZE = cache->block_size();
     char* p = static_cast<char*>(out);
@@ -65,8 +73,10 @@ StatusOr<int64_t> CacheInputStream::read(void* out, int64_t count) {
                 return Status::OK();
             }
         }
-        if (!res.status().is_not_found()) Status::NotFound("");
-        DCHECK(res.status().is_not_found());
+        // a corrupted or unreadable block is treated as a miss, read it from the stream again.
+        if (!res.status().is_not_found()) {
+            LOG(WARNING) << "read block cache failed, errmsg: " << res.status().get_error_msg();
+        }
 
         int64_t block_id = offset / BLOCK_SIZE;
         int64_t block_offset = block_id * BLOCK_SIZE;
@@ -121,14 +131,6 @@ StatusOr<int64_t> CacheInputStream::read(void* out, int64_t count) {
     DCHECK(p == pe);
     return count;
 }
-#else
-StatusOr<int64_t> CacheInputStream::read(void* out, int64_t count) {
-    int64_t load_size = std::min(count, _size - _offset);
-    RETURN_IF_ERROR(_stream->read_at_fully(_offset, out, load_size));
-    _offset += load_size;
-    return load_size;
-}
-#endif
 
 Status CacheInputStream::seek(int64_t offset) {
     if (offset < 0) return Status::InvalidArgument(fmt::format("Invalid offset {}", offset));
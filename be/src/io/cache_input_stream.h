@@ -33,7 +33,11 @@ public:
     };
 
     static constexpr int64_t BLOCK_SIZE = 1 * 1024 * 1024;
-    explicit CacheInputStream(std::string filename, std::shared_ptr<SeekableInputStream> stream);
+
+    // The blocks of |stream| are cached by the name and the size of the file, return an error if the size of
+    // |stream| can't be got.
+    static StatusOr<std::unique_ptr<CacheInputStream>> create(std::string filename,
+                                                              std::shared_ptr<SeekableInputStream> stream);
 
     ~CacheInputStream() override = default;
 
@@ -50,6 +54,8 @@ public:
     void set_enable_populate_cache(bool v) { _enable_populate_cache = v; }
 
 private:
+    CacheInputStream(std::string filename, std::shared_ptr<SeekableInputStream> stream, int64_t size);
+
     std::string _cache_key;
     std::string _filename;
     std::shared_ptr<SeekableInputStream> _stream;
@@ -26,7 +26,8 @@
 namespace starrocks::io {
 
 S3OutputStream::S3OutputStream(std::shared_ptr<Aws::S3::S3Client> client, std::string bucket, std::string object,
-                               int64_t max_single_part_size, int64_t min_upload_part_size)
+                               int64_t max_single_part_size, int64_t min_upload_part_size,
+                               int max_concurrent_part_uploads)
         : _client(std::move(client)),
           _bucket(std::move(bucket)),
           _object(std::move(object)),
@@ -34,10 +35,18 @@ S3OutputStream::S3OutputStream(std::shared_ptr<Aws::S3::S3Client> client, std::s
           _min_upload_part_size(min_upload_part_size),
           _buffer(),
           _upload_id(),
+          _max_concurrent_part_uploads(max_concurrent_part_uploads),
           _etags() {
     CHECK(_client != nullptr);
 }
 
+S3OutputStream::~S3OutputStream() {
+    // the uploads in progress refer to the client
+    for (auto& [part_number, outcome] : _pending_parts) {
+        outcome.wait();
+    }
+}
+
 Status S3OutputStream::write(const void* data, int64_t size) {
     _buffer.append(static_cast<const char*>(data), size);
     if (_upload_id.empty() && _buffer.size() > _max_single_part_size) {
@@ -80,6 +89,9 @@ Status S3OutputStream::close() {
         RETURN_IF_ERROR(singlepart_upload());
     } else {
         RETURN_IF_ERROR(multipart_upload());
+        while (!_pending_parts.empty()) {
+            RETURN_IF_ERROR(wait_for_part_upload());
+        }
         RETURN_IF_ERROR(complete_multipart_upload());
     }
     _client = nullptr;
@@ -122,22 +134,45 @@ Status S3OutputStream::multipart_upload() {
     if (_buffer.empty()) {
         return Status::OK();
     }
+    _etags.emplace_back();
+    int part_number = static_cast<int>(_etags.size());
     Aws::S3::Model::UploadPartRequest req;
     req.SetBucket(_bucket);
     req.SetKey(_object);
-    req.SetPartNumber(static_cast<int>(_etags.size() + 1));
+    req.SetPartNumber(part_number);
     req.SetUploadId(_upload_id);
     req.SetContentLength(static_cast<int64_t>(_buffer.size()));
+    // the body holds a copy of the buffer, so the buffer can be reused during the upload
     req.SetBody(std::make_shared<Aws::StringStream>(_buffer));
+    if (_max_concurrent_part_uploads > 1) {
+        while (_pending_parts.size() >= static_cast<size_t>(_max_concurrent_part_uploads)) {
+            RETURN_IF_ERROR(wait_for_part_upload());
+        }
+        _pending_parts.emplace_back(part_number, _client->UploadPartCallable(req));
+        return Status::OK();
+    }
     auto outcome = _client->UploadPart(req);
     if (outcome.IsSuccess()) {
-        _etags.push_back(outcome.GetResult().GetETag());
+        _etags[part_number - 1] = outcome.GetResult().GetETag();
         return Status::OK();
     }
     return Status::IOError(
             fmt::format("S3: Fail to upload part of {}/{}: {}", _bucket, _object, outcome.GetError().GetMessage()));
 }
 
+Status S3OutputStream::wait_for_part_upload() {
+    DCHECK(!_pending_parts.empty());
+    auto [part_number, outcome_callable] = std::move(_pending_parts.front());
+    _pending_parts.pop_front();
+    auto outcome = outcome_callable.get();
+    if (outcome.IsSuccess()) {
+        _etags[part_number - 1] = outcome.GetResult().GetETag();
+        return Status::OK();
+    }
+    return Status::IOError(fmt::format("S3: Fail to upload part {} of {}/{}: {}", part_number, _bucket, _object,
+                                       outcome.GetError().GetMessage()));
+}
+
 Status S3OutputStream::complete_multipart_upload() {
     VLOG(12) << "Completing multipart upload s3://" << _bucket << "/" << _object;
     DCHECK(!_upload_id.empty());
@@ -16,16 +16,21 @@
 
 #include <aws/s3/S3Client.h>
 
+#include <deque>
+
 #include "io/output_stream.h"
 
 namespace starrocks::io {
 
 class S3OutputStream : public OutputStream {
 public:
+    // At most |max_concurrent_part_uploads| parts are uploaded concurrently in the executor of |client|, while
+    // the following parts are being written.
     explicit S3OutputStream(std::shared_ptr<Aws::S3::S3Client> client, std::string bucket, std::string object,
-                            int64_t max_single_part_size, int64_t min_upload_part_size);
+                            int64_t max_single_part_size, int64_t min_upload_part_size,
+                            int max_concurrent_part_uploads = 1);
 
-    ~S3OutputStream() override = default;
+    ~S3OutputStream() override;
 
     // Disallow copy and assignment
     S3OutputStream(const S3OutputStream&) = delete;
@@ -54,6 +59,8 @@ private:
     Status multipart_upload();
     Status singlepart_upload();
     Status complete_multipart_upload();
+    // Wait for the earliest pending part upload
+    Status wait_for_part_upload();
 
     std::shared_ptr<Aws::S3::S3Client> _client;
     const Aws::String _bucket;
@@ -62,7 +69,10 @@ private:
     const int64_t _min_upload_part_size;
     Aws::String _buffer;
     Aws::String _upload_id;
+    const int _max_concurrent_part_uploads;
     std::vector<Aws::String> _etags;
+    // the part numbers and the outcomes of the part uploads in progress
+    std::deque<std::pair<int, Aws::S3::Model::UploadPartOutcomeCallable>> _pending_parts;
 };
 
 } // namespace starrocks::io
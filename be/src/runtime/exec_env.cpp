@@ -72,6 +72,7 @@
 #include "runtime/stream_load/load_stream_mgr.h"
 #include "runtime/stream_load/stream_load_executor.h"
 #include "runtime/stream_load/transaction_mgr.h"
+#include "storage/compaction_manager.h"
 #include "storage/lake/fixed_location_provider.h"
 #include "storage/lake/starlet_location_provider.h"
 #include "storage/lake/tablet_manager.h"
@@ -155,6 +156,11 @@ Status ExecEnv::_init(const std::vector<StorePath>& store_paths) {
     // query_context_mgr keeps slotted map with 64 slot to reduce contention
     _query_context_mgr = new pipeline::QueryContextManager(6);
     RETURN_IF_ERROR(_query_context_mgr->init());
+    if (StorageEngine::instance() != nullptr && StorageEngine::instance()->compaction_manager() != nullptr) {
+        // compactions are throttled when the Backend is busy with queries
+        StorageEngine::instance()->compaction_manager()->throttle()->set_running_query_num_getter(
+                [mgr = _query_context_mgr] { return static_cast<int64_t>(mgr->size()); });
+    }
     _thread_pool =
             new PriorityThreadPool("table_scan_io", // olap/external table scan thread pool
                                    config::scanner_thread_pool_thread_num, config::scanner_thread_pool_queue_size);
@@ -492,6 +498,9 @@ void ExecEnv::_destroy() {
 
     // WorkGroupManager should release MemTracker of WorkGroups belongs to itself before deallocate _query_pool_mem_tracker.
     workgroup::WorkGroupManager::instance()->destroy();
+    if (StorageEngine::instance() != nullptr && StorageEngine::instance()->compaction_manager() != nullptr) {
+        StorageEngine::instance()->compaction_manager()->throttle()->set_running_query_num_getter(nullptr);
+    }
     SAFE_DELETE(_query_context_mgr);
     SAFE_DELETE(_runtime_filter_cache);
     SAFE_DELETE(_driver_limiter);
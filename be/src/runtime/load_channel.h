@@ -106,6 +106,8 @@ public:
 
     MemTracker* mem_tracker() { return _mem_tracker.get(); }
 
+    LoadChannelMgr* load_mgr() { return _load_mgr; }
+
     Span get_span() { return _span; }
 
 private:
@@ -81,6 +81,7 @@ LoadChannelMgr::~LoadChannelMgr() {
 
 Status LoadChannelMgr::init(MemTracker* mem_tracker) {
     _mem_tracker = mem_tracker;
+    _write_buffer_manager = std::make_unique<WriteBufferManager>(mem_tracker);
     RETURN_IF_ERROR(_start_bg_worker());
     return Status::OK();
 }
@@ -236,7 +237,8 @@ void LoadChannelMgr::_start_load_channels_clean() {
     // this log print every 1 min, so that we could observe the mem consumption of load process
     // on this Backend
     LOG(INFO) << "Memory consumption(bytes) limit=" << _mem_tracker->limit()
-              << " current=" << _mem_tracker->consumption() << " peak=" << _mem_tracker->peak_consumption();
+              << " current=" << _mem_tracker->consumption() << " peak=" << _mem_tracker->peak_consumption()
+              << " write_buffer=" << _write_buffer_manager->total_bytes();
 }
 
 std::shared_ptr<LoadChannel> LoadChannelMgr::_find_load_channel(const UniqueId& load_id) {
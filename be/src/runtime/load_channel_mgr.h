@@ -50,6 +50,7 @@
 #include "gen_cpp/internal_service.pb.h"
 #include "runtime/load_channel.h"
 #include "runtime/tablets_channel.h"
+#include "storage/write_buffer_manager.h"
 #include "util/blocking_queue.hpp"
 #include "util/threadpool.h"
 #include "util/uid_util.h"
@@ -86,6 +87,9 @@ public:
 
     std::shared_ptr<LoadChannel> remove_load_channel(const UniqueId& load_id);
 
+    // nullptr before init()
+    WriteBufferManager* write_buffer_manager() { return _write_buffer_manager.get(); }
+
 private:
     static void* load_channel_clean_bg_worker(void* arg);
 
@@ -93,6 +97,9 @@ private:
     std::shared_ptr<LoadChannel> _find_load_channel(const UniqueId& load_id);
     void _start_load_channels_clean();
 
+    // flush the memtables of all the load channels, must outlive them
+    std::unique_ptr<WriteBufferManager> _write_buffer_manager;
+
     // lock protect the load channel map
     bthread::Mutex _lock;
     // load id -> load channel
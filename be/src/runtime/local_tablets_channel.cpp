@@ -32,6 +32,7 @@
 #include "runtime/descriptors.h"
 #include "runtime/global_dict/types.h"
 #include "runtime/load_channel.h"
+#include "runtime/load_channel_mgr.h"
 #include "runtime/mem_pool.h"
 #include "runtime/mem_tracker.h"
 #include "runtime/tablets_channel.h"
@@ -462,6 +463,7 @@ Status LocalTabletsChannel::_open_all_writers(const PTabletWriterOpenRequest& pa
             options.replica_state = Peer;
         }
         options.merge_condition = params.merge_condition();
+        options.write_buffer_manager = _load_channel->load_mgr()->write_buffer_manager();
 
         auto res = AsyncDeltaWriter::open(options, _mem_tracker);
         if (res.status().ok()) {
@@ -34,6 +34,9 @@
 
 #include "runtime/stream_load/stream_load_pipe.h"
 
+#include <cstring>
+#include <vector>
+
 namespace starrocks {
 
 Status StreamLoadPipe::append(ByteBufferPtr&& buf) {
@@ -305,4 +308,65 @@ Status StreamLoadPipeInputStream::skip(int64_t n) {
     return Status::OK();
 }
 
+StatusOr<ByteBufferPtr> StreamLoadPipeSplitter::next_block(int64_t* seq) {
+    while (true) {
+        {
+            std::lock_guard<std::mutex> l(_lock);
+            if (_has_block_unlocked()) {
+                if (_pending_size == 0) {
+                    return Status::EndOfFile("all data has been read");
+                }
+                return _cut_block_unlocked(_eof ? _pending_size : _pending_row_end, seq);
+            }
+        }
+        RETURN_IF_ERROR(_read_more());
+    }
+}
+
+Status StreamLoadPipeSplitter::_read_more() {
+    std::lock_guard<std::mutex> rl(_read_lock);
+    {
+        std::lock_guard<std::mutex> l(_lock);
+        // another reader may have read enough data while this one waited for the read lock
+        if (_has_block_unlocked()) {
+            return Status::OK();
+        }
+    }
+    // the pipe may wait for the data from the network, don't block the readers cutting the pending data
+    auto res = _pipe->read();
+    std::lock_guard<std::mutex> l(_lock);
+    if (res.status().is_end_of_file()) {
+        _eof = true;
+        return Status::OK();
+    }
+    RETURN_IF_ERROR(res.status());
+    ByteBufferPtr buf = std::move(res).value();
+    const char* data = buf->ptr + buf->pos;
+    const void* delimiter = memrchr(data, _row_delimiter, buf->remaining());
+    if (delimiter != nullptr) {
+        _pending_row_end = _pending_size + (static_cast<const char*>(delimiter) - data) + 1;
+    }
+    _pending_size += buf->remaining();
+    _pending.emplace_back(std::move(buf));
+    return Status::OK();
+}
+
+ByteBufferPtr StreamLoadPipeSplitter::_cut_block_unlocked(size_t size, int64_t* seq) {
+    auto block = ByteBuffer::allocate(size);
+    while (block->has_remaining()) {
+        auto& buf = _pending.front();
+        size_t n = std::min(buf->remaining(), block->remaining());
+        block->put_bytes(buf->ptr + buf->pos, n);
+        buf->pos += n;
+        if (!buf->has_remaining()) {
+            _pending.pop_front();
+        }
+    }
+    block->flip();
+    _pending_size -= size;
+    _pending_row_end = _pending_row_end > size ? _pending_row_end - size : 0;
+    *seq = _next_seq++;
+    return block;
+}
+
 } // namespace starrocks
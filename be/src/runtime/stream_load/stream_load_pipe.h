@@ -124,4 +124,42 @@ private:
     std::shared_ptr<StreamLoadPipe> _pipe;
 };
 
+// StreamLoadPipeSplitter cuts the byte stream of a pipe into blocks which end at a row delimiter, so that
+// the blocks can be parsed by several scanners in parallel. Each block gets a sequence number following
+// the order of the stream.
+class StreamLoadPipeSplitter {
+public:
+    StreamLoadPipeSplitter(std::shared_ptr<StreamLoadPipe> pipe, char row_delimiter, size_t block_size)
+            : _pipe(std::move(pipe)), _row_delimiter(row_delimiter), _block_size(block_size) {}
+    ~StreamLoadPipeSplitter() { _pipe->close(); }
+
+    // Return the next block of at least |block_size| bytes unless it's the last one, which may not end
+    // with a row delimiter. Return EndOfFile if all the data has been returned.
+    // Thread-safe.
+    StatusOr<ByteBufferPtr> next_block(int64_t* seq);
+
+private:
+    // Whether the pending data makes up a block
+    bool _has_block_unlocked() const { return _eof || (_pending_size >= _block_size && _pending_row_end > 0); }
+    // Read a buffer from the pipe into the pending data unless another reader has done it
+    Status _read_more();
+    ByteBufferPtr _cut_block_unlocked(size_t size, int64_t* seq);
+
+    // serializes the reads of the pipe, so that the buffers are appended in the order of the stream,
+    // but is not held while cutting blocks
+    std::mutex _read_lock;
+    // protects the pending data
+    std::mutex _lock;
+    std::shared_ptr<StreamLoadPipe> _pipe;
+    const char _row_delimiter;
+    const size_t _block_size;
+    // the data read from the pipe but not returned in a block yet
+    std::deque<ByteBufferPtr> _pending;
+    size_t _pending_size = 0;
+    // the end of the last complete row in the pending data, 0 if there is none
+    size_t _pending_row_end = 0;
+    int64_t _next_seq = 0;
+    bool _eof = false;
+};
+
 } // namespace starrocks
@@ -18,6 +18,7 @@
 
 #include "gutil/strings/substitute.h"
 #include "util/raw_container.h"
+#include "util/swar_digits.h"
 
 namespace starrocks {
 
@@ -298,27 +299,32 @@ bool date::from_string(const char* date_str, size_t len, int* year, int* month,
     return true;
 }
 
+// Load the eight digits of "%Y-%m-%d" into "YYYYMMDD", '-' means any char.
+static inline uint64_t load_date_digits(const char* ptr) {
+    uint64_t chunk = swar::load_eight_chars(ptr);
+    uint64_t day = unaligned_load<uint16_t>(ptr + 8);
+    return (chunk & 0x00000000FFFFFFFFULL) | ((chunk >> 8) & 0x0000FFFF00000000ULL) | (day << 48);
+}
+
+// Load the six digits of "%H:%i:%s" into "00HHMMSS", ':' means any char.
+static inline uint64_t load_time_digits(const char* ptr) {
+    uint64_t chunk = swar::load_eight_chars(ptr);
+    return 0x3030ULL | ((chunk & 0xFFFFULL) << 16) | (((chunk >> 24) & 0xFFFFULL) << 32) |
+           (((chunk >> 48) & 0xFFFFULL) << 48);
+}
+
 // Get date base on format "%Y-%m-%d", '-' means any char.
-// compare every char.
+// The eight digits are validated and converted at a time.
 bool date::from_string_to_date_internal(const char* ptr, int* year, int* month, int* day) {
-    uint8_t year1;
-    uint8_t year2;
-    uint8_t year3;
-    uint8_t year4;
-    uint8_t month1;
-    uint8_t month2;
-    uint8_t day1;
-    uint8_t day2;
-    if (char_to_digit(ptr, 0, &year1) || char_to_digit(ptr, 1, &year2) || char_to_digit(ptr, 2, &year3) ||
-        char_to_digit(ptr, 3, &year4) || isdigit(ptr[4]) || char_to_digit(ptr, 5, &month1) ||
-        char_to_digit(ptr, 6, &month2) || isdigit(ptr[7]) || char_to_digit(ptr, 8, &day1) ||
-        char_to_digit(ptr, 9, &day2)) {
+    uint64_t digits = load_date_digits(ptr);
+    if (!swar::is_eight_digits(digits) || isdigit(ptr[4]) || isdigit(ptr[7])) {
         return false;
     }
+    uint32_t value = swar::parse_eight_digits(digits);
 
-    *year = year1 * 1000 + year2 * 100 + year3 * 10 + year4;
-    *month = month1 * 10 + month2;
-    *day = day1 * 10 + day2;
+    *year = value / 10000;
+    *month = value / 100 % 100;
+    *day = value % 100;
 
     if (*month > 12 || (*day > DAYS_IN_MONTH[is_leap(*year)][*month])) {
         return false;
@@ -386,37 +392,21 @@ bool date::is_standard_datetime_format(const char* ptr, int length, const char**
 // else return false;
 bool date::from_string_to_datetime_internal(const char* ptr_date, const char* ptr_time, int* year, int* month, int* day,
                                             int* hour, int* minute, int* second, int* microsecond) {
-    uint8_t year1;
-    uint8_t year2;
-    uint8_t year3;
-    uint8_t year4;
-    uint8_t month1;
-    uint8_t month2;
-    uint8_t day1;
-    uint8_t day2;
-
-    uint8_t hour1;
-    uint8_t hour2;
-    uint8_t minute1;
-    uint8_t minute2;
-    uint8_t second1;
-    uint8_t second2;
-    if (char_to_digit(ptr_date, 0, &year1) || char_to_digit(ptr_date, 1, &year2) ||
-        char_to_digit(ptr_date, 2, &year3) || char_to_digit(ptr_date, 3, &year4) || isdigit(ptr_date[4]) ||
-        char_to_digit(ptr_date, 5, &month1) || char_to_digit(ptr_date, 6, &month2) || isdigit(ptr_date[7]) ||
-        char_to_digit(ptr_date, 8, &day1) || char_to_digit(ptr_date, 9, &day2) || char_to_digit(ptr_time, 0, &hour1) ||
-        char_to_digit(ptr_time, 1, &hour2) || isdigit(ptr_time[2]) || char_to_digit(ptr_time, 3, &minute1) ||
-        char_to_digit(ptr_time, 4, &minute2) || isdigit(ptr_time[5]) || char_to_digit(ptr_time, 6, &second1) ||
-        char_to_digit(ptr_time, 7, &second2)) {
+    uint64_t date_digits = load_date_digits(ptr_date);
+    uint64_t time_digits = load_time_digits(ptr_time);
+    if (!swar::is_eight_digits(date_digits) || !swar::is_eight_digits(time_digits) || isdigit(ptr_date[4]) ||
+        isdigit(ptr_date[7]) || isdigit(ptr_time[2]) || isdigit(ptr_time[5])) {
         return false;
     }
+    uint32_t date_value = swar::parse_eight_digits(date_digits);
+    uint32_t time_value = swar::parse_eight_digits(time_digits);
 
-    *year = year1 * 1000 + year2 * 100 + year3 * 10 + year4;
-    *month = month1 * 10 + month2;
-    *day = day1 * 10 + day2;
-    *hour = hour1 * 10 + hour2;
-    *minute = minute1 * 10 + minute2;
-    *second = second1 * 10 + second2;
+    *year = date_value / 10000;
+    *month = date_value / 100 % 100;
+    *day = date_value % 100;
+    *hour = time_value / 10000;
+    *minute = time_value / 100 % 100;
+    *second = time_value % 100;
     *microsecond = 0;
     if (*month > 12 || (*day > DAYS_IN_MONTH[is_leap(*year)][*month]) || *hour > 23 || *minute > 59 || *second > 59) {
         return false;
@@ -183,7 +183,6 @@ int main(int argc, char** argv) {
     }
 #endif
 
-#ifdef WITH_BLOCK_CACHE
     if (starrocks::config::block_cache_enable) {
         starrocks::BlockCache* cache = starrocks::BlockCache::instance();
         starrocks::CacheOptions cache_options;
@@ -205,9 +204,12 @@ int main(int argc, char** argv) {
         cache_options.meta_path = starrocks::config::block_cache_meta_path;
         cache_options.block_size = starrocks::config::block_cache_block_size;
         cache_options.checksum = starrocks::config::block_cache_checksum_enable;
-        cache->init(cache_options);
+        cache_options.engine = starrocks::config::block_cache_engine;
+        auto st = cache->init(cache_options);
+        if (!st.ok()) {
+            LOG(WARNING) << "init block cache failed, block cache is disabled: " << st;
+        }
     }
-#endif
 
     Aws::SDKOptions aws_sdk_options;
     if (starrocks::config::aws_sdk_logging_trace_enabled) {
@@ -321,9 +323,7 @@ int main(int argc, char** argv) {
         start_be();
     }
 
-#ifdef WITH_BLOCK_CACHE
-    starrocks::BlockCache::instance()->shutdown();
-#endif
+    (void)starrocks::BlockCache::instance()->shutdown();
 
     daemon->stop();
     daemon.reset();
@@ -31,20 +31,28 @@ int AsyncDeltaWriter::_execute(void* meta, bthread::TaskIterator<AsyncDeltaWrite
     if (iter.is_queue_stopped()) {
         return 0;
     }
-    auto writer = static_cast<DeltaWriter*>(meta);
+    auto async_writer = static_cast<AsyncDeltaWriter*>(meta);
+    auto writer = async_writer->_writer.get();
     for (; iter; ++iter) {
         Status st;
         if (iter->abort) {
             writer->abort(iter->abort_with_log);
             continue;
         }
+        if (iter->flush) {
+            async_writer->_flush_write_buffer();
+            continue;
+        }
         if (iter->chunk != nullptr && iter->indexes_size > 0) {
             st = writer->write(*iter->chunk, iter->indexes, 0, iter->indexes_size);
+            async_writer->_update_write_buffer_usage();
         }
         FailedRowsetInfo failed_info{.tablet_id = writer->tablet()->tablet_id(),
                                      .replicate_token = writer->replicate_token()};
         if (st.ok() && iter->commit_after_write) {
-            if (st = writer->close(); !st.ok()) {
+            st = writer->close();
+            async_writer->_update_write_buffer_usage();
+            if (!st.ok()) {
                 LOG(WARNING) << "Fail to write or commit. txn_id: " << writer->txn_id()
                              << " tablet_id: " << writer->tablet()->tablet_id() << ": " << st;
                 iter->write_cb->run(st, nullptr, &failed_info);
@@ -80,6 +88,7 @@ StatusOr<std::unique_ptr<AsyncDeltaWriter>> AsyncDeltaWriter::open(const DeltaWr
         return res.status();
     }
     auto w = std::make_unique<AsyncDeltaWriter>(private_type(0), std::move(res).value());
+    w->_write_buffer_manager = opt.write_buffer_manager;
     RETURN_IF_ERROR(w->_init());
     return std::move(w);
 }
@@ -93,9 +102,12 @@ Status AsyncDeltaWriter::_init() {
     if (UNLIKELY(opts.executor == nullptr)) {
         return Status::InternalError("AsyncDeltaWriterExecutor init failed");
     }
-    if (int r = bthread::execution_queue_start(&_queue_id, &opts, _execute, _writer.get()); r != 0) {
+    if (int r = bthread::execution_queue_start(&_queue_id, &opts, _execute, this); r != 0) {
         return Status::InternalError(fmt::format("fail to create bthread execution queue: {}", r));
     }
+    if (_write_buffer_manager != nullptr && replica_state() != Secondary) {
+        _write_buffer_manager->register_owner(this, _writer->tablet()->belonged_table_id());
+    }
     if (replica_state() == Secondary) {
         _segment_flush_executor = StorageEngine::instance()->segment_flush_executor()->create_flush_token(_writer);
         if (_segment_flush_executor == nullptr) {
@@ -148,6 +160,29 @@ void AsyncDeltaWriter::cancel(const Status& st) {
     _writer->cancel(st);
 }
 
+void AsyncDeltaWriter::flush_write_buffer() {
+    Task task;
+    task.flush = true;
+    int r = bthread::execution_queue_execute(_queue_id, task);
+    LOG_IF(WARNING, r != 0) << "Fail to execution_queue_execute: " << r;
+}
+
+void AsyncDeltaWriter::_flush_write_buffer() {
+    // The memtable is counted as being flushed from the hand-off until the flush task releases it.
+    _write_buffer_manager->start_flush(this);
+    auto st = _writer->flush_memtable_async(
+            [manager = _write_buffer_manager, owner = this]() { manager->finish_flush(owner); });
+    LOG_IF(WARNING, !st.ok()) << "Fail to flush memtable. txn_id: " << _writer->txn_id()
+                              << " tablet_id: " << _writer->tablet()->tablet_id() << ": " << st;
+    _update_write_buffer_usage();
+}
+
+void AsyncDeltaWriter::_update_write_buffer_usage() {
+    if (_write_buffer_manager != nullptr) {
+        _write_buffer_manager->update_usage(this, _writer->write_buffer_size());
+    }
+}
+
 void AsyncDeltaWriter::abort(bool with_log) {
     Task task;
     task.abort = true;
@@ -181,6 +216,9 @@ void AsyncDeltaWriter::_close() {
     if (_segment_flush_executor != nullptr) {
         _segment_flush_executor->wait();
     }
+    if (_write_buffer_manager != nullptr) {
+        _write_buffer_manager->unregister_owner(this);
+    }
 }
 
 } // namespace starrocks
@@ -21,6 +21,7 @@
 
 #include "common/compiler_util.h"
 #include "storage/delta_writer.h"
+#include "storage/write_buffer_manager.h"
 
 namespace brpc {
 class Controller;
@@ -44,7 +45,7 @@ class AsyncDeltaWriterSegmentRequest;
 // All submitted tasks will be executed in the FIFO order.
 // TODO: this class is too similar to lake::AsyncDeltaWriter, remove this AsyncDeltaWriter and
 // keep lake::AsyncDeltaWriter.
-class AsyncDeltaWriter {
+class AsyncDeltaWriter final : public WriteBufferOwner {
     struct private_type;
 
 public:
@@ -57,7 +58,7 @@ public:
     AsyncDeltaWriter(private_type, std::unique_ptr<DeltaWriter> writer)
             : _writer(std::move(writer)), _queue_id{kInvalidQueueId}, _closed(false) {}
 
-    ~AsyncDeltaWriter();
+    ~AsyncDeltaWriter() override;
 
     AsyncDeltaWriter(const AsyncDeltaWriter&) = delete; // DISALLOW COPY
     void operator=(const AsyncDeltaWriter&) = delete;   // DISALLOW ASSIGN
@@ -82,6 +83,10 @@ public:
 
     void cancel(const Status& st);
 
+    // Submit a task to flush the active memtable.
+    // [thread-safe and wait-free]
+    void flush_write_buffer() override;
+
     int64_t partition_id() const { return _writer->partition_id(); }
 
     ReplicaState replica_state() const { return _writer->replica_state(); }
@@ -104,17 +109,22 @@ private:
         bool commit_after_write = false;
         bool abort = false;
         bool abort_with_log = false;
+        // flush the active memtable on the request of the WriteBufferManager
+        bool flush = false;
     };
 
     static int _execute(void* meta, bthread::TaskIterator<AsyncDeltaWriter::Task>& iter);
 
     Status _init();
     void _close();
+    void _flush_write_buffer();
+    void _update_write_buffer_usage();
 
     std::shared_ptr<DeltaWriter> _writer;
     bthread::ExecutionQueueId<Task> _queue_id;
     std::atomic<bool> _closed;
     std::unique_ptr<starrocks::SegmentFlushToken> _segment_flush_executor = nullptr;
+    WriteBufferManager* _write_buffer_manager = nullptr;
 };
 
 class CommittedRowsetInfo {
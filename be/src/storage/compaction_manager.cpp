@@ -17,6 +17,7 @@
 #include <chrono>
 #include <thread>
 
+#include "common/config.h"
 #include "storage/data_dir.h"
 #include "util/starrocks_metrics.h"
 #include "util/thread.h"
@@ -35,6 +36,9 @@ CompactionManager::~CompactionManager() {
     if (_compaction_pool) {
         _compaction_pool->shutdown();
     }
+    if (_column_group_pool) {
+        _column_group_pool->shutdown();
+    }
     if (_dispatch_update_candidate_thread.joinable()) {
         _dispatch_update_candidate_thread.join();
     }
@@ -61,6 +65,15 @@ void CompactionManager::schedule() {
                  .build(&_compaction_pool);
     DCHECK(st.ok());
 
+    // the compaction threads wait for the column groups merged in this pool, so it must be a separate one
+    st = ThreadPoolBuilder("compact_cg")
+                 .set_min_threads(0)
+                 .set_max_threads(std::max(1, max_task_num()) *
+                                  std::max(1, config::vertical_compaction_max_parallel_column_groups))
+                 .set_max_queue_size(1000)
+                 .build(&_column_group_pool);
+    DCHECK(st.ok());
+
     _scheduler_thread = std::thread([this] { _schedule(); });
     Thread::set_thread_name(_scheduler_thread, "compact_sched");
 }
@@ -216,6 +229,10 @@ bool CompactionManager::_check_precondition(const CompactionCandidate& candidate
         }
         last_failure_ts = tablet->last_cumu_compaction_failure_time();
     } else if (candidate.type == BASE_COMPACTION) {
+        if (_throttle.is_paused(COMPACTION_PRIORITY_LOW)) {
+            VLOG(2) << "skip tablet:" << tablet->tablet_id() << " because base compaction is paused by query load";
+            return false;
+        }
         std::unique_lock lk(tablet->get_base_lock(), std::try_to_lock);
         if (!lk.owns_lock()) {
             VLOG(2) << "skip tablet:" << tablet->tablet_id() << " for base lock";
@@ -24,6 +24,7 @@
 #include "common/config.h"
 #include "storage/compaction_candidate.h"
 #include "storage/compaction_task.h"
+#include "storage/compaction_throttle.h"
 #include "storage/olap_common.h"
 #include "storage/rowset/rowset.h"
 #include "storage/storage_engine.h"
@@ -99,6 +100,11 @@ public:
 
     Status update_max_threads(int max_threads);
 
+    CompactionThrottle* throttle() { return &_throttle; }
+
+    // The pool to merge the column groups of vertical compaction tasks concurrently, may be nullptr.
+    ThreadPool* column_group_pool() { return _column_group_pool.get(); }
+
 private:
     CompactionManager(const CompactionManager& compaction_manager) = delete;
     CompactionManager(CompactionManager&& compaction_manager) = delete;
@@ -140,7 +146,10 @@ private:
     uint64_t _round = 0;
 
     std::unique_ptr<ThreadPool> _compaction_pool = nullptr;
+    std::unique_ptr<ThreadPool> _column_group_pool = nullptr;
     std::thread _scheduler_thread;
+
+    CompactionThrottle _throttle;
 };
 
 } // namespace starrocks
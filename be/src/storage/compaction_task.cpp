@@ -14,12 +14,25 @@
 
 #include "storage/compaction_task.h"
 
+#include <algorithm>
 #include <sstream>
 
+#include "column/datum_convert.h"
 #include "runtime/current_thread.h"
+#include "runtime/mem_pool.h"
 #include "runtime/mem_tracker.h"
+#include "storage/chunk_helper.h"
+#include "storage/chunk_iterator.h"
 #include "storage/compaction_manager.h"
+#include "storage/compaction_utils.h"
+#include "storage/olap_common.h"
+#include "storage/rowset/column_reader.h"
+#include "storage/rowset/rowset_writer.h"
+#include "storage/rowset/segment.h"
+#include "storage/rowset/segment_options.h"
 #include "storage/storage_engine.h"
+#include "storage/types.h"
+#include "util/defer_op.h"
 #include "util/scoped_cleanup.h"
 #include "util/starrocks_metrics.h"
 #include "util/time.h"
@@ -180,4 +193,128 @@ void CompactionTask::_failure_callback(const Status& st) {
     LOG(WARNING) << "compaction task:" << _task_info.task_id << ", tablet:" << _task_info.tablet_id << " failed.";
 }
 
+StatusOr<bool> CompactionTask::_link_non_overlapping_segments() {
+    if (!config::enable_compaction_link_segments || _tablet->keys_type() == PRIMARY_KEYS) {
+        return false;
+    }
+    const TabletSchema& tablet_schema = _tablet->tablet_schema();
+    if (tablet_schema.sort_key_idxes().empty()) {
+        return false;
+    }
+    ColumnId first_key = tablet_schema.sort_key_idxes()[0];
+    TypeInfoPtr type_info = get_type_info(delegate_type(tablet_schema.column(first_key).type()));
+
+    struct SegmentKeyRange {
+        RowsetSharedPtr rowset;
+        uint32_t segment_id;
+        Datum min;
+        Datum max;
+    };
+    std::vector<SegmentKeyRange> ranges;
+    MemPool mem_pool;
+    for (auto& rowset : _input_rowsets) {
+        if (rowset->rowset_meta()->has_delete_predicate()) {
+            return false;
+        }
+        RETURN_IF_ERROR(rowset->load());
+        auto& segments = rowset->segments();
+        for (uint32_t i = 0; i < segments.size(); ++i) {
+            // the zone map of the segment is not loaded if the column is missing, e.g. added by schema change
+            const ColumnReader* column_reader = segments[i]->column(first_key);
+            if (column_reader == nullptr || column_reader->segment_zone_map() == nullptr) {
+                return false;
+            }
+            const ZoneMapPB* zone_map = column_reader->segment_zone_map();
+            if (zone_map->has_null() || !zone_map->has_not_null()) {
+                return false;
+            }
+            SegmentKeyRange range{rowset, i, Datum(), Datum()};
+            RETURN_IF_ERROR(datum_from_string(type_info.get(), &range.min, zone_map->min(), &mem_pool));
+            RETURN_IF_ERROR(datum_from_string(type_info.get(), &range.max, zone_map->max(), &mem_pool));
+            ranges.emplace_back(std::move(range));
+        }
+    }
+    std::sort(ranges.begin(), ranges.end(), [&](const SegmentKeyRange& lhs, const SegmentKeyRange& rhs) {
+        return type_info->cmp(lhs.min, rhs.min) < 0;
+    });
+    for (size_t i = 1; i < ranges.size(); ++i) {
+        // the keys of two segments may be equal if the first keys are equal
+        if (type_info->cmp(ranges[i - 1].max, ranges[i].min) >= 0) {
+            return false;
+        }
+    }
+
+    std::unique_ptr<RowsetWriter> output_rs_writer;
+    int64_t max_rows_per_segment = CompactionUtils::get_segment_max_rows(
+            config::max_segment_file_size, _task_info.input_rows_num, _task_info.input_rowsets_size);
+    RETURN_IF_ERROR(CompactionUtils::construct_output_rowset_writer(
+            _tablet.get(), max_rows_per_segment, HORIZONTAL_COMPACTION, _task_info.output_version, &output_rs_writer));
+    // Linking small segments would keep as many small segments after compaction, so they are rewritten into
+    // larger ones. Since the segments don't overlap, their rows are only copied in the order of keys.
+    auto min_link_size = static_cast<int64_t>(static_cast<double>(config::max_segment_file_size) *
+                                              config::compaction_link_segment_min_size_ratio);
+    Schema schema = ChunkHelper::convert_schema(tablet_schema);
+    auto chunk = ChunkHelper::new_chunk(schema, config::vector_chunk_size);
+    OlapReaderStatistics stats;
+    size_t num_linked_segments = 0;
+    auto rate_limiter = CompactionRateLimiter::create(compaction_priority_of(compaction_type()));
+    for (auto& range : ranges) {
+        if (should_stop()) {
+            return Status::Cancelled("compaction task is stopped.");
+        }
+        auto& rowset = range.rowset;
+        auto& segment = rowset->segments()[range.segment_id];
+        // the size of a segment is not recorded, so share the size of the rowset by the number of rows
+        int64_t segment_size = rowset->num_rows() > 0 ? static_cast<int64_t>(rowset->data_disk_size()) *
+                                                                segment->num_rows() / rowset->num_rows()
+                                                      : 0;
+        if (segment_size >= min_link_size) {
+            // the rows rewritten before must not be written into the same segment as the rows after
+            RETURN_IF_ERROR(output_rs_writer->flush());
+            RETURN_IF_ERROR(output_rs_writer->link_segment(rowset, range.segment_id));
+            ++num_linked_segments;
+            continue;
+        }
+        SegmentReadOptions seg_options;
+        ASSIGN_OR_RETURN(seg_options.fs, FileSystem::CreateSharedFromString(rowset->rowset_path()));
+        seg_options.stats = &stats;
+        auto res = segment->new_iterator(schema, seg_options);
+        if (res.status().is_end_of_file()) {
+            continue;
+        }
+        RETURN_IF_ERROR(res.status());
+        auto iter = std::move(res).value();
+        DeferOp close_iter([&] { iter->close(); });
+        while (true) {
+            if (should_stop()) {
+                return Status::Cancelled("compaction task is stopped.");
+            }
+#ifndef BE_TEST
+            RETURN_IF_ERROR(tls_thread_status.mem_tracker()->check_mem_limit("Compaction"));
+#endif
+            chunk->reset();
+            auto st = iter->get_next(chunk.get());
+            if (st.is_end_of_file()) {
+                break;
+            }
+            RETURN_IF_ERROR(st);
+            RETURN_IF_ERROR(output_rs_writer->add_chunk(*chunk));
+            RETURN_IF_ERROR(rate_limiter.charge(chunk->bytes_usage(), [this] { return should_stop(); }));
+        }
+    }
+    TRACE_COUNTER_INCREMENT("throttle_wait_us", rate_limiter.wait_ns() / 1000);
+    RETURN_IF_ERROR(output_rs_writer->flush());
+    ASSIGN_OR_RETURN(_output_rowset, output_rs_writer->build());
+    _task_info.output_num_rows = _output_rowset->num_rows();
+    _task_info.output_segments_num = _output_rowset->num_segments();
+    _task_info.output_rowset_size = _output_rowset->data_disk_size();
+    _task_info.total_output_num_rows = _output_rowset->num_rows();
+    TRACE_COUNTER_INCREMENT("linked_segments_num", num_linked_segments);
+    TRACE_COUNTER_INCREMENT("rewritten_segments_num", ranges.size() - num_linked_segments);
+    TRACE_COUNTER_INCREMENT("output_rowset_data_size", _output_rowset->data_disk_size());
+    TRACE("[Compaction] output rowset built from $0 non-overlapping segments, $1 linked", ranges.size(),
+          num_linked_segments);
+    return true;
+}
+
 } // namespace starrocks
@@ -19,6 +19,7 @@
 #include <vector>
 
 #include "storage/background_task.h"
+#include "storage/compaction_throttle.h"
 #include "storage/compaction_utils.h"
 #include "storage/olap_common.h"
 #include "storage/rowset/rowset.h"
@@ -252,6 +253,13 @@ protected:
                 << ", input rowsets:" << input_stream_info.str() << ", input rowsets size:" << _input_rowsets.size();
     }
 
+    // If the input rowsets have no delete predicate and their segments do not overlap on the first sort key
+    // column, which is common for append-only time series, build the output rowset by linking the input
+    // segment files in the order of keys, without decoding any page. The segments smaller than
+    // compaction_link_segment_min_size_ratio of max_segment_file_size are rewritten into larger ones instead.
+    // Return false if the input rowsets do not qualify.
+    StatusOr<bool> _link_non_overlapping_segments();
+
     void _success_callback();
 
     void _failure_callback(const Status& st);
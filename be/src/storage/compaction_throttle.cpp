@@ -0,0 +1,176 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "storage/compaction_throttle.h"
+
+#include <algorithm>
+#include <chrono>
+#include <ctime>
+
+#include "common/config.h"
+#include "storage/compaction_manager.h"
+#include "storage/storage_engine.h"
+#include "util/starrocks_metrics.h"
+#include "util/time.h"
+
+namespace starrocks {
+
+static constexpr int64_t kNanosPerSecond = 1000L * 1000 * 1000;
+static constexpr int64_t kMinWaitNs = 1000L * 1000;
+static constexpr int64_t kMaxWaitNs = 100L * 1000 * 1000;
+
+static int64_t thread_cpu_nanos() {
+    timespec ts;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return ts.tv_sec * kNanosPerSecond + ts.tv_nsec;
+}
+
+void CompactionThrottle::TokenBucket::refill(double rate, int64_t now_ns) {
+    if (last_refill_ns == 0) {
+        last_refill_ns = now_ns;
+        return;
+    }
+    // the bucket holds up to one second of budget
+    double elapsed_s = static_cast<double>(now_ns - last_refill_ns) / kNanosPerSecond;
+    tokens = std::min(rate, tokens + rate * elapsed_s);
+    last_refill_ns = now_ns;
+}
+
+int64_t CompactionThrottle::TokenBucket::wait_ns(double rate) const {
+    return tokens >= 0 ? 0 : static_cast<int64_t>(-tokens / rate * kNanosPerSecond) + 1;
+}
+
+Status CompactionThrottle::acquire(CompactionPriority priority, int64_t io_bytes, int64_t cpu_ns,
+                                   const std::function<bool()>& should_stop) {
+    int64_t start_ns = MonotonicNanos();
+    std::unique_lock l(_mutex);
+    _waiters[priority]++;
+    double io_rate = 0;
+    double cpu_rate = 0;
+    while (true) {
+        int64_t now_ns = MonotonicNanos();
+        _refresh_query_load_unlocked(now_ns);
+        double scale = _rate_scale_unlocked();
+        io_rate = config::compaction_max_io_bytes_per_second * scale;
+        cpu_rate = config::compaction_max_cpu_cores * kNanosPerSecond * scale;
+        if (io_rate > 0) {
+            _io_bucket.refill(io_rate, now_ns);
+        }
+        if (cpu_rate > 0) {
+            _cpu_bucket.refill(cpu_rate, now_ns);
+        }
+
+        int64_t wait_ns = 0;
+        if ((_busy && priority == COMPACTION_PRIORITY_LOW) || _has_higher_waiters_unlocked(priority)) {
+            wait_ns = kMaxWaitNs;
+        } else {
+            if (io_rate > 0) {
+                wait_ns = std::max(wait_ns, _io_bucket.wait_ns(io_rate));
+            }
+            if (cpu_rate > 0) {
+                wait_ns = std::max(wait_ns, _cpu_bucket.wait_ns(cpu_rate));
+            }
+        }
+        if (wait_ns == 0) {
+            break;
+        }
+        if (should_stop != nullptr && should_stop()) {
+            _waiters[priority]--;
+            _cv.notify_all();
+            return Status::Cancelled("compaction is stopped while throttled");
+        }
+        _cv.wait_for(l, std::chrono::nanoseconds(std::clamp(wait_ns, kMinWaitNs, kMaxWaitNs)));
+    }
+    _waiters[priority]--;
+    if (io_rate > 0) {
+        _io_bucket.tokens -= io_bytes;
+    }
+    if (cpu_rate > 0) {
+        _cpu_bucket.tokens -= cpu_ns;
+    }
+    _cv.notify_all();
+    l.unlock();
+
+    StarRocksMetrics::instance()->compaction_throttle_io_bytes_total.increment(io_bytes);
+    StarRocksMetrics::instance()->compaction_throttle_wait_duration_us.increment((MonotonicNanos() - start_ns) /
+                                                                                 1000);
+    return Status::OK();
+}
+
+void CompactionThrottle::set_running_query_num_getter(std::function<int64_t()> getter) {
+    std::lock_guard l(_mutex);
+    _running_query_num_getter = std::move(getter);
+    // take the new getter into account on the next check
+    _last_load_check_ns = 0;
+}
+
+bool CompactionThrottle::is_paused(CompactionPriority priority) {
+    std::lock_guard l(_mutex);
+    _refresh_query_load_unlocked(MonotonicNanos());
+    return _busy && priority == COMPACTION_PRIORITY_LOW;
+}
+
+void CompactionThrottle::_refresh_query_load_unlocked(int64_t now_ns) {
+    if (_last_load_check_ns != 0 && now_ns - _last_load_check_ns < kNanosPerSecond) {
+        return;
+    }
+    _last_load_check_ns = now_ns;
+    int32_t busy_query_num = config::compaction_busy_query_num;
+    if (busy_query_num <= 0) {
+        _busy = false;
+    } else {
+        int64_t query_num = _running_query_num_getter != nullptr ? _running_query_num_getter() : 0;
+        _busy = query_num >= busy_query_num;
+    }
+    StarRocksMetrics::instance()->compaction_throttle_busy.set_value(_busy ? 1 : 0);
+}
+
+double CompactionThrottle::_rate_scale_unlocked() const {
+    return _busy ? std::clamp<double>(config::compaction_busy_throttle_ratio, 0.01, 1.0) : 1.0;
+}
+
+bool CompactionThrottle::_has_higher_waiters_unlocked(CompactionPriority priority) const {
+    for (int p = COMPACTION_PRIORITY_HIGH; p < priority; p++) {
+        if (_waiters[p] > 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+CompactionRateLimiter::CompactionRateLimiter(CompactionThrottle* throttle, CompactionPriority priority)
+        : _throttle(throttle), _priority(priority), _last_cpu_ns(thread_cpu_nanos()) {}
+
+CompactionRateLimiter CompactionRateLimiter::create(CompactionPriority priority) {
+    CompactionThrottle* throttle = nullptr;
+    if (StorageEngine::instance() != nullptr && StorageEngine::instance()->compaction_manager() != nullptr) {
+        throttle = StorageEngine::instance()->compaction_manager()->throttle();
+    }
+    return {throttle, priority};
+}
+
+Status CompactionRateLimiter::charge(int64_t io_bytes, const std::function<bool()>& should_stop) {
+    if (_throttle == nullptr) {
+        return Status::OK();
+    }
+    int64_t cpu_ns = thread_cpu_nanos();
+    int64_t start_ns = MonotonicNanos();
+    // the CPU time of the thread is only meaningful if the task runs on the same thread all the time
+    Status st = _throttle->acquire(_priority, io_bytes, std::max<int64_t>(0, cpu_ns - _last_cpu_ns), should_stop);
+    _wait_ns += MonotonicNanos() - start_ns;
+    _last_cpu_ns = thread_cpu_nanos();
+    return st;
+}
+
+} // namespace starrocks
@@ -0,0 +1,111 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+
+#include "common/status.h"
+#include "storage/olap_common.h"
+
+namespace starrocks {
+
+// The tasks of a higher priority consume the compaction budgets ahead of the tasks of a lower priority.
+enum CompactionPriority {
+    // primary key update compaction
+    COMPACTION_PRIORITY_HIGH = 0,
+    // cumulative compaction
+    COMPACTION_PRIORITY_NORMAL = 1,
+    // base compaction
+    COMPACTION_PRIORITY_LOW = 2,
+};
+
+inline CompactionPriority compaction_priority_of(CompactionType type) {
+    return type == BASE_COMPACTION ? COMPACTION_PRIORITY_LOW : COMPACTION_PRIORITY_NORMAL;
+}
+
+// CompactionThrottle limits the I/O bytes and the CPU time consumed by all the compaction tasks of a Backend
+// with token buckets refilled at `compaction_max_io_bytes_per_second` and `compaction_max_cpu_cores`.
+// A task charges the buckets after it has done the work, so a bucket may go into debt, and the next
+// charge waits until the debt is repaid.
+// When at least `compaction_busy_query_num` queries are running, the budgets are scaled by
+// `compaction_busy_throttle_ratio` and the tasks of the lowest priority are paused.
+class CompactionThrottle {
+public:
+    CompactionThrottle() = default;
+
+    // Charge |io_bytes| and |cpu_ns| for a task of |priority|, waiting until the budgets allow it.
+    // Return Cancelled if |should_stop| returns true while waiting.
+    Status acquire(CompactionPriority priority, int64_t io_bytes, int64_t cpu_ns,
+                   const std::function<bool()>& should_stop = nullptr);
+
+    // Whether the tasks of |priority| are paused because of the query load
+    bool is_paused(CompactionPriority priority);
+
+    // Set the function returning the number of the queries running on this Backend, which decides whether
+    // the Backend is busy. Nothing is considered busy until it's set.
+    void set_running_query_num_getter(std::function<int64_t()> getter);
+
+private:
+    struct TokenBucket {
+        // may be negative
+        double tokens = 0;
+        // 0 before the first refill, which starts with an empty bucket
+        int64_t last_refill_ns = 0;
+
+        void refill(double rate, int64_t now_ns);
+        // the time to wait until the tokens are not negative
+        int64_t wait_ns(double rate) const;
+    };
+
+    // Refresh the query load at most once per second
+    void _refresh_query_load_unlocked(int64_t now_ns);
+    double _rate_scale_unlocked() const;
+    bool _has_higher_waiters_unlocked(CompactionPriority priority) const;
+
+    std::mutex _mutex;
+    std::condition_variable _cv;
+    TokenBucket _io_bucket;
+    TokenBucket _cpu_bucket;
+    int _waiters[COMPACTION_PRIORITY_LOW + 1] = {0, 0, 0};
+    bool _busy = false;
+    int64_t _last_load_check_ns = 0;
+    std::function<int64_t()> _running_query_num_getter;
+};
+
+// CompactionRateLimiter charges the work of one compaction task to the CompactionThrottle: the bytes it
+// reads or writes and the CPU time of the calling thread since the previous charge.
+class CompactionRateLimiter {
+public:
+    // |throttle| may be nullptr, in which case nothing is limited.
+    CompactionRateLimiter(CompactionThrottle* throttle, CompactionPriority priority);
+
+    // Create a limiter with the throttle of the CompactionManager of the StorageEngine
+    static CompactionRateLimiter create(CompactionPriority priority);
+
+    Status charge(int64_t io_bytes, const std::function<bool()>& should_stop = nullptr);
+
+    int64_t wait_ns() const { return _wait_ns; }
+
+private:
+    CompactionThrottle* _throttle;
+    CompactionPriority _priority;
+    int64_t _last_cpu_ns;
+    int64_t _wait_ns = 0;
+};
+
+} // namespace starrocks
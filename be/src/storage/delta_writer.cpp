@@ -29,6 +29,7 @@
 #include "storage/tablet_updates.h"
 #include "storage/txn_manager.h"
 #include "storage/update_manager.h"
+#include "util/defer_op.h"
 
 namespace starrocks {
 
@@ -318,6 +319,29 @@ Status DeltaWriter::write(const Chunk& chunk, const uint32_t* indexes, uint32_t
     return st;
 }
 
+Status DeltaWriter::flush_memtable_async(std::function<void()> on_flushed) {
+    SCOPED_THREAD_LOCAL_MEM_SETTER(_mem_tracker, false);
+    // The guard is captured by the flush task and runs |on_flushed| when the task is destroyed, i.e. once the
+    // memtable has been flushed, failed to be flushed or been dropped, or right away if nothing is submitted.
+    auto on_flushed_guard = std::make_shared<DeferOp<std::function<void()>>>([cb = std::move(on_flushed)]() {
+        if (cb) {
+            cb();
+        }
+    });
+    if (get_state() != kWriting || _replica_state == Secondary || _mem_table == nullptr) {
+        return Status::OK();
+    }
+    auto st = _flush_memtable_async(false, std::move(on_flushed_guard));
+    if (!st.ok()) {
+        _set_state(kAborted, st);
+    }
+    return st;
+}
+
+int64_t DeltaWriter::write_buffer_size() const {
+    return _mem_table != nullptr ? _mem_table->memory_usage() : 0;
+}
+
 Status DeltaWriter::write_segment(const SegmentPB& segment_pb, butil::IOBuf& data) {
     auto state = get_state();
     if (state != kWriting) {
@@ -365,18 +389,22 @@ Status DeltaWriter::close() {
     return Status::OK();
 }
 
-Status DeltaWriter::_flush_memtable_async(bool eos) {
+Status DeltaWriter::_flush_memtable_async(bool eos, std::shared_ptr<void> flush_guard) {
     // _mem_table is nullptr means write() has not been called
     if (_mem_table != nullptr) {
         RETURN_IF_ERROR(_mem_table->finalize());
     }
+    std::function<void(std::unique_ptr<SegmentPB>, bool)> flush_cb = nullptr;
+    if (flush_guard != nullptr) {
+        flush_cb = [flush_guard](std::unique_ptr<SegmentPB> seg, bool eos) {};
+    }
     if (_replica_state == Primary) {
         // have secondary replica
         if (_replicate_token != nullptr) {
             // Although there maybe no data, but we still need send eos to seconary replica
             auto replicate_token = _replicate_token.get();
             return _flush_token->submit(std::move(_mem_table), eos,
-                                        [replicate_token](std::unique_ptr<SegmentPB> seg, bool eos) {
+                                        [replicate_token, flush_guard](std::unique_ptr<SegmentPB> seg, bool eos) {
                                             auto st = replicate_token->submit(std::move(seg), eos);
                                             if (!st.ok()) {
                                                 LOG(WARNING) << "Failed to submit sync segment err=" << st;
@@ -385,12 +413,12 @@ Status DeltaWriter::_flush_memtable_async(bool eos) {
                                         });
         } else {
             if (_mem_table != nullptr) {
-                return _flush_token->submit(std::move(_mem_table), eos, nullptr);
+                return _flush_token->submit(std::move(_mem_table), eos, std::move(flush_cb));
             }
         }
     } else if (_replica_state == Peer) {
         if (_mem_table != nullptr) {
-            return _flush_token->submit(std::move(_mem_table), eos, nullptr);
+            return _flush_token->submit(std::move(_mem_table), eos, std::move(flush_cb));
         }
     }
     return Status::OK();
@@ -36,6 +36,7 @@ class SlotDescriptor;
 
 class MemTable;
 class MemTableSink;
+class WriteBufferManager;
 
 enum ReplicaState {
     // peer storage engine
@@ -62,6 +63,8 @@ struct DeltaWriterOptions {
     WriteQuorumTypePB write_quorum;
     std::string merge_condition;
     ReplicaState replica_state;
+    // nullptr if the memtables are not managed globally
+    WriteBufferManager* write_buffer_manager = nullptr;
 };
 
 enum State {
@@ -88,6 +91,16 @@ public:
     // [thread-safe]
     [[nodiscard]] Status write_segment(const SegmentPB& segment_pb, butil::IOBuf& data);
 
+    // Flush the active memtable to disk without waiting, the subsequent `write()`s go to a new memtable.
+    // |on_flushed| is called once the memtable is released, after it has been flushed or failed to be,
+    // and right away if there is nothing to flush or the flush fails to be submitted.
+    // [NOT thread-safe]
+    [[nodiscard]] Status flush_memtable_async(std::function<void()> on_flushed = nullptr);
+
+    // The memory usage of the active memtable
+    // [NOT thread-safe]
+    int64_t write_buffer_size() const;
+
     // Flush all in-memory data to disk, without waiting.
     // Subsequent `write()`s to this DeltaWriter will fail after this method returned.
     // [NOT thread-safe]
@@ -147,7 +160,8 @@ private:
     DeltaWriter(DeltaWriterOptions opt, MemTracker* parent, StorageEngine* storage_engine);
 
     Status _init();
-    Status _flush_memtable_async(bool eos = false);
+    // |flush_guard| is kept alive by the flush task until the task is destroyed.
+    Status _flush_memtable_async(bool eos = false, std::shared_ptr<void> flush_guard = nullptr);
     Status _flush_memtable();
     const char* _state_name(State state) const;
     const char* _replica_state_name(ReplicaState state) const;
@@ -33,7 +33,12 @@ namespace starrocks {
 
 Status HorizontalCompactionTask::run_impl() {
     Statistics statistics;
-    RETURN_IF_ERROR(_horizontal_compact_data(&statistics));
+    ASSIGN_OR_RETURN(bool linked, _link_non_overlapping_segments());
+    if (!linked) {
+        RETURN_IF_ERROR(_horizontal_compact_data(&statistics));
+    } else {
+        statistics.output_rows = _output_rowset->num_rows();
+    }
 
     TRACE_COUNTER_INCREMENT("merged_rows", statistics.merged_rows);
     TRACE_COUNTER_INCREMENT("filtered_rows", statistics.filtered_rows);
@@ -121,6 +126,7 @@ StatusOr<size_t> HorizontalCompactionTask::_compact_data(int32_t chunk_size, Tab
     size_t output_rows = 0;
     auto char_field_indexes = ChunkHelper::get_char_field_indexes(schema);
     auto chunk = ChunkHelper::new_chunk(schema, chunk_size);
+    auto rate_limiter = CompactionRateLimiter::create(compaction_priority_of(compaction_type()));
     while (LIKELY(!should_stop())) {
 #ifndef BE_TEST
         status = tls_thread_status.mem_tracker()->check_mem_limit("Compaction");
@@ -145,11 +151,13 @@ StatusOr<size_t> HorizontalCompactionTask::_compact_data(int32_t chunk_size, Tab
         ChunkHelper::padding_char_columns(char_field_indexes, schema, _tablet->tablet_schema(), chunk.get());
 
         RETURN_IF_ERROR(output_rs_writer->add_chunk(*chunk));
+        RETURN_IF_ERROR(rate_limiter.charge(chunk->bytes_usage(), [this] { return should_stop(); }));
         output_rows += chunk->num_rows();
         _task_info.output_num_rows = output_rows;
         _task_info.filtered_rows = reader.stats().rows_del_filtered;
         _task_info.merged_rows = reader.merged_rows();
     }
+    TRACE_COUNTER_INCREMENT("throttle_wait_us", rate_limiter.wait_ns() / 1000);
     TRACE("[Compaction] data compacted");
 
     if (should_stop()) {
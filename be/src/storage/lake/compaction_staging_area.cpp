@@ -0,0 +1,136 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "storage/lake/compaction_staging_area.h"
+
+#include <algorithm>
+
+#include "common/config.h"
+#include "common/logging.h"
+#include "fs/fs.h"
+#include "storage/lake/join_path.h"
+#include "storage/lake/rowset.h"
+#include "storage/lake/tablet.h"
+#include "util/defer_op.h"
+#include "util/threadpool.h"
+
+namespace starrocks::lake {
+
+static constexpr int64_t kDownloadBufferSize = 4 * 1024 * 1024;
+
+std::atomic<int64_t> CompactionStagingArea::s_total_staged_bytes{0};
+
+CompactionStagingArea::~CompactionStagingArea() {
+    s_total_staged_bytes.fetch_sub(_staged_bytes, std::memory_order_relaxed);
+    if (_dir_created) {
+        auto st = FileSystem::Default()->delete_dir_recursive(_dir);
+        LOG_IF(WARNING, !st.ok() && !st.is_not_found()) << "Fail to remove staging dir " << _dir << ": " << st;
+    }
+}
+
+Status CompactionStagingArea::stage(const Tablet& tablet, const std::vector<std::shared_ptr<Rowset>>& rowsets,
+                                    int parallelism) {
+    std::vector<std::string> segments;
+    for (const auto& rowset : rowsets) {
+        for (const auto& segment_name : rowset->metadata().segments()) {
+            segments.emplace_back(segment_name);
+        }
+    }
+    if (segments.empty()) {
+        return Status::OK();
+    }
+    RETURN_IF_ERROR(FileSystem::Default()->create_dir_recursive(_dir));
+    _dir_created = true;
+
+    std::atomic<size_t> next{0};
+    auto download = [&]() {
+        for (size_t i = next.fetch_add(1); i < segments.size(); i = next.fetch_add(1)) {
+            auto src = tablet.segment_location(segments[i]);
+            auto dst = join_path(_dir, segments[i]);
+            auto res = _download(src, dst);
+            if (!res.ok()) {
+                LOG(WARNING) << "Fail to download " << src << " for compaction, read it remotely: " << res.status();
+                (void)FileSystem::Default()->delete_file(dst);
+            } else if (*res) {
+                std::lock_guard l(_mutex);
+                _staged_files.emplace(std::move(src), std::move(dst));
+            }
+        }
+    };
+    int num_downloads = std::clamp<int>(parallelism, 1, segments.size());
+    auto token = _download_pool->new_token(ThreadPool::ExecutionMode::CONCURRENT);
+    Status st;
+    for (int i = 1; i < num_downloads && st.ok(); i++) {
+        st = token->submit_func(download);
+    }
+    if (st.ok()) {
+        download();
+    }
+    // the submitted downloads refer to the local variables
+    token->wait();
+    if (!st.ok()) {
+        LOG(WARNING) << "Fail to submit the download of the segments of tablet " << tablet.id() << ": " << st;
+        return st;
+    }
+    VLOG(2) << "Staged " << _staged_files.size() << "/" << segments.size() << " segments of tablet " << tablet.id()
+            << " in " << _dir << ", bytes: " << _staged_bytes;
+    return Status::OK();
+}
+
+bool CompactionStagingArea::_reserve(int64_t bytes) {
+    int64_t total = s_total_staged_bytes.load(std::memory_order_relaxed);
+    do {
+        if (total + bytes > config::lake_compaction_staging_max_bytes) {
+            return false;
+        }
+    } while (!s_total_staged_bytes.compare_exchange_weak(total, total + bytes, std::memory_order_relaxed));
+    std::lock_guard l(_mutex);
+    _staged_bytes += bytes;
+    return true;
+}
+
+void CompactionStagingArea::_release(int64_t bytes) {
+    s_total_staged_bytes.fetch_sub(bytes, std::memory_order_relaxed);
+    std::lock_guard l(_mutex);
+    _staged_bytes -= bytes;
+}
+
+StatusOr<bool> CompactionStagingArea::_download(const std::string& src, const std::string& dst) {
+    ASSIGN_OR_RETURN(auto src_fs, FileSystem::CreateSharedFromString(src));
+    ASSIGN_OR_RETURN(auto src_file, src_fs->new_random_access_file(src));
+    ASSIGN_OR_RETURN(auto size, src_file->get_size());
+    if (!_reserve(size)) {
+        return false;
+    }
+    bool downloaded = false;
+    DeferOp release_if_failed([&]() {
+        if (!downloaded) {
+            _release(size);
+        }
+    });
+    ASSIGN_OR_RETURN(auto dst_file, FileSystem::Default()->new_writable_file(dst));
+    std::string buffer;
+    buffer.resize(std::min(size, kDownloadBufferSize));
+    for (int64_t offset = 0; offset < size;) {
+        int64_t count = std::min<int64_t>(size - offset, buffer.size());
+        RETURN_IF_ERROR(src_file->read_at_fully(offset, buffer.data(), count));
+        RETURN_IF_ERROR(dst_file->append(Slice(buffer.data(), count)));
+        offset += count;
+    }
+    RETURN_IF_ERROR(dst_file->close());
+    downloaded = true;
+    return true;
+}
+
+} // namespace starrocks::lake
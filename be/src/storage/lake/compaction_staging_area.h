@@ -0,0 +1,81 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "common/statusor.h"
+#include "gutil/macros.h"
+
+namespace starrocks {
+class ThreadPool;
+}
+
+namespace starrocks::lake {
+
+class Rowset;
+class Tablet;
+
+// CompactionStagingArea downloads the input segments of a compaction task into a local directory in parallel,
+// so that the merge reads the local copies instead of paying the latency of the remote storage on every read.
+// The total size of the local copies of all the tasks is bounded by `lake_compaction_staging_max_bytes`, a
+// segment beyond the budget or failed to download is read remotely.
+// The local copies are removed when the staging area is destroyed.
+class CompactionStagingArea {
+public:
+    // |dir| is the directory owned by this staging area, it is created by `stage()` and removed on destruction.
+    // The segments are downloaded by the threads of |download_pool|, which must outlive this staging area.
+    CompactionStagingArea(std::string dir, ThreadPool* download_pool)
+            : _dir(std::move(dir)), _download_pool(download_pool) {}
+
+    ~CompactionStagingArea();
+
+    DISALLOW_COPY_AND_MOVE(CompactionStagingArea);
+
+    // Download the segments of |rowsets| of |tablet| with at most |parallelism| concurrent downloads, the calling
+    // thread being one of them.
+    Status stage(const Tablet& tablet, const std::vector<std::shared_ptr<Rowset>>& rowsets, int parallelism);
+
+    // The paths of the local copies keyed by the paths of the segments
+    const std::unordered_map<std::string, std::string>& staged_files() const { return _staged_files; }
+
+    int64_t staged_bytes() const { return _staged_bytes; }
+
+    // The total size of the local copies of all the staging areas
+    static int64_t total_staged_bytes() { return s_total_staged_bytes.load(std::memory_order_relaxed); }
+
+private:
+    // Return false if the segment is not downloaded as it exceeds the budget
+    StatusOr<bool> _download(const std::string& src, const std::string& dst);
+
+    bool _reserve(int64_t bytes);
+    void _release(int64_t bytes);
+
+    static std::atomic<int64_t> s_total_staged_bytes;
+
+    std::string _dir;
+    ThreadPool* _download_pool;
+    std::mutex _mutex;
+    std::unordered_map<std::string, std::string> _staged_files;
+    int64_t _staged_bytes = 0;
+    bool _dir_created = false;
+};
+
+} // namespace starrocks::lake
@@ -14,9 +14,13 @@
 
 #include "storage/lake/horizontal_compaction_task.h"
 
+#include <fmt/format.h>
+
 #include "runtime/runtime_state.h"
 #include "storage/chunk_helper.h"
 #include "storage/compaction_utils.h"
+#include "storage/lake/compaction_staging_area.h"
+#include "storage/lake/join_path.h"
 #include "storage/lake/rowset.h"
 #include "storage/lake/tablet_metadata.h"
 #include "storage/lake/tablet_reader.h"
@@ -50,6 +54,16 @@ Status HorizontalCompactionTask::execute(Stats* stats) {
     const int32_t chunk_size = CompactionUtils::get_read_chunk_size(
             config::compaction_memory_limit_per_worker, config::vector_chunk_size, num_rows, num_size, max_input_segs);
 
+    // download the input segments in parallel before merging them, instead of reading them one by one remotely
+    std::unique_ptr<CompactionStagingArea> staging_area;
+    std::string staging_dir = config::lake_compaction_staging_dir;
+    if (!staging_dir.empty()) {
+        staging_area = std::make_unique<CompactionStagingArea>(
+                join_path(staging_dir, fmt::format("{}_{}", _tablet->id(), _txn_id)),
+                _tablet->tablet_mgr()->compaction_download_pool());
+        RETURN_IF_ERROR(staging_area->stage(*_tablet, _input_rowsets, config::lake_compaction_download_parallelism));
+    }
+
     Schema schema = ChunkHelper::convert_schema(*tablet_schema);
     TabletReader reader(*_tablet, _version, schema, _input_rowsets);
     RETURN_IF_ERROR(reader.prepare());
@@ -58,6 +72,7 @@ Status HorizontalCompactionTask::execute(Stats* stats) {
     reader_params.chunk_size = chunk_size;
     reader_params.profile = nullptr;
     reader_params.use_page_cache = false;
+    reader_params.staged_files = staging_area != nullptr ? &staging_area->staged_files() : nullptr;
     RETURN_IF_ERROR(reader.open(reader_params));
 
     ASSIGN_OR_RETURN(auto writer, _tablet->new_writer());
@@ -14,6 +14,7 @@
 
 #include "storage/lake/rowset.h"
 
+#include "common/config.h"
 #include "storage/chunk_helper.h"
 #include "storage/chunk_iterator.h"
 #include "storage/delete_predicates.h"
@@ -48,6 +49,8 @@ StatusOr<ChunkIteratorPtr> Rowset::read(const Schema& schema, const RowsetReadOp
     seg_options.predicates = options.predicates;
     seg_options.predicates_for_zone_map = options.predicates_for_zone_map;
     seg_options.use_page_cache = options.use_page_cache;
+    seg_options.use_block_cache = config::block_cache_lake_segment_enable;
+    seg_options.staged_files = options.staged_files;
     seg_options.profile = options.profile;
     seg_options.reader_type = options.reader_type;
     seg_options.chunk_size = options.chunk_size;
@@ -118,6 +118,8 @@ public:
 
     UpdateManager* update_mgr() { return _mgr->update_mgr(); }
 
+    TabletManager* tablet_mgr() { return _mgr; }
+
 private:
     TabletManager* _mgr;
     int64_t _id;
@@ -16,6 +16,7 @@
 
 #include <bthread/bthread.h>
 
+#include <algorithm>
 #include <atomic>
 #include <chrono>
 #include <variant>
@@ -57,11 +58,21 @@ static StatusOr<double> publish(LocationProvider* location_provider, Tablet* tab
 
 TabletManager::TabletManager(LocationProvider* location_provider, UpdateManager* update_mgr, int64_t cache_capacity)
         : _location_provider(location_provider),
-          _metacache(new_lru_cache(cache_capacity)),
+          _metacache(new_lru_cache(cache_capacity,
+                                   cache_policy_from_string(config::lake_metadata_cache_eviction_policy))),
           _update_mgr(update_mgr),
-          _gc_checker_tid(INVALID_BTHREAD) {}
+          _gc_checker_tid(INVALID_BTHREAD) {
+    auto st = ThreadPoolBuilder("lake_compact_dl")
+                      .set_min_threads(0)
+                      .set_max_threads(std::max(1, config::lake_compaction_download_threads))
+                      .build(&_compaction_download_pool);
+    CHECK(st.ok()) << st;
+}
 
 TabletManager::~TabletManager() {
+    if (_compaction_download_pool != nullptr) {
+        _compaction_download_pool->shutdown();
+    }
     if (_gc_checker_tid != INVALID_BTHREAD) {
         [[maybe_unused]] void* ret = nullptr;
         // We don't care about the return value of bthread_stop or bthread_join.
@@ -30,6 +30,7 @@ class Cache;
 class CacheKey;
 class Segment;
 class TCreateTabletReq;
+class ThreadPool;
 } // namespace starrocks
 
 namespace starrocks::lake {
@@ -143,6 +144,9 @@ public:
 
     UpdateManager* update_mgr();
 
+    // The pool downloading the input segments of the compaction tasks, see `CompactionStagingArea`.
+    ThreadPool* compaction_download_pool() { return _compaction_download_pool.get(); }
+
 private:
     using CacheValue = std::variant<TabletMetadataPtr, TxnLogPtr, TabletSchemaPtr, SegmentPtr>;
 
@@ -167,6 +171,7 @@ private:
     LocationProvider* _location_provider;
     std::unique_ptr<Cache> _metacache;
     UpdateManager* _update_mgr;
+    std::unique_ptr<ThreadPool> _compaction_download_pool;
 
     bthread_t _gc_checker_tid;
 };
@@ -27,6 +27,8 @@
 #include "storage/primary_key_encoder.h"
 #include "storage/tablet_schema.h"
 #include "types/logical_type_infra.h"
+#include "util/hash_util.hpp"
+#include "util/phmap/phmap.h"
 #include "util/starrocks_metrics.h"
 #include "util/time.h"
 
@@ -174,6 +176,10 @@ bool MemTable::insert(const Chunk& chunk, const uint32_t* indexes, uint32_t from
     if (is_full()) {
         size_t orig_bytes = write_buffer_size();
         _merge();
+        if (_hash_group && _merge_count > 1 && !_compact_runs_disabled &&
+            _aggregator_bytes_usage * 2 >= _max_buffer_size) {
+            _compact_runs();
+        }
         size_t new_bytes = write_buffer_size();
         if (new_bytes > orig_bytes * 2 / 3 && _merge_count <= 1) {
             // this means aggregate doesn't remove enough duplicate rows,
@@ -205,7 +211,7 @@ Status MemTable::finalize() {
                 _merge();
             }
 
-            if (_merge_count > 1) {
+            if (_merge_count > 1 || _has_unsorted_run) {
                 _chunk = _aggregator->aggregate_result();
                 _aggregator->aggregate_reset();
 
@@ -295,13 +301,50 @@ void MemTable::_merge() {
         return;
     }
 
+    size_t num_rows = _chunk->num_rows();
+    size_t merged_rows = _aggregator->merged_rows();
     int64_t t1 = MonotonicMicros();
-    _sort(false);
+    _sort(false, false, _hash_group);
     int64_t t2 = MonotonicMicros();
     _aggregate(false);
     int64_t t3 = MonotonicMicros();
-    VLOG(1) << strings::Substitute("memtable sort:$0 agg:$1 total:$2", t2 - t1, t3 - t2, t3 - t1);
+    VLOG(1) << strings::Substitute("memtable $0:$1 agg:$2 total:$3", _hash_group ? "group" : "sort", t2 - t1,
+                                   t3 - t2, t3 - t1);
     ++_merge_count;
+    _has_unsorted_run |= _hash_group;
+    _num_hash_grouped_runs += _hash_group;
+
+    if (num_rows > 0) {
+        // Group the rows of the next runs by hash if the keys of this run are highly duplicated. The rows
+        // with a merge condition have to be sorted by the condition column besides the keys.
+        double dup_ratio = static_cast<double>(_aggregator->merged_rows() - merged_rows) / num_rows;
+        double min_dup_ratio = config::memtable_hash_aggregate_dup_ratio;
+        _hash_group = min_dup_ratio > 0 && dup_ratio >= min_dup_ratio && _merge_condition.empty();
+    }
+}
+
+void MemTable::_compact_runs() {
+    size_t orig_bytes = _aggregator_bytes_usage;
+    // |_chunk| has been emptied by the last merge, keep it for the following inserts
+    ChunkPtr chunk = std::move(_chunk);
+    _chunk = _aggregator->aggregate_result();
+    _aggregator->aggregate_reset();
+    _aggregator_memory_usage = 0;
+    _aggregator_bytes_usage = 0;
+
+    int64_t t1 = MonotonicMicros();
+    _sort(false, false, true);
+    _aggregate(false);
+    int64_t t2 = MonotonicMicros();
+    _chunk = std::move(chunk);
+    _merge_count = 1;
+    _has_unsorted_run = true;
+    VLOG(1) << strings::Substitute("memtable compact runs:$0 bytes:$1->$2", t2 - t1, orig_bytes,
+                                   _aggregator_bytes_usage);
+    if (_aggregator_bytes_usage > orig_bytes * 2 / 3) {
+        // The runs hardly share keys, flushing them is cheaper than merging them again.
+        _compact_runs_disabled = true;
+    }
 }
 
 void MemTable::_aggregate(bool is_final) {
@@ -332,10 +375,14 @@ void MemTable::_aggregate(bool is_final) {
     }
 }
 
-void MemTable::_sort(bool is_final, bool by_sort_key) {
+void MemTable::_sort(bool is_final, bool by_sort_key, bool group_only) {
     SmallPermutation perm = create_small_permutation(static_cast<uint32_t>(_chunk->num_rows()));
     std::swap(perm, _permutations);
-    _sort_column_inc(by_sort_key);
+    if (group_only) {
+        _group_column_by_hash();
+    } else {
+        _sort_column_inc(by_sort_key);
+    }
     if (is_final) {
         // No need to reserve, it will be reserve in IColumn::append_selective(),
         // Otherwise it will use more peak memory
@@ -439,4 +486,59 @@ void MemTable::_sort_column_inc(bool by_sort_key) {
     CHECK(st.ok());
 }
 
+// Make the rows with equal keys adjacent without sorting them. The groups of equal keys are ordered by
+// their first rows and every group keeps the order of its rows, so aggregating the result gives the same
+// rows as aggregating a stable sort of the keys, only in a different order.
+void MemTable::_group_column_by_hash() {
+    static constexpr uint32_t kNoGroup = UINT32_MAX;
+    const auto num_rows = static_cast<uint32_t>(_chunk->num_rows());
+    _hashes.assign(num_rows, HashUtil::FNV_SEED);
+    for (ColumnId i = 0; i < _vectorized_schema->num_key_fields(); ++i) {
+        _chunk->get_column_by_index(i)->fnv_hash(_hashes.data(), 0, num_rows);
+    }
+
+    // the first row of every group, and the previous group with the same hash
+    std::vector<uint32_t> group_rows;
+    std::vector<uint32_t> next_groups;
+    std::vector<uint32_t> row_groups(num_rows);
+    phmap::flat_hash_map<uint32_t, uint32_t> hash_to_group;
+    for (uint32_t row = 0; row < num_rows; ++row) {
+        auto [iter, inserted] = hash_to_group.emplace(_hashes[row], static_cast<uint32_t>(group_rows.size()));
+        uint32_t group = inserted ? kNoGroup : iter->second;
+        while (group != kNoGroup && !_keys_equal(group_rows[group], row)) {
+            group = next_groups[group];
+        }
+        if (group == kNoGroup) {
+            group = static_cast<uint32_t>(group_rows.size());
+            group_rows.push_back(row);
+            next_groups.push_back(inserted ? kNoGroup : iter->second);
+            iter->second = group;
+        }
+        row_groups[row] = group;
+    }
+
+    // counting sort by group
+    std::vector<uint32_t> offsets(group_rows.size() + 1, 0);
+    for (uint32_t row = 0; row < num_rows; ++row) {
+        ++offsets[row_groups[row] + 1];
+    }
+    for (size_t i = 1; i < offsets.size(); ++i) {
+        offsets[i] += offsets[i - 1];
+    }
+    DCHECK_EQ(num_rows, _permutations.size());
+    for (uint32_t row = 0; row < num_rows; ++row) {
+        _permutations[offsets[row_groups[row]]++].index_in_chunk = row;
+    }
+}
+
+bool MemTable::_keys_equal(uint32_t lhs, uint32_t rhs) const {
+    for (ColumnId i = 0; i < _vectorized_schema->num_key_fields(); ++i) {
+        const ColumnPtr& column = _chunk->get_column_by_index(i);
+        if (column->compare_at(lhs, rhs, *column, -1) != 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
 } // namespace starrocks
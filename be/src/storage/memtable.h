@@ -64,17 +64,25 @@ public:
 
     void set_write_buffer_row(size_t max_buffer_row) { _max_buffer_row = max_buffer_row; }
 
+    // the number of runs whose rows were grouped by hash instead of sorted before being aggregated
+    size_t num_hash_grouped_runs() const { return _num_hash_grouped_runs; }
+
     static Schema convert_schema(const TabletSchema* tablet_schema, const std::vector<SlotDescriptor*>* slot_descs);
 
 private:
     void _merge();
 
-    void _sort(bool is_final, bool by_sort_key = false);
+    // If |group_only| is true, the rows with equal keys are only made adjacent instead of sorted.
+    void _sort(bool is_final, bool by_sort_key = false, bool group_only = false);
     void _sort_column_inc(bool by_sort_key = false);
+    void _group_column_by_hash();
+    bool _keys_equal(uint32_t lhs, uint32_t rhs) const;
     void _append_to_sorted_chunk(Chunk* src, Chunk* dest, bool is_final);
 
     void _init_aggregator_if_needed();
     void _aggregate(bool is_final);
+    // Merge all the aggregated runs into one to remove the duplicated keys between runs.
+    void _compact_runs();
 
     Status _split_upserts_deletes(ChunkPtr& src, ChunkPtr* upserts, std::unique_ptr<Column>* deletes);
 
@@ -97,7 +105,14 @@ private:
     // aggregate
     std::unique_ptr<ChunkAggregator> _aggregator;
 
+    // the number of aggregated runs in |_aggregator|
     uint64_t _merge_count = 0;
+    // whether the aggregated runs are grouped by hash instead of sorted
+    bool _hash_group = false;
+    bool _has_unsorted_run = false;
+    bool _compact_runs_disabled = false;
+    size_t _num_hash_grouped_runs = 0;
+    std::vector<uint32_t> _hashes;
 
     bool _has_op_slot = false;
     std::unique_ptr<Column> _deletes;
@@ -36,6 +36,7 @@
 
 #include <malloc.h>
 
+#include "common/config.h"
 #include "runtime/current_thread.h"
 #include "runtime/mem_tracker.h"
 #include "util/defer_op.h"
@@ -81,7 +82,8 @@ static void init_metrics() {
 }
 
 StoragePageCache::StoragePageCache(MemTracker* mem_tracker, size_t capacity)
-        : _mem_tracker(mem_tracker), _cache(new_lru_cache(capacity)) {
+        : _mem_tracker(mem_tracker),
+          _cache(new_lru_cache(capacity, cache_policy_from_string(config::storage_page_cache_eviction_policy))) {
     init_metrics();
 }
 
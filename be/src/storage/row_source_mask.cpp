@@ -14,6 +14,8 @@
 
 #include "storage/row_source_mask.h"
 
+#include <unistd.h>
+
 #include <utility>
 
 #include "common/config.h"
@@ -103,16 +105,28 @@ size_t RowSourceMaskBuffer::max_same_source_count(uint16_t source, size_t limit_
 Status RowSourceMaskBuffer::flip_to_read() {
     _current_index = 0;
     if (_tmp_file_fd > 0) {
-        off_t offset = lseek(_tmp_file_fd, 0, SEEK_SET);
-        if (offset != 0) {
-            PLOG(WARNING) << "fail to seek to offset 0. offset=" << offset;
-            return Status::InternalError("fail to seek to offset 0");
-        }
+        _read_offset = 0;
         _reset_mask_column();
     }
     return Status::OK();
 }
 
+StatusOr<std::unique_ptr<RowSourceMaskBuffer>> RowSourceMaskBuffer::clone_for_read() const {
+    auto buffer = std::make_unique<RowSourceMaskBuffer>(_tablet_id, _storage_root_path);
+    if (_tmp_file_fd > 0) {
+        DCHECK(_mask_column->empty()) << "the buffer must be flushed before clone";
+        // the masks are read with pread, so the duplicated fd can be read concurrently with the origin one
+        buffer->_tmp_file_fd = ::dup(_tmp_file_fd);
+        if (buffer->_tmp_file_fd < 0) {
+            PLOG(WARNING) << "fail to dup mask tmp file";
+            return Status::InternalError("fail to dup mask tmp file");
+        }
+    } else {
+        buffer->_mask_column->append(*_mask_column, 0, _mask_column->size());
+    }
+    return std::move(buffer);
+}
+
 Status RowSourceMaskBuffer::flush() {
     if (_tmp_file_fd > 0 && !_mask_column->empty()) {
         RETURN_IF_ERROR(_serialize_masks());
@@ -154,7 +168,7 @@ Status RowSourceMaskBuffer::_serialize_masks() {
 
 Status RowSourceMaskBuffer::_deserialize_masks() {
     uint64_t num_rows = 0;
-    ssize_t r_size = ::read(_tmp_file_fd, &num_rows, sizeof(num_rows));
+    ssize_t r_size = ::pread(_tmp_file_fd, &num_rows, sizeof(num_rows), _read_offset);
     if (r_size == 0) {
         return Status::EndOfFile("end of file");
     } else if (r_size != sizeof(uint64_t)) {
@@ -164,11 +178,13 @@ Status RowSourceMaskBuffer::_deserialize_masks() {
 
     std::vector<uint16_t> content;
     raw::stl_vector_resize_uninitialized(&content, num_rows);
-    r_size = ::read(_tmp_file_fd, content.data(), content.size() * sizeof(content[0]));
+    r_size = ::pread(_tmp_file_fd, content.data(), content.size() * sizeof(content[0]),
+                     _read_offset + sizeof(num_rows));
     if (r_size != content.size() * sizeof(content[0])) {
         PLOG(WARNING) << "fail to read masks from mask file. read size=" << r_size;
         return Status::InternalError("fail to read masks from mask file");
     }
+    _read_offset += sizeof(num_rows) + r_size;
     _mask_column->get_data().swap(content);
     return Status::OK();
 }
@@ -14,6 +14,8 @@
 
 #pragma once
 
+#include <memory>
+
 #include "column/fixed_length_column.h"
 #include "common/statusor.h"
 
@@ -87,6 +89,10 @@ public:
     Status flip_to_read();
     Status flush();
 
+    // Create a buffer to read the flushed masks from the beginning, independently of this buffer.
+    // Used to merge several column groups concurrently in vertical compaction.
+    StatusOr<std::unique_ptr<RowSourceMaskBuffer>> clone_for_read() const;
+
 private:
     void _reset_mask_column() { _mask_column->reset_column(); }
     Status _create_tmp_file();
@@ -97,6 +103,8 @@ private:
 
     // for read
     uint64_t _current_index = 0;
+    // the offset of the temporary file to deserialize the next masks from
+    uint64_t _read_offset = 0;
 
     // temporary file for persistence
     int _tmp_file_fd = -1;
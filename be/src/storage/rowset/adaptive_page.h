@@ -0,0 +1,287 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <vector>
+
+#include "column/column.h"
+#include "storage/rowset/common.h"
+#include "storage/rowset/encoding_info.h"
+#include "storage/rowset/options.h"
+#include "storage/rowset/page_builder.h"
+#include "storage/rowset/page_decoder.h"
+#include "storage/type_traits.h"
+#include "util/coding.h"
+#include "util/faststring.h"
+
+namespace starrocks {
+
+// The relative decoding cost of every encoding which can be chosen by AdaptivePageBuilder, in percent.
+// The estimated size of a page is multiplied by this factor, so an encoding which is slower to decode
+// must save more space to be chosen.
+// BIT_SHUFFLE pages are decompressed only once, when the page is loaded into the page cache, while
+// FOR, DELTA and RLE pages are decoded on every read.
+inline uint32_t adaptive_encoding_decode_cost(EncodingTypePB encoding) {
+    switch (encoding) {
+    case PLAIN_ENCODING:
+        return 100;
+    case BIT_SHUFFLE:
+        return 105;
+    case FOR_ENCODING:
+    case DELTA_ENCODING:
+        return 110;
+    case DELTA_OF_DELTA_ENCODING:
+        return 115;
+    case RLE:
+        return 130;
+    default:
+        return 150;
+    }
+}
+
+// AdaptivePageBuilder chooses the encoding of every data page separately.
+//
+// The raw values of a page are buffered until the page is finished, then a sample of them is encoded
+// with every candidate encoding of the type, and the whole page is encoded with the candidate which has
+// the smallest estimated size weighted by its decoding cost.
+//
+// The page format is as follows:
+//
+// 1. Header: (4 bytes total)
+//
+//    <encoding> [32-bit]
+//      The EncodingTypePB of the page body.
+//
+// 2. Body
+//
+//    The page built by the page builder of the chosen encoding.
+//
+template <LogicalType Type>
+class AdaptivePageBuilder final : public PageBuilder {
+public:
+    // Number of contiguous runs of values sampled from a page, and the number of values in each run.
+    static constexpr uint32_t kNumSampleRuns = 4;
+    static constexpr uint32_t kSampleRunLength = 512;
+
+    explicit AdaptivePageBuilder(const PageBuilderOptions& options)
+            : _options(options), _max_count(std::max<uint32_t>(1, options.data_page_size / SIZE_OF_TYPE)) {
+        _data.reserve(_max_count * SIZE_OF_TYPE);
+    }
+
+    ~AdaptivePageBuilder() override = default;
+
+    bool is_page_full() override { return _count >= _max_count; }
+
+    uint32_t add(const uint8_t* vals, uint32_t count) override {
+        DCHECK(!_finished);
+        uint32_t to_add = std::min<uint32_t>(_max_count - _count, count);
+        _data.append(vals, to_add * SIZE_OF_TYPE);
+        _count += to_add;
+        return to_add;
+    }
+
+    faststring* finish() override {
+        DCHECK(!_finished);
+        _finished = true;
+        if (_count > 0) {
+            memcpy(&_first_value, &_data[0], SIZE_OF_TYPE);
+            memcpy(&_last_value, &_data[(_count - 1) * SIZE_OF_TYPE], SIZE_OF_TYPE);
+        }
+        _selected_encoding = _select_encoding();
+        faststring* body = _encode(_selected_encoding, _data.data(), _count);
+
+        _buffer.clear();
+        _buffer.resize(ADAPTIVE_PAGE_HEADER_SIZE);
+        encode_fixed32_le(_buffer.data(), _selected_encoding);
+        _buffer.append(body->data(), body->size());
+        return &_buffer;
+    }
+
+    void reset() override {
+        _count = 0;
+        _data.clear();
+        _finished = false;
+    }
+
+    uint32_t count() const override { return _count; }
+
+    uint64_t size() const override { return _data.size(); }
+
+    Status get_first_value(void* value) const override {
+        DCHECK(_finished);
+        if (_count == 0) {
+            return Status::NotFound("page is empty");
+        }
+        memcpy(value, &_first_value, SIZE_OF_TYPE);
+        return Status::OK();
+    }
+
+    Status get_last_value(void* value) const override {
+        DCHECK(_finished);
+        if (_count == 0) {
+            return Status::NotFound("page is empty");
+        }
+        memcpy(value, &_last_value, SIZE_OF_TYPE);
+        return Status::OK();
+    }
+
+    // The encoding chosen for the last finished page.
+    EncodingTypePB selected_encoding() const { return _selected_encoding; }
+
+    // The encodings which may be chosen for a page of |Type|, the first one is used for empty pages.
+    static const std::vector<EncodingTypePB>& candidate_encodings() {
+        static const std::vector<EncodingTypePB> s_candidates = [] {
+            std::vector<EncodingTypePB> candidates;
+            for (EncodingTypePB encoding :
+                 {BIT_SHUFFLE, FOR_ENCODING, DELTA_ENCODING, DELTA_OF_DELTA_ENCODING, RLE, PLAIN_ENCODING}) {
+                const EncodingInfo* info = nullptr;
+                if (EncodingInfo::get(Type, encoding, &info).ok()) {
+                    candidates.push_back(encoding);
+                }
+            }
+            return candidates;
+        }();
+        return s_candidates;
+    }
+
+private:
+    typedef typename TypeTraits<Type>::CppType CppType;
+    enum { SIZE_OF_TYPE = TypeTraits<Type>::size };
+
+    EncodingTypePB _select_encoding() {
+        const auto& candidates = candidate_encodings();
+        DCHECK(!candidates.empty());
+        if (_count == 0 || candidates.size() == 1) {
+            return candidates[0];
+        }
+        // Sample several runs evenly spread over the page, the runs are kept contiguous because
+        // encodings like FOR, DELTA and RLE depend on the locality of the values.
+        const uint32_t run_length = std::min<uint32_t>(kSampleRunLength, _count);
+        const uint32_t num_runs = std::min<uint32_t>(kNumSampleRuns, _count / run_length);
+        const uint32_t stride = num_runs > 1 ? (_count - run_length) / (num_runs - 1) : 0;
+
+        EncodingTypePB best = candidates[0];
+        uint64_t best_score = std::numeric_limits<uint64_t>::max();
+        for (EncodingTypePB encoding : candidates) {
+            uint64_t estimated_size = 0;
+            for (uint32_t i = 0; i < num_runs; i++) {
+                const uint8_t* run = _data.data() + static_cast<size_t>(i) * stride * SIZE_OF_TYPE;
+                estimated_size += _encode(encoding, run, run_length)->size();
+            }
+            uint64_t score = estimated_size * adaptive_encoding_decode_cost(encoding);
+            if (score < best_score) {
+                best_score = score;
+                best = encoding;
+            }
+        }
+        return best;
+    }
+
+    faststring* _encode(EncodingTypePB encoding, const uint8_t* vals, uint32_t count) {
+        PageBuilder* builder = _get_builder(encoding);
+        builder->reset();
+        [[maybe_unused]] uint32_t added = builder->add(vals, count);
+        DCHECK_EQ(count, added);
+        return builder->finish();
+    }
+
+    PageBuilder* _get_builder(EncodingTypePB encoding) {
+        for (auto& [builder_encoding, builder] : _builders) {
+            if (builder_encoding == encoding) {
+                return builder.get();
+            }
+        }
+        const EncodingInfo* info = nullptr;
+        PageBuilder* builder = nullptr;
+        CHECK(EncodingInfo::get(Type, encoding, &info).ok());
+        CHECK(info->create_page_builder(_options, &builder).ok());
+        _builders.emplace_back(encoding, std::unique_ptr<PageBuilder>(builder));
+        return builder;
+    }
+
+    PageBuilderOptions _options;
+    uint32_t _max_count;
+    uint32_t _count{0};
+    bool _finished{false};
+    EncodingTypePB _selected_encoding{UNKNOWN_ENCODING};
+    faststring _data;
+    faststring _buffer;
+    CppType _first_value;
+    CppType _last_value;
+    std::vector<std::pair<EncodingTypePB, std::unique_ptr<PageBuilder>>> _builders;
+};
+
+template <LogicalType Type>
+class AdaptivePageDecoder final : public PageDecoder {
+public:
+    AdaptivePageDecoder(Slice data, const PageDecoderOptions& options) : _data(data), _options(options) {}
+
+    ~AdaptivePageDecoder() override = default;
+
+    Status init() override {
+        CHECK(!_parsed);
+        if (_data.size < ADAPTIVE_PAGE_HEADER_SIZE) {
+            return Status::Corruption("not enough bytes for header in AdaptivePageDecoder");
+        }
+        auto encoding = static_cast<EncodingTypePB>(decode_fixed32_le((const uint8_t*)&_data[0]));
+        if (encoding == ADAPTIVE_ENCODING) {
+            return Status::Corruption("invalid encoding type in adaptive page header");
+        }
+        const EncodingInfo* info = nullptr;
+        RETURN_IF_ERROR(EncodingInfo::get(Type, encoding, &info));
+        PageDecoder* decoder = nullptr;
+        Slice body(_data.data + ADAPTIVE_PAGE_HEADER_SIZE, _data.size - ADAPTIVE_PAGE_HEADER_SIZE);
+        RETURN_IF_ERROR(info->create_page_decoder(body, _options, &decoder));
+        _page_decoder.reset(decoder);
+        RETURN_IF_ERROR(_page_decoder->init());
+        _parsed = true;
+        return Status::OK();
+    }
+
+    Status seek_to_position_in_page(uint32_t pos) override {
+        DCHECK(_parsed) << "Must call init() firstly";
+        return _page_decoder->seek_to_position_in_page(pos);
+    }
+
+    Status seek_at_or_after_value(const void* value, bool* exact_match) override {
+        DCHECK(_parsed) << "Must call init() firstly";
+        return _page_decoder->seek_at_or_after_value(value, exact_match);
+    }
+
+    size_t seek_forward(uint32_t n) override { return _page_decoder->seek_forward(n); }
+
+    Status next_batch(size_t* n, Column* dst) override { return _page_decoder->next_batch(n, dst); }
+
+    Status next_batch(const SparseRange& range, Column* dst) override { return _page_decoder->next_batch(range, dst); }
+
+    uint32_t count() const override { return _page_decoder->count(); }
+
+    uint32_t current_index() const override { return _page_decoder->current_index(); }
+
+    // Return the encoding actually used by this page.
+    EncodingTypePB encoding_type() const override { return _page_decoder->encoding_type(); }
+
+private:
+    Slice _data;
+    PageDecoderOptions _options;
+    bool _parsed{false};
+    std::unique_ptr<PageDecoder> _page_decoder;
+};
+
+} // namespace starrocks
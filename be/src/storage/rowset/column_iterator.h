@@ -140,6 +140,18 @@ public:
         return Status::NotSupported("");
     }
 
+    // push |predicates| of this column down into the iterator, so they are evaluated while the column is
+    // read instead of after it. for dictionary encoded pages the predicates are evaluated once against the
+    // dictionary and applied to the codes, only the values of selected rows are materialized.
+    // the result of every row returned by `next_batch` is appended to `pushed_down_selection()`, the values
+    // of the rows that are not selected are unspecified.
+    // return false if the predicates can not be pushed down, the caller must evaluate them by itself.
+    virtual bool push_down_predicates(const std::vector<const ColumnPredicate*>& predicates) { return false; }
+
+    // return the selection of the pushed down predicates, nullptr if no predicate has been pushed down.
+    // the caller should clear it after consuming.
+    virtual std::vector<uint8_t>* pushed_down_selection() { return nullptr; }
+
     // Return the current array element position.
     virtual int64_t element_ordinal() const { return -1; }
 
@@ -50,6 +50,7 @@
 #include "storage/rowset/bloom_filter.h"
 #include "storage/rowset/bloom_filter_index_reader.h"
 #include "storage/rowset/encoding_info.h"
+#include "storage/rowset/json_column_iterator.h"
 #include "storage/rowset/map_column_iterator.h"
 #include "storage/rowset/page_handle.h"
 #include "storage/rowset/page_io.h"
@@ -115,6 +116,21 @@ Status ColumnReader::_init(ColumnMetaPB* meta) {
         // TODO(mofei) store format_version in ColumnReader
         const JsonMetaPB& json_meta = meta->json_meta();
         CHECK_EQ(kJsonMetaDefaultFormatVersion, json_meta.format_version()) << "Only format_version=1 is supported";
+        if (json_meta.flat_paths_size() > 0) {
+            if (json_meta.flat_paths_size() != meta->children_columns_size()) {
+                return Status::Corruption(
+                        fmt::format("Bad file {}: JSON column {} has {} flat paths but {} children columns",
+                                    file_name(), meta->column_id(), json_meta.flat_paths_size(),
+                                    meta->children_columns_size()));
+            }
+            _json_flat_paths = std::make_unique<std::vector<std::string>>(json_meta.flat_paths().begin(),
+                                                                          json_meta.flat_paths().end());
+            _sub_readers = std::make_unique<SubReaderList>();
+            for (int i = 0; i < meta->children_columns_size(); ++i) {
+                ASSIGN_OR_RETURN(auto sub_reader, ColumnReader::create(meta->mutable_children_columns(i), _segment));
+                _sub_readers->emplace_back(std::move(sub_reader));
+            }
+        }
     }
     if (is_scalar_field_type(delegate_type(_column_type))) {
         RETURN_IF_ERROR(EncodingInfo::get(delegate_type(_column_type), meta->encoding(), &_encoding_info));
@@ -477,7 +493,18 @@ bool ColumnReader::segment_zone_map_filter(const std::vector<const ColumnPredica
 }
 
 StatusOr<std::unique_ptr<ColumnIterator>> ColumnReader::new_iterator() {
-    if (is_scalar_field_type(delegate_type(_column_type))) {
+    if (_column_type == TYPE_JSON && _json_flat_paths != nullptr) {
+        std::vector<LogicalType> flat_types;
+        std::vector<std::unique_ptr<ColumnIterator>> flat_iters;
+        for (auto& sub_reader : *_sub_readers) {
+            flat_types.emplace_back(sub_reader->column_type());
+            ASSIGN_OR_RETURN(auto flat_iter, sub_reader->new_iterator());
+            flat_iters.emplace_back(std::move(flat_iter));
+        }
+        return std::make_unique<JsonFlatColumnIterator>(std::make_unique<ScalarColumnIterator>(this),
+                                                        *_json_flat_paths, std::move(flat_types),
+                                                        std::move(flat_iters));
+    } else if (is_scalar_field_type(delegate_type(_column_type))) {
         return std::make_unique<ScalarColumnIterator>(this);
     } else if (_column_type == LogicalType::TYPE_ARRAY) {
         size_t col = 0;
@@ -206,6 +206,8 @@ private:
 
     using SubReaderList = std::vector<std::unique_ptr<ColumnReader>>;
     std::unique_ptr<SubReaderList> _sub_readers;
+    // the keys of the flat columns of a JSON column, which are read by the _sub_readers
+    std::unique_ptr<std::vector<std::string>> _json_flat_paths;
 
     // Pointer to its father segment, as the column reader
     // is never released before the end of the parent's life cycle,
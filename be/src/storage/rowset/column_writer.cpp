@@ -51,6 +51,7 @@
 #include "storage/rowset/bloom_filter.h"
 #include "storage/rowset/bloom_filter_index_writer.h"
 #include "storage/rowset/encoding_info.h"
+#include "storage/rowset/json_column_writer.h"
 #include "storage/rowset/map_column_writer.h"
 #include "storage/rowset/options.h"
 #include "storage/rowset/ordinal_page_index.h"
@@ -263,6 +264,8 @@ StatusOr<std::unique_ptr<ColumnWriter>> ColumnWriter::create(const ColumnWriterO
         str_opts.need_speculate_encoding = true;
         auto column_writer = std::make_unique<ScalarColumnWriter>(str_opts, type_info, wfile);
         return std::make_unique<StringColumnWriter>(str_opts, std::move(type_info), std::move(column_writer));
+    } else if (column->type() == TYPE_JSON && config::enable_json_flat && opts.meta->has_json_meta()) {
+        return create_json_column_writer(opts, std::move(type_info), wfile);
     } else if (is_scalar_field_type(delegate_type(column->type()))) {
         return std::make_unique<ScalarColumnWriter>(opts, std::move(type_info), wfile);
     } else {
@@ -312,7 +315,13 @@ Status ScalarColumnWriter::init() {
     RETURN_IF_ERROR(get_block_compression_codec(_opts.meta->compression(), &_compress_codec));
 
     if (!_opts.need_speculate_encoding) {
-        set_encoding(_opts.meta->encoding());
+        EncodingTypePB encoding = _opts.meta->encoding();
+        const EncodingInfo* adaptive_encoding_info = nullptr;
+        if (encoding == DEFAULT_ENCODING && config::enable_adaptive_page_encoding &&
+            EncodingInfo::get(type_info()->type(), ADAPTIVE_ENCODING, &adaptive_encoding_info).ok()) {
+            encoding = ADAPTIVE_ENCODING;
+        }
+        set_encoding(encoding);
     }
     // create ordinal builder
     _ordinal_index_builder = std::make_unique<OrdinalIndexWriter>();
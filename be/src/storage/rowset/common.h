@@ -41,6 +41,7 @@
 
 enum { BINARY_DICT_PAGE_HEADER_SIZE = 4 };
 enum { BITSHUFFLE_PAGE_HEADER_SIZE = 16 };
+enum { ADAPTIVE_PAGE_HEADER_SIZE = 4 };
 
 namespace starrocks {
 
@@ -0,0 +1,479 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+#include "column/column.h"
+#include "gutil/strings/substitute.h"
+#include "runtime/time_types.h"
+#include "storage/rowset/options.h"
+#include "storage/rowset/page_builder.h"
+#include "storage/rowset/page_decoder.h"
+#include "storage/type_traits.h"
+#include "util/bit_packing.inline.h"
+#include "util/bit_stream_utils.inline.h"
+#include "util/coding.h"
+#include "util/faststring.h"
+
+namespace starrocks {
+
+// Number of values in every block of a delta page.
+static const uint32_t DELTA_PAGE_BLOCK_SIZE = 128;
+static const size_t DELTA_PAGE_HEADER_SIZE = 8;
+
+// The values of a datetime page are converted to microseconds since the julian epoch before
+// computing the deltas, so that the deltas do not jump at every day boundary.
+static const uint32_t DELTA_PAGE_FLAG_LINEAR_DATETIME = 1;
+
+// In-place inclusive prefix sum of |n| values starting from |base|, all arithmetic wraps around.
+// Return the last sum.
+inline uint64_t delta_prefix_sum(uint64_t* values, size_t n, uint64_t base) {
+    size_t i = 0;
+#ifdef __AVX2__
+    if (n >= 4) {
+        const __m256i zero = _mm256_setzero_si256();
+        __m256i carry = _mm256_set1_epi64x(static_cast<int64_t>(base));
+        for (; i + 4 <= n; i += 4) {
+            __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(values + i));
+            // [a, b, c, d] + [0, a, b, c] + [0, 0, a, a + b]
+            __m256i t = _mm256_blend_epi32(_mm256_permute4x64_epi64(x, _MM_SHUFFLE(2, 1, 0, 0)), zero, 0x03);
+            x = _mm256_add_epi64(x, t);
+            t = _mm256_blend_epi32(_mm256_permute4x64_epi64(x, _MM_SHUFFLE(1, 0, 0, 0)), zero, 0x0F);
+            x = _mm256_add_epi64(x, t);
+            x = _mm256_add_epi64(x, carry);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(values + i), x);
+            carry = _mm256_permute4x64_epi64(x, _MM_SHUFFLE(3, 3, 3, 3));
+        }
+        base = values[i - 1];
+    }
+#endif
+    for (; i < n; i++) {
+        base += values[i];
+        values[i] = base;
+    }
+    return base;
+}
+
+// DeltaPageBuilder encodes integers by the differences between adjacent values (DELTA_ENCODING), or by
+// the differences between adjacent deltas (DELTA_OF_DELTA_ENCODING), which is efficient for sorted keys,
+// monotonically increasing ids and timestamps sampled at a regular interval.
+//
+// Values are split into blocks of DELTA_PAGE_BLOCK_SIZE values, every block is bit-packed against the
+// minimum of its deltas, so that any position of the page can be reached by decoding one block.
+//
+// The page format is as follows:
+//
+// 1. Header: (8 bytes total)
+//
+//    <num_elements> [32-bit]
+//      The number of elements encoded in the page.
+//
+//    <flags> [32-bit]
+//      DELTA_PAGE_FLAG_LINEAR_DATETIME if datetime values were converted to microseconds before encoding.
+//
+// 2. Block offsets: ceil(num_elements / DELTA_PAGE_BLOCK_SIZE) * [32-bit]
+//
+//    The offset of every block from the beginning of the page.
+//
+// 3. Blocks
+//
+//    <first_value> [64-bit]
+//    <first_delta> [64-bit], DELTA_OF_DELTA_ENCODING only
+//    <min_delta> [64-bit]
+//    <bit_width> [8-bit]
+//    <packed deltas minus min_delta> [ceil(num_packed * bit_width / 8) bytes]
+//
+//   NOTE: all on-disk ints are encoded little-endian
+//
+template <LogicalType Type, EncodingTypePB Encoding>
+class DeltaPageBuilder final : public PageBuilder {
+public:
+    static_assert(Encoding == DELTA_ENCODING || Encoding == DELTA_OF_DELTA_ENCODING, "unexpected encoding");
+
+    explicit DeltaPageBuilder(const PageBuilderOptions& options)
+            : _max_count(std::max<uint32_t>(1, options.data_page_size / SIZE_OF_TYPE)) {
+        _data.reserve(_max_count * SIZE_OF_TYPE);
+    }
+
+    ~DeltaPageBuilder() override = default;
+
+    bool is_page_full() override { return _count >= _max_count; }
+
+    uint32_t add(const uint8_t* vals, uint32_t count) override {
+        DCHECK(!_finished);
+        uint32_t to_add = std::min<uint32_t>(_max_count - _count, count);
+        _data.append(vals, to_add * SIZE_OF_TYPE);
+        _count += to_add;
+        return to_add;
+    }
+
+    faststring* finish() override {
+        DCHECK(!_finished);
+        _finished = true;
+        const auto* values = reinterpret_cast<const CppType*>(_data.data());
+        if (_count > 0) {
+            _first_value = values[0];
+            _last_value = values[_count - 1];
+        }
+
+        uint32_t flags = 0;
+        if constexpr (Type == TYPE_DATETIME) {
+            bool linear = true;
+            for (uint32_t i = 0; i < _count && linear; i++) {
+                Timestamp time = timestamp::to_time(values[i]);
+                JulianDate julian = timestamp::to_julian(values[i]);
+                linear = time >= 0 && time < USECS_PER_DAY && julian >= 0 && julian <= 2 * date::MAX_DATE;
+            }
+            flags = linear ? DELTA_PAGE_FLAG_LINEAR_DATETIME : 0;
+        }
+
+        const uint32_t num_blocks = (_count + DELTA_PAGE_BLOCK_SIZE - 1) / DELTA_PAGE_BLOCK_SIZE;
+        _buffer.clear();
+        _buffer.resize(DELTA_PAGE_HEADER_SIZE + num_blocks * sizeof(uint32_t));
+        encode_fixed32_le(&_buffer[0], _count);
+        encode_fixed32_le(&_buffer[4], flags);
+        for (uint32_t block = 0; block < num_blocks; block++) {
+            encode_fixed32_le(&_buffer[DELTA_PAGE_HEADER_SIZE + block * sizeof(uint32_t)], _buffer.size());
+            uint32_t begin = block * DELTA_PAGE_BLOCK_SIZE;
+            uint32_t n = std::min(DELTA_PAGE_BLOCK_SIZE, _count - begin);
+            _encode_block(values + begin, n, flags);
+        }
+        return &_buffer;
+    }
+
+    void reset() override {
+        _count = 0;
+        _data.clear();
+        _finished = false;
+    }
+
+    uint32_t count() const override { return _count; }
+
+    uint64_t size() const override { return _data.size(); }
+
+    Status get_first_value(void* value) const override {
+        DCHECK(_finished);
+        if (_count == 0) {
+            return Status::NotFound("page is empty");
+        }
+        memcpy(value, &_first_value, SIZE_OF_TYPE);
+        return Status::OK();
+    }
+
+    Status get_last_value(void* value) const override {
+        DCHECK(_finished);
+        if (_count == 0) {
+            return Status::NotFound("page is empty");
+        }
+        memcpy(value, &_last_value, SIZE_OF_TYPE);
+        return Status::OK();
+    }
+
+private:
+    typedef typename TypeTraits<Type>::CppType CppType;
+    enum { SIZE_OF_TYPE = TypeTraits<Type>::size };
+    static constexpr uint32_t kNumSkipped = Encoding == DELTA_ENCODING ? 1 : 2;
+
+    static uint64_t _to_uint(CppType value, uint32_t flags) {
+        if constexpr (Type == TYPE_DATETIME) {
+            if (flags & DELTA_PAGE_FLAG_LINEAR_DATETIME) {
+                return timestamp::to_julian(value) * USECS_PER_DAY + timestamp::to_time(value);
+            }
+        }
+        return static_cast<uint64_t>(static_cast<int64_t>(value));
+    }
+
+    void _encode_block(const CppType* values, uint32_t n, uint32_t flags) {
+        uint64_t deltas[DELTA_PAGE_BLOCK_SIZE];
+        for (uint32_t i = 0; i < n; i++) {
+            deltas[i] = _to_uint(values[i], flags);
+        }
+        const uint64_t first_value = deltas[0];
+        // compute backwards to transform in place
+        for (uint32_t i = n - 1; i >= 1; i--) {
+            deltas[i] -= deltas[i - 1];
+        }
+        const uint64_t first_delta = n > 1 ? deltas[1] : 0;
+        if constexpr (Encoding == DELTA_OF_DELTA_ENCODING) {
+            for (uint32_t i = n - 1; i >= 2; i--) {
+                deltas[i] -= deltas[i - 1];
+            }
+        }
+
+        uint64_t* packed = deltas + kNumSkipped;
+        const uint32_t num_packed = n > kNumSkipped ? n - kNumSkipped : 0;
+        int64_t min_delta = 0;
+        if (num_packed > 0) {
+            min_delta = static_cast<int64_t>(packed[0]);
+            for (uint32_t i = 1; i < num_packed; i++) {
+                min_delta = std::min(min_delta, static_cast<int64_t>(packed[i]));
+            }
+        }
+        uint64_t max_packed = 0;
+        for (uint32_t i = 0; i < num_packed; i++) {
+            packed[i] -= static_cast<uint64_t>(min_delta);
+            max_packed |= packed[i];
+        }
+        const int bit_width = max_packed == 0 ? 0 : 64 - __builtin_clzll(max_packed);
+
+        put_fixed64_le(&_buffer, first_value);
+        if constexpr (Encoding == DELTA_OF_DELTA_ENCODING) {
+            put_fixed64_le(&_buffer, first_delta);
+        }
+        put_fixed64_le(&_buffer, static_cast<uint64_t>(min_delta));
+        _buffer.push_back(static_cast<uint8_t>(bit_width));
+        if (bit_width > 0) {
+            BitWriter writer(&_packed_buffer);
+            for (uint32_t i = 0; i < num_packed; i++) {
+                writer.PutValue(packed[i], bit_width);
+            }
+            writer.Flush();
+            _buffer.append(_packed_buffer.data(), _packed_buffer.size());
+        }
+    }
+
+    uint32_t _max_count;
+    uint32_t _count{0};
+    bool _finished{false};
+    faststring _data;
+    faststring _buffer;
+    faststring _packed_buffer;
+    CppType _first_value;
+    CppType _last_value;
+};
+
+template <LogicalType Type, EncodingTypePB Encoding>
+class DeltaPageDecoder final : public PageDecoder {
+public:
+    DeltaPageDecoder(Slice data, const PageDecoderOptions& options) : _data(data) {}
+
+    ~DeltaPageDecoder() override = default;
+
+    Status init() override {
+        CHECK(!_parsed);
+        if (_data.size < DELTA_PAGE_HEADER_SIZE) {
+            return Status::Corruption("not enough bytes for header in DeltaPageDecoder");
+        }
+        _num_elements = decode_fixed32_le((const uint8_t*)&_data[0]);
+        _flags = decode_fixed32_le((const uint8_t*)&_data[4]);
+        _num_blocks = (_num_elements + DELTA_PAGE_BLOCK_SIZE - 1) / DELTA_PAGE_BLOCK_SIZE;
+        if (_data.size < DELTA_PAGE_HEADER_SIZE + _num_blocks * sizeof(uint32_t)) {
+            return Status::Corruption(strings::Substitute("not enough bytes for $0 blocks in DeltaPageDecoder",
+                                                          _num_blocks));
+        }
+        _parsed = true;
+        return Status::OK();
+    }
+
+    Status seek_to_position_in_page(uint32_t pos) override {
+        DCHECK(_parsed) << "Must call init() firstly";
+        DCHECK_LE(pos, _num_elements) << "Tried to seek to " << pos << " which is > number of elements ("
+                                      << _num_elements << ") in the block!";
+        _cur_index = pos;
+        return Status::OK();
+    }
+
+    Status seek_at_or_after_value(const void* value, bool* exact_match) override {
+        DCHECK(_parsed) << "Must call init() firstly";
+        if (_num_elements == 0) {
+            return Status::NotFound("page is empty");
+        }
+        CppType target;
+        memcpy(&target, value, SIZE_OF_TYPE);
+
+        // find the last block whose first value is less than the target, the values are assumed to be sorted.
+        uint32_t left = 0;
+        uint32_t right = _num_blocks;
+        while (left + 1 < right) {
+            uint32_t mid = left + (right - left) / 2;
+            CppType first;
+            RETURN_IF_ERROR(_block_first_value(mid, &first));
+            if (first < target) {
+                left = mid;
+            } else {
+                right = mid;
+            }
+        }
+        for (uint32_t block = left; block < _num_blocks; block++) {
+            RETURN_IF_ERROR(_decode_block(block));
+            for (uint32_t i = 0; i < _block_count; i++) {
+                if (!(_block_values[i] < target)) {
+                    _cur_index = block * DELTA_PAGE_BLOCK_SIZE + i;
+                    *exact_match = _block_values[i] == target;
+                    return Status::OK();
+                }
+            }
+        }
+        return Status::NotFound("all value small than the value");
+    }
+
+    Status next_batch(size_t* n, Column* dst) override {
+        SparseRange read_range;
+        uint32_t begin = current_index();
+        read_range.add(Range(begin, begin + *n));
+        RETURN_IF_ERROR(next_batch(read_range, dst));
+        *n = current_index() - begin;
+        return Status::OK();
+    }
+
+    Status next_batch(const SparseRange& range, Column* dst) override {
+        DCHECK(_parsed) << "Must call init() firstly";
+        if (PREDICT_FALSE(range.span_size() == 0 || _cur_index >= _num_elements)) {
+            return Status::OK();
+        }
+        size_t to_read =
+                std::min(static_cast<size_t>(range.span_size()), static_cast<size_t>(_num_elements - _cur_index));
+        SparseRangeIterator iter = range.new_iterator();
+        while (to_read > 0 && _cur_index < _num_elements) {
+            _cur_index = iter.begin();
+            Range r = iter.next(to_read);
+            const size_t ori_size = dst->size();
+            dst->resize(ori_size + r.span_size());
+            auto* p = reinterpret_cast<CppType*>(dst->mutable_raw_data()) + ori_size;
+            RETURN_IF_ERROR(_copy_next_values(r.span_size(), p));
+            to_read -= r.span_size();
+        }
+        return Status::OK();
+    }
+
+    uint32_t count() const override { return _num_elements; }
+
+    uint32_t current_index() const override { return _cur_index; }
+
+    EncodingTypePB encoding_type() const override { return Encoding; }
+
+private:
+    typedef typename TypeTraits<Type>::CppType CppType;
+    enum { SIZE_OF_TYPE = TypeTraits<Type>::size };
+    static constexpr uint32_t kNumSkipped = Encoding == DELTA_ENCODING ? 1 : 2;
+    static constexpr size_t kBlockHeaderSize = (Encoding == DELTA_ENCODING ? 16 : 24) + 1;
+
+    CppType _from_uint(uint64_t value) const {
+        if constexpr (Type == TYPE_DATETIME) {
+            if (_flags & DELTA_PAGE_FLAG_LINEAR_DATETIME) {
+                auto linear = static_cast<int64_t>(value);
+                return timestamp::from_julian_and_time(linear / USECS_PER_DAY, linear % USECS_PER_DAY);
+            }
+        }
+        return static_cast<CppType>(static_cast<int64_t>(value));
+    }
+
+    Status _block_offset(uint32_t block, size_t* offset) const {
+        *offset = decode_fixed32_le((const uint8_t*)&_data[DELTA_PAGE_HEADER_SIZE + block * sizeof(uint32_t)]);
+        if (*offset + kBlockHeaderSize > _data.size) {
+            return Status::Corruption(strings::Substitute("invalid offset $0 of block $1 in DeltaPageDecoder",
+                                                          *offset, block));
+        }
+        return Status::OK();
+    }
+
+    Status _block_first_value(uint32_t block, CppType* value) const {
+        size_t offset = 0;
+        RETURN_IF_ERROR(_block_offset(block, &offset));
+        *value = _from_uint(decode_fixed64_le((const uint8_t*)&_data[offset]));
+        return Status::OK();
+    }
+
+    Status _decode_block(uint32_t block) {
+        if (_block_index == block) {
+            return Status::OK();
+        }
+        size_t offset = 0;
+        RETURN_IF_ERROR(_block_offset(block, &offset));
+        const auto* p = (const uint8_t*)&_data[offset];
+        const uint32_t n = std::min(DELTA_PAGE_BLOCK_SIZE, _num_elements - block * DELTA_PAGE_BLOCK_SIZE);
+        const uint32_t num_packed = n > kNumSkipped ? n - kNumSkipped : 0;
+
+        uint64_t* values = _block_buffer;
+        values[0] = decode_fixed64_le(p);
+        p += 8;
+        if constexpr (Encoding == DELTA_OF_DELTA_ENCODING) {
+            values[1] = decode_fixed64_le(p);
+            p += 8;
+        }
+        const uint64_t min_delta = decode_fixed64_le(p);
+        p += 8;
+        const int bit_width = *p++;
+        if (bit_width > 64) {
+            return Status::Corruption(strings::Substitute("invalid bit width $0 in DeltaPageDecoder", bit_width));
+        }
+
+        uint64_t* packed = values + kNumSkipped;
+        if (bit_width == 0) {
+            std::fill(packed, packed + num_packed, min_delta);
+        } else {
+            const int64_t in_bytes = _data.data + _data.size - (const char*)p;
+            const int64_t packed_bytes = (static_cast<int64_t>(num_packed) * bit_width + 7) / 8;
+            if (packed_bytes > in_bytes) {
+                return Status::Corruption("not enough bytes for packed values in DeltaPageDecoder");
+            }
+            int64_t num_unpacked = BitPacking::UnpackValues(bit_width, p, packed_bytes, num_packed, packed).second;
+            if (num_unpacked != static_cast<int64_t>(num_packed)) {
+                return Status::Corruption("failed to unpack values in DeltaPageDecoder");
+            }
+            for (uint32_t i = 0; i < num_packed; i++) {
+                packed[i] += min_delta;
+            }
+        }
+        if (n > 1) {
+            if constexpr (Encoding == DELTA_OF_DELTA_ENCODING) {
+                delta_prefix_sum(values + 1, n - 1, 0);
+            }
+            delta_prefix_sum(values + 1, n - 1, values[0]);
+        }
+        for (uint32_t i = 0; i < n; i++) {
+            _block_values[i] = _from_uint(values[i]);
+        }
+        _block_index = block;
+        _block_count = n;
+        return Status::OK();
+    }
+
+    Status _copy_next_values(size_t n, CppType* dst) {
+        while (n > 0) {
+            const uint32_t block = _cur_index / DELTA_PAGE_BLOCK_SIZE;
+            RETURN_IF_ERROR(_decode_block(block));
+            const uint32_t offset = _cur_index % DELTA_PAGE_BLOCK_SIZE;
+            const size_t to_copy = std::min<size_t>(n, _block_count - offset);
+            memcpy(dst, _block_values + offset, to_copy * SIZE_OF_TYPE);
+            dst += to_copy;
+            n -= to_copy;
+            _cur_index += to_copy;
+        }
+        return Status::OK();
+    }
+
+    Slice _data;
+    bool _parsed{false};
+    uint32_t _num_elements{0};
+    uint32_t _num_blocks{0};
+    uint32_t _flags{0};
+    uint32_t _cur_index{0};
+
+    // the decoded block
+    uint32_t _block_index{std::numeric_limits<uint32_t>::max()};
+    uint32_t _block_count{0};
+    uint64_t _block_buffer[DELTA_PAGE_BLOCK_SIZE];
+    CppType _block_values[DELTA_PAGE_BLOCK_SIZE];
+};
+
+} // namespace starrocks
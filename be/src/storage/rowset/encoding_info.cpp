@@ -38,10 +38,12 @@
 
 #include "gutil/strings/substitute.h"
 #include "storage/olap_common.h"
+#include "storage/rowset/adaptive_page.h"
 #include "storage/rowset/binary_dict_page.h"
 #include "storage/rowset/binary_plain_page.h"
 #include "storage/rowset/binary_prefix_page.h"
 #include "storage/rowset/bitshuffle_page.h"
+#include "storage/rowset/delta_page.h"
 #include "storage/rowset/frame_of_reference_page.h"
 #include "storage/rowset/plain_page.h"
 #include "storage/rowset/rle_page.h"
@@ -106,6 +108,60 @@ struct TypeEncodingTraits<TYPE_BOOLEAN, RLE, bool> {
     }
 };
 
+// The bit width of RLE is the width of the type, and 64-bit values are not supported by the bit writer.
+template <LogicalType type, typename CppType>
+struct TypeEncodingTraits<type, RLE, CppType,
+                          typename std::enable_if<std::is_integral<CppType>::value && !std::is_same<CppType, bool>::value &&
+                                                  sizeof(CppType) <= 4>::type> {
+    static Status create_page_builder(const PageBuilderOptions& opts, PageBuilder** builder) {
+        *builder = new RlePageBuilder<type>(opts);
+        return Status::OK();
+    }
+    static Status create_page_decoder(const Slice& data, const PageDecoderOptions& opts, PageDecoder** decoder) {
+        *decoder = new RlePageDecoder<type>(data, opts);
+        return Status::OK();
+    }
+};
+
+template <LogicalType type, typename CppType>
+struct TypeEncodingTraits<type, DELTA_ENCODING, CppType,
+                          typename std::enable_if<std::is_integral<CppType>::value && sizeof(CppType) <= 8>::type> {
+    static Status create_page_builder(const PageBuilderOptions& opts, PageBuilder** builder) {
+        *builder = new DeltaPageBuilder<type, DELTA_ENCODING>(opts);
+        return Status::OK();
+    }
+    static Status create_page_decoder(const Slice& data, const PageDecoderOptions& opts, PageDecoder** decoder) {
+        *decoder = new DeltaPageDecoder<type, DELTA_ENCODING>(data, opts);
+        return Status::OK();
+    }
+};
+
+template <LogicalType type, typename CppType>
+struct TypeEncodingTraits<type, DELTA_OF_DELTA_ENCODING, CppType,
+                          typename std::enable_if<std::is_integral<CppType>::value && sizeof(CppType) <= 8>::type> {
+    static Status create_page_builder(const PageBuilderOptions& opts, PageBuilder** builder) {
+        *builder = new DeltaPageBuilder<type, DELTA_OF_DELTA_ENCODING>(opts);
+        return Status::OK();
+    }
+    static Status create_page_decoder(const Slice& data, const PageDecoderOptions& opts, PageDecoder** decoder) {
+        *decoder = new DeltaPageDecoder<type, DELTA_OF_DELTA_ENCODING>(data, opts);
+        return Status::OK();
+    }
+};
+
+template <LogicalType type, typename CppType>
+struct TypeEncodingTraits<type, ADAPTIVE_ENCODING, CppType,
+                          typename std::enable_if<std::is_integral<CppType>::value>::type> {
+    static Status create_page_builder(const PageBuilderOptions& opts, PageBuilder** builder) {
+        *builder = new AdaptivePageBuilder<type>(opts);
+        return Status::OK();
+    }
+    static Status create_page_decoder(const Slice& data, const PageDecoderOptions& opts, PageDecoder** decoder) {
+        *decoder = new AdaptivePageDecoder<type>(data, opts);
+        return Status::OK();
+    }
+};
+
 template <LogicalType type>
 struct TypeEncodingTraits<type, DICT_ENCODING, Slice> {
     static Status create_page_builder(const PageBuilderOptions& opts, PageBuilder** builder) {
@@ -205,22 +261,38 @@ EncodingInfoResolver::EncodingInfoResolver() {
     _add_map<TYPE_TINYINT, BIT_SHUFFLE>();
     _add_map<TYPE_TINYINT, FOR_ENCODING, true>();
     _add_map<TYPE_TINYINT, PLAIN_ENCODING>();
+    _add_map<TYPE_TINYINT, RLE>();
+    _add_map<TYPE_TINYINT, DELTA_ENCODING>();
+    _add_map<TYPE_TINYINT, DELTA_OF_DELTA_ENCODING>();
+    _add_map<TYPE_TINYINT, ADAPTIVE_ENCODING>();
 
     _add_map<TYPE_SMALLINT, BIT_SHUFFLE>();
     _add_map<TYPE_SMALLINT, FOR_ENCODING, true>();
     _add_map<TYPE_SMALLINT, PLAIN_ENCODING>();
+    _add_map<TYPE_SMALLINT, RLE>();
+    _add_map<TYPE_SMALLINT, DELTA_ENCODING>();
+    _add_map<TYPE_SMALLINT, DELTA_OF_DELTA_ENCODING>();
+    _add_map<TYPE_SMALLINT, ADAPTIVE_ENCODING>();
 
     _add_map<TYPE_INT, BIT_SHUFFLE>();
     _add_map<TYPE_INT, FOR_ENCODING, true>();
     _add_map<TYPE_INT, PLAIN_ENCODING>();
+    _add_map<TYPE_INT, RLE>();
+    _add_map<TYPE_INT, DELTA_ENCODING>();
+    _add_map<TYPE_INT, DELTA_OF_DELTA_ENCODING>();
+    _add_map<TYPE_INT, ADAPTIVE_ENCODING>();
 
     _add_map<TYPE_BIGINT, BIT_SHUFFLE>();
     _add_map<TYPE_BIGINT, FOR_ENCODING, true>();
     _add_map<TYPE_BIGINT, PLAIN_ENCODING>();
+    _add_map<TYPE_BIGINT, DELTA_ENCODING>();
+    _add_map<TYPE_BIGINT, DELTA_OF_DELTA_ENCODING>();
+    _add_map<TYPE_BIGINT, ADAPTIVE_ENCODING>();
 
     _add_map<TYPE_LARGEINT, BIT_SHUFFLE>();
     _add_map<TYPE_LARGEINT, PLAIN_ENCODING>();
     _add_map<TYPE_LARGEINT, FOR_ENCODING, true>();
+    _add_map<TYPE_LARGEINT, ADAPTIVE_ENCODING>();
 
     _add_map<TYPE_FLOAT, BIT_SHUFFLE>();
     _add_map<TYPE_FLOAT, PLAIN_ENCODING>();
@@ -247,6 +319,10 @@ EncodingInfoResolver::EncodingInfoResolver() {
     _add_map<TYPE_DATE, BIT_SHUFFLE>();
     _add_map<TYPE_DATE, PLAIN_ENCODING>();
     _add_map<TYPE_DATE, FOR_ENCODING, true>();
+    _add_map<TYPE_DATE, RLE>();
+    _add_map<TYPE_DATE, DELTA_ENCODING>();
+    _add_map<TYPE_DATE, DELTA_OF_DELTA_ENCODING>();
+    _add_map<TYPE_DATE, ADAPTIVE_ENCODING>();
 
     _add_map<TYPE_DATETIME_V1, BIT_SHUFFLE>();
     _add_map<TYPE_DATETIME_V1, PLAIN_ENCODING>();
@@ -255,6 +331,9 @@ EncodingInfoResolver::EncodingInfoResolver() {
     _add_map<TYPE_DATETIME, BIT_SHUFFLE>();
     _add_map<TYPE_DATETIME, PLAIN_ENCODING>();
     _add_map<TYPE_DATETIME, FOR_ENCODING, true>();
+    _add_map<TYPE_DATETIME, DELTA_ENCODING>();
+    _add_map<TYPE_DATETIME, DELTA_OF_DELTA_ENCODING>();
+    _add_map<TYPE_DATETIME, ADAPTIVE_ENCODING>();
 
     _add_map<TYPE_DECIMAL, BIT_SHUFFLE, true>();
     _add_map<TYPE_DECIMAL, PLAIN_ENCODING>();
@@ -0,0 +1,151 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "storage/rowset/json_column_iterator.h"
+
+#include <fmt/format.h>
+
+#include "column/json_column.h"
+#include "column/nullable_column.h"
+#include "gutil/casts.h"
+#include "storage/chunk_helper.h"
+#include "storage/range.h"
+
+namespace starrocks {
+
+static JsonColumn* get_json_column(Column* column) {
+    if (column->is_nullable()) {
+        return down_cast<JsonColumn*>(down_cast<NullableColumn*>(column)->data_column().get());
+    }
+    return down_cast<JsonColumn*>(column);
+}
+
+JsonFlatColumnIterator::JsonFlatColumnIterator(std::unique_ptr<ColumnIterator> json_iter,
+                                               std::vector<std::string> flat_paths,
+                                               std::vector<LogicalType> flat_types,
+                                               std::vector<std::unique_ptr<ColumnIterator>> flat_iters)
+        : _json_iter(std::move(json_iter)),
+          _flat_paths(std::move(flat_paths)),
+          _flat_types(std::move(flat_types)),
+          _flat_iters(std::move(flat_iters)) {
+    DCHECK_EQ(_flat_paths.size(), _flat_iters.size());
+    DCHECK_EQ(_flat_types.size(), _flat_iters.size());
+}
+
+Status JsonFlatColumnIterator::init(const ColumnIteratorOptions& opts) {
+    RETURN_IF_ERROR(ColumnIterator::init(opts));
+    RETURN_IF_ERROR(_json_iter->init(opts));
+    ColumnIteratorOptions flat_opts = opts;
+    flat_opts.is_nullable = true;
+    for (auto& iter : _flat_iters) {
+        RETURN_IF_ERROR(iter->init(flat_opts));
+    }
+    return Status::OK();
+}
+
+Status JsonFlatColumnIterator::seek_to_first() {
+    RETURN_IF_ERROR(_json_iter->seek_to_first());
+    _flat_iters_synced = false;
+    return Status::OK();
+}
+
+Status JsonFlatColumnIterator::seek_to_ordinal(ordinal_t ord) {
+    RETURN_IF_ERROR(_json_iter->seek_to_ordinal(ord));
+    _flat_iters_synced = false;
+    return Status::OK();
+}
+
+bool JsonFlatColumnIterator::_take_flat_columns(JsonColumn* json_column, std::vector<ColumnPtr>* flat_columns) {
+    flat_columns->clear();
+    if (json_column->size() == 0) {
+        for (auto type : _flat_types) {
+            flat_columns->emplace_back(ChunkHelper::column_from_field_type(type, true));
+        }
+        return true;
+    }
+    for (const auto& path : _flat_paths) {
+        LogicalType type;
+        auto flat_column = json_column->get_flat_column(path, &type);
+        if (flat_column == nullptr) {
+            return false;
+        }
+        flat_columns->emplace_back(std::move(flat_column));
+    }
+    // the flat columns are only referenced by |flat_columns| now, so they can be appended to
+    json_column->clear_flat_columns();
+    return true;
+}
+
+void JsonFlatColumnIterator::_set_flat_columns(JsonColumn* json_column, std::vector<ColumnPtr>* flat_columns) {
+    for (size_t i = 0; i < _flat_paths.size(); i++) {
+        json_column->set_flat_column(_flat_paths[i], _flat_types[i], std::move((*flat_columns)[i]));
+    }
+}
+
+Status JsonFlatColumnIterator::next_batch(size_t* n, Column* dst) {
+    JsonColumn* json_column = get_json_column(dst);
+    std::vector<ColumnPtr> flat_columns;
+    bool read_flat_columns = _take_flat_columns(json_column, &flat_columns);
+    ordinal_t ord = _json_iter->get_current_ordinal();
+    RETURN_IF_ERROR(_json_iter->next_batch(n, dst));
+    if (!read_flat_columns) {
+        json_column->clear_flat_columns();
+        _flat_iters_synced = false;
+        return Status::OK();
+    }
+    for (size_t i = 0; i < _flat_iters.size(); i++) {
+        if (!_flat_iters_synced) {
+            RETURN_IF_ERROR(_flat_iters[i]->seek_to_ordinal(ord));
+        }
+        size_t num_rows = *n;
+        RETURN_IF_ERROR(_flat_iters[i]->next_batch(&num_rows, flat_columns[i].get()));
+        if (num_rows != *n) {
+            return Status::Corruption(fmt::format("flat JSON column {} has {} rows, while {} rows are expected",
+                                                  _flat_paths[i], num_rows, *n));
+        }
+    }
+    _flat_iters_synced = true;
+    _set_flat_columns(json_column, &flat_columns);
+    return Status::OK();
+}
+
+Status JsonFlatColumnIterator::next_batch(const SparseRange& range, Column* dst) {
+    JsonColumn* json_column = get_json_column(dst);
+    std::vector<ColumnPtr> flat_columns;
+    bool read_flat_columns = _take_flat_columns(json_column, &flat_columns);
+    RETURN_IF_ERROR(_json_iter->next_batch(range, dst));
+    if (!read_flat_columns) {
+        json_column->clear_flat_columns();
+        _flat_iters_synced = false;
+        return Status::OK();
+    }
+    for (size_t i = 0; i < _flat_iters.size(); i++) {
+        if (!_flat_iters_synced && !range.empty()) {
+            RETURN_IF_ERROR(_flat_iters[i]->seek_to_ordinal(range.begin()));
+        }
+        RETURN_IF_ERROR(_flat_iters[i]->next_batch(range, flat_columns[i].get()));
+    }
+    _flat_iters_synced = !range.empty() || _flat_iters_synced;
+    _set_flat_columns(json_column, &flat_columns);
+    return Status::OK();
+}
+
+Status JsonFlatColumnIterator::fetch_values_by_rowid(const rowid_t* rowids, size_t size, Column* values) {
+    // the flat columns are not read for random reads
+    get_json_column(values)->clear_flat_columns();
+    _flat_iters_synced = false;
+    return _json_iter->fetch_values_by_rowid(rowids, size, values);
+}
+
+} // namespace starrocks
@@ -0,0 +1,76 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "storage/rowset/column_iterator.h"
+
+namespace starrocks {
+
+class JsonColumn;
+
+// JsonFlatColumnIterator reads the JSON values of a column with flat columns, see JsonMetaPB.flat_paths,
+// and attaches the flat columns of the rows read sequentially to the JsonColumn read.
+class JsonFlatColumnIterator final : public ColumnIterator {
+public:
+    JsonFlatColumnIterator(std::unique_ptr<ColumnIterator> json_iter, std::vector<std::string> flat_paths,
+                           std::vector<LogicalType> flat_types,
+                           std::vector<std::unique_ptr<ColumnIterator>> flat_iters);
+
+    ~JsonFlatColumnIterator() override = default;
+
+    Status init(const ColumnIteratorOptions& opts) override;
+
+    Status seek_to_first() override;
+
+    Status seek_to_ordinal(ordinal_t ord) override;
+
+    Status next_batch(size_t* n, Column* dst) override;
+
+    Status next_batch(const SparseRange& range, Column* dst) override;
+
+    ordinal_t get_current_ordinal() const override { return _json_iter->get_current_ordinal(); }
+
+    Status get_row_ranges_by_zone_map(const std::vector<const ColumnPredicate*>& predicates,
+                                      const ColumnPredicate* del_predicate, SparseRange* row_ranges) override {
+        return _json_iter->get_row_ranges_by_zone_map(predicates, del_predicate, row_ranges);
+    }
+
+    Status get_row_ranges_by_bloom_filter(const std::vector<const ColumnPredicate*>& predicates,
+                                          SparseRange* row_ranges) override {
+        return _json_iter->get_row_ranges_by_bloom_filter(predicates, row_ranges);
+    }
+
+    Status fetch_values_by_rowid(const rowid_t* rowids, size_t size, Column* values) override;
+
+private:
+    // Take the flat columns of the rows in |json_column|, or create empty ones if it's empty.
+    // Return false if the flat columns of some rows are missing.
+    bool _take_flat_columns(JsonColumn* json_column, std::vector<ColumnPtr>* flat_columns);
+
+    void _set_flat_columns(JsonColumn* json_column, std::vector<ColumnPtr>* flat_columns);
+
+    std::unique_ptr<ColumnIterator> _json_iter;
+    std::vector<std::string> _flat_paths;
+    std::vector<LogicalType> _flat_types;
+    std::vector<std::unique_ptr<ColumnIterator>> _flat_iters;
+    // whether the flat iterators are at the same ordinal as the JSON iterator, they are only
+    // moved when the flat columns are read
+    bool _flat_iters_synced = false;
+};
+
+} // namespace starrocks
@@ -0,0 +1,379 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "storage/rowset/json_column_writer.h"
+
+#include <algorithm>
+#include <map>
+
+#include "column/json_column.h"
+#include "column/nullable_column.h"
+#include "column/type_traits.h"
+#include "common/config.h"
+#include "gutil/casts.h"
+#include "storage/olap_define.h"
+#include "util/json.h"
+
+namespace starrocks {
+
+// The type of the flat column able to store |value| exactly, or TYPE_UNKNOWN if there is none.
+// JSON nulls are not stored in the flat columns, where NULL means the key is missing.
+static LogicalType flat_type_of(const vpack::Slice& value) {
+    switch (value.type()) {
+    case vpack::ValueType::SmallInt:
+    case vpack::ValueType::Int:
+        return TYPE_BIGINT;
+    case vpack::ValueType::UInt:
+        return value.getUInt() <= static_cast<uint64_t>(INT64_MAX) ? TYPE_BIGINT : TYPE_UNKNOWN;
+    case vpack::ValueType::Double:
+        return TYPE_DOUBLE;
+    case vpack::ValueType::String:
+        return TYPE_VARCHAR;
+    default:
+        return TYPE_UNKNOWN;
+    }
+}
+
+// Extract the values of |path| into a nullable column of |Type|.
+// Return nullptr if a value of |path| can not be stored in the column.
+template <LogicalType Type>
+static ColumnPtr extract_flat_column(const JsonColumn& json_column, const NullColumn* null_column,
+                                     const std::string& path) {
+    size_t num_rows = json_column.size();
+    auto data = RunTimeColumnType<Type>::create();
+    auto nulls = NullColumn::create();
+    data->reserve(num_rows);
+    nulls->reserve(num_rows);
+    for (size_t i = 0; i < num_rows; i++) {
+        vpack::Slice value = vpack::Slice::noneSlice();
+        if (null_column == nullptr || !null_column->get_data()[i]) {
+            vpack::Slice slice = json_column.get_object(i)->to_vslice();
+            if (slice.isObject()) {
+                value = slice.get(path);
+            }
+        }
+        if (value.isNone()) {
+            data->append_default();
+            nulls->append(1);
+            continue;
+        }
+        if (flat_type_of(value) != Type) {
+            return nullptr;
+        }
+        if constexpr (Type == TYPE_BIGINT) {
+            data->append(value.getNumber<int64_t>());
+        } else if constexpr (Type == TYPE_DOUBLE) {
+            data->append(value.getDouble());
+        } else {
+            vpack::ValueLength len;
+            const char* str = value.getStringUnchecked(len);
+            data->append(Slice(str, len));
+        }
+        nulls->append(0);
+    }
+    return NullableColumn::create(std::move(data), std::move(nulls));
+}
+
+class JsonColumnWriter final : public ColumnWriter {
+public:
+    JsonColumnWriter(const ColumnWriterOptions& opts, TypeInfoPtr type_info, WritableFile* wfile,
+                     std::unique_ptr<ScalarColumnWriter> json_writer);
+
+    ~JsonColumnWriter() override = default;
+
+    Status init() override { return _json_writer->init(); }
+
+    Status append(const Column& column) override;
+
+    Status finish_current_page() override;
+
+    uint64_t estimate_buffer_size() override;
+
+    Status finish() override;
+
+    Status write_data() override;
+
+    Status write_ordinal_index() override;
+
+    Status write_zone_map() override;
+
+    Status write_bitmap_index() override { return _json_writer->write_bitmap_index(); }
+
+    Status write_bloom_filter_index() override { return _json_writer->write_bloom_filter_index(); }
+
+    ordinal_t get_next_rowid() const override { return _json_writer->get_next_rowid(); }
+
+    uint64_t total_mem_footprint() const override;
+
+private:
+    struct FlatColumn {
+        std::string path;
+        LogicalType type;
+        // nullptr once a value which can not be stored in the column is met, and the column is dropped
+        std::unique_ptr<ScalarColumnWriter> writer;
+    };
+
+    // Choose the keys to extract from the sampled values
+    Status _init_flat_columns(const Column& sample);
+
+    Status _flush_sample();
+
+    Status _append_json_and_flat_columns(const Column& column);
+
+    ColumnWriterOptions _opts;
+    WritableFile* _wfile;
+    std::unique_ptr<ScalarColumnWriter> _json_writer;
+
+    // the leading values buffered until there are enough values to choose the keys to extract
+    ColumnPtr _sample;
+    bool _flat_columns_inited = false;
+    std::vector<FlatColumn> _flat_columns;
+};
+
+StatusOr<std::unique_ptr<ColumnWriter>> create_json_column_writer(const ColumnWriterOptions& opts,
+                                                                  TypeInfoPtr type_info, WritableFile* wfile) {
+    DCHECK_EQ(0, opts.meta->children_columns_size());
+    auto json_writer = std::make_unique<ScalarColumnWriter>(opts, type_info, wfile);
+    return std::make_unique<JsonColumnWriter>(opts, std::move(type_info), wfile, std::move(json_writer));
+}
+
+JsonColumnWriter::JsonColumnWriter(const ColumnWriterOptions& opts, TypeInfoPtr type_info, WritableFile* wfile,
+                                   std::unique_ptr<ScalarColumnWriter> json_writer)
+        : ColumnWriter(std::move(type_info), opts.meta->length(), opts.meta->is_nullable()),
+          _opts(opts),
+          _wfile(wfile),
+          _json_writer(std::move(json_writer)) {}
+
+Status JsonColumnWriter::append(const Column& column) {
+    if (_flat_columns_inited) {
+        return _append_json_and_flat_columns(column);
+    }
+    if (_sample == nullptr) {
+        _sample = column.clone_empty();
+    }
+    _sample->append(column, 0, column.size());
+    if (_sample->size() < static_cast<size_t>(std::max(1, config::json_flat_sample_rows))) {
+        return Status::OK();
+    }
+    return _flush_sample();
+}
+
+Status JsonColumnWriter::_flush_sample() {
+    if (_flat_columns_inited) {
+        return Status::OK();
+    }
+    _flat_columns_inited = true;
+    if (_sample == nullptr) {
+        return Status::OK();
+    }
+    auto sample = std::move(_sample);
+    RETURN_IF_ERROR(_init_flat_columns(*sample));
+    return _append_json_and_flat_columns(*sample);
+}
+
+Status JsonColumnWriter::_init_flat_columns(const Column& sample) {
+    const NullColumn* null_column = nullptr;
+    const JsonColumn* json_column = nullptr;
+    if (sample.is_nullable()) {
+        const auto& nullable_column = down_cast<const NullableColumn&>(sample);
+        null_column = nullable_column.null_column().get();
+        json_column = down_cast<const JsonColumn*>(nullable_column.data_column().get());
+    } else {
+        json_column = down_cast<const JsonColumn*>(&sample);
+    }
+
+    struct KeyStat {
+        LogicalType type = TYPE_UNKNOWN;
+        size_t count = 0;
+        bool mixed = false;
+    };
+    std::map<std::string, KeyStat> key_stats;
+    size_t num_values = 0;
+    for (size_t i = 0; i < json_column->size(); i++) {
+        if (null_column != nullptr && null_column->get_data()[i]) {
+            continue;
+        }
+        num_values++;
+        vpack::Slice slice = json_column->get_object(i)->to_vslice();
+        if (!slice.isObject()) {
+            continue;
+        }
+        for (const auto& iter : vpack::ObjectIterator(slice)) {
+            KeyStat& stat = key_stats[iter.key.copyString()];
+            LogicalType type = flat_type_of(iter.value);
+            if (type == TYPE_UNKNOWN || (stat.count > 0 && stat.type != type)) {
+                stat.mixed = true;
+            }
+            stat.type = type;
+            stat.count++;
+        }
+    }
+
+    auto min_count = static_cast<size_t>(static_cast<double>(num_values) * config::json_flat_min_key_ratio);
+    std::vector<std::pair<std::string, KeyStat>> candidates;
+    for (auto& [key, stat] : key_stats) {
+        if (!stat.mixed && stat.count > 0 && stat.count >= min_count) {
+            candidates.emplace_back(key, stat);
+        }
+    }
+    // prefer the keys appearing most frequently
+    std::stable_sort(candidates.begin(), candidates.end(),
+                     [](const auto& lhs, const auto& rhs) { return lhs.second.count > rhs.second.count; });
+    auto max_columns = static_cast<size_t>(std::max(0, config::json_flat_max_columns));
+    if (candidates.size() > max_columns) {
+        candidates.resize(max_columns);
+    }
+
+    for (auto& [key, stat] : candidates) {
+        ColumnWriterOptions flat_options;
+        flat_options.meta = _opts.meta->add_children_columns();
+        flat_options.meta->set_column_id(_opts.meta->column_id());
+        flat_options.meta->set_unique_id(_opts.meta->unique_id());
+        flat_options.meta->set_type(stat.type);
+        flat_options.meta->set_length(stat.type == TYPE_VARCHAR ? OLAP_STRING_MAX_LENGTH : 0);
+        flat_options.meta->set_encoding(DEFAULT_ENCODING);
+        flat_options.meta->set_compression(_opts.meta->compression());
+        flat_options.meta->set_is_nullable(true);
+        flat_options.data_page_size = _opts.data_page_size;
+        flat_options.page_format = _opts.page_format;
+        flat_options.need_zone_map = true;
+
+        auto writer = std::make_unique<ScalarColumnWriter>(flat_options, get_type_info(stat.type), _wfile);
+        RETURN_IF_ERROR(writer->init());
+        _flat_columns.push_back(FlatColumn{key, stat.type, std::move(writer)});
+    }
+    return Status::OK();
+}
+
+Status JsonColumnWriter::_append_json_and_flat_columns(const Column& column) {
+    RETURN_IF_ERROR(_json_writer->append(column));
+    if (_flat_columns.empty()) {
+        return Status::OK();
+    }
+
+    const NullColumn* null_column = nullptr;
+    const JsonColumn* json_column = nullptr;
+    if (column.is_nullable()) {
+        const auto& nullable_column = down_cast<const NullableColumn&>(column);
+        null_column = nullable_column.null_column().get();
+        json_column = down_cast<const JsonColumn*>(nullable_column.data_column().get());
+    } else {
+        json_column = down_cast<const JsonColumn*>(&column);
+    }
+    for (auto& flat : _flat_columns) {
+        if (flat.writer == nullptr) {
+            continue;
+        }
+        ColumnPtr flat_column;
+        switch (flat.type) {
+        case TYPE_BIGINT:
+            flat_column = extract_flat_column<TYPE_BIGINT>(*json_column, null_column, flat.path);
+            break;
+        case TYPE_DOUBLE:
+            flat_column = extract_flat_column<TYPE_DOUBLE>(*json_column, null_column, flat.path);
+            break;
+        default:
+            flat_column = extract_flat_column<TYPE_VARCHAR>(*json_column, null_column, flat.path);
+            break;
+        }
+        if (flat_column == nullptr) {
+            // the values written already are buffered in memory, so the column can still be dropped
+            flat.writer.reset();
+            continue;
+        }
+        RETURN_IF_ERROR(flat.writer->append(*flat_column));
+    }
+    return Status::OK();
+}
+
+Status JsonColumnWriter::finish_current_page() {
+    RETURN_IF_ERROR(_flush_sample());
+    RETURN_IF_ERROR(_json_writer->finish_current_page());
+    for (auto& flat : _flat_columns) {
+        if (flat.writer != nullptr) {
+            RETURN_IF_ERROR(flat.writer->finish_current_page());
+        }
+    }
+    return Status::OK();
+}
+
+uint64_t JsonColumnWriter::estimate_buffer_size() {
+    uint64_t size = _json_writer->estimate_buffer_size();
+    if (_sample != nullptr) {
+        size += _sample->byte_size();
+    }
+    for (auto& flat : _flat_columns) {
+        if (flat.writer != nullptr) {
+            size += flat.writer->estimate_buffer_size();
+        }
+    }
+    return size;
+}
+
+Status JsonColumnWriter::finish() {
+    RETURN_IF_ERROR(_flush_sample());
+    RETURN_IF_ERROR(_json_writer->finish());
+
+    // remove the dropped columns, the metas of the others are not moved
+    auto* children = _opts.meta->mutable_children_columns();
+    for (int i = static_cast<int>(_flat_columns.size()) - 1; i >= 0; i--) {
+        if (_flat_columns[i].writer == nullptr) {
+            children->DeleteSubrange(i, 1);
+            _flat_columns.erase(_flat_columns.begin() + i);
+        }
+    }
+    JsonMetaPB* json_meta = _opts.meta->mutable_json_meta();
+    json_meta->clear_flat_paths();
+    for (auto& flat : _flat_columns) {
+        RETURN_IF_ERROR(flat.writer->finish());
+        json_meta->add_flat_paths(flat.path);
+    }
+    return Status::OK();
+}
+
+Status JsonColumnWriter::write_data() {
+    RETURN_IF_ERROR(_json_writer->write_data());
+    for (auto& flat : _flat_columns) {
+        RETURN_IF_ERROR(flat.writer->write_data());
+    }
+    return Status::OK();
+}
+
+Status JsonColumnWriter::write_ordinal_index() {
+    RETURN_IF_ERROR(_json_writer->write_ordinal_index());
+    for (auto& flat : _flat_columns) {
+        RETURN_IF_ERROR(flat.writer->write_ordinal_index());
+    }
+    return Status::OK();
+}
+
+Status JsonColumnWriter::write_zone_map() {
+    RETURN_IF_ERROR(_json_writer->write_zone_map());
+    for (auto& flat : _flat_columns) {
+        RETURN_IF_ERROR(flat.writer->write_zone_map());
+    }
+    return Status::OK();
+}
+
+uint64_t JsonColumnWriter::total_mem_footprint() const {
+    uint64_t total_mem_footprint = _json_writer->total_mem_footprint();
+    for (auto& flat : _flat_columns) {
+        if (flat.writer != nullptr) {
+            total_mem_footprint += flat.writer->total_mem_footprint();
+        }
+    }
+    return total_mem_footprint;
+}
+
+} // namespace starrocks
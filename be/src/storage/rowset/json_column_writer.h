@@ -0,0 +1,26 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include "storage/rowset/column_writer.h"
+
+namespace starrocks {
+
+// Create a writer of a JSON column, which stores the JSON values as they are and, besides, extracts the
+// top-level keys appearing in most of the values into typed children columns, see JsonMetaPB.flat_paths.
+StatusOr<std::unique_ptr<ColumnWriter>> create_json_column_writer(const ColumnWriterOptions& opts,
+                                                                  TypeInfoPtr type_info, WritableFile* wfile);
+
+} // namespace starrocks
@@ -38,6 +38,7 @@
 #include <butil/reader_writer.h>
 #include <fmt/format.h>
 
+#include <algorithm>
 #include <ctime>
 #include <memory>
 
@@ -503,6 +504,29 @@ Status HorizontalRowsetWriter::add_rowset(RowsetSharedPtr rowset) {
     return Status::OK();
 }
 
+Status HorizontalRowsetWriter::link_segment(const RowsetSharedPtr& rowset, uint32_t segment_id) {
+    DCHECK(_segment_writer == nullptr);
+    std::string src_path = Rowset::segment_file_path(rowset->rowset_path(), rowset->rowset_id(), segment_id);
+    std::string dst_path = Rowset::segment_file_path(_context.rowset_path_prefix, _context.rowset_id, _num_segment);
+    if (link(src_path.c_str(), dst_path.c_str()) != 0) {
+        PLOG(WARNING) << "Fail to link " << src_path << " to " << dst_path;
+        return Status::RuntimeError("Fail to link segment data file");
+    }
+    ++_num_segment;
+    ASSIGN_OR_RETURN(auto file_size, _fs->get_file_size(dst_path));
+    int64_t num_rows = rowset->segments()[segment_id]->num_rows();
+    _num_rows_written += num_rows;
+    _total_data_size += static_cast<int64_t>(file_size);
+    // the row size and the index size are only recorded per rowset, so share them by the number of rows
+    auto rowset_num_rows = static_cast<int64_t>(rowset->num_rows());
+    if (rowset_num_rows > 0) {
+        _total_row_size += static_cast<int64_t>(rowset->total_row_size()) * num_rows / rowset_num_rows;
+        _total_index_size +=
+                static_cast<int64_t>(rowset->rowset_meta()->index_disk_size()) * num_rows / rowset_num_rows;
+    }
+    return Status::OK();
+}
+
 Status HorizontalRowsetWriter::add_rowset_for_linked_schema_change(RowsetSharedPtr rowset,
                                                                    const SchemaMapping& schema_mapping) {
     // TODO use schema_mapping to transfer zonemap
@@ -1043,6 +1067,91 @@ Status VerticalRowsetWriter::final_flush() {
     return Status::OK();
 }
 
+// VerticalColumnGroupWriter writes a column group into the segments created by the key columns,
+// following the number of rows of each segment.
+class VerticalColumnGroupWriter final : public ColumnGroupWriter {
+public:
+    VerticalColumnGroupWriter(VerticalRowsetWriter* rowset_writer, std::vector<uint32_t> column_indexes)
+            : _rowset_writer(rowset_writer), _column_indexes(std::move(column_indexes)) {}
+
+    Status add_columns(const Chunk& chunk) override {
+        const auto& segment_writers = _rowset_writer->_segment_writers;
+        const size_t chunk_num_rows = chunk.num_rows();
+        size_t offset = 0;
+        while (offset < chunk_num_rows) {
+            if (_writer == nullptr || _writer->num_rows_written() == segment_writers[_segment_index]->num_rows()) {
+                RETURN_IF_ERROR(_next_segment());
+            }
+            size_t write_size = std::min<size_t>(
+                    segment_writers[_segment_index]->num_rows() - _writer->num_rows_written(), chunk_num_rows - offset);
+            if (write_size == chunk_num_rows) {
+                RETURN_IF_ERROR(_writer->append_chunk(chunk));
+            } else {
+                // split into multi chunks and write into multi segments
+                if (_write_chunk == nullptr) {
+                    _write_chunk = chunk.clone_empty();
+                }
+                _write_chunk->reset();
+                _write_chunk->append(chunk, offset, write_size);
+                RETURN_IF_ERROR(_writer->append_chunk(*_write_chunk));
+            }
+            offset += write_size;
+        }
+
+        std::lock_guard<std::mutex> l(_rowset_writer->_lock);
+        _rowset_writer->_total_row_size += static_cast<int64_t>(chunk.bytes_usage());
+        return Status::OK();
+    }
+
+    Status flush_columns() override {
+        const auto& segment_writers = _rowset_writer->_segment_writers;
+        if (_writer == nullptr) {
+            return segment_writers.empty() ? Status::OK()
+                                           : Status::InternalError("no rows are written into the column group");
+        }
+        RETURN_IF_ERROR(_finalize_writer());
+        if (_segment_index + 1 != segment_writers.size()) {
+            return Status::InternalError(fmt::format("rows are written into {} segments of {}", _segment_index + 1,
+                                                     segment_writers.size()));
+        }
+        return Status::OK();
+    }
+
+private:
+    Status _next_segment() {
+        const auto& segment_writers = _rowset_writer->_segment_writers;
+        if (_writer != nullptr) {
+            RETURN_IF_ERROR(_finalize_writer());
+            ++_segment_index;
+        }
+        if (_segment_index >= segment_writers.size()) {
+            return Status::InternalError("more rows are written into the column group than the key columns");
+        }
+        ASSIGN_OR_RETURN(_writer, segment_writers[_segment_index]->new_column_group_writer(_column_indexes));
+        return Status::OK();
+    }
+
+    Status _finalize_writer() {
+        uint64_t index_size = 0;
+        RETURN_IF_ERROR(_writer->finalize(&index_size));
+        std::lock_guard<std::mutex> l(_rowset_writer->_lock);
+        _rowset_writer->_total_index_size += static_cast<int64_t>(index_size);
+        return Status::OK();
+    }
+
+    VerticalRowsetWriter* _rowset_writer;
+    std::vector<uint32_t> _column_indexes;
+    size_t _segment_index = 0;
+    std::unique_ptr<SegmentColumnGroupWriter> _writer;
+    ChunkUniquePtr _write_chunk;
+};
+
+StatusOr<std::unique_ptr<ColumnGroupWriter>> VerticalRowsetWriter::new_column_group_writer(
+        const std::vector<uint32_t>& column_indexes) {
+    std::unique_ptr<ColumnGroupWriter> writer = std::make_unique<VerticalColumnGroupWriter>(this, column_indexes);
+    return std::move(writer);
+}
+
 StatusOr<std::unique_ptr<SegmentWriter>> VerticalRowsetWriter::_create_segment_writer(
         const std::vector<uint32_t>& column_indexes, bool is_key) {
     std::lock_guard<std::mutex> l(_lock);
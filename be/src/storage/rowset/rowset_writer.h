@@ -65,6 +65,19 @@ enum class FlushChunkState { UNKNOWN, UPSERT, DELETE, MIXED };
 class Chunk;
 class Column;
 
+// ColumnGroupWriter writes a group of non-key columns into all the segments of a rowset whose
+// key columns have been flushed, concurrently with the writers of the other column groups.
+class ColumnGroupWriter {
+public:
+    virtual ~ColumnGroupWriter() = default;
+
+    // |chunk| contains the columns data corresponding to the column group.
+    virtual Status add_columns(const Chunk& chunk) = 0;
+
+    // flush columns data and index of the last segment
+    virtual Status flush_columns() = 0;
+};
+
 // RowsetWriter is responsible for writing data into segment by row or chunk.
 // Usage Example:
 //      // create writer
@@ -93,6 +106,15 @@ class Column;
 //      }
 //      writer->final_flush();
 //
+//      // 4. add non-key columns by column groups concurrently, after the key columns are flushed
+//      // in each thread:
+//      auto group_writer = writer->new_column_group_writer(column_group).value();
+//      group_writer->add_columns(chunk1);
+//      ...
+//      group_writer->flush_columns();
+//      // after all the column groups are flushed:
+//      writer->final_flush();
+//
 //      // finish
 //      writer->build();
 //
@@ -127,6 +149,12 @@ public:
     // Precondition: the input `rowset` should have the same type of the rowset we're building
     virtual Status add_rowset(RowsetSharedPtr rowset) { return Status::NotSupported("RowsetWriter::add_rowset"); }
 
+    // Add the segment |segment_id| of |rowset| as the next segment by creating a hard link, without decoding it.
+    // Precondition: the input `rowset` should have the same type of the rowset we're building
+    virtual Status link_segment(const RowsetSharedPtr& rowset, uint32_t segment_id) {
+        return Status::NotSupported("RowsetWriter::link_segment");
+    }
+
     // Precondition: the input `rowset` should have the same type of the rowset we're building
     virtual Status add_rowset_for_linked_schema_change(RowsetSharedPtr rowset, const SchemaMapping& schema_mapping) {
         return Status::NotSupported("RowsetWriter::add_rowset_for_linked_schema_change");
@@ -142,6 +170,13 @@ public:
     // flush segments footer
     virtual Status final_flush() { return Status::NotSupported("RowsetWriter::final_flush"); }
 
+    // Used for vertical compaction
+    // create a writer of the non-key columns |column_indexes|, see ColumnGroupWriter
+    virtual StatusOr<std::unique_ptr<ColumnGroupWriter>> new_column_group_writer(
+            const std::vector<uint32_t>& column_indexes) {
+        return Status::NotSupported("RowsetWriter::new_column_group_writer");
+    }
+
     // finish building and return pointer to the built rowset (guaranteed to be inited).
     // return nullptr when failed
     virtual StatusOr<RowsetSharedPtr> build();
@@ -205,6 +240,7 @@ public:
 
     // add rowset by create hard link
     Status add_rowset(RowsetSharedPtr rowset) override;
+    Status link_segment(const RowsetSharedPtr& rowset, uint32_t segment_id) override;
     Status add_rowset_for_linked_schema_change(RowsetSharedPtr rowset, const SchemaMapping& schema_mapping) override;
 
     Status flush() override;
@@ -238,7 +274,12 @@ public:
 
     Status final_flush() override;
 
+    StatusOr<std::unique_ptr<ColumnGroupWriter>> new_column_group_writer(
+            const std::vector<uint32_t>& column_indexes) override;
+
 private:
+    friend class VerticalColumnGroupWriter;
+
     StatusOr<std::unique_ptr<SegmentWriter>> _create_segment_writer(const std::vector<uint32_t>& column_indexes,
                                                                     bool is_key);
 
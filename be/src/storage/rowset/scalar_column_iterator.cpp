@@ -34,6 +34,11 @@
 
 #include "storage/rowset/scalar_column_iterator.h"
 
+#include <limits>
+
+#include "column/binary_column.h"
+#include "column/nullable_column.h"
+#include "gutil/strings/substitute.h"
 #include "storage/column_predicate.h"
 #include "storage/rowset/binary_dict_page.h"
 #include "storage/rowset/column_reader.h"
@@ -147,6 +152,137 @@ void ScalarColumnIterator::_seek_to_pos_in_page(ParsedPage* page, ordinal_t offs
     page->seek(offset_in_page);
 }
 
+template <typename ReadRange>
+Status ScalarColumnIterator::_read_page(Column* dst, const ReadRange& range) {
+    if (_pushed_predicates.empty()) {
+        return _page->read(dst, range);
+    }
+    if (_page->encoding_type() == DICT_ENCODING) {
+        _dict_codes->reset_column();
+        RETURN_IF_ERROR(_page->read_dict_codes(_dict_codes.get(), range));
+        return _materialize_selected_dict_codes(dst);
+    }
+    // the dictionary is full and this page falls back to plain encoding, evaluate the predicates on the values.
+    size_t from = dst->size();
+    RETURN_IF_ERROR(_page->read(dst, range));
+    return _evaluate_pushed_predicates(dst, from);
+}
+
+Status ScalarColumnIterator::_materialize_selected_dict_codes(Column* dst) {
+    const Int32Column* codes = nullptr;
+    const uint8_t* nulls = nullptr;
+    if (_dict_codes->is_nullable()) {
+        auto* nullable_codes = down_cast<NullableColumn*>(_dict_codes.get());
+        codes = down_cast<const Int32Column*>(nullable_codes->data_column().get());
+        nulls = nullable_codes->has_null() ? nullable_codes->null_column()->get_data().data() : nullptr;
+    } else {
+        codes = down_cast<const Int32Column*>(_dict_codes.get());
+    }
+    const size_t num_rows = codes->size();
+    const int32_t* code_data = codes->get_data().data();
+    const int32_t dict_size = static_cast<int32_t>(_dict_words.size());
+
+    const size_t offset = _pushed_selection.size();
+    _pushed_selection.resize(offset + num_rows);
+    uint8_t* selection = _pushed_selection.data() + offset;
+    _selected_words.resize(num_rows);
+    for (size_t i = 0; i < num_rows; i++) {
+        if (nulls != nullptr && nulls[i]) {
+            selection[i] = _null_selected;
+            _selected_words[i] = Slice();
+            continue;
+        }
+        int32_t code = code_data[i];
+        if (UNLIKELY(code < 0 || code >= dict_size)) {
+            return Status::Corruption(strings::Substitute("invalid dictionary code $0, dictionary size $1", code,
+                                                          dict_size));
+        }
+        selection[i] = _dict_selection[code];
+        // only the words of selected rows are copied, the others are left empty.
+        _selected_words[i] = selection[i] ? _dict_words[code] : Slice();
+    }
+
+    if (dst->is_nullable()) {
+        auto* nullable_dst = down_cast<NullableColumn*>(dst);
+        [[maybe_unused]] bool ok = nullable_dst->data_column()->append_strings(_selected_words);
+        DCHECK(ok);
+        if (nulls != nullptr) {
+            (void)nullable_dst->null_column()->append_numbers(nulls, num_rows);
+        } else {
+            nullable_dst->null_column()->append_default(num_rows);
+        }
+        nullable_dst->update_has_null();
+    } else {
+        [[maybe_unused]] bool ok = dst->append_strings(_selected_words);
+        DCHECK(ok);
+    }
+    return Status::OK();
+}
+
+Status ScalarColumnIterator::_evaluate_pushed_predicates(const Column* column, size_t from) {
+    const size_t to = column->size();
+    DCHECK_LE(to, std::numeric_limits<uint16_t>::max());
+    _page_selection.resize(to);
+    RETURN_IF_ERROR(_pushed_predicates[0]->evaluate(column, _page_selection.data(), from, to));
+    for (size_t i = 1; i < _pushed_predicates.size(); i++) {
+        RETURN_IF_ERROR(_pushed_predicates[i]->evaluate_and(column, _page_selection.data(), from, to));
+    }
+    _pushed_selection.insert(_pushed_selection.end(), _page_selection.begin() + from, _page_selection.begin() + to);
+    return Status::OK();
+}
+
+bool ScalarColumnIterator::push_down_predicates(const std::vector<const ColumnPredicate*>& predicates) {
+    DCHECK(_pushed_predicates.empty());
+    // only dictionary encoded columns which are not read as dictionary codes benefit from it.
+    if (predicates.empty() || _init_dict_decoder_func == nullptr || _all_dict_encoded) {
+        return false;
+    }
+    if (_dict_decoder == nullptr && !_load_dict_page().ok()) {
+        return false;
+    }
+    std::vector<Slice> words;
+    Status st = _reader->column_type() == TYPE_CHAR ? _fetch_all_dict_words<TYPE_CHAR>(&words)
+                                                     : _fetch_all_dict_words<TYPE_VARCHAR>(&words);
+    // predicates are evaluated on at most 65535 rows at a time.
+    const size_t num_values = words.size() + is_nullable();
+    if (!st.ok() || num_values >= std::numeric_limits<uint16_t>::max()) {
+        return false;
+    }
+
+    // evaluate the predicates on the dictionary, with NULL at the end for nullable column.
+    auto dict_column = BinaryColumn::create();
+    [[maybe_unused]] bool ok = dict_column->append_strings(words);
+    DCHECK(ok);
+    ColumnPtr values = dict_column;
+    if (is_nullable()) {
+        auto null_column = NullColumn::create();
+        null_column->resize(words.size());
+        auto nullable_column = NullableColumn::create(dict_column, null_column);
+        nullable_column->append_default();
+        values = nullable_column;
+    }
+    std::vector<uint8_t> selection(num_values);
+    for (size_t i = 0; i < predicates.size(); i++) {
+        st = i == 0 ? predicates[i]->evaluate(values.get(), selection.data(), 0, num_values)
+                    : predicates[i]->evaluate_and(values.get(), selection.data(), 0, num_values);
+        if (!st.ok()) {
+            return false;
+        }
+    }
+
+    _null_selected = is_nullable() && selection.back();
+    selection.resize(words.size());
+    _dict_selection = std::move(selection);
+    _dict_words = std::move(words);
+    ColumnPtr codes = Int32Column::create();
+    if (is_nullable()) {
+        codes = NullableColumn::create(codes, NullColumn::create());
+    }
+    _dict_codes = std::move(codes);
+    _pushed_predicates = predicates;
+    return true;
+}
+
 Status ScalarColumnIterator::next_batch(size_t* n, Column* dst) {
     size_t remaining = *n;
     size_t prev_bytes = dst->byte_size();
@@ -163,7 +299,7 @@ Status ScalarColumnIterator::next_batch(size_t* n, Column* dst) {
         contain_deleted_row = contain_deleted_row || _contains_deleted_row(_page->page_index());
         // number of rows to be read from this page
         size_t nread = remaining;
-        RETURN_IF_ERROR(_page->read(dst, &nread));
+        RETURN_IF_ERROR(_read_page(dst, &nread));
         _current_ordinal += nread;
         remaining -= nread;
     }
@@ -218,7 +354,7 @@ Status ScalarColumnIterator::next_batch(const SparseRange& range, Column* dst) {
             // current page have been added in read range
             // read current page data first
             contain_deleted_row = contain_deleted_row || _contains_deleted_row(_page->page_index());
-            RETURN_IF_ERROR(_page->read(dst, read_range));
+            RETURN_IF_ERROR(_read_page(dst, read_range));
             read_range.clear();
         }
     }
@@ -226,7 +362,7 @@ Status ScalarColumnIterator::next_batch(const SparseRange& range, Column* dst) {
     if (!read_range.empty()) {
         // read data left if read range is not empty
         contain_deleted_row = contain_deleted_row || _contains_deleted_row(_page->page_index());
-        RETURN_IF_ERROR(_page->read(dst, read_range));
+        RETURN_IF_ERROR(_read_page(dst, read_range));
         read_range.clear();
     }
     dst->set_delete_state(contain_deleted_row ? DEL_PARTIAL_SATISFIED : DEL_NOT_SATISFIED);
@@ -85,6 +85,12 @@ public:
 
     Status fetch_dict_codes_by_rowid(const rowid_t* rowids, size_t size, Column* values) override;
 
+    bool push_down_predicates(const std::vector<const ColumnPredicate*>& predicates) override;
+
+    std::vector<uint8_t>* pushed_down_selection() override {
+        return _pushed_predicates.empty() ? nullptr : &_pushed_selection;
+    }
+
     ParsedPage* get_current_page() { return _page.get(); }
 
     bool is_nullable();
@@ -123,6 +129,15 @@ private:
 
     Status _load_dict_page();
 
+    // read the rows specified by |range| of the current page into |dst|, evaluating the pushed down
+    // predicates if there is any. |range| is either a `size_t*` or a `SparseRange`.
+    template <typename ReadRange>
+    Status _read_page(Column* dst, const ReadRange& range);
+
+    Status _materialize_selected_dict_codes(Column* dst);
+
+    Status _evaluate_pushed_predicates(const Column* column, size_t from);
+
     bool _contains_deleted_row(uint32_t page_index) const;
 
     ColumnReader* _reader;
@@ -165,6 +180,18 @@ private:
     int64_t _element_ordinal = 0;
 
     UInt32Column _array_size;
+
+    // predicates pushed down by `push_down_predicates`.
+    std::vector<const ColumnPredicate*> _pushed_predicates;
+    // the result of the pushed down predicates for every dictionary code, plus one for null.
+    std::vector<uint8_t> _dict_selection;
+    bool _null_selected = false;
+    std::vector<Slice> _dict_words;
+    // buffers used to read dictionary codes and evaluate plain encoded pages.
+    ColumnPtr _dict_codes;
+    std::vector<Slice> _selected_words;
+    std::vector<uint8_t> _page_selection;
+    std::vector<uint8_t> _pushed_selection;
 };
 
 } // namespace starrocks
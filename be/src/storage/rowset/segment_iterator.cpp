@@ -19,6 +19,7 @@
 #include <stack>
 #include <unordered_map>
 
+#include "block_cache/block_cache.h"
 #include "column/binary_column.h"
 #include "column/chunk.h"
 #include "column/column_helper.h"
@@ -29,6 +30,7 @@
 #include "glog/logging.h"
 #include "gutil/casts.h"
 #include "gutil/stl_util.h"
+#include "io/cache_input_stream.h"
 #include "segment_options.h"
 #include "simd/simd.h"
 #include "storage/chunk_helper.h"
@@ -205,6 +207,8 @@ private:
 
     void _init_column_predicates();
 
+    bool _can_push_down_predicates(ColumnId cid) const;
+
     Status _init_context();
 
     template <bool late_materialization>
@@ -264,6 +268,8 @@ private:
     std::vector<const ColumnPredicate*> _vectorized_preds;
     std::vector<const ColumnPredicate*> _branchless_preds;
     std::vector<const ColumnPredicate*> _expr_ctx_preds; // predicates using ExprContext*
+    // iterators of the columns whose predicates are evaluated while reading, see `push_down_predicates`.
+    std::vector<ColumnIterator*> _pushed_down_iterators;
     // _selection is used to accelerate
     Buffer<uint8_t> _selection;
 
@@ -349,7 +355,22 @@ Status SegmentIterator::_init() {
 
     StarRocksMetrics::instance()->segment_read_total.increment(1);
     // get file handle from file descriptor of segment
-    ASSIGN_OR_RETURN(_rfile, _opts.fs->new_random_access_file(_segment->file_name()));
+    const std::string* staged_file = nullptr;
+    if (_opts.staged_files != nullptr) {
+        auto iter = _opts.staged_files->find(_segment->file_name());
+        staged_file = iter != _opts.staged_files->end() ? &iter->second : nullptr;
+    }
+    if (staged_file != nullptr) {
+        ASSIGN_OR_RETURN(_rfile, FileSystem::Default()->new_random_access_file(*staged_file));
+    } else {
+        ASSIGN_OR_RETURN(_rfile, _opts.fs->new_random_access_file(_segment->file_name()));
+    }
+    if (staged_file == nullptr && _opts.use_block_cache && BlockCache::instance()->is_initialized()) {
+        ASSIGN_OR_RETURN(std::shared_ptr<io::CacheInputStream> cache_stream,
+                         io::CacheInputStream::create(_rfile->filename(), _rfile->stream()));
+        cache_stream->set_enable_populate_cache(_opts.reader_type == READER_QUERY);
+        _rfile = std::make_unique<RandomAccessFile>(std::move(cache_stream), _segment->file_name());
+    }
 
     /// the calling order matters, do not change unless you know why.
 
@@ -454,13 +475,23 @@ Status SegmentIterator::_init_column_iterators(const Schema& schema) {
 
 void SegmentIterator::_init_column_predicates() {
     DCHECK_EQ(_predicate_columns, _opts.predicates.size());
+    std::vector<const ColumnPredicate*> preds;
     for (const auto& pair : _opts.predicates) {
+        preds.clear();
         for (const ColumnPredicate* pred : pair.second) {
             // If this predicate is generated by join runtime filter,
             // We only use it to compute segment row range.
             if (pred->is_index_filter_only()) {
                 continue;
             }
+            preds.emplace_back(pred);
+        }
+        if (!preds.empty() && _can_push_down_predicates(pair.first) &&
+            _column_iterators[pair.first]->push_down_predicates(preds)) {
+            _pushed_down_iterators.emplace_back(_column_iterators[pair.first].get());
+            continue;
+        }
+        for (const ColumnPredicate* pred : preds) {
             if (pred->is_expr_predicate()) {
                 _expr_ctx_preds.emplace_back(pred);
             } else if (pred->can_vectorized()) {
@@ -470,11 +501,18 @@ void SegmentIterator::_init_column_predicates() {
             }
         }
     }
-    if (_vectorized_preds.empty() && _branchless_preds.empty()) {
+    if (_vectorized_preds.empty() && _branchless_preds.empty() && _pushed_down_iterators.empty()) {
         _opts.predicates.clear();
     }
 }
 
+// Predicates on a dictionary encoded column that is not read as dictionary codes, i.e. some of its
+// pages fall back to plain encoding, can still be evaluated against the dictionary while reading.
+bool SegmentIterator::_can_push_down_predicates(ColumnId cid) const {
+    return config::enable_dict_page_predicate_pushdown && !_predicate_need_rewrite[cid] &&
+           _opts.global_dictmaps->count(cid) == 0;
+}
+
 Status SegmentIterator::_get_row_ranges_by_keys() {
     StarRocksMetrics::instance()->segment_row_total.increment(num_rows());
 
@@ -774,6 +812,9 @@ inline Status SegmentIterator::_read(Chunk* chunk, vector<rowid_t>* rowids, size
     {
         _opts.stats->blocks_load += 1;
         SCOPED_RAW_TIMER(&_opts.stats->block_fetch_ns);
+        for (ColumnIterator* iter : _pushed_down_iterators) {
+            iter->pushed_down_selection()->clear();
+        }
         RETURN_IF_ERROR(_context->read_columns(chunk, range));
     }
 
@@ -982,17 +1023,40 @@ void SegmentIterator::_switch_context(ScanContext* to) {
 }
 
 StatusOr<uint16_t> SegmentIterator::_filter(Chunk* chunk, vector<rowid_t>* rowid, uint16_t from, uint16_t to) {
-    // There must be one predicate, either vectorized or branchless.
-    DCHECK(_vectorized_preds.size() + _branchless_preds.size() > 0 || _del_vec);
+    // There must be one predicate, either pushed down, vectorized or branchless.
+    DCHECK(_pushed_down_iterators.size() + _vectorized_preds.size() + _branchless_preds.size() > 0 || _del_vec);
 
     SCOPED_RAW_TIMER(&_opts.stats->vec_cond_ns);
 
+    // merge the results of the predicates evaluated by column iterators
+    bool selection_inited = false;
+    if (!_pushed_down_iterators.empty()) {
+        SCOPED_RAW_TIMER(&_opts.stats->vec_cond_evaluate_ns);
+        for (ColumnIterator* iter : _pushed_down_iterators) {
+            const std::vector<uint8_t>* pushed = iter->pushed_down_selection();
+            DCHECK_EQ(to - from, pushed->size());
+            if (!selection_inited) {
+                memcpy(&_selection[from], pushed->data(), to - from);
+                selection_inited = true;
+            } else {
+                for (uint16_t i = from; i < to; ++i) {
+                    _selection[i] &= (*pushed)[i - from];
+                }
+            }
+        }
+    }
+
     // first evaluate
     if (!_vectorized_preds.empty()) {
         SCOPED_RAW_TIMER(&_opts.stats->vec_cond_evaluate_ns);
         const ColumnPredicate* pred = _vectorized_preds[0];
         Column* c = chunk->get_column_by_id(pred->column_id()).get();
-        pred->evaluate(c, _selection.data(), from, to);
+        if (!selection_inited) {
+            pred->evaluate(c, _selection.data(), from, to);
+        } else {
+            pred->evaluate_and(c, _selection.data(), from, to);
+        }
+        selection_inited = true;
         for (int i = 1; i < _vectorized_preds.size(); ++i) {
             pred = _vectorized_preds[i];
             c = chunk->get_column_by_id(pred->column_id()).get();
@@ -1005,13 +1069,13 @@ StatusOr<uint16_t> SegmentIterator::_filter(Chunk* chunk, vector<rowid_t>* rowid
         SCOPED_RAW_TIMER(&_opts.stats->branchless_cond_evaluate_ns);
 
         uint16_t selected_size = 0;
-        if (!_vectorized_preds.empty()) {
+        if (selection_inited) {
             for (uint16_t i = from; i < to; ++i) {
                 _selected_idx[selected_size] = i;
                 selected_size += _selection[i];
             }
         } else {
-            // when there is no vectorized predicates, should initialize _selected_idx
+            // when there is no vectorized or pushed down predicates, should initialize _selected_idx
             // in a vectorized way
             selected_size = to - from;
             for (uint16_t i = from, j = 0; i < to; ++i, ++j) {
@@ -1554,6 +1618,7 @@ void SegmentIterator::close() {
     }
     _context_list[0].close();
     _context_list[1].close();
+    _pushed_down_iterators.clear();
     _column_iterators.resize(0);
     _obj_pool.clear();
     _rfile.reset();
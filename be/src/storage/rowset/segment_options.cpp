@@ -42,6 +42,8 @@ Status SegmentReadOptions::convert_to(SegmentReadOptions* dst, const std::vector
     dst->fs = fs;
     dst->stats = stats;
     dst->use_page_cache = use_page_cache;
+    dst->use_block_cache = use_block_cache;
+    dst->staged_files = staged_files;
     dst->profile = profile;
     dst->global_dictmaps = global_dictmaps;
     dst->rowid_range_option = rowid_range_option;
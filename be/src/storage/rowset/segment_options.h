@@ -66,6 +66,11 @@ public:
     RuntimeProfile* profile = nullptr;
 
     bool use_page_cache = false;
+    // read the segment file through the block cache, blocks read by queries are also populated into it.
+    bool use_block_cache = false;
+    // the local copies of the segment files keyed by the paths of the segment files, read instead of the
+    // segment files if present
+    const std::unordered_map<std::string, std::string>* staged_files = nullptr;
 
     ReaderType reader_type = READER_QUERY;
     int chunk_size = DEFAULT_CHUNK_SIZE;
@@ -122,62 +122,66 @@ Status SegmentWriter::init(const std::vector<uint32_t>& column_indexes, bool has
 
     _column_indexes.insert(_column_indexes.end(), column_indexes.begin(), column_indexes.end());
     _column_writers.reserve(_column_indexes.size());
-    size_t num_columns = _tablet_schema->num_columns();
     for (uint32_t column_index : _column_indexes) {
-        if (column_index >= num_columns) {
-            return Status::InternalError(
-                    strings::Substitute("column index $0 out of range $1", column_index, num_columns));
-        }
+        ASSIGN_OR_RETURN(auto writer, _create_column_writer(column_index));
+        _column_writers.push_back(std::move(writer));
+    }
 
-        const auto& column = _tablet_schema->column(column_index);
-        ColumnWriterOptions opts;
-        opts.page_format = 2;
-        opts.meta = _footer.add_columns();
+    _has_key = has_key;
+    if (_has_key) {
+        _index_builder = std::make_unique<ShortKeyIndexBuilder>(_segment_id, _opts.num_rows_per_block);
+    }
+    return Status::OK();
+}
 
-        if (!_opts.referenced_column_ids.empty()) {
-            DCHECK(_opts.referenced_column_ids.size() == num_columns);
-            _init_column_meta(opts.meta, _opts.referenced_column_ids[column_index], column);
-        } else {
-            _init_column_meta(opts.meta, column_index, column);
-        }
+StatusOr<std::unique_ptr<ColumnWriter>> SegmentWriter::_create_column_writer(uint32_t column_index) {
+    size_t num_columns = _tablet_schema->num_columns();
+    if (column_index >= num_columns) {
+        return Status::InternalError(strings::Substitute("column index $0 out of range $1", column_index, num_columns));
+    }
+
+    const auto& column = _tablet_schema->column(column_index);
+    ColumnWriterOptions opts;
+    opts.page_format = 2;
+    opts.meta = _footer.add_columns();
+
+    if (!_opts.referenced_column_ids.empty()) {
+        DCHECK(_opts.referenced_column_ids.size() == num_columns);
+        _init_column_meta(opts.meta, _opts.referenced_column_ids[column_index], column);
+    } else {
+        _init_column_meta(opts.meta, column_index, column);
+    }
 
-        // now we create zone map for key columns
-        // and not support zone map for array type.
-        // TODO(mofei) refactor it to type specification
-        opts.need_zone_map = column.is_key() ||
-                             (_tablet_schema->keys_type() == KeysType::DUP_KEYS && is_zone_map_key_type(column.type()));
-        if (column.type() == LogicalType::TYPE_ARRAY) {
-            opts.need_zone_map = false;
+    // now we create zone map for key columns
+    // and not support zone map for array type.
+    // TODO(mofei) refactor it to type specification
+    opts.need_zone_map = column.is_key() ||
+                         (_tablet_schema->keys_type() == KeysType::DUP_KEYS && is_zone_map_key_type(column.type()));
+    if (column.type() == LogicalType::TYPE_ARRAY) {
+        opts.need_zone_map = false;
+    }
+    opts.need_bloom_filter = column.is_bf_column();
+    opts.need_bitmap_index = column.has_bitmap_index();
+    if (column.type() == LogicalType::TYPE_ARRAY) {
+        if (opts.need_bloom_filter) {
+            return Status::NotSupported("Do not support bloom filter for array type");
         }
-        opts.need_bloom_filter = column.is_bf_column();
-        opts.need_bitmap_index = column.has_bitmap_index();
-        if (column.type() == LogicalType::TYPE_ARRAY) {
-            if (opts.need_bloom_filter) {
-                return Status::NotSupported("Do not support bloom filter for array type");
-            }
-            if (opts.need_bitmap_index) {
-                return Status::NotSupported("Do not support bitmap index for array type");
-            }
+        if (opts.need_bitmap_index) {
+            return Status::NotSupported("Do not support bitmap index for array type");
         }
+    }
 
-        if (column.type() == LogicalType::TYPE_VARCHAR && _opts.global_dicts != nullptr) {
-            auto iter = _opts.global_dicts->find(column.name().data());
-            if (iter != _opts.global_dicts->end()) {
-                opts.global_dict = &iter->second;
-                _global_dict_columns_valid_info[iter->first] = true;
-            }
+    if (column.type() == LogicalType::TYPE_VARCHAR && _opts.global_dicts != nullptr) {
+        auto iter = _opts.global_dicts->find(column.name().data());
+        if (iter != _opts.global_dicts->end()) {
+            opts.global_dict = &iter->second;
+            _global_dict_columns_valid_info[iter->first] = true;
         }
-
-        ASSIGN_OR_RETURN(auto writer, ColumnWriter::create(opts, &column, _wfile.get()));
-        RETURN_IF_ERROR(writer->init());
-        _column_writers.push_back(std::move(writer));
     }
 
-    _has_key = has_key;
-    if (_has_key) {
-        _index_builder = std::make_unique<ShortKeyIndexBuilder>(_segment_id, _opts.num_rows_per_block);
-    }
-    return Status::OK();
+    ASSIGN_OR_RETURN(auto writer, ColumnWriter::create(opts, &column, _wfile.get()));
+    RETURN_IF_ERROR(writer->init());
+    return std::move(writer);
 }
 
 // TODO(lingbin): Currently this function does not include the size of various indexes,
@@ -209,35 +213,11 @@ Status SegmentWriter::finalize_columns(uint64_t* index_size) {
     }
     _num_rows_written = 0;
 
-    size_t num_columns = _tablet_schema->num_columns();
     for (size_t i = 0; i < _column_indexes.size(); ++i) {
-        uint32_t column_index = _column_indexes[i];
-        if (column_index >= num_columns) {
-            return Status::InternalError(
-                    strings::Substitute("column index $0 out of range $1", column_index, num_columns));
-        }
-
-        auto& column_writer = _column_writers[i];
-        RETURN_IF_ERROR(column_writer->finish());
-        // write data
-        RETURN_IF_ERROR(column_writer->write_data());
-        // write index
-        uint64_t index_offset = _wfile->size();
-        RETURN_IF_ERROR(column_writer->write_ordinal_index());
-        RETURN_IF_ERROR(column_writer->write_zone_map());
-        RETURN_IF_ERROR(column_writer->write_bitmap_index());
-        RETURN_IF_ERROR(column_writer->write_bloom_filter_index());
-        *index_size += _wfile->size() - index_offset;
-
-        // global dict
-        if (!column_writer->is_global_dict_valid()) {
-            std::string col_name(_tablet_schema->columns()[column_index].name().data(),
-                                 _tablet_schema->columns()[column_index].name().size());
-            _global_dict_columns_valid_info[col_name] = false;
-        }
-
+        RETURN_IF_ERROR(_column_writers[i]->finish());
+        RETURN_IF_ERROR(_finalize_column_writer(_column_indexes[i], _column_writers[i].get(), index_size));
         // reset to release memory
-        column_writer.reset();
+        _column_writers[i].reset();
     }
     _column_writers.clear();
     _column_indexes.clear();
@@ -251,6 +231,32 @@ Status SegmentWriter::finalize_columns(uint64_t* index_size) {
     return Status::OK();
 }
 
+Status SegmentWriter::_finalize_column_writer(uint32_t column_index, ColumnWriter* column_writer,
+                                              uint64_t* index_size) {
+    size_t num_columns = _tablet_schema->num_columns();
+    if (column_index >= num_columns) {
+        return Status::InternalError(strings::Substitute("column index $0 out of range $1", column_index, num_columns));
+    }
+
+    // write data
+    RETURN_IF_ERROR(column_writer->write_data());
+    // write index
+    uint64_t index_offset = _wfile->size();
+    RETURN_IF_ERROR(column_writer->write_ordinal_index());
+    RETURN_IF_ERROR(column_writer->write_zone_map());
+    RETURN_IF_ERROR(column_writer->write_bitmap_index());
+    RETURN_IF_ERROR(column_writer->write_bloom_filter_index());
+    *index_size += _wfile->size() - index_offset;
+
+    // global dict
+    if (!column_writer->is_global_dict_valid()) {
+        std::string col_name(_tablet_schema->columns()[column_index].name().data(),
+                             _tablet_schema->columns()[column_index].name().size());
+        _global_dict_columns_valid_info[col_name] = false;
+    }
+    return Status::OK();
+}
+
 Status SegmentWriter::finalize_footer(uint64_t* segment_file_size, uint64_t* footer_position) {
     if (footer_position != nullptr) {
         *footer_position = _wfile->size();
@@ -325,4 +331,51 @@ Status SegmentWriter::append_chunk(const Chunk& chunk) {
     return Status::OK();
 }
 
+StatusOr<std::unique_ptr<SegmentColumnGroupWriter>> SegmentWriter::new_column_group_writer(
+        const std::vector<uint32_t>& column_indexes) {
+    DCHECK(_column_writers.empty());
+    std::unique_ptr<SegmentColumnGroupWriter> writer(new SegmentColumnGroupWriter(this, column_indexes));
+    writer->_column_writers.reserve(column_indexes.size());
+    std::lock_guard l(_lock);
+    for (uint32_t column_index : column_indexes) {
+        ASSIGN_OR_RETURN(auto column_writer, _create_column_writer(column_index));
+        DCHECK(!_tablet_schema->column(column_index).is_key());
+        writer->_column_writers.push_back(std::move(column_writer));
+    }
+    return std::move(writer);
+}
+
+SegmentColumnGroupWriter::SegmentColumnGroupWriter(SegmentWriter* segment_writer, std::vector<uint32_t> column_indexes)
+        : _segment_writer(segment_writer), _column_indexes(std::move(column_indexes)) {}
+
+SegmentColumnGroupWriter::~SegmentColumnGroupWriter() = default;
+
+Status SegmentColumnGroupWriter::append_chunk(const Chunk& chunk) {
+    DCHECK_EQ(_column_writers.size(), chunk.num_columns());
+    for (size_t i = 0; i < _column_writers.size(); ++i) {
+        RETURN_IF_ERROR(_column_writers[i]->append(*chunk.get_column_by_index(i)));
+    }
+    _num_rows_written += chunk.num_rows();
+    return Status::OK();
+}
+
+Status SegmentColumnGroupWriter::finalize(uint64_t* index_size) {
+    if (_num_rows_written != _segment_writer->num_rows()) {
+        return Status::InternalError(strings::Substitute("num rows written $0 is not equal to segment num rows $1",
+                                                         _num_rows_written, _segment_writer->num_rows()));
+    }
+    // encode the last pages before taking the lock, only the writes of the file are serialized
+    for (auto& column_writer : _column_writers) {
+        RETURN_IF_ERROR(column_writer->finish());
+    }
+    std::lock_guard l(_segment_writer->_lock);
+    for (size_t i = 0; i < _column_indexes.size(); ++i) {
+        RETURN_IF_ERROR(_segment_writer->_finalize_column_writer(_column_indexes[i], _column_writers[i].get(),
+                                                                 index_size));
+        _column_writers[i].reset();
+    }
+    _column_writers.clear();
+    return Status::OK();
+}
+
 } // namespace starrocks
@@ -36,10 +36,12 @@
 
 #include <cstdint>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 
 #include "common/status.h"
+#include "common/statusor.h"
 #include "gen_cpp/segment.pb.h"
 #include "gutil/macros.h"
 #include "runtime/global_dict/types.h"
@@ -54,6 +56,7 @@ class MemTracker;
 class WritableFile;
 class Chunk;
 class ColumnWriter;
+class SegmentColumnGroupWriter;
 
 extern const char* const k_segment_magic;
 extern const uint32_t k_segment_magic_length;
@@ -87,6 +90,12 @@ struct SegmentWriterOptions {
 //      }
 //      writer->finalize_footer(file_size);
 //
+//      // 3. non-key column groups concurrently, after the key columns are finalized
+//      auto group_writer = writer.new_column_group_writer(column_group).value();
+//      group_writer->append_chunk(chunk1);
+//      ...
+//      group_writer->finalize(index_size);
+//
 class SegmentWriter {
 public:
     SegmentWriter(std::unique_ptr<WritableFile> block, uint32_t segment_id, const TabletSchema* tablet_schema,
@@ -119,6 +128,12 @@ public:
     // finalize footer
     Status finalize_footer(uint64_t* segment_file_size, uint64_t* footer_position = nullptr);
 
+    // Used for vertical compaction
+    // Create a writer of the non-key columns |column_indexes|, which can run concurrently with the writers
+    // of the other column groups. Must be called after the key columns are finalized.
+    StatusOr<std::unique_ptr<SegmentColumnGroupWriter>> new_column_group_writer(
+            const std::vector<uint32_t>& column_indexes);
+
     uint32_t segment_id() const { return _segment_id; }
 
     const DictColumnsValidMap& global_dict_columns_valid_info() { return _global_dict_columns_valid_info; }
@@ -126,6 +141,10 @@ public:
     std::string segment_path() const;
 
 private:
+    friend class SegmentColumnGroupWriter;
+
+    StatusOr<std::unique_ptr<ColumnWriter>> _create_column_writer(uint32_t column_index);
+    Status _finalize_column_writer(uint32_t column_index, ColumnWriter* column_writer, uint64_t* index_size);
     Status _write_short_key_index();
     Status _write_footer();
     Status _write_raw_data(const std::vector<Slice>& slices);
@@ -149,6 +168,34 @@ private:
     uint32_t _num_rows = 0;
 
     DictColumnsValidMap _global_dict_columns_valid_info;
+
+    // protects _footer, _wfile and _global_dict_columns_valid_info among the column group writers
+    std::mutex _lock;
+};
+
+// SegmentColumnGroupWriter writes a group of non-key columns of a segment.
+// The pages are buffered in memory and written into the segment file in finalize() under the lock of the
+// SegmentWriter, so the column groups of one segment can be encoded concurrently.
+class SegmentColumnGroupWriter {
+public:
+    ~SegmentColumnGroupWriter();
+
+    // |chunk| contains the columns corresponding to the column group.
+    Status append_chunk(const Chunk& chunk);
+
+    uint32_t num_rows_written() const { return _num_rows_written; }
+
+    Status finalize(uint64_t* index_size);
+
+private:
+    friend class SegmentWriter;
+
+    SegmentColumnGroupWriter(SegmentWriter* segment_writer, std::vector<uint32_t> column_indexes);
+
+    SegmentWriter* _segment_writer;
+    std::vector<uint32_t> _column_indexes;
+    std::vector<std::unique_ptr<ColumnWriter>> _column_writers;
+    uint32_t _num_rows_written = 0;
 };
 
 } // namespace starrocks
@@ -98,9 +98,38 @@ private:
     std::unique_ptr<BitShuffleDataDecoder> _bit_shuffle_decoder;
 };
 
+// The body of an adaptive page is encoded by the encoding stored in its header,
+// see AdaptivePageBuilder for the page format.
+class AdaptiveDataDecoder : public DataDecoder {
+public:
+    AdaptiveDataDecoder() {
+        _bit_shuffle_decoder = std::make_unique<BitShuffleDataDecoder>();
+        _bit_shuffle_decoder->reserve_head(ADAPTIVE_PAGE_HEADER_SIZE);
+    }
+    ~AdaptiveDataDecoder() override = default;
+
+    Status decode_page_data(PageFooterPB* footer, uint32_t footer_size, EncodingTypePB encoding,
+                            std::unique_ptr<char[]>* page, Slice* page_slice) override {
+        size_t type = decode_fixed32_le((const uint8_t*)&(page_slice->data[0]));
+        if (type == BIT_SHUFFLE) {
+            return _bit_shuffle_decoder->decode_page_data(footer, footer_size, encoding, page, page_slice);
+        } else if (type != ADAPTIVE_ENCODING && EncodingTypePB_IsValid(type) &&
+                   DataDecoder::get_data_decoder(static_cast<EncodingTypePB>(type)) != nullptr) {
+            return Status::OK();
+        } else {
+            LOG(WARNING) << "invalid encoding type:" << type;
+            return Status::Corruption(strings::Substitute("invalid encoding type:$0", type));
+        }
+    }
+
+private:
+    std::unique_ptr<BitShuffleDataDecoder> _bit_shuffle_decoder;
+};
+
 static DataDecoder g_base_decoder;
 static BitShuffleDataDecoder g_bit_shuffle_decoder;
 static BinaryDictDataDecoder g_binary_dict_decoder;
+static AdaptiveDataDecoder g_adaptive_decoder;
 
 DataDecoder* DataDecoder::get_data_decoder(EncodingTypePB encoding) {
     switch (encoding) {
@@ -110,7 +139,12 @@ DataDecoder* DataDecoder::get_data_decoder(EncodingTypePB encoding) {
     case DICT_ENCODING: {
         return &g_binary_dict_decoder;
     }
+    case ADAPTIVE_ENCODING: {
+        return &g_adaptive_decoder;
+    }
     case FOR_ENCODING:
+    case DELTA_ENCODING:
+    case DELTA_OF_DELTA_ENCODING:
     case PLAIN_ENCODING:
     case PREFIX_ENCODING:
     case RLE: {
@@ -20,6 +20,7 @@
 #include "column/binary_column.h"
 #include "gutil/stl_util.h"
 #include "storage/chunk_helper.h"
+#include "storage/compaction_throttle.h"
 #include "storage/empty_iterator.h"
 #include "storage/merge_iterator.h"
 #include "storage/primary_key_encoder.h"
@@ -329,7 +330,26 @@ private:
             column_indexes = tablet.tablet_schema().sort_key_idxes();
         }
 
+        // collect the primary keys of the output rows, which are the leading columns of the merged chunks
+        Column* output_pks = nullptr;
+        Schema pkey_schema;
+        if (cfg.output_pks != nullptr) {
+            vector<ColumnId> pk_columns;
+            for (ColumnId i = 0; i < tablet.tablet_schema().num_key_columns(); i++) {
+                if (i >= schema.num_fields() || schema.field(i)->id() != i) {
+                    pk_columns.clear();
+                    break;
+                }
+                pk_columns.push_back(i);
+            }
+            if (!pk_columns.empty()) {
+                output_pks = cfg.output_pks;
+                pkey_schema = ChunkHelper::convert_schema(tablet.tablet_schema(), pk_columns);
+            }
+        }
+
         auto chunk = ChunkHelper::new_chunk(schema, _chunk_size);
+        auto rate_limiter = CompactionRateLimiter::create(COMPACTION_PRIORITY_HIGH);
         while (true) {
             chunk->reset();
             Status status = get_next(chunk.get(), source_masks.get());
@@ -343,6 +363,15 @@ private:
                 }
             }
 
+            // encode the keys before padding, as they are read back from the segments unpadded
+            if (output_pks != nullptr) {
+                PrimaryKeyEncoder::encode(pkey_schema, *chunk, 0, chunk->num_rows(), output_pks);
+                if (output_pks->memory_usage() > cfg.output_pks_max_bytes) {
+                    output_pks->reset_column();
+                    output_pks = nullptr;
+                }
+            }
+
             ChunkHelper::padding_char_columns(char_field_indexes, schema, tablet.tablet_schema(), chunk.get());
 
             *total_rows += chunk->num_rows();
@@ -364,6 +393,7 @@ private:
                     return st;
                 }
             }
+            RETURN_IF_ERROR(rate_limiter.charge(chunk->bytes_usage()));
 
             if (rowsets_mask_buffer) {
                 for (size_t i = 0; i < rowsets_source_masks.size(); ++i) {
@@ -471,6 +501,7 @@ private:
 
             auto chunk = ChunkHelper::new_chunk(schema, _chunk_size);
             auto char_field_indexes = ChunkHelper::get_char_field_indexes(schema);
+            auto rate_limiter = CompactionRateLimiter::create(COMPACTION_PRIORITY_HIGH);
 
             while (true) {
                 chunk->reset();
@@ -491,6 +522,7 @@ private:
                     LOG(WARNING) << "writer add_columns error, tablet=" << tablet.tablet_id() << ", err=" << st;
                     return st;
                 }
+                RETURN_IF_ERROR(rate_limiter.charge(chunk->bytes_usage()));
 
                 if (!source_masks->empty()) {
                     source_masks->clear();
@@ -23,6 +23,10 @@ namespace starrocks {
 struct MergeConfig {
     size_t chunk_size;
     CompactionAlgorithm algorithm = HORIZONTAL_COMPACTION;
+    // If not null, the *encoded* primary keys of the output rows are appended to it in the output order,
+    // until its memory usage exceeds |output_pks_max_bytes|, in which case it is cleared and left empty.
+    Column* output_pks = nullptr;
+    size_t output_pks_max_bytes = 0;
 };
 
 // heap based rowset merger used for updatable tablet's compaction
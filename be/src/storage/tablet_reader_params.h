@@ -55,6 +55,8 @@ struct TabletReaderParams {
     // 2. when read column index page
     //     if config::disable_storage_page_cache is false, we use page cache
     bool use_page_cache = false;
+    // the local copies of the segment files keyed by the paths of the segment files, only used by lake tablets
+    const std::unordered_map<std::string, std::string>* staged_files = nullptr;
 
     RangeStartOperation range = RangeStartOperation::GT;
     RangeEndOperation end_range = RangeEndOperation::LT;
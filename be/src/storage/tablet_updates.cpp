@@ -17,6 +17,7 @@
 #include <cmath>
 #include <ctime>
 #include <memory>
+#include <numeric>
 
 #include "common/status.h"
 #include "common/tracer.h"
@@ -34,6 +35,7 @@
 #include "storage/compaction_utils.h"
 #include "storage/del_vector.h"
 #include "storage/merge_iterator.h"
+#include "storage/primary_key_encoder.h"
 #include "storage/rowset/default_value_column_iterator.h"
 #include "storage/rowset/rowset_factory.h"
 #include "storage/rowset/rowset_meta_manager.h"
@@ -1256,13 +1258,29 @@ Status TabletUpdates::_do_compaction(std::unique_ptr<CompactionInfo>* pinfo) {
     MergeConfig cfg;
     cfg.chunk_size = config::vector_chunk_size;
     cfg.algorithm = algorithm;
+    // collect the primary keys of the output rows, so that they need not be read back from the output segments
+    // when committing and applying this compaction
+    std::unique_ptr<Column> merged_pks;
+    if (config::update_compaction_merged_keys_max_bytes > 0) {
+        vector<ColumnId> pk_columns(_tablet.tablet_schema().num_key_columns());
+        std::iota(pk_columns.begin(), pk_columns.end(), 0);
+        auto pkey_schema = ChunkHelper::convert_schema(_tablet.tablet_schema(), pk_columns);
+        if (PrimaryKeyEncoder::create_column(pkey_schema, &merged_pks).ok()) {
+            cfg.output_pks = merged_pks.get();
+            cfg.output_pks_max_bytes = config::update_compaction_merged_keys_max_bytes;
+        }
+    }
     RETURN_IF_ERROR(
             compaction_merge_rowsets(_tablet, info->start_version.major(), input_rowsets, rowset_writer.get(), cfg));
     auto output_rowset = rowset_writer->build();
     if (!output_rowset.ok()) return output_rowset.status();
+    if (merged_pks != nullptr && merged_pks->size() != (*output_rowset)->num_rows()) {
+        // not collected, or the keys take too much memory
+        merged_pks.reset();
+    }
     // 4. commit compaction
     EditVersion version;
-    RETURN_IF_ERROR(_commit_compaction(pinfo, *output_rowset, &version));
+    RETURN_IF_ERROR(_commit_compaction(pinfo, *output_rowset, &version, std::move(merged_pks)));
     // already committed, so we can ignore timeout error here
     std::unique_lock<std::mutex> ul(_lock);
     _wait_for_version(version, 120000, ul);
@@ -1270,11 +1288,13 @@ Status TabletUpdates::_do_compaction(std::unique_ptr<CompactionInfo>* pinfo) {
 }
 
 Status TabletUpdates::_commit_compaction(std::unique_ptr<CompactionInfo>* pinfo, const RowsetSharedPtr& rowset,
-                                         EditVersion* commit_version) {
+                                         EditVersion* commit_version, std::unique_ptr<Column> merged_pks) {
     auto span = Tracer::Instance().start_trace_tablet("commit_compaction", _tablet.tablet_id());
     auto scoped_span = trace::Scope(span);
     _compaction_state = std::make_unique<CompactionState>();
-    const auto status = _compaction_state->load(rowset.get());
+    const auto status = merged_pks != nullptr
+                                ? _compaction_state->load_from_merged_pks(rowset.get(), std::move(merged_pks))
+                                : _compaction_state->load(rowset.get());
     if (!status.ok()) {
         _compaction_state.reset();
         std::string msg = strings::Substitute("_commit_compaction error: load compaction state failed: $0 $1",
@@ -317,8 +317,10 @@ private:
     // assuming _lock already hold
     Status _wait_for_version(const EditVersion& version, int64_t timeout_ms, std::unique_lock<std::mutex>& lock);
 
+    // |merged_pks| holds the encoded primary keys of all the rows of |rowset| if they are collected while merging,
+    // or nullptr. It is consumed by the compaction state and freed before the compaction is applied.
     Status _commit_compaction(std::unique_ptr<CompactionInfo>* info, const RowsetSharedPtr& rowset,
-                              EditVersion* commit_version);
+                              EditVersion* commit_version, std::unique_ptr<Column> merged_pks = nullptr);
 
     void _stop_and_wait_apply_done();
 
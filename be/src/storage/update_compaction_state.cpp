@@ -51,6 +51,20 @@ Status CompactionState::load(Rowset* rowset) {
     return _status;
 }
 
+Status CompactionState::load_from_merged_pks(Rowset* rowset, std::unique_ptr<Column> pks) {
+    if (UNLIKELY(!_status.ok())) {
+        return _status;
+    }
+    std::call_once(_load_once_flag, [&] {
+        _status = _do_load_from_merged_pks(rowset, std::move(pks));
+        if (!_status.ok()) {
+            LOG(WARNING) << "load CompactionState from merged keys error: " << _status
+                         << " tablet:" << rowset->rowset_meta()->tablet_id();
+        }
+    });
+    return _status;
+}
+
 Status CompactionState::load_segments(Rowset* rowset, uint32_t segment_id) {
     if (segment_id >= pk_cols.size() && pk_cols.size() != 0) {
         std::string msg = strings::Substitute("Error segment id: $0 vs $1", segment_id, pk_cols.size());
@@ -151,6 +165,46 @@ void CompactionState::release_segments(Rowset* rowset, uint32_t segment_id) {
     pk_cols[segment_id]->reset_column();
 }
 
+Status CompactionState::_do_load_from_merged_pks(Rowset* rowset, std::unique_ptr<Column> pks) {
+    if (pks->size() != rowset->num_rows()) {
+        return Status::InternalError(
+                strings::Substitute("merged keys mismatch: $0 vs $1 rows", pks->size(), rowset->num_rows()));
+    }
+    RowsetReleaseGuard guard(rowset->shared_from_this());
+    RETURN_IF_ERROR(rowset->load());
+    auto tracker = StorageEngine::instance()->update_manager()->compaction_state_mem_tracker();
+    const auto num_segments = rowset->num_segments();
+    const auto total_rows = pks->size();
+    pk_cols.resize(num_segments);
+    size_t offset = 0;
+    for (size_t i = 0; i < num_segments; i++) {
+        const auto num_rows = rowset->segments()[i]->num_rows();
+        if (offset + num_rows > total_rows) {
+            pk_cols.clear();
+            return Status::InternalError(
+                    strings::Substitute("merged keys mismatch: $0 rows in segment $1", num_rows, i));
+        }
+        auto& dest = pk_cols[i];
+        if (num_rows == total_rows) {
+            // the only non-empty segment takes the merged keys as they are
+            dest = std::move(pks);
+            pks = dest->clone_empty();
+        } else {
+            dest = pks->clone_empty();
+            if (num_rows > 0) {
+                dest->append(*pks, offset, num_rows);
+            }
+        }
+        offset += num_rows;
+        dest->raw_data();
+        _memory_usage += dest->memory_usage();
+        tracker->consume(dest->memory_usage());
+    }
+    // the merged keys have been split into |pk_cols|, don't hold them until applied
+    pks.reset();
+    return Status::OK();
+}
+
 Status CompactionState::_do_load(Rowset* rowset) {
     if (rowset->num_segments() == 0) {
         return Status::OK();
@@ -35,6 +35,11 @@ public:
 
     Status load(Rowset* rowset);
 
+    // Load the state from the *encoded* primary keys of all the rows of |rowset| in the order of its segments,
+    // which are collected while merging the input rowsets, instead of reading them back from the segment files.
+    // |pks| is split into |pk_cols| and released before returning.
+    Status load_from_merged_pks(Rowset* rowset, std::unique_ptr<Column> pks);
+
     Status load_segments(Rowset* rowset, uint32_t segment_id);
     void release_segments(Rowset* rowset, uint32_t segment_id);
 
@@ -45,6 +50,7 @@ public:
 private:
     Status _load_segments(Rowset* rowset, uint32_t segment_id);
     Status _do_load(Rowset* rowset);
+    Status _do_load_from_merged_pks(Rowset* rowset, std::unique_ptr<Column> pks);
 
     std::once_flag _load_once_flag;
     Status _status;
@@ -14,19 +14,24 @@
 
 #include "storage/vertical_compaction_task.h"
 
+#include <algorithm>
+#include <condition_variable>
 #include <vector>
 
 #include "column/schema.h"
 #include "runtime/current_thread.h"
 #include "storage/chunk_helper.h"
+#include "storage/compaction_manager.h"
 #include "storage/compaction_utils.h"
 #include "storage/olap_common.h"
 #include "storage/row_source_mask.h"
 #include "storage/rowset/column_reader.h"
 #include "storage/rowset/rowset.h"
 #include "storage/rowset/rowset_writer.h"
+#include "storage/storage_engine.h"
 #include "storage/tablet_reader.h"
 #include "storage/tablet_reader_params.h"
+#include "util/threadpool.h"
 #include "util/time.h"
 #include "util/trace.h"
 
@@ -34,7 +39,12 @@ namespace starrocks {
 
 Status VerticalCompactionTask::run_impl() {
     Statistics statistics;
-    RETURN_IF_ERROR(_vertical_compaction_data(&statistics));
+    ASSIGN_OR_RETURN(bool linked, _link_non_overlapping_segments());
+    if (!linked) {
+        RETURN_IF_ERROR(_vertical_compaction_data(&statistics));
+    } else {
+        statistics.output_rows = _output_rowset->num_rows();
+    }
     TRACE_COUNTER_INCREMENT("merged_rows", statistics.merged_rows);
     TRACE_COUNTER_INCREMENT("filtered_rows", statistics.filtered_rows);
     TRACE_COUNTER_INCREMENT("output_rows", statistics.output_rows);
@@ -68,7 +78,11 @@ Status VerticalCompactionTask::_vertical_compaction_data(Statistics* statistics)
           "size:$1",
           max_rows_per_segment, column_groups.size());
 
-    for (size_t i = 0; i < column_groups.size(); ++i) {
+    // the value column groups are merged concurrently once the row source masks are produced by the key columns
+    int parallelism = std::min<int>(config::vertical_compaction_max_parallel_column_groups,
+                                    static_cast<int>(column_groups.size()) - 1);
+    size_t num_serial_groups = parallelism > 1 ? 1 : column_groups.size();
+    for (size_t i = 0; i < num_serial_groups; ++i) {
         if (should_stop()) {
             LOG(INFO) << "vertical compaction task_id:" << _task_info.task_id << " is stopped.";
             return Status::Cancelled("vertical compaction task is stopped.");
@@ -78,8 +92,12 @@ Status VerticalCompactionTask::_vertical_compaction_data(Statistics* statistics)
             // read mask buffer from the beginning
             mask_buffer->flip_to_read();
         }
-        RETURN_IF_ERROR(_compact_column_group(is_key, i, column_groups[i], output_rs_writer.get(), mask_buffer.get(),
-                                              source_masks.get(), statistics));
+        RETURN_IF_ERROR(_compact_column_group(is_key, i, column_groups[i], output_rs_writer.get(), nullptr, 1,
+                                              mask_buffer.get(), source_masks.get(), statistics));
+    }
+    if (num_serial_groups < column_groups.size()) {
+        RETURN_IF_ERROR(_compact_column_groups_in_parallel(column_groups, parallelism, output_rs_writer.get(),
+                                                           mask_buffer.get()));
     }
     TRACE("[Compaction] data compacted");
 
@@ -109,9 +127,90 @@ Status VerticalCompactionTask::_vertical_compaction_data(Statistics* statistics)
     return Status::OK();
 }
 
+Status VerticalCompactionTask::_compact_column_groups_in_parallel(
+        const std::vector<std::vector<uint32_t>>& column_groups, int parallelism, RowsetWriter* output_rs_writer,
+        RowSourceMaskBuffer* mask_buffer) {
+    ThreadPool* pool = nullptr;
+    if (StorageEngine::instance() != nullptr && StorageEngine::instance()->compaction_manager() != nullptr) {
+        pool = StorageEngine::instance()->compaction_manager()->column_group_pool();
+    }
+    TRACE("[Compaction] merge $0 value column groups with $1 threads", column_groups.size() - 1, parallelism);
+
+    std::mutex mutex;
+    std::condition_variable cv;
+    size_t next_group = 1;
+    int num_running_workers = 0;
+    Status status;
+    Trace* trace = Trace::CurrentTrace();
+    // every worker merges the remaining column groups one by one until all are done or any one fails
+    auto worker = [&]() {
+        ADOPT_TRACE(trace);
+        SCOPED_THREAD_LOCAL_MEM_TRACKER_SETTER(_mem_tracker);
+        while (true) {
+            size_t i = 0;
+            {
+                std::lock_guard l(mutex);
+                if (!status.ok() || next_group >= column_groups.size()) {
+                    break;
+                }
+                i = next_group++;
+            }
+            Status st = should_stop() ? Status::Cancelled("vertical compaction task is stopped.") : Status::OK();
+            std::unique_ptr<RowSourceMaskBuffer> group_mask_buffer;
+            std::unique_ptr<ColumnGroupWriter> column_group_writer;
+            if (st.ok()) {
+                auto res = mask_buffer->clone_for_read();
+                st = res.status();
+                if (st.ok()) {
+                    group_mask_buffer = std::move(res).value();
+                }
+            }
+            if (st.ok()) {
+                auto res = output_rs_writer->new_column_group_writer(column_groups[i]);
+                st = res.status();
+                if (st.ok()) {
+                    column_group_writer = std::move(res).value();
+                }
+            }
+            if (st.ok()) {
+                std::vector<RowSourceMask> source_masks;
+                st = _compact_column_group(false, i, column_groups[i], output_rs_writer, column_group_writer.get(),
+                                           parallelism, group_mask_buffer.get(), &source_masks, nullptr);
+            }
+            if (!st.ok()) {
+                LOG(WARNING) << "fail to compact column group " << i << ", task_id:" << _task_info.task_id
+                             << ", tablet:" << _task_info.tablet_id << ", err:" << st;
+                std::lock_guard l(mutex);
+                if (status.ok()) {
+                    status = st;
+                }
+            }
+        }
+        std::lock_guard l(mutex);
+        --num_running_workers;
+        cv.notify_all();
+    };
+
+    for (int i = 0; i < parallelism; ++i) {
+        {
+            std::lock_guard l(mutex);
+            ++num_running_workers;
+        }
+        if (pool == nullptr || !pool->submit_func(worker).ok()) {
+            // merge in the current thread if there is no thread available
+            worker();
+        }
+    }
+    std::unique_lock l(mutex);
+    cv.wait(l, [&] { return num_running_workers == 0; });
+    return status;
+}
+
 Status VerticalCompactionTask::_compact_column_group(bool is_key, int column_group_index,
                                                      const std::vector<uint32_t>& column_group,
-                                                     RowsetWriter* output_rs_writer, RowSourceMaskBuffer* mask_buffer,
+                                                     RowsetWriter* output_rs_writer,
+                                                     ColumnGroupWriter* column_group_writer, int num_concurrent_groups,
+                                                     RowSourceMaskBuffer* mask_buffer,
                                                      std::vector<RowSourceMask>* source_masks, Statistics* statistics) {
     Schema schema = ChunkHelper::convert_schema(_tablet->tablet_schema(), column_group);
     TabletReader reader(std::static_pointer_cast<Tablet>(_tablet->shared_from_this()), output_rs_writer->version(),
@@ -123,7 +222,7 @@ Status VerticalCompactionTask::_compact_column_group(bool is_key, int column_gro
             compaction_type() == BASE_COMPACTION ? READER_BASE_COMPACTION : READER_CUMULATIVE_COMPACTION;
     reader_params.profile = _runtime_profile.create_child("merge_rowsets");
 
-    StatusOr<int32_t> ret = _calculate_chunk_size_for_column_group(column_group);
+    StatusOr<int32_t> ret = _calculate_chunk_size_for_column_group(column_group, num_concurrent_groups);
     if (!ret.ok()) {
         return ret.status();
     }
@@ -134,7 +233,7 @@ Status VerticalCompactionTask::_compact_column_group(bool is_key, int column_gro
     RETURN_IF_ERROR(reader.open(reader_params));
 
     StatusOr<size_t> rows_st = _compact_data(is_key, chunk_size, column_group, schema, &reader, output_rs_writer,
-                                             mask_buffer, source_masks);
+                                             column_group_writer, mask_buffer, source_masks);
     if (!rows_st.ok()) {
         return rows_st.status();
     }
@@ -145,7 +244,11 @@ Status VerticalCompactionTask::_compact_column_group(bool is_key, int column_gro
         statistics->filtered_rows = reader.stats().rows_del_filtered;
     }
 
-    RETURN_IF_ERROR(output_rs_writer->flush_columns());
+    if (column_group_writer != nullptr) {
+        RETURN_IF_ERROR(column_group_writer->flush_columns());
+    } else {
+        RETURN_IF_ERROR(output_rs_writer->flush_columns());
+    }
 
     if (is_key) {
         RETURN_IF_ERROR(mask_buffer->flush());
@@ -154,7 +257,7 @@ Status VerticalCompactionTask::_compact_column_group(bool is_key, int column_gro
 }
 
 StatusOr<int32_t> VerticalCompactionTask::_calculate_chunk_size_for_column_group(
-        const std::vector<uint32_t>& column_group) {
+        const std::vector<uint32_t>& column_group, int num_concurrent_groups) {
     int64_t total_num_rows = 0;
     int64_t total_mem_footprint = 0;
     for (auto& rowset : _input_rowsets) {
@@ -169,15 +272,17 @@ StatusOr<int32_t> VerticalCompactionTask::_calculate_chunk_size_for_column_group
             }
         }
     }
-    int32_t chunk_size =
-            CompactionUtils::get_read_chunk_size(config::compaction_memory_limit_per_worker, config::vector_chunk_size,
-                                                 total_num_rows, total_mem_footprint, _task_info.input_segments_num);
+    // the concurrent column groups share the memory limit of the task
+    int64_t memory_limit = config::compaction_memory_limit_per_worker / std::max(1, num_concurrent_groups);
+    int32_t chunk_size = CompactionUtils::get_read_chunk_size(memory_limit, config::vector_chunk_size, total_num_rows,
+                                                              total_mem_footprint, _task_info.input_segments_num);
     return chunk_size;
 }
 
 StatusOr<size_t> VerticalCompactionTask::_compact_data(bool is_key, int32_t chunk_size,
                                                        const std::vector<uint32_t>& column_group, const Schema& schema,
                                                        TabletReader* reader, RowsetWriter* output_rs_writer,
+                                                       ColumnGroupWriter* column_group_writer,
                                                        RowSourceMaskBuffer* mask_buffer,
                                                        std::vector<RowSourceMask>* source_masks) {
     DCHECK(reader);
@@ -188,6 +293,7 @@ StatusOr<size_t> VerticalCompactionTask::_compact_data(bool is_key, int32_t chun
     Status status = Status::OK();
     size_t column_group_del_filtered_rows = 0;
     size_t column_group_merged_rows = 0;
+    auto rate_limiter = CompactionRateLimiter::create(compaction_priority_of(compaction_type()));
     while (LIKELY(!should_stop())) {
 #ifndef BE_TEST
         status = tls_thread_status.mem_tracker()->check_mem_limit("Compaction");
@@ -211,11 +317,19 @@ StatusOr<size_t> VerticalCompactionTask::_compact_data(bool is_key, int32_t chun
 
         ChunkHelper::padding_char_columns(char_field_indexes, schema, _tablet->tablet_schema(), chunk.get());
 
-        RETURN_IF_ERROR(output_rs_writer->add_columns(*chunk, column_group, is_key));
+        if (column_group_writer != nullptr) {
+            RETURN_IF_ERROR(column_group_writer->add_columns(*chunk));
+        } else {
+            RETURN_IF_ERROR(output_rs_writer->add_columns(*chunk, column_group, is_key));
+        }
+        RETURN_IF_ERROR(rate_limiter.charge(chunk->bytes_usage(), [this] { return should_stop(); }));
 
-        _task_info.total_output_num_rows += chunk->num_rows();
-        _task_info.total_del_filtered_rows += reader->stats().rows_del_filtered - column_group_del_filtered_rows;
-        _task_info.total_merged_rows += reader->merged_rows() - column_group_merged_rows;
+        {
+            std::lock_guard l(_progress_lock);
+            _task_info.total_output_num_rows += chunk->num_rows();
+            _task_info.total_del_filtered_rows += reader->stats().rows_del_filtered - column_group_del_filtered_rows;
+            _task_info.total_merged_rows += reader->merged_rows() - column_group_merged_rows;
+        }
         column_group_del_filtered_rows = reader->stats().rows_del_filtered;
         column_group_merged_rows = reader->merged_rows();
 
@@ -229,6 +343,7 @@ StatusOr<size_t> VerticalCompactionTask::_compact_data(bool is_key, int32_t chun
             source_masks->clear();
         }
     }
+    TRACE_COUNTER_INCREMENT("throttle_wait_us", rate_limiter.wait_ns() / 1000);
     if (should_stop()) {
         LOG(INFO) << "vertical compaction task_id:" << _task_info.task_id << ", tablet:" << _task_info.tablet_id
                   << " is stopped.";
@@ -14,6 +14,7 @@
 
 #pragma once
 
+#include <mutex>
 #include <vector>
 
 #include "common/status.h"
@@ -24,6 +25,7 @@
 
 namespace starrocks {
 
+class ColumnGroupWriter;
 class RowsetWriter;
 class TabletReader;
 class RowSourceMaskBuffer;
@@ -40,15 +42,29 @@ public:
 private:
     Status _vertical_compaction_data(Statistics* statistics);
 
+    // |column_group_writer| is used to write the non-key columns concurrently with the other column groups,
+    // or nullptr to write the columns with |output_rs_writer|.
+    // |num_concurrent_groups| is the number of column groups sharing the memory of this task.
     Status _compact_column_group(bool is_key, int column_group_index, const std::vector<uint32_t>& column_group,
-                                 RowsetWriter* output_rs_writer, RowSourceMaskBuffer* mask_buffer,
+                                 RowsetWriter* output_rs_writer, ColumnGroupWriter* column_group_writer,
+                                 int num_concurrent_groups, RowSourceMaskBuffer* mask_buffer,
                                  std::vector<RowSourceMask>* source_masks, Statistics* statistics);
 
+    // Merge the non-key column groups with at most |parallelism| threads after the key columns are compacted.
+    Status _compact_column_groups_in_parallel(const std::vector<std::vector<uint32_t>>& column_groups,
+                                              int parallelism, RowsetWriter* output_rs_writer,
+                                              RowSourceMaskBuffer* mask_buffer);
+
     StatusOr<size_t> _compact_data(bool is_key, int32_t chunk_size, const std::vector<uint32_t>& column_group,
                                    const Schema& schema, TabletReader* reader, RowsetWriter* output_rs_writer,
-                                   RowSourceMaskBuffer* mask_buffer, std::vector<RowSourceMask>* source_masks);
+                                   ColumnGroupWriter* column_group_writer, RowSourceMaskBuffer* mask_buffer,
+                                   std::vector<RowSourceMask>* source_masks);
+
+    StatusOr<int32_t> _calculate_chunk_size_for_column_group(const std::vector<uint32_t>& column_group,
+                                                             int num_concurrent_groups);
 
-    StatusOr<int32_t> _calculate_chunk_size_for_column_group(const std::vector<uint32_t>& column_group);
+    // protects the progress in _task_info updated by the concurrent column groups
+    std::mutex _progress_lock;
 };
 
 } // namespace starrocks
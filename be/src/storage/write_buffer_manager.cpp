@@ -0,0 +1,215 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "storage/write_buffer_manager.h"
+
+#include <algorithm>
+#include <iterator>
+#include <vector>
+
+#include "common/config.h"
+#include "common/logging.h"
+#include "runtime/mem_tracker.h"
+#include "util/starrocks_metrics.h"
+#include "util/time.h"
+
+namespace starrocks {
+
+WriteBufferManager::~WriteBufferManager() {
+    DCHECK(_owners.empty());
+}
+
+void WriteBufferManager::register_owner(WriteBufferOwner* owner, int64_t table_id) {
+    std::lock_guard l(_lock);
+    auto [iter, inserted] = _owners.emplace(owner, nullptr);
+    if (!inserted) {
+        return;
+    }
+    iter->second = std::make_unique<OwnerStat>();
+    iter->second->table = _get_or_create_table_stat(table_id);
+    iter->second->table->num_owners++;
+    owner->_write_buffer_stat = iter->second.get();
+}
+
+void WriteBufferManager::unregister_owner(WriteBufferOwner* owner) {
+    std::lock_guard l(_lock);
+    auto iter = _owners.find(owner);
+    if (iter == _owners.end()) {
+        return;
+    }
+    OwnerStat* stat = iter->second.get();
+    TableStat* table = stat->table;
+    _add_bytes(stat, -stat->bytes.load() - stat->detached_bytes);
+    _flushing_bytes -= stat->flushing_bytes;
+    owner->_write_buffer_stat = nullptr;
+    _owners.erase(iter);
+    if (--table->num_owners == 0) {
+        // the metrics are deregistered by their destructors
+        _tables.erase(table->table_id);
+    }
+}
+
+void WriteBufferManager::update_usage(WriteBufferOwner* owner, int64_t bytes) {
+    // An owner reports its own usage from a single thread, between its registration and unregistration,
+    // so its stat can be read without the lock.
+    OwnerStat* stat = owner->_write_buffer_stat;
+    if (stat == nullptr) {
+        return;
+    }
+    int64_t old_bytes = stat->bytes.exchange(bytes);
+    if (old_bytes == 0 && bytes > 0) {
+        stat->start_time_ms = MonotonicMillis();
+    }
+    if (bytes == old_bytes) {
+        return;
+    }
+    _add_bytes(stat, bytes - old_bytes);
+    if (bytes > old_bytes) {
+        int64_t limit = budget();
+        if (limit >= 0 && _total_bytes.load() - _flushing_bytes.load() > limit) {
+            _schedule_flush_if_needed();
+        }
+    }
+}
+
+void WriteBufferManager::start_flush(WriteBufferOwner* owner) {
+    std::lock_guard l(_lock);
+    OwnerStat* stat = owner->_write_buffer_stat;
+    if (stat == nullptr) {
+        return;
+    }
+    int64_t bytes = stat->bytes.exchange(0);
+    stat->start_time_ms = 0;
+    stat->detached_bytes += bytes;
+    _flushing_bytes += bytes - stat->flushing_bytes;
+    stat->flushing = true;
+    stat->flushing_bytes = bytes;
+}
+
+void WriteBufferManager::finish_flush(WriteBufferOwner* owner) {
+    std::lock_guard l(_lock);
+    // The flush may finish after |owner| has been unregistered.
+    auto iter = _owners.find(owner);
+    if (iter == _owners.end()) {
+        return;
+    }
+    OwnerStat* stat = iter->second.get();
+    if (!stat->flushing) {
+        return;
+    }
+    _add_bytes(stat, -stat->detached_bytes);
+    _flushing_bytes -= stat->flushing_bytes;
+    stat->flushing = false;
+    stat->flushing_bytes = 0;
+    stat->detached_bytes = 0;
+}
+
+int64_t WriteBufferManager::table_bytes(int64_t table_id) const {
+    std::lock_guard l(_lock);
+    auto iter = _tables.find(table_id);
+    return iter != _tables.end() ? iter->second->bytes_metric->value() : 0;
+}
+
+int64_t WriteBufferManager::budget() const {
+    int32_t percent = config::load_write_buffer_soft_limit_percent;
+    if (percent <= 0 || _mem_tracker == nullptr || !_mem_tracker->has_limit()) {
+        return -1;
+    }
+    return _mem_tracker->limit() / 100 * percent;
+}
+
+WriteBufferManager::TableStat* WriteBufferManager::_get_or_create_table_stat(int64_t table_id) {
+    auto& table = _tables[table_id];
+    if (table == nullptr) {
+        table = std::make_unique<TableStat>();
+        table->table_id = table_id;
+        table->bytes_metric = std::make_unique<IntGauge>(MetricUnit::BYTES);
+        table->flush_metric = std::make_unique<IntCounter>(MetricUnit::OPERATIONS);
+        auto labels = MetricLabels().add("table_id", std::to_string(table_id));
+        auto* metrics = StarRocksMetrics::instance()->metrics();
+        metrics->register_metric("load_write_buffer_bytes", labels, table->bytes_metric.get());
+        metrics->register_metric("load_write_buffer_flush_total", labels, table->flush_metric.get());
+    }
+    return table.get();
+}
+
+void WriteBufferManager::_add_bytes(OwnerStat* stat, int64_t delta) {
+    _total_bytes += delta;
+    stat->table->bytes_metric->increment(delta);
+}
+
+void WriteBufferManager::_schedule_flush_if_needed() {
+    std::unique_lock schedule_lock(_schedule_lock, std::try_to_lock);
+    if (!schedule_lock.owns_lock()) {
+        // another thread is picking the buffers to flush
+        return;
+    }
+
+    struct Candidate {
+        WriteBufferOwner* owner;
+        int64_t bytes;
+        int64_t start_time_ms;
+    };
+    std::vector<Candidate> candidates;
+    {
+        std::lock_guard l(_lock);
+        candidates.reserve(_owners.size());
+        for (auto& [owner, stat] : _owners) {
+            int64_t bytes = stat->bytes.load(std::memory_order_relaxed);
+            if (!stat->flushing && bytes > 0) {
+                candidates.push_back({owner, bytes, stat->start_time_ms.load(std::memory_order_relaxed)});
+            }
+        }
+    }
+
+    int64_t limit = budget();
+    int64_t excess = _total_bytes.load() - _flushing_bytes.load() - limit / 4 * 3;
+    if (limit < 0 || excess <= 0) {
+        return;
+    }
+    // Only the few largest buffers are flushed, so pick them from a heap instead of sorting all the owners.
+    auto less = [](const Candidate& lhs, const Candidate& rhs) {
+        if (lhs.bytes != rhs.bytes) {
+            return lhs.bytes < rhs.bytes;
+        }
+        return lhs.start_time_ms > rhs.start_time_ms;
+    };
+    std::make_heap(candidates.begin(), candidates.end(), less);
+    auto heap_end = candidates.end();
+    for (int64_t picked = 0; picked < excess && heap_end != candidates.begin(); --heap_end) {
+        std::pop_heap(candidates.begin(), heap_end, less);
+        picked += (heap_end - 1)->bytes;
+    }
+
+    size_t num_flushes = 0;
+    std::lock_guard l(_lock);
+    for (auto iter = candidates.rbegin(); iter != std::make_reverse_iterator(heap_end); ++iter) {
+        // the owner may have been unregistered or flushed since the candidates were collected
+        auto owner_iter = _owners.find(iter->owner);
+        if (owner_iter == _owners.end() || owner_iter->second->flushing) {
+            continue;
+        }
+        OwnerStat* stat = owner_iter->second.get();
+        stat->flushing = true;
+        stat->flushing_bytes = stat->bytes.load();
+        _flushing_bytes += stat->flushing_bytes;
+        stat->table->flush_metric->increment(1);
+        iter->owner->flush_write_buffer();
+        num_flushes++;
+    }
+    VLOG(1) << "Flush " << num_flushes << " write buffers, total bytes: " << _total_bytes.load()
+            << " flushing bytes: " << _flushing_bytes.load() << " budget: " << limit;
+}
+
+} // namespace starrocks
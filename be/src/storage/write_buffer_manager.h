@@ -0,0 +1,127 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+#include "util/metrics.h"
+
+namespace starrocks {
+
+class MemTracker;
+class WriteBufferOwner;
+
+// WriteBufferManager tracks the write buffers of all the loads on a Backend. Once their total size exceeds
+// `load_write_buffer_soft_limit_percent` of the load memory limit, the largest buffers are flushed first,
+// the oldest first among buffers of the same size, until the total size drops below 3/4 of the budget.
+// This keeps the memory below the hard limit, where every writer would flush its own small buffer
+// synchronously and produce lots of tiny segments.
+// A buffer handed over to be flushed is still counted in the total until its flush finishes.
+// The size of the write buffers of every table is exported as the metric `load_write_buffer_bytes`.
+class WriteBufferManager {
+public:
+    explicit WriteBufferManager(MemTracker* mem_tracker) : _mem_tracker(mem_tracker) {}
+    ~WriteBufferManager();
+
+    void register_owner(WriteBufferOwner* owner, int64_t table_id);
+
+    void unregister_owner(WriteBufferOwner* owner);
+
+    // Report the current size of the active write buffer of |owner|, and schedule flushes if the budget
+    // is exceeded. Only takes the lock when the budget is exceeded.
+    void update_usage(WriteBufferOwner* owner, int64_t bytes);
+
+    // Called by |owner| right before it hands its active write buffer over to be flushed on the request of
+    // this manager. The size of the buffer stays in the total until `finish_flush()`.
+    void start_flush(WriteBufferOwner* owner);
+
+    // Called once the write buffer handed over by `start_flush()` has been flushed, failed to be flushed,
+    // or has been dropped.
+    void finish_flush(WriteBufferOwner* owner);
+
+    int64_t total_bytes() const { return _total_bytes.load(std::memory_order_relaxed); }
+
+    // The total size of the write buffers of |table_id|
+    int64_t table_bytes(int64_t table_id) const;
+
+    // The size above which write buffers are flushed, or -1 if there is no limit.
+    int64_t budget() const;
+
+private:
+    friend class WriteBufferOwner;
+
+    struct TableStat {
+        int64_t table_id = 0;
+        int64_t num_owners = 0;
+        std::unique_ptr<IntGauge> bytes_metric;
+        std::unique_ptr<IntCounter> flush_metric;
+    };
+
+    struct OwnerStat {
+        // the size of the active buffer, updated by the owner without the lock
+        std::atomic<int64_t> bytes{0};
+        // the time the buffer starts to receive data since its last flush
+        std::atomic<int64_t> start_time_ms{0};
+        // the fields below are guarded by |_lock|
+        // a flush has been requested and not finished yet
+        bool flushing = false;
+        // the size counted in |_flushing_bytes|, i.e. the size of the buffer when the flush was requested
+        // or when it was handed over
+        int64_t flushing_bytes = 0;
+        // the size of the buffer handed over to be flushed, still counted in the total
+        int64_t detached_bytes = 0;
+        TableStat* table = nullptr;
+    };
+
+    TableStat* _get_or_create_table_stat(int64_t table_id);
+
+    void _add_bytes(OwnerStat* stat, int64_t delta);
+
+    void _schedule_flush_if_needed();
+
+    MemTracker* _mem_tracker;
+
+    // only one thread picks the buffers to flush at a time
+    std::mutex _schedule_lock;
+    mutable std::mutex _lock;
+    std::atomic<int64_t> _total_bytes{0};
+    // the size of the buffers being flushed on requests of this manager
+    std::atomic<int64_t> _flushing_bytes{0};
+    std::unordered_map<WriteBufferOwner*, std::unique_ptr<OwnerStat>> _owners;
+    std::unordered_map<int64_t, std::unique_ptr<TableStat>> _tables;
+};
+
+// An object holding a write buffer, i.e. the active memtable of a tablet writer.
+class WriteBufferOwner {
+public:
+    virtual ~WriteBufferOwner() = default;
+
+    // Flush the write buffer in the background, calling `WriteBufferManager::start_flush()` before handing the
+    // buffer over and `WriteBufferManager::finish_flush()` once it has been flushed.
+    // Called with the lock of the WriteBufferManager held, so it must not block.
+    virtual void flush_write_buffer() = 0;
+
+private:
+    friend class WriteBufferManager;
+
+    // set while the owner is registered to a WriteBufferManager
+    WriteBufferManager::OwnerStat* _write_buffer_stat = nullptr;
+};
+
+} // namespace starrocks
@@ -154,6 +154,16 @@ void BitmapValue::add(uint64_t value) {
     }
 }
 
+void BitmapValue::add_many(size_t size, const uint64_t* values) {
+    size_t i = 0;
+    for (; i < size && _type != BITMAP; i++) {
+        add(values[i]);
+    }
+    if (i < size) {
+        _bitmap->addMany(size - i, values + i);
+    }
+}
+
 void BitmapValue::_from_set_to_bitmap() {
     _bitmap = std::make_shared<detail::Roaring64Map>();
     for (auto x : *_set) {
@@ -232,6 +242,47 @@ BitmapValue& BitmapValue::operator|=(const BitmapValue& rhs) {
     return *this;
 }
 
+void BitmapValue::fast_union(const std::vector<const BitmapValue*>& values) {
+    std::vector<const BitmapValue*> bitmaps;
+    for (const auto* value : values) {
+        if (value->_type == BITMAP) {
+            bitmaps.push_back(value);
+        } else {
+            *this |= *value;
+        }
+    }
+    if (bitmaps.size() <= 1) {
+        for (const auto* value : bitmaps) {
+            *this |= *value;
+        }
+        return;
+    }
+
+    switch (_type) {
+    case EMPTY:
+        _bitmap = std::make_shared<detail::Roaring64Map>(*bitmaps[0]->_bitmap);
+        bitmaps.erase(bitmaps.begin());
+        _type = BITMAP;
+        break;
+    case SINGLE: {
+        auto bitmap = std::make_shared<detail::Roaring64Map>();
+        bitmap->add(_sv);
+        _bitmap = std::move(bitmap);
+        _type = BITMAP;
+        break;
+    }
+    case SET:
+        _from_set_to_bitmap();
+        break;
+    case BITMAP:
+        break;
+    }
+    for (const auto* value : bitmaps) {
+        _bitmap->lazyOrInplace(*value->_bitmap);
+    }
+    _bitmap->repairAfterLazy();
+}
+
 // Note: rhs BitmapValue is only readable after this method
 // Compute the intersection between the current bitmap and the provided bitmap.
 // Possible type transitions are:
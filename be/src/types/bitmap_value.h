@@ -46,6 +46,7 @@
 #include <stdexcept>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "common/config.h"
 #include "common/logging.h"
@@ -86,6 +87,10 @@ public:
 
     void add(uint64_t value);
 
+    // Add |size| values, the same as add() one by one, but the values are added
+    // to the roaring bitmap in bulk once it's converted to one.
+    void add_many(size_t size, const uint64_t* values);
+
     // Note: rhs BitmapValue is only readable after this method
     // Compute the union between the current bitmap and the provided bitmap.
     // Possible type transitions are:
@@ -94,6 +99,11 @@ public:
     // SINGLE -> BITMAP
     BitmapValue& operator|=(const BitmapValue& rhs);
 
+    // Compute the union between the current bitmap and all the provided bitmaps,
+    // the same as |= one by one, but the roaring bitmaps are ORed lazily and
+    // the result is repaired only once at the end.
+    void fast_union(const std::vector<const BitmapValue*>& values);
+
     // Note: rhs BitmapValue is only readable after this method
     // Compute the intersection between the current bitmap and the provided bitmap.
     // Possible type transitions are:
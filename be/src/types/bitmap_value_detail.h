@@ -168,9 +168,18 @@ public:
         }
     }
     void addMany(size_t n_args, const uint64_t* vals) {
-        for (size_t lcv = 0; lcv < n_args; lcv++) {
-            roarings[highBytes(vals[lcv])].add(lowBytes(vals[lcv]));
-            roarings[highBytes(vals[lcv])].setCopyOnWrite(copyOnWrite);
+        // add the consecutive values with the same high bytes in bulk
+        uint32_t lows[256];
+        size_t lcv = 0;
+        while (lcv < n_args) {
+            const uint32_t high = highBytes(vals[lcv]);
+            size_t n = 0;
+            while (lcv < n_args && n < 256 && highBytes(vals[lcv]) == high) {
+                lows[n++] = lowBytes(vals[lcv++]);
+            }
+            Roaring& roaring = roarings[high];
+            roaring.addMany(n, lows);
+            roaring.setCopyOnWrite(copyOnWrite);
         }
     }
 
@@ -276,6 +285,34 @@ public:
         return *this;
     }
 
+    /**
+     * Compute the union between the current bitmap and the provided bitmap
+     * lazily, writing the result in the current bitmap. The cardinalities of
+     * the containers are not maintained, so repairAfterLazy() must be called
+     * before the current bitmap is used by anything else.
+     */
+    void lazyOrInplace(const Roaring64Map& r) {
+        for (const auto& map_entry : r.roarings) {
+            auto roaring_iter = roarings.find(map_entry.first);
+            if (roaring_iter == roarings.end()) {
+                Roaring& roaring = roarings[map_entry.first];
+                roaring = map_entry.second;
+                roaring.setCopyOnWrite(copyOnWrite);
+            } else {
+                roaring_bitmap_lazy_or_inplace(&roaring_iter->second.roaring, &map_entry.second.roaring, false);
+            }
+        }
+    }
+
+    /**
+     * Repair the current bitmap after lazyOrInplace().
+     */
+    void repairAfterLazy() {
+        for (auto& map_entry : roarings) {
+            roaring_bitmap_repair_after_lazy(&map_entry.second.roaring);
+        }
+    }
+
     /**
      * Compute the symmetric union between the current bitmap and the provided
      * bitmap,
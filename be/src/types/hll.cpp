@@ -36,6 +36,8 @@
 
 #ifdef __x86_64__
 #include <immintrin.h>
+#elif defined(__ARM_NEON__) || defined(__aarch64__)
+#include <arm_neon.h>
 #endif
 
 #include <cmath>
@@ -135,11 +137,7 @@ HyperLogLog::~HyperLogLog() {
 // NOTE: this function won't modify _type.
 void HyperLogLog::_convert_explicit_to_register() {
     DCHECK(_type == HLL_DATA_EXPLICIT) << "_type(" << _type << ") should be explicit(" << HLL_DATA_EXPLICIT << ")";
-    DCHECK_EQ(_registers.data, nullptr);
-    MemChunkAllocator::instance()->allocate(HLL_REGISTERS_COUNT, &_registers);
-    DCHECK_NE(_registers.data, nullptr);
-    DCHECK_EQ(_registers.size, HLL_REGISTERS_COUNT);
-    memset(_registers.data, 0, HLL_REGISTERS_COUNT);
+    _allocate_registers();
 
     for (auto value : _hash_set) {
         _update_registers(value);
@@ -172,6 +170,16 @@ void HyperLogLog::update(uint64_t hash_value) {
     }
 }
 
+void HyperLogLog::update_batch(const uint64_t* hash_values, size_t size) {
+    size_t i = 0;
+    for (; i < size && (_type == HLL_DATA_EMPTY || _type == HLL_DATA_EXPLICIT); ++i) {
+        update(hash_values[i]);
+    }
+    for (; i < size; ++i) {
+        _update_registers(hash_values[i]);
+    }
+}
+
 void HyperLogLog::merge(const HyperLogLog& other) {
     // fast path
     if (other._type == HLL_DATA_EMPTY) {
@@ -240,6 +248,66 @@ void HyperLogLog::merge(const HyperLogLog& other) {
     }
 }
 
+void HyperLogLog::deserialize_and_merge(const Slice& slice) {
+    if (slice.data == nullptr || slice.size <= 0 || !is_valid(slice)) {
+        return;
+    }
+
+    const uint8_t* ptr = (uint8_t*)slice.data;
+    auto other_type = (HllDataType)*ptr++;
+    switch (other_type) {
+    case HLL_DATA_EXPLICIT: {
+        uint8_t num_explicits = *ptr++;
+        if (_type == HLL_DATA_EMPTY || _type == HLL_DATA_EXPLICIT) {
+            // The same as merge(), insert all the values first, then check the number.
+            _type = HLL_DATA_EXPLICIT;
+            for (int i = 0; i < num_explicits; ++i) {
+                _hash_set.insert(decode_fixed64_le(ptr));
+                ptr += 8;
+            }
+            if (_hash_set.size() > HLL_EXPLICLIT_INT64_NUM) {
+                _convert_explicit_to_register();
+                _type = HLL_DATA_FULL;
+            }
+        } else {
+            for (int i = 0; i < num_explicits; ++i) {
+                _update_registers(decode_fixed64_le(ptr));
+                ptr += 8;
+            }
+        }
+        break;
+    }
+    case HLL_DATA_SPARSE:
+    case HLL_DATA_FULL: {
+        if (_type == HLL_DATA_EMPTY) {
+            _allocate_registers();
+            _type = other_type;
+        } else if (_type == HLL_DATA_EXPLICIT) {
+            _convert_explicit_to_register();
+            _type = HLL_DATA_FULL;
+        }
+        if (other_type == HLL_DATA_FULL) {
+            _merge_registers(ptr);
+            break;
+        }
+        // 2-5(4 byte): number of registers
+        uint32_t num_registers = decode_fixed32_le(ptr);
+        ptr += 4;
+        for (uint32_t i = 0; i < num_registers; ++i) {
+            // 2 bytes: register index
+            // 1 byte: register value
+            uint16_t register_idx = decode_fixed16_le(ptr);
+            ptr += 2;
+            DCHECK_LT(register_idx, HLL_REGISTERS_COUNT);
+            _registers.data[register_idx] = std::max(_registers.data[register_idx], *ptr++);
+        }
+        break;
+    }
+    default:
+        break;
+    }
+}
+
 size_t HyperLogLog::max_serialized_size() const {
     switch (_type) {
     case HLL_DATA_EMPTY:
@@ -562,11 +630,21 @@ void HyperLogLog::clear() {
     _hash_set.clear();
 }
 
-void HyperLogLog::_merge_registers(uint8_t* other_registers) {
-#ifdef __AVX2__
-    int loop = HLL_REGISTERS_COUNT / 32;
+void HyperLogLog::_allocate_registers() {
+    // the registers are kept by clear() to be reused
+    if (_registers.data == nullptr) {
+        MemChunkAllocator::instance()->allocate(HLL_REGISTERS_COUNT, &_registers);
+    }
+    DCHECK_NE(_registers.data, nullptr);
+    DCHECK_EQ(_registers.size, HLL_REGISTERS_COUNT);
+    memset(_registers.data, 0, HLL_REGISTERS_COUNT);
+}
+
+void HyperLogLog::_merge_registers(const uint8_t* other_registers) {
     uint8_t* dst = _registers.data;
     const uint8_t* src = other_registers;
+#ifdef __AVX2__
+    int loop = HLL_REGISTERS_COUNT / 32;
     for (int i = 0; i < loop; i++) {
         __m256i xa = _mm256_loadu_si256((const __m256i*)dst);
         __m256i xb = _mm256_loadu_si256((const __m256i*)src);
@@ -574,9 +652,25 @@ void HyperLogLog::_merge_registers(uint8_t* other_registers) {
         src += 32;
         dst += 32;
     }
+#elif defined(__SSE2__)
+    int loop = HLL_REGISTERS_COUNT / 16;
+    for (int i = 0; i < loop; i++) {
+        __m128i xa = _mm_loadu_si128((const __m128i*)dst);
+        __m128i xb = _mm_loadu_si128((const __m128i*)src);
+        _mm_storeu_si128((__m128i*)dst, _mm_max_epu8(xa, xb));
+        src += 16;
+        dst += 16;
+    }
+#elif defined(__ARM_NEON__) || defined(__aarch64__)
+    int loop = HLL_REGISTERS_COUNT / 16;
+    for (int i = 0; i < loop; i++) {
+        vst1q_u8(dst, vmaxq_u8(vld1q_u8(dst), vld1q_u8(src)));
+        src += 16;
+        dst += 16;
+    }
 #else
     for (int i = 0; i < HLL_REGISTERS_COUNT; i++) {
-        _registers.data[i] = std::max(_registers.data[i], other_registers[i]);
+        dst[i] = std::max(dst[i], src[i]);
     }
 #endif
 }
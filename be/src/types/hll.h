@@ -113,8 +113,17 @@ public:
     // NOTE: input must be a hash_value
     void update(uint64_t hash_value);
 
+    // Add |size| hash values to this HLL value, the same as update() one by one, but
+    // the type is only checked once the HLL value has registers.
+    void update_batch(const uint64_t* hash_values, size_t size);
+
     void merge(const HyperLogLog& other);
 
+    // The same as merge(HyperLogLog(slice)), but merge the registers directly from
+    // the serialized binary instead of copying them into a temporary HLL value.
+    // An invalid binary is merged as an empty HLL value.
+    void deserialize_and_merge(const Slice& slice);
+
     // Return max size of serialized binary
     size_t max_serialized_size() const;
 
@@ -162,7 +171,10 @@ private:
     void _convert_explicit_to_register();
 
     // absorb other registers into this registers
-    void _merge_registers(uint8_t* other_registers);
+    void _merge_registers(const uint8_t* other_registers);
+
+    // allocate the registers if not yet, and zero them
+    void _allocate_registers();
 
     // update one hash value into this registers
     void _update_registers(uint64_t hash_value) {
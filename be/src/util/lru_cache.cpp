@@ -6,6 +6,9 @@
 
 #include <rapidjson/document.h>
 
+#include <strings.h>
+
+#include <algorithm>
 #include <cstdio>
 #include <cstdlib>
 #include <sstream>
@@ -150,10 +153,73 @@ bool HandleTable::_resize() {
     return true;
 }
 
+static const uint64_t kSketchSeeds[] = {0xc3a5c85c97cb3127ULL, 0xb492b66fbe98f273ULL, 0x9ae16a3b2f90404fULL,
+                                         0xcbf29ce484222325ULL};
+
+void FrequencySketch::ensure_capacity(size_t num_entries) {
+    size_t length = 64;
+    while (length < num_entries) {
+        length <<= 1;
+    }
+    if (length <= _table.size()) {
+        return;
+    }
+    _table.assign(length, 0);
+    _sample_size = 10 * length;
+    _additions = 0;
+}
+
+size_t FrequencySketch::_index_of(uint32_t hash, int i) const {
+    uint64_t h = (hash + kSketchSeeds[i]) * kSketchSeeds[i];
+    h += (h >> 32);
+    return h & (_table.size() - 1);
+}
+
+bool FrequencySketch::_increment_at(size_t index, int counter) {
+    const int offset = counter << 2;
+    const uint64_t mask = 0xfULL << offset;
+    if ((_table[index] & mask) != mask) {
+        _table[index] += 1ULL << offset;
+        return true;
+    }
+    return false;
+}
+
+void FrequencySketch::increment(uint32_t hash) {
+    // every key uses one group of 4 counters in each word.
+    const int start = (hash & 3) << 2;
+    bool added = false;
+    for (int i = 0; i < 4; i++) {
+        added |= _increment_at(_index_of(hash, i), start + i);
+    }
+    if (added && ++_additions >= _sample_size) {
+        _reset();
+    }
+}
+
+uint32_t FrequencySketch::frequency(uint32_t hash) const {
+    const int start = (hash & 3) << 2;
+    uint32_t frequency = 0xf;
+    for (int i = 0; i < 4; i++) {
+        const int offset = (start + i) << 2;
+        frequency = std::min<uint32_t>(frequency, (_table[_index_of(hash, i)] >> offset) & 0xf);
+    }
+    return frequency;
+}
+
+void FrequencySketch::_reset() {
+    for (auto& word : _table) {
+        word = (word >> 1) & 0x7777777777777777ULL;
+    }
+    _additions /= 2;
+}
+
 LRUCache::LRUCache() {
     // Make empty circular linked list
     _lru.next = &_lru;
     _lru.prev = &_lru;
+    _protected_lru.next = &_protected_lru;
+    _protected_lru.prev = &_protected_lru;
 }
 
 LRUCache::~LRUCache() noexcept {
@@ -185,6 +251,9 @@ void LRUCache::set_capacity(size_t capacity) {
     {
         std::lock_guard l(_mutex);
         _capacity = capacity;
+        // 80% of the capacity is reserved for the protected segment, like W-TinyLFU.
+        _protected_capacity = capacity / 5 * 4;
+        _demote_protected();
         _evict_from_lru(0, &last_ref_list);
     }
 
@@ -193,14 +262,26 @@ void LRUCache::set_capacity(size_t capacity) {
     }
 }
 
-uint64_t LRUCache::get_lookup_count() {
+void LRUCache::set_policy(CachePolicy policy) {
     std::lock_guard l(_mutex);
-    return _lookup_count;
+    DCHECK_EQ(0, _usage);
+    _policy = policy;
+}
+
+uint64_t LRUCache::get_lookup_count() {
+    return _lookup_count.load(std::memory_order_relaxed);
 }
 
 uint64_t LRUCache::get_hit_count() {
-    std::lock_guard l(_mutex);
-    return _hit_count;
+    return _hit_count.load(std::memory_order_relaxed);
+}
+
+uint64_t LRUCache::get_evict_count() {
+    return _evict_count.load(std::memory_order_relaxed);
+}
+
+uint64_t LRUCache::get_reject_count() {
+    return _reject_count.load(std::memory_order_relaxed);
 }
 
 size_t LRUCache::get_usage() {
@@ -208,6 +289,11 @@ size_t LRUCache::get_usage() {
     return _usage;
 }
 
+size_t LRUCache::get_protected_usage() {
+    std::lock_guard l(_mutex);
+    return _protected_usage;
+}
+
 size_t LRUCache::get_capacity() {
     std::lock_guard l(_mutex);
     return _capacity;
@@ -215,7 +301,10 @@ size_t LRUCache::get_capacity() {
 
 Cache::Handle* LRUCache::lookup(const CacheKey& key, uint32_t hash) {
     std::lock_guard l(_mutex);
-    ++_lookup_count;
+    _lookup_count.fetch_add(1, std::memory_order_relaxed);
+    if (_policy == CachePolicy::SLRU) {
+        _sketch.increment(hash);
+    }
     LRUHandle* e = _table.lookup(key, hash);
     if (e != nullptr) {
         // we get it from _table, so in_cache must be true
@@ -225,7 +314,13 @@ Cache::Handle* LRUCache::lookup(const CacheKey& key, uint32_t hash) {
             _lru_remove(e);
         }
         e->refs++;
-        ++_hit_count;
+        _hit_count.fetch_add(1, std::memory_order_relaxed);
+        if (_policy == CachePolicy::SLRU && !e->in_protected) {
+            // hit again after insertion, promote it into the protected segment when released.
+            e->in_protected = true;
+            _protected_usage += e->charge;
+            _demote_protected();
+        }
     }
     return reinterpret_cast<Cache::Handle*>(e);
 }
@@ -235,6 +330,12 @@ void LRUCache::release(Cache::Handle* handle) {
         return;
     }
     auto* e = reinterpret_cast<LRUHandle*>(handle);
+    if (e->detached) {
+        // only referenced by the handle returned by insert()
+        DCHECK_EQ(1, e->refs);
+        e->free();
+        return;
+    }
     bool last_ref = false;
     {
         std::lock_guard l(_mutex);
@@ -242,17 +343,20 @@ void LRUCache::release(Cache::Handle* handle) {
         if (last_ref) {
             _usage -= e->charge;
         } else if (e->in_cache && e->refs == 1) {
-            // only exists in cache
-            if (_usage > _capacity) {
+            // only exists in cache, the entries in the protected segment are kept even if the
+            // cache is over capacity, they are evicted only after being demoted to the probation
+            // segment.
+            if (_usage > _capacity && !e->in_protected) {
                 // take this opportunity and remove the item
                 _table.remove(e->key(), e->hash);
                 e->in_cache = false;
+                _leave_protected(e);
                 _unref(e);
                 _usage -= e->charge;
                 last_ref = true;
             } else {
                 // put it to LRU free list
-                _lru_append(&_lru, e);
+                _lru_append(e->in_protected ? &_protected_lru : &_lru, e);
             }
         }
     }
@@ -264,9 +368,16 @@ void LRUCache::release(Cache::Handle* handle) {
 }
 
 void LRUCache::_evict_from_lru(size_t charge, std::vector<LRUHandle*>* deleted) {
-    LRUHandle* cur = &_lru;
+    // entries in the probation segment are evicted before those in the protected segment,
+    // the protected segment is always empty for LRU policy.
+    _evict_from_list(&_lru, charge, deleted);
+    _evict_from_list(&_protected_lru, charge, deleted);
+}
+
+void LRUCache::_evict_from_list(LRUHandle* list, size_t charge, std::vector<LRUHandle*>* deleted) {
+    LRUHandle* cur = list;
     // 1. evict normal cache entries
-    while (_usage + charge > _capacity && cur->next != &_lru) {
+    while (_usage + charge > _capacity && cur->next != list) {
         LRUHandle* old = cur->next;
         if (old->priority == CachePriority::DURABLE) {
             cur = cur->next;
@@ -276,8 +387,8 @@ void LRUCache::_evict_from_lru(size_t charge, std::vector<LRUHandle*>* deleted)
         deleted->push_back(old);
     }
     // 2. evict durable cache entries if need
-    while (_usage + charge > _capacity && _lru.next != &_lru) {
-        LRUHandle* old = _lru.next;
+    while (_usage + charge > _capacity && list->next != list) {
+        LRUHandle* old = list->next;
         DCHECK(old->priority == CachePriority::DURABLE);
         _evict_one_entry(old);
         deleted->push_back(old);
@@ -290,8 +401,40 @@ void LRUCache::_evict_one_entry(LRUHandle* e) {
     _lru_remove(e);
     _table.remove(e->key(), e->hash);
     e->in_cache = false;
+    _leave_protected(e);
     _unref(e);
     _usage -= e->charge;
+    _evict_count.fetch_add(1, std::memory_order_relaxed);
+}
+
+void LRUCache::_leave_protected(LRUHandle* e) {
+    if (e->in_protected) {
+        e->in_protected = false;
+        _protected_usage -= e->charge;
+    }
+}
+
+// Move the oldest entries of the protected segment back to the probation segment until
+// the protected segment fits in its capacity.
+void LRUCache::_demote_protected() {
+    while (_protected_usage > _protected_capacity && _protected_lru.next != &_protected_lru) {
+        LRUHandle* old = _protected_lru.next;
+        _lru_remove(old);
+        _leave_protected(old);
+        _lru_append(&_lru, old);
+    }
+}
+
+// For SLRU policy, when the cache is full, a new entry is admitted only if it is accessed more
+// frequently than the oldest entry in the probation segment, which would be evicted for it.
+// A rejected entry is still returned to the caller as a detached handle, which is not put into
+// the cache and is freed when released.
+bool LRUCache::_admit(uint32_t hash, size_t charge, CachePriority priority) const {
+    if (_policy != CachePolicy::SLRU || priority == CachePriority::DURABLE || _usage + charge <= _capacity ||
+        _lru.next == &_lru) {
+        return true;
+    }
+    return _sketch.frequency(hash) >= _sketch.frequency(_lru.next->hash);
 }
 
 Cache::Handle* LRUCache::insert(const CacheKey& key, uint32_t hash, void* value, size_t charge,
@@ -305,12 +448,23 @@ Cache::Handle* LRUCache::insert(const CacheKey& key, uint32_t hash, void* value,
     e->refs = 2; // one for the returned handle, one for LRUCache.
     e->next = e->prev = nullptr;
     e->in_cache = true;
+    e->in_protected = false;
+    e->detached = false;
     e->priority = priority;
     memcpy(e->key_data, key.data(), key.size());
     std::vector<LRUHandle*> last_ref_list;
     {
         std::lock_guard l(_mutex);
 
+        // an existing entry is always replaced by the new value
+        if (!_admit(hash, charge, priority) && _table.lookup(key, hash) == nullptr) {
+            _reject_count.fetch_add(1, std::memory_order_relaxed);
+            e->refs = 1;
+            e->in_cache = false;
+            e->detached = true;
+            return reinterpret_cast<Cache::Handle*>(e);
+        }
+
         // Free the space following strict LRU policy until enough space
         // is freed or the lru list is empty
         _evict_from_lru(charge, &last_ref_list);
@@ -320,8 +474,12 @@ Cache::Handle* LRUCache::insert(const CacheKey& key, uint32_t hash, void* value,
         // space was freed
         auto old = _table.insert(e);
         _usage += charge;
+        if (_policy == CachePolicy::SLRU) {
+            _sketch.ensure_capacity(_table.size());
+        }
         if (old != nullptr) {
             old->in_cache = false;
+            _leave_protected(old);
             if (_unref(old)) {
                 _usage -= old->charge;
                 // old is on LRU because it's in cache and its reference count
@@ -348,6 +506,7 @@ void LRUCache::erase(const CacheKey& key, uint32_t hash) {
         std::lock_guard l(_mutex);
         e = _table.remove(key, hash);
         if (e != nullptr) {
+            _leave_protected(e);
             last_ref = _unref(e);
             if (last_ref) {
                 _usage -= e->charge;
@@ -369,16 +528,19 @@ int LRUCache::prune() {
     std::vector<LRUHandle*> last_ref_list;
     {
         std::lock_guard l(_mutex);
-        while (_lru.next != &_lru) {
-            LRUHandle* old = _lru.next;
-            DCHECK(old->in_cache);
-            DCHECK(old->refs == 1); // LRU list contains elements which may be evicted
-            _lru_remove(old);
-            _table.remove(old->key(), old->hash);
-            old->in_cache = false;
-            _unref(old);
-            _usage -= old->charge;
-            last_ref_list.push_back(old);
+        for (LRUHandle* list : {&_lru, &_protected_lru}) {
+            while (list->next != list) {
+                LRUHandle* old = list->next;
+                DCHECK(old->in_cache);
+                DCHECK(old->refs == 1); // LRU list contains elements which may be evicted
+                _lru_remove(old);
+                _table.remove(old->key(), old->hash);
+                old->in_cache = false;
+                _leave_protected(old);
+                _unref(old);
+                _usage -= old->charge;
+                last_ref_list.push_back(old);
+            }
         }
     }
     for (auto entry : last_ref_list) {
@@ -395,9 +557,11 @@ uint32_t ShardedLRUCache::_shard(uint32_t hash) {
     return hash >> (32 - kNumShardBits);
 }
 
-ShardedLRUCache::ShardedLRUCache(size_t capacity) : _last_id(0), _capacity(capacity) {
+ShardedLRUCache::ShardedLRUCache(size_t capacity, CachePolicy policy)
+        : _policy(policy), _last_id(0), _capacity(capacity) {
     const size_t per_shard = (_capacity + (kNumShards - 1)) / kNumShards;
     for (auto& _shard : _shards) {
+        _shard.set_policy(policy);
         _shard.set_capacity(per_shard);
     }
 }
@@ -522,12 +686,28 @@ void ShardedLRUCache::get_cache_status(rapidjson::Document* document) {
         }
 
         shard_info.AddMember("hit_ratio", hit_ratio, document->GetAllocator());
+
+        shard_info.AddMember("evict_count", static_cast<double>(_shards[i].get_evict_count()),
+                             document->GetAllocator());
+        if (_policy == CachePolicy::SLRU) {
+            shard_info.AddMember("protected_usage", static_cast<double>(_shards[i].get_protected_usage()),
+                                 document->GetAllocator());
+            shard_info.AddMember("reject_count", static_cast<double>(_shards[i].get_reject_count()),
+                                 document->GetAllocator());
+        }
         document->PushBack(shard_info, document->GetAllocator());
     }
 }
 
-Cache* new_lru_cache(size_t capacity) {
-    return new ShardedLRUCache(capacity);
+CachePolicy cache_policy_from_string(const std::string& name) {
+    if (strcasecmp(name.c_str(), "slru") == 0) {
+        return CachePolicy::SLRU;
+    }
+    return CachePolicy::LRU;
+}
+
+Cache* new_lru_cache(size_t capacity, CachePolicy policy) {
+    return new ShardedLRUCache(capacity, policy);
 }
 
 } // namespace starrocks
@@ -6,6 +6,7 @@
 
 #include <rapidjson/document.h>
 
+#include <atomic>
 #include <cstdint>
 #include <cstring>
 #include <mutex>
@@ -20,9 +21,21 @@ namespace starrocks {
 class Cache;
 class CacheKey;
 
+// The eviction policy of a cache.
+//  LRU: strict least-recently-used.
+//  SLRU: segmented LRU with frequency based admission. New entries are put into a probation segment
+//        and promoted into a protected segment when they are hit again, so a large scan only evicts
+//        entries in the probation segment and keeps the hot working set. When the cache is full, a
+//        new entry is only admitted if it was accessed more often recently than the entry it would
+//        evict, the access frequencies are estimated by a count-min sketch.
+enum class CachePolicy { LRU = 0, SLRU = 1 };
+
+// Return the policy named |name|, which is "lru" or "slru", LRU is returned for unknown names.
+CachePolicy cache_policy_from_string(const std::string& name);
+
 // Create a new cache with a fixed size capacity.  This implementation
-// of Cache uses a least-recently-used eviction policy.
-extern Cache* new_lru_cache(size_t capacity);
+// of Cache uses a least-recently-used eviction policy by default.
+extern Cache* new_lru_cache(size_t capacity, CachePolicy policy = CachePolicy::LRU);
 
 class CacheKey {
 public:
@@ -202,7 +215,10 @@ typedef struct LRUHandle {
     LRUHandle* prev;
     size_t charge;
     size_t key_length;
-    bool in_cache; // Whether entry is in the cache.
+    bool in_cache;     // Whether entry is in the cache.
+    bool in_protected; // Whether entry is in the protected segment, only used by SLRU policy.
+    bool detached;     // Whether entry is rejected by the admission of SLRU policy, so it's never in the cache
+                       // nor charged in the usage, and it's freed on release.
     uint32_t refs;
     uint32_t hash; // Hash of key(); used for fast sharding and comparisons
     CachePriority priority = CachePriority::NORMAL;
@@ -243,6 +259,8 @@ public:
 
     LRUHandle* remove(const CacheKey& key, uint32_t hash);
 
+    uint32_t size() const { return _elems; }
+
 private:
     // The tablet consists of an array of buckets where each bucket is
     // a linked list of cache entries that hash into the bucket.
@@ -257,6 +275,31 @@ private:
     bool _resize();
 };
 
+// A count-min sketch of 4-bit counters, estimating how many times a key has been accessed recently.
+// All counters are halved after a number of increments proportional to the size of the sketch, so
+// the estimation follows the changes of the workload.
+class FrequencySketch {
+public:
+    FrequencySketch() { ensure_capacity(0); }
+
+    // Grow the sketch to estimate the frequencies of |num_entries| keys accurately.
+    void ensure_capacity(size_t num_entries);
+
+    void increment(uint32_t hash);
+
+    uint32_t frequency(uint32_t hash) const;
+
+private:
+    size_t _index_of(uint32_t hash, int i) const;
+    bool _increment_at(size_t index, int counter);
+    void _reset();
+
+    // every word holds 16 counters.
+    std::vector<uint64_t> _table;
+    size_t _additions{0};
+    size_t _sample_size{0};
+};
+
 // A single shard of sharded cache.
 class LRUCache {
 public:
@@ -266,6 +309,9 @@ public:
     // Separate from constructor so caller can easily make an array of LRUCache
     void set_capacity(size_t capacity);
 
+    // Must be called before any entry is inserted.
+    void set_policy(CachePolicy policy);
+
     // Like Cache methods, but with an extra "hash" parameter.
     Cache::Handle* insert(const CacheKey& key, uint32_t hash, void* value, size_t charge,
                           void (*deleter)(const CacheKey& key, void* value),
@@ -277,7 +323,10 @@ public:
 
     uint64_t get_lookup_count();
     uint64_t get_hit_count();
+    uint64_t get_evict_count();
+    uint64_t get_reject_count();
     size_t get_usage();
+    size_t get_protected_usage();
     size_t get_capacity();
 
 private:
@@ -285,24 +334,39 @@ private:
     void _lru_append(LRUHandle* list, LRUHandle* e);
     bool _unref(LRUHandle* e);
     void _evict_from_lru(size_t charge, std::vector<LRUHandle*>* deleted);
+    void _evict_from_list(LRUHandle* list, size_t charge, std::vector<LRUHandle*>* deleted);
     void _evict_one_entry(LRUHandle* e);
+    bool _admit(uint32_t hash, size_t charge, CachePriority priority) const;
+    void _leave_protected(LRUHandle* e);
+    void _demote_protected();
 
     // Initialized before use.
     size_t _capacity{0};
+    CachePolicy _policy{CachePolicy::LRU};
 
     // _mutex protects the following state.
     std::mutex _mutex;
     size_t _usage{0};
 
-    // Dummy head of LRU list.
+    // Dummy head of LRU list, it's the probation segment for SLRU policy.
     // lru.prev is newest entry, lru.next is oldest entry.
     // Entries have refs==1 and in_cache==true.
     LRUHandle _lru;
 
+    // Dummy head of the protected segment, only used by SLRU policy.
+    LRUHandle _protected_lru;
+    size_t _protected_capacity{0};
+    size_t _protected_usage{0};
+
     HandleTable _table;
 
-    uint64_t _lookup_count{0};
-    uint64_t _hit_count{0};
+    FrequencySketch _sketch;
+
+    // statistics are updated under _mutex but can be read without it.
+    std::atomic<uint64_t> _lookup_count{0};
+    std::atomic<uint64_t> _hit_count{0};
+    std::atomic<uint64_t> _evict_count{0};
+    std::atomic<uint64_t> _reject_count{0};
 };
 
 static const int kNumShardBits = 5;
@@ -310,7 +374,7 @@ static const int kNumShards = 1 << kNumShardBits;
 
 class ShardedLRUCache : public Cache {
 public:
-    explicit ShardedLRUCache(size_t capacity);
+    explicit ShardedLRUCache(size_t capacity, CachePolicy policy = CachePolicy::LRU);
     ~ShardedLRUCache() override = default;
     Handle* insert(const CacheKey& key, void* value, size_t charge, void (*deleter)(const CacheKey& key, void* value),
                    CachePriority priority = CachePriority::NORMAL) override;
@@ -336,6 +400,7 @@ private:
     size_t _get_stat(size_t (LRUCache::*mem_fun)());
 
     LRUCache _shards[kNumShards];
+    CachePolicy _policy;
     std::mutex _mutex;
     uint64_t _last_id;
     size_t _capacity;
@@ -134,6 +134,9 @@ StarRocksMetrics::StarRocksMetrics() : _metrics(_s_registry_name) {
     _metrics.register_metric("update_compaction_duration_us", MetricLabels().add("type", "update"),
                              &update_compaction_duration_us);
 
+    REGISTER_STARROCKS_METRIC(compaction_throttle_io_bytes_total);
+    REGISTER_STARROCKS_METRIC(compaction_throttle_wait_duration_us);
+
     _metrics.register_metric("meta_request_total", MetricLabels().add("type", "write"), &meta_write_request_total);
     _metrics.register_metric("meta_request_total", MetricLabels().add("type", "read"), &meta_read_request_total);
     _metrics.register_metric("meta_request_duration", MetricLabels().add("type", "write"),
@@ -168,6 +171,7 @@ StarRocksMetrics::StarRocksMetrics() : _metrics(_s_registry_name) {
 
     REGISTER_STARROCKS_METRIC(tablet_cumulative_max_compaction_score);
     REGISTER_STARROCKS_METRIC(tablet_base_max_compaction_score);
+    REGISTER_STARROCKS_METRIC(compaction_throttle_busy);
     REGISTER_STARROCKS_METRIC(tablet_update_max_compaction_score);
 
     REGISTER_STARROCKS_METRIC(push_request_write_bytes_per_second);
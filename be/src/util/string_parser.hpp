@@ -47,6 +47,7 @@
 #include "common/status.h"
 #include "types/logical_type.h"
 #include "util/decimal_types.h"
+#include "util/swar_digits.h"
 
 namespace starrocks {
 
@@ -67,7 +68,8 @@ namespace starrocks {
 //  - lookup table for converting character to digit
 // Improvements (TODO):
 //  - Validate input using _sidd_compare_ranges
-//  - Since we know the length, we can parallelize this: i.e. result = 100*s[0] + 10*s[1] + s[2]
+//
+// The integers which can't overflow are validated and converted eight digits at a time by SWAR.
 class StringParser {
 public:
     enum ParseResult { PARSE_SUCCESS = 0, PARSE_FAILURE, PARSE_OVERFLOW, PARSE_UNDERFLOW };
@@ -403,7 +405,19 @@ inline T StringParser::string_to_int_no_overflow(const char* s, int len, ParseRe
         *result = PARSE_FAILURE;
         return 0;
     }
-    for (int i = 1; i < len; ++i) {
+    int i = 1;
+    if constexpr (sizeof(T) >= sizeof(uint32_t)) {
+        // Validate and convert eight digits at a time, the rest and the trailing whitespaces are handled one
+        // by one below.
+        for (; i + 8 <= len; i += 8) {
+            uint64_t chunk = swar::load_eight_chars(s + i);
+            if (!swar::is_eight_digits(chunk)) {
+                break;
+            }
+            val = val * 100000000 + swar::parse_eight_digits(chunk);
+        }
+    }
+    for (; i < len; ++i) {
         if (LIKELY(s[i] >= '0' && s[i] <= '9')) {
             T digit = s[i] - '0';
             val = val * 10 + digit;
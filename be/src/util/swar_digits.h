@@ -0,0 +1,53 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+
+#include "util/unaligned_access.h"
+
+namespace starrocks {
+
+// Validate and convert eight ASCII digits at a time in a 64-bit register (SIMD within a register), the first
+// char in the lowest byte as loaded from memory on little-endian machines.
+// See "Parsing series of integers with SIMD" and simdjson for the details.
+namespace swar {
+
+inline uint64_t load_eight_chars(const char* s) {
+    return unaligned_load<uint64_t>(s);
+}
+
+// Return whether all the eight chars in |chunk| are in '0'..'9'
+inline bool is_eight_digits(uint64_t chunk) {
+    return ((chunk & 0xF0F0F0F0F0F0F0F0ULL) | (((chunk + 0x0606060606060606ULL) & 0xF0F0F0F0F0F0F0F0ULL) >> 4)) ==
+           0x3333333333333333ULL;
+}
+
+// Return the value of the eight digits in |chunk|, which must be validated by is_eight_digits()
+inline uint32_t parse_eight_digits(uint64_t chunk) {
+    const uint64_t mask = 0x000000FF000000FFULL;
+    const uint64_t mul1 = 0x000F424000000064ULL; // 100 + (1000000ULL << 32)
+    const uint64_t mul2 = 0x0000271000000001ULL; // 1 + (10000ULL << 32)
+    chunk -= 0x3030303030303030ULL;
+    // every two digits to a byte
+    chunk = (chunk * 10) + (chunk >> 8);
+    // every eight digits to the high 32 bits
+    chunk = (((chunk & mask) * mul1) + (((chunk >> 16) & mask) * mul2)) >> 32;
+    return static_cast<uint32_t>(chunk);
+}
+
+} // namespace swar
+} // namespace starrocks
@@ -39,6 +39,7 @@ TEST_F(BlockCacheTest, hybrid_cache) {
     size_t quota = 500 * 1024 * 1024;
     options.disk_spaces.push_back({.path = "./ut_dir/block_disk_cache", .size = quota});
     options.block_size = block_size;
+    options.engine = "cachelib";
     Status status = cache->init(options);
     ASSERT_TRUE(status.ok());
 
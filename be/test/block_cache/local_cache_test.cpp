@@ -0,0 +1,209 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "block_cache/local_cache.h"
+
+#include <fcntl.h>
+#include <gtest/gtest.h>
+#include <unistd.h>
+
+#include <cstring>
+
+#include "fs/fs_util.h"
+#include "testutil/assert.h"
+
+namespace starrocks {
+
+class LocalCacheTest : public ::testing::Test {
+protected:
+    void SetUp() override { ASSERT_OK(fs::create_directories(kCacheDir)); }
+    void TearDown() override { ASSERT_OK(fs::remove_all("./ut_dir")); }
+
+    static CacheOptions cache_options(size_t mem_size, size_t num_slots) {
+        CacheOptions options;
+        options.mem_space_size = mem_size;
+        options.disk_spaces.push_back({.path = kCacheDir, .size = num_slots * kSlotSize});
+        options.block_size = kBlockSize;
+        options.checksum = true;
+        return options;
+    }
+
+    static std::string block_value(size_t i) { return std::string(kBlockSize - i % 7, 'a' + i % 26); }
+
+    static void check_block(LocalCache* cache, const std::string& key, const std::string& expected) {
+        std::string value(expected.size(), '\0');
+        auto res = cache->read_cache(key, value.data(), 0, value.size());
+        ASSERT_OK(res.status());
+        ASSERT_EQ(expected.size(), res.value());
+        ASSERT_EQ(expected, value);
+    }
+
+    static constexpr const char* kCacheDir = "./ut_dir/local_cache";
+    static constexpr size_t kBlockSize = 8 * 1024;
+    static constexpr size_t kSlotSize = LocalCache::kSlotHeaderSize + kBlockSize;
+};
+
+TEST_F(LocalCacheTest, test_read_write) {
+    LocalCache cache;
+    ASSERT_OK(cache.init(cache_options(1024 * 1024, 16)));
+    ASSERT_EQ(16, cache.disk_slot_count());
+
+    for (size_t i = 0; i < 8; i++) {
+        ASSERT_OK(cache.write_cache("key" + std::to_string(i), block_value(i).data(), block_value(i).size(), 0));
+    }
+    for (size_t i = 0; i < 8; i++) {
+        check_block(&cache, "key" + std::to_string(i), block_value(i));
+    }
+    ASSERT_EQ(8, cache.mem_hit_count());
+
+    // read part of a block
+    char buf[100];
+    auto res = cache.read_cache("key1", buf, 1000, sizeof(buf));
+    ASSERT_OK(res.status());
+    ASSERT_EQ(0, memcmp(buf, block_value(1).data() + 1000, sizeof(buf)));
+
+    res = cache.read_cache("key1", buf, kBlockSize - 10, sizeof(buf));
+    ASSERT_TRUE(res.status().is_invalid_argument());
+    res = cache.read_cache("not_exist", buf, 0, sizeof(buf));
+    ASSERT_TRUE(res.status().is_not_found());
+
+    std::string too_large(kBlockSize + 1, 'x');
+    ASSERT_TRUE(cache.write_cache("too_large", too_large.data(), too_large.size(), 0).is_invalid_argument());
+
+    cache.wait_for_flush();
+    ASSERT_EQ(8, cache.disk_block_count());
+    ASSERT_OK(cache.remove_cache("key1"));
+    ASSERT_EQ(7, cache.disk_block_count());
+    res = cache.read_cache("key1", buf, 0, sizeof(buf));
+    ASSERT_TRUE(res.status().is_not_found());
+    ASSERT_OK(cache.shutdown());
+}
+
+TEST_F(LocalCacheTest, test_disk_only) {
+    LocalCache cache;
+    ASSERT_OK(cache.init(cache_options(0, 16)));
+    for (size_t i = 0; i < 10; i++) {
+        ASSERT_OK(cache.write_cache("key" + std::to_string(i), block_value(i).data(), block_value(i).size(), 0));
+    }
+    cache.wait_for_flush();
+    for (size_t i = 0; i < 10; i++) {
+        check_block(&cache, "key" + std::to_string(i), block_value(i));
+    }
+    ASSERT_EQ(0, cache.mem_hit_count());
+    ASSERT_EQ(10, cache.disk_hit_count());
+    ASSERT_EQ(0, cache.mem_usage());
+    ASSERT_OK(cache.shutdown());
+}
+
+TEST_F(LocalCacheTest, test_evict) {
+    LocalCache cache;
+    ASSERT_OK(cache.init(cache_options(0, 4)));
+    for (size_t i = 0; i < 4; i++) {
+        ASSERT_OK(cache.write_cache("key" + std::to_string(i), block_value(i).data(), block_value(i).size(), 0));
+        cache.wait_for_flush();
+    }
+    // key0 becomes the most recently used one, so key1 is evicted first
+    check_block(&cache, "key0", block_value(0));
+    for (size_t i = 4; i < 6; i++) {
+        ASSERT_OK(cache.write_cache("key" + std::to_string(i), block_value(i).data(), block_value(i).size(), 0));
+        cache.wait_for_flush();
+    }
+    ASSERT_EQ(4, cache.disk_block_count());
+
+    char buf[16];
+    ASSERT_TRUE(cache.read_cache("key1", buf, 0, sizeof(buf)).status().is_not_found());
+    ASSERT_TRUE(cache.read_cache("key2", buf, 0, sizeof(buf)).status().is_not_found());
+    check_block(&cache, "key0", block_value(0));
+    check_block(&cache, "key3", block_value(3));
+    check_block(&cache, "key4", block_value(4));
+    check_block(&cache, "key5", block_value(5));
+    ASSERT_OK(cache.shutdown());
+}
+
+TEST_F(LocalCacheTest, test_recover_after_restart) {
+    {
+        LocalCache cache;
+        ASSERT_OK(cache.init(cache_options(1024 * 1024, 16)));
+        for (size_t i = 0; i < 10; i++) {
+            ASSERT_OK(cache.write_cache("key" + std::to_string(i), block_value(i).data(), block_value(i).size(), 0));
+        }
+        cache.wait_for_flush();
+        ASSERT_OK(cache.remove_cache("key3"));
+        ASSERT_OK(cache.shutdown());
+    }
+
+    LocalCache cache;
+    ASSERT_OK(cache.init(cache_options(1024 * 1024, 16)));
+    ASSERT_EQ(9, cache.disk_block_count());
+    for (size_t i = 0; i < 10; i++) {
+        if (i == 3) {
+            char buf[16];
+            ASSERT_TRUE(cache.read_cache("key3", buf, 0, sizeof(buf)).status().is_not_found());
+            continue;
+        }
+        check_block(&cache, "key" + std::to_string(i), block_value(i));
+    }
+    ASSERT_EQ(9, cache.disk_hit_count());
+    ASSERT_OK(cache.shutdown());
+
+    // the cached blocks are dropped if the block size is changed
+    LocalCache other;
+    CacheOptions options = cache_options(0, 16);
+    options.block_size = kBlockSize / 2;
+    ASSERT_OK(other.init(options));
+    ASSERT_EQ(0, other.disk_block_count());
+    ASSERT_OK(other.shutdown());
+}
+
+TEST_F(LocalCacheTest, test_corrupted_block) {
+    {
+        LocalCache cache;
+        ASSERT_OK(cache.init(cache_options(0, 4)));
+        ASSERT_OK(cache.write_cache("key0", block_value(0).data(), block_value(0).size(), 0));
+        cache.wait_for_flush();
+        ASSERT_OK(cache.shutdown());
+    }
+
+    // flip one byte of the block data
+    std::string path = std::string(kCacheDir) + "/" + LocalCache::kDataFileName;
+    int fd = ::open(path.c_str(), O_RDWR);
+    ASSERT_GE(fd, 0);
+    char ch = 0;
+    off_t offset = -1;
+    for (size_t slot = 0; slot < 4 && offset < 0; slot++) {
+        off_t data_offset = slot * kSlotSize + LocalCache::kSlotHeaderSize + 100;
+        ASSERT_EQ(1, ::pread(fd, &ch, 1, data_offset));
+        if (ch == block_value(0)[100]) {
+            offset = data_offset;
+        }
+    }
+    ASSERT_GE(offset, 0);
+    ch = ~ch;
+    ASSERT_EQ(1, ::pwrite(fd, &ch, 1, offset));
+    ::close(fd);
+
+    LocalCache cache;
+    // the recovered block is verified on its first read even if checksum is disabled
+    CacheOptions options = cache_options(0, 4);
+    options.checksum = false;
+    ASSERT_OK(cache.init(options));
+    ASSERT_EQ(1, cache.disk_block_count());
+    char buf[16];
+    ASSERT_TRUE(cache.read_cache("key0", buf, 0, sizeof(buf)).status().is_not_found());
+    ASSERT_EQ(1, cache.corruption_count());
+    ASSERT_EQ(0, cache.disk_block_count());
+    ASSERT_OK(cache.shutdown());
+}
+
+} // namespace starrocks
@@ -239,6 +239,49 @@ TEST(DateValueTest, cast) {
     ASSERT_EQ("2004-03-31 00:00:00", v.to_string());
 }
 
+TEST(DateValueTest, fromString) {
+    int year, month, day, hour, minute, second, usec;
+    ASSERT_TRUE(date::from_string_to_date_internal("2023-11-29", &year, &month, &day));
+    ASSERT_EQ(2023, year);
+    ASSERT_EQ(11, month);
+    ASSERT_EQ(29, day);
+    // any non-digit separator
+    ASSERT_TRUE(date::from_string_to_date_internal("0001/02/03", &year, &month, &day));
+    ASSERT_EQ(1, year);
+    ASSERT_EQ(2, month);
+    ASSERT_EQ(3, day);
+    ASSERT_TRUE(date::from_string_to_date_internal("2024-02-29", &year, &month, &day));
+    ASSERT_FALSE(date::from_string_to_date_internal("2023-02-29", &year, &month, &day));
+    ASSERT_FALSE(date::from_string_to_date_internal("2023-13-01", &year, &month, &day));
+    ASSERT_FALSE(date::from_string_to_date_internal("2023-1a-01", &year, &month, &day));
+    ASSERT_FALSE(date::from_string_to_date_internal("2023011201", &year, &month, &day));
+
+    ASSERT_TRUE(date::from_string_to_datetime_internal("2023-11-29", "23:59:58", &year, &month, &day, &hour, &minute,
+                                                       &second, &usec));
+    ASSERT_EQ(2023, year);
+    ASSERT_EQ(11, month);
+    ASSERT_EQ(29, day);
+    ASSERT_EQ(23, hour);
+    ASSERT_EQ(59, minute);
+    ASSERT_EQ(58, second);
+    ASSERT_EQ(0, usec);
+    ASSERT_FALSE(date::from_string_to_datetime_internal("2023-11-29", "24:00:00", &year, &month, &day, &hour, &minute,
+                                                        &second, &usec));
+    ASSERT_FALSE(date::from_string_to_datetime_internal("2023-11-29", "12:60:00", &year, &month, &day, &hour, &minute,
+                                                        &second, &usec));
+    ASSERT_FALSE(date::from_string_to_datetime_internal("2023-11-29", "12:00:0x", &year, &month, &day, &hour, &minute,
+                                                        &second, &usec));
+    ASSERT_FALSE(date::from_string_to_datetime_internal("2023-11-29", "1200:001", &year, &month, &day, &hour, &minute,
+                                                        &second, &usec));
+
+    DateValue dv;
+    ASSERT_TRUE(dv.from_string(" 2023-11-29 ", 12));
+    ASSERT_EQ("2023-11-29", dv.to_string());
+    TimestampValue tv;
+    ASSERT_TRUE(tv.from_string("2023-11-29 01:02:03", 19));
+    ASSERT_EQ("2023-11-29 01:02:03", tv.to_string());
+}
+
 TEST(DateValueTest, weekday) {
     DateValue dv;
     dv.from_date(2020, 5, 31);
@@ -0,0 +1,91 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "exec/conjuncts_eval_context.h"
+
+#include <gtest/gtest.h>
+
+#include "common/config.h"
+
+namespace starrocks {
+
+// The conjuncts are only used as the keys of the order, they are never evaluated
+static ExprContext* fake_conjunct(uintptr_t id) {
+    return reinterpret_cast<ExprContext*>(id);
+}
+
+TEST(ConjunctsEvalContextTest, reorder_by_cost_and_selectivity) {
+    std::vector<ExprContext*> conjuncts = {fake_conjunct(8), fake_conjunct(16), fake_conjunct(24)};
+    ConjunctsEvalContext context;
+    bool sampling = false;
+    ASSERT_EQ(conjuncts, context.ordered_conjuncts(conjuncts, &sampling));
+    ASSERT_TRUE(sampling);
+
+    // #0: expensive and not selective, #1: cheap but not selective, #2: cheap and selective
+    context.update(0, 1000, 900, 100000);
+    context.update(1, 900, 810, 900);
+    context.update(2, 810, 81, 810);
+    context.reorder();
+    ASSERT_EQ(1, context.num_reorders());
+    std::vector<ExprContext*> expected = {fake_conjunct(24), fake_conjunct(16), fake_conjunct(8)};
+    ASSERT_EQ(expected, context.ordered_conjuncts(conjuncts, &sampling));
+    ASSERT_EQ(2, context.stats()[0].index);
+    ASSERT_DOUBLE_EQ(0.1, context.stats()[0].selectivity());
+    ASSERT_DOUBLE_EQ(1, context.stats()[0].cost_per_row());
+
+    // the order is kept if nothing changes
+    context.reorder();
+    ASSERT_EQ(1, context.num_reorders());
+    ASSERT_EQ("#2(selectivity=0.10, cost=1.00ns/row), #1(selectivity=0.90, cost=1.00ns/row), "
+              "#0(selectivity=0.90, cost=100.00ns/row)",
+              context.debug_string());
+
+    // the conjuncts are changed
+    conjuncts.pop_back();
+    ASSERT_EQ(conjuncts, context.ordered_conjuncts(conjuncts, &sampling));
+    ASSERT_TRUE(sampling);
+    ASSERT_EQ(2, context.stats().size());
+}
+
+TEST(ConjunctsEvalContextTest, resample_periodically) {
+    int32_t old_period = config::adaptive_conjuncts_order_sample_period;
+    config::adaptive_conjuncts_order_sample_period = 8;
+    std::vector<ExprContext*> conjuncts = {fake_conjunct(8), fake_conjunct(16)};
+    ConjunctsEvalContext context;
+    std::vector<int> sampled_chunks;
+    for (int i = 0; i < 20; i++) {
+        bool sampling = false;
+        context.ordered_conjuncts(conjuncts, &sampling);
+        if (sampling) {
+            sampled_chunks.push_back(i);
+        }
+    }
+    config::adaptive_conjuncts_order_sample_period = old_period;
+    ASSERT_EQ((std::vector<int>{0, 1, 2, 3, 8, 16}), sampled_chunks);
+
+    // #1 is more selective at first
+    context.update(0, 1000, 800, 1000);
+    context.update(1, 800, 80, 800);
+    context.reorder();
+    ASSERT_EQ(1, context.stats()[0].index);
+
+    // then #0 becomes more selective as the data changes, the statistics are updated in the current order
+    context.update(0, 1000, 990, 1000);
+    context.update(1, 990, 99, 990);
+    context.reorder();
+    ASSERT_EQ(0, context.stats()[0].index);
+    ASSERT_EQ(2, context.num_reorders());
+}
+
+} // namespace starrocks
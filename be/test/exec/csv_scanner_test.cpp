@@ -17,15 +17,21 @@
 #include <gtest/gtest.h>
 
 #include <iostream>
+#include <set>
 
 #include "column/chunk.h"
 #include "column/datum_tuple.h"
+#include "common/config.h"
+#include "connector/file_connector.h"
 #include "fs/fs_memory.h"
 #include "gen_cpp/Descriptors_types.h"
 #include "runtime/descriptor_helper.h"
 #include "runtime/descriptors.h"
 #include "runtime/mem_tracker.h"
 #include "runtime/runtime_state.h"
+#include "runtime/stream_load/stream_load_pipe.h"
+#include "testutil/assert.h"
+#include "util/defer_op.h"
 
 namespace starrocks {
 
@@ -869,6 +875,113 @@ TEST_P(CSVScannerTest, test_empty) {
     run_test(TYPE_DATETIME);
 }
 
+TEST_P(CSVScannerTest, test_parse_stream_blocks) {
+    std::vector<TypeDescriptor> types{TypeDescriptor(TYPE_INT), TypeDescriptor(TYPE_VARCHAR)};
+    types[1].len = 10;
+
+    std::vector<TBrokerRangeDesc> ranges;
+    TBrokerRangeDesc range;
+    range.__set_file_type(TFileType::FILE_STREAM);
+    range.__set_format_type(TFileFormatType::FORMAT_CSV_PLAIN);
+    range.__set_start_offset(0);
+    range.__set_num_of_columns_from_file(types.size());
+    ranges.push_back(range);
+
+    TBrokerScanRange scan_range;
+    scan_range.ranges = ranges;
+    EXPECT_TRUE(CSVScanner::is_splittable_stream_load(scan_range));
+    scan_range.params.__set_enclose('"');
+    EXPECT_FALSE(CSVScanner::is_splittable_stream_load(scan_range));
+    scan_range.params.__set_enclose(0);
+    scan_range.params.__set_multi_row_delimiter("\r\n");
+    EXPECT_FALSE(CSVScanner::is_splittable_stream_load(scan_range));
+    scan_range.params.__set_multi_row_delimiter("\n");
+    scan_range.ranges[0].__set_format_type(TFileFormatType::FORMAT_JSON);
+    EXPECT_FALSE(CSVScanner::is_splittable_stream_load(scan_range));
+
+    auto pipe = std::make_shared<StreamLoadPipe>();
+    std::string data;
+    for (int i = 0; i < 1000; i++) {
+        data += std::to_string(i) + "|v" + std::to_string(i % 10) + "\n";
+    }
+    ASSERT_OK(pipe->append(data.data(), data.size()));
+    ASSERT_OK(pipe->finish());
+    StreamLoadPipeSplitter splitter(pipe, '\n', /*block_size=*/100);
+
+    // two scanners take turns to parse the blocks of the same stream
+    std::vector<std::unique_ptr<CSVScanner>> scanners;
+    for (int i = 0; i < 2; i++) {
+        auto scanner = create_csv_scanner(types, ranges);
+        ASSERT_OK(scanner->open());
+        scanner->use_v2(_use_v2);
+        scanner->set_stream_splitter(&splitter);
+        scanners.emplace_back(std::move(scanner));
+    }
+    std::vector<bool> finished(scanners.size(), false);
+    size_t num_finished = 0;
+    int64_t num_rows = 0;
+    int64_t sum = 0;
+    std::set<int64_t> block_seqs;
+    while (num_finished < scanners.size()) {
+        for (size_t i = 0; i < scanners.size(); i++) {
+            if (finished[i]) {
+                continue;
+            }
+            auto res = scanners[i]->get_next();
+            if (res.status().is_end_of_file()) {
+                finished[i] = true;
+                num_finished++;
+                continue;
+            }
+            ASSERT_OK(res.status());
+            auto chunk = res.value();
+            for (size_t row = 0; row < chunk->num_rows(); row++) {
+                auto v = chunk->get(row)[0].get_int32();
+                sum += v;
+                EXPECT_EQ("v" + std::to_string(v % 10), chunk->get(row)[1].get_slice().to_string());
+            }
+            num_rows += chunk->num_rows();
+            if (scanners[i]->block_finished()) {
+                EXPECT_TRUE(block_seqs.insert(scanners[i]->current_block_seq()).second);
+            }
+        }
+    }
+    EXPECT_EQ(1000, num_rows);
+    EXPECT_EQ(999 * 1000 / 2, sum);
+    EXPECT_GT(block_seqs.size(), 1);
+    EXPECT_EQ(0, *block_seqs.begin());
+    EXPECT_EQ(static_cast<int64_t>(block_seqs.size()) - 1, *block_seqs.rbegin());
+}
+
+TEST_P(CSVScannerTest, test_stream_load_data_sources) {
+    auto parallelism = config::stream_load_parse_parallelism;
+    auto keep_order = config::stream_load_parse_keep_order;
+    DeferOp reset_config([&] {
+        config::stream_load_parse_parallelism = parallelism;
+        config::stream_load_parse_keep_order = keep_order;
+    });
+
+    std::vector<TScanRangeParams> scan_ranges(1);
+    TBrokerRangeDesc range;
+    range.__set_file_type(TFileType::FILE_STREAM);
+    range.__set_format_type(TFileFormatType::FORMAT_CSV_PLAIN);
+    scan_ranges[0].scan_range.broker_scan_range.ranges.push_back(range);
+
+    connector::FileDataSourceProvider provider(nullptr, TPlanNode());
+    config::stream_load_parse_parallelism = 4;
+    config::stream_load_parse_keep_order = true;
+    // the pipeline engine can't keep the order of the rows parsed by several data sources
+    EXPECT_EQ(1, provider.data_sources_per_scan_range(scan_ranges));
+    config::stream_load_parse_keep_order = false;
+    EXPECT_EQ(4, provider.data_sources_per_scan_range(scan_ranges));
+
+    scan_ranges.push_back(scan_ranges[0]);
+    EXPECT_EQ(1, provider.data_sources_per_scan_range(scan_ranges));
+    scan_ranges.pop_back();
+    scan_ranges[0].scan_range.broker_scan_range.ranges[0].__set_file_type(TFileType::FILE_LOCAL);
+    EXPECT_EQ(1, provider.data_sources_per_scan_range(scan_ranges));
+}
+
 INSTANTIATE_TEST_CASE_P(CSVScannerTestParams, CSVScannerTest, Values(true, false));
 
 } // namespace starrocks
@@ -39,7 +39,10 @@
 #include "runtime/descriptors.h"
 #include "runtime/exec_env.h"
 #include "runtime/runtime_state.h"
+#include "runtime/stream_load/load_stream_mgr.h"
+#include "runtime/stream_load/stream_load_pipe.h"
 #include "storage/storage_engine.h"
+#include "testutil/assert.h"
 #include "util/defer_op.h"
 #include "util/disk_info.h"
 #include "util/mem_info.h"
@@ -422,4 +425,71 @@ TEST_F(PipeLineFileScanNodeTest, CSVBasic) {
 
     ASSERT_COUNTER_CHUNK_ROW_NUM(sinkCounter, 3, 0);
 }
+
+TEST_F(PipeLineFileScanNodeTest, CSVStreamLoadInParallel) {
+    auto parallelism = config::stream_load_parse_parallelism;
+    auto keep_order = config::stream_load_parse_keep_order;
+    auto block_size = config::stream_load_parse_block_size;
+    DeferOp reset_config([&] {
+        config::stream_load_parse_parallelism = parallelism;
+        config::stream_load_parse_keep_order = keep_order;
+        config::stream_load_parse_block_size = block_size;
+    });
+    // the pipeline engine only parses a stream load in parallel if the order of the rows needn't be kept
+    config::stream_load_parse_parallelism = 4;
+    config::stream_load_parse_keep_order = false;
+    config::stream_load_parse_block_size = 1024;
+
+    std::vector<TypeDescriptor> types;
+    types.emplace_back(TYPE_INT);
+    types.emplace_back(TYPE_VARCHAR);
+    types[1].len = 10;
+
+    TUniqueId load_id;
+    load_id.__set_hi(1234);
+    load_id.__set_lo(5678);
+    auto pipe = std::make_shared<StreamLoadPipe>();
+    ASSERT_OK(_exec_env->load_stream_mgr()->put(load_id, pipe));
+    DeferOp remove_pipe([&] { _exec_env->load_stream_mgr()->remove(load_id); });
+    const int num_rows = 10000;
+    std::string data;
+    for (int i = 0; i < num_rows; i++) {
+        data += std::to_string(i) + "|v" + std::to_string(i % 10) + "\n";
+    }
+    ASSERT_OK(pipe->append(data.data(), data.size()));
+    ASSERT_OK(pipe->finish());
+
+    auto tnode = _create_tplan_node();
+    auto* descs = _create_table_desc(types);
+    auto file_scan_node = std::make_shared<starrocks::ConnectorScanNode>(_pool, *tnode, *descs);
+
+    Status status = file_scan_node->init(*tnode, _runtime_state);
+    ASSERT_TRUE(status.ok());
+
+    auto scan_ranges = _create_csv_scan_ranges(types);
+    auto& range = scan_ranges[0].scan_range.broker_scan_range.ranges[0];
+    range.__set_file_type(TFileType::FILE_STREAM);
+    range.__set_format_type(TFileFormatType::FORMAT_CSV_PLAIN);
+    range.__set_load_id(load_id);
+    generate_morse_queue({file_scan_node.get()}, scan_ranges);
+    // every morsel reads the same stream load
+    ASSERT_EQ(4, _fragment_ctx->morsel_queue_factories()[file_scan_node->id()]->num_original_morsels());
+
+    starrocks::pipeline::CounterPtr sinkCounter = std::make_shared<starrocks::pipeline::FileScanCounter>();
+
+    OpFactories op_factories = file_scan_node->decompose_to_pipeline(_context);
+
+    op_factories.push_back(std::make_shared<starrocks::pipeline::TestFileScanSinkOperatorFactory>(
+            _context->next_operator_id(), 0, sinkCounter));
+
+    _pipelines.push_back(std::make_shared<starrocks::pipeline::Pipeline>(_context->next_pipe_id(), op_factories));
+
+    prepare_pipeline();
+
+    execute_pipeline();
+
+    ASSERT_EQ(std::future_status::ready, _fragment_future.wait_for(std::chrono::seconds(15)));
+
+    ASSERT_COUNTER_CHUNK_ROW_NUM(sinkCounter, num_rows, 0);
+}
 } // namespace starrocks::pipeline
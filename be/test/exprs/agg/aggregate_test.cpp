@@ -889,6 +889,78 @@ TEST_F(AggregateTest, test_count_distinct) {
     test_agg_function<DateValue, int64_t>(ctx, func, 20, 21, 40);
 }
 
+TEST_F(AggregateTest, test_count_distinct_v3) {
+    const AggregateFunction* func = get_aggregate_function("multi_distinct_count", TYPE_SMALLINT, TYPE_BIGINT, false,
+                                                           TFunctionBinaryType::BUILTIN, 5);
+    ASSERT_EQ("count-distinct", func->get_name());
+    test_agg_function<int16_t, int64_t>(ctx, func, 1024, 1000, 2024);
+
+    func = get_aggregate_function("multi_distinct_count", TYPE_INT, TYPE_BIGINT, false, TFunctionBinaryType::BUILTIN,
+                                  5);
+    test_agg_function<int32_t, int64_t>(ctx, func, 1024, 1000, 2024);
+
+    func = get_aggregate_function("multi_distinct_count", TYPE_DOUBLE, TYPE_BIGINT, false,
+                                  TFunctionBinaryType::BUILTIN, 5);
+    test_agg_function<double, int64_t>(ctx, func, 1024, 1000, 2024);
+
+    func = get_aggregate_function("multi_distinct_count", TYPE_VARCHAR, TYPE_BIGINT, false,
+                                  TFunctionBinaryType::BUILTIN, 5);
+    test_agg_function<Slice, int64_t>(ctx, func, 3, 3, 6);
+
+    // the dense keys are converted to a bitmap, and the sparse ones are kept in a hash set
+    func = get_aggregate_function("multi_distinct_count", TYPE_BIGINT, TYPE_BIGINT, false,
+                                  TFunctionBinaryType::BUILTIN, 5);
+    auto dense_column = Int64Column::create();
+    for (int64_t i = -50000; i < 50000; i++) {
+        dense_column->append(i);
+        dense_column->append(i);
+    }
+    auto sparse_column = Int64Column::create();
+    for (int64_t i = 0; i < 20000; i++) {
+        sparse_column->append(i * 1000003);
+    }
+    auto update = [&](const ColumnPtr& column) {
+        auto state = ManagedAggrState::create(ctx, func);
+        const Column* row_column = column.get();
+        func->update_batch_single_state(ctx, row_column->size(), &row_column, state->state());
+        return state;
+    };
+    auto count = [&](AggDataPtr state) {
+        auto result_column = Int64Column::create();
+        func->finalize_to_column(ctx, state, result_column.get());
+        return result_column->get_data()[0];
+    };
+    auto dense_state = update(dense_column);
+    size_t dense_mem_usage = ctx->mem_usage();
+    // the keys added after the conversion to a bitmap are counted too
+    auto more_dense_column = Int64Column::create();
+    for (int64_t i = 50000; i < 1000000; i++) {
+        more_dense_column->append(i);
+    }
+    const Column* more_dense_row_column = more_dense_column.get();
+    func->update_batch_single_state(ctx, more_dense_column->size(), &more_dense_row_column, dense_state->state());
+    ASSERT_GT(ctx->mem_usage(), dense_mem_usage);
+    ASSERT_EQ(1050000, count(dense_state->state()));
+    dense_state = update(dense_column);
+    auto sparse_state = update(sparse_column);
+    ASSERT_EQ(100000, count(dense_state->state()));
+    ASSERT_EQ(20000, count(sparse_state->state()));
+
+    auto serde_column = BinaryColumn::create();
+    func->serialize_to_column(ctx, dense_state->state(), serde_column.get());
+    func->serialize_to_column(ctx, sparse_state->state(), serde_column.get());
+    // a dense bitmap takes less than a byte per key
+    ASSERT_LT(serde_column->get_slice(0).size, 100000u);
+    // 0 is the only key in both states
+    auto merged_state = update(dense_column);
+    func->merge(ctx, serde_column.get(), merged_state->state(), 1);
+    ASSERT_EQ(100000 + 20000 - 1, count(merged_state->state()));
+    merged_state = update(sparse_column);
+    func->merge(ctx, serde_column.get(), merged_state->state(), 0);
+    func->merge(ctx, serde_column.get(), merged_state->state(), 0);
+    ASSERT_EQ(100000 + 20000 - 1, count(merged_state->state()));
+}
+
 TEST_F(AggregateTest, test_sum_distinct) {
     const AggregateFunction* func = get_aggregate_function("multi_distinct_sum", TYPE_SMALLINT, TYPE_BIGINT, false);
     test_agg_function<int16_t, int64_t>(ctx, func, 523776, 2499500, 3023276);
@@ -1356,6 +1428,52 @@ TEST_F(AggregateTest, test_bitmap_intersect) {
     ASSERT_EQ("1", result_column->get_pool()[0].to_string());
 }
 
+TEST_F(AggregateTest, test_bitmap_union_count_batch) {
+    const AggregateFunction* func = get_aggregate_function("bitmap_union_count", TYPE_OBJECT, TYPE_BIGINT, false);
+    auto state1 = ManagedAggrState::create(ctx, func);
+    auto state2 = ManagedAggrState::create(ctx, func);
+
+    // the rows of the two states are interleaved, {0..99}, {0, 2..198} and bitmaps of 1000 values
+    auto data_column = BitmapColumn::create();
+    std::vector<AggDataPtr> states;
+    for (uint64_t i = 0; i < 100; i++) {
+        BitmapValue b1(i);
+        data_column->append(&b1);
+        states.push_back(state1->state());
+        BitmapValue b2(i * 2);
+        data_column->append(&b2);
+        states.push_back(state2->state());
+    }
+    for (uint64_t i = 0; i < 10; i++) {
+        BitmapValue b;
+        for (uint64_t j = 0; j < 1000; j++) {
+            b.add(i * 500 + j);
+        }
+        data_column->append(&b);
+        states.push_back(i % 2 == 0 ? state1->state() : state2->state());
+    }
+    const Column* row_column = data_column.get();
+    func->update_batch(ctx, data_column->size(), 0, &row_column, states.data());
+
+    auto count = [&](AggDataPtr state) {
+        auto result_column = Int64Column::create();
+        func->finalize_to_column(ctx, state, result_column.get());
+        return result_column->get_data()[0];
+    };
+    // state1: [0, 1000), [1000, 2000), ..., [4000, 5000)
+    ASSERT_EQ(5000, count(state1->state()));
+    // state2: [500, 5500) and the even numbers less than 200
+    ASSERT_EQ(5000 + 100, count(state2->state()));
+
+    // merge both into a single state
+    auto serde_column = BitmapColumn::create();
+    func->serialize_to_column(ctx, state1->state(), serde_column.get());
+    func->serialize_to_column(ctx, state2->state(), serde_column.get());
+    auto merged_state = ManagedAggrState::create(ctx, func);
+    func->merge_batch_single_state(ctx, merged_state->state(), serde_column.get(), 0, serde_column->size());
+    ASSERT_EQ(5500, count(merged_state->state()));
+}
+
 template <typename T>
 ColumnPtr gen_histogram_column() {
     using DataColumn = typename ColumnTraits<T>::ColumnType;
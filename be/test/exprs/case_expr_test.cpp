@@ -565,4 +565,60 @@ TEST_F(VectorizedCaseExprTest, NoCaseWhenNullReturnIntElse) {
     }
 }
 
+TEST_F(VectorizedCaseExprTest, whenNoCaseEvaluateSelectively) {
+    expr_node.case_expr.has_case_expr = false;
+    expr_node.case_expr.has_else_expr = true;
+    std::unique_ptr<Expr> expr(VectorizedCaseExprFactory::from_thrift(expr_node));
+
+    auto when1_column = BooleanColumn::create();
+    when1_column->append_numbers(std::vector<uint8_t>{1, 0, 0, 1, 0, 0}.data(), 6);
+    auto when2_column = BooleanColumn::create();
+    when2_column->append_numbers(std::vector<uint8_t>{0, 1, 0, 0, 1, 0}.data(), 6);
+    MockSelectiveExpr when1(expr_node, when1_column);
+    MockSelectiveExpr then1(expr_node, Int64Column::create(6, 10));
+    MockSelectiveExpr when2(expr_node, when2_column);
+    MockSelectiveExpr then2(expr_node, Int64Column::create(6, 20));
+    MockSelectiveExpr else_expr(expr_node, Int64Column::create(6, 30));
+
+    expr->_children.push_back(&when1);
+    expr->_children.push_back(&then1);
+    expr->_children.push_back(&when2);
+    expr->_children.push_back(&then2);
+    expr->_children.push_back(&else_expr);
+
+    // each WHEN is only evaluated on the rows not matched yet, each THEN on the rows matching its WHEN and
+    // ELSE on the rows matching none
+    {
+        std::vector<uint8_t> filter{1, 1, 1, 1, 1, 0};
+        ColumnPtr ptr = expr->evaluate_with_filter(nullptr, nullptr, filter.data()).value();
+        ASSERT_EQ((std::vector<uint8_t>{1, 1, 1, 1, 1, 0}), when1.selection());
+        ASSERT_EQ((std::vector<uint8_t>{1, 0, 0, 1, 0, 0}), then1.selection());
+        ASSERT_EQ((std::vector<uint8_t>{0, 1, 1, 0, 1, 0}), when2.selection());
+        ASSERT_EQ((std::vector<uint8_t>{0, 1, 0, 0, 1, 0}), then2.selection());
+        ASSERT_EQ((std::vector<uint8_t>{0, 0, 1, 0, 0, 0}), else_expr.selection());
+
+        ColumnViewer<TYPE_BIGINT> viewer(ptr);
+        std::vector<int64_t> expected{10, 20, 30, 10, 20};
+        for (int j = 0; j < expected.size(); ++j) {
+            ASSERT_FALSE(viewer.is_null(j));
+            ASSERT_EQ(expected[j], viewer.value(j));
+        }
+    }
+
+    // ELSE isn't evaluated if all the rows selected match some WHEN
+    {
+        std::vector<uint8_t> filter{1, 1, 0, 1, 1, 0};
+        ColumnPtr ptr = expr->evaluate_with_filter(nullptr, nullptr, filter.data()).value();
+        ASSERT_EQ(1, else_expr.num_evaluations());
+
+        ColumnViewer<TYPE_BIGINT> viewer(ptr);
+        std::vector<int64_t> expected{10, 20, 0, 10, 20};
+        for (int j = 0; j < expected.size(); ++j) {
+            if (filter[j]) {
+                ASSERT_EQ(expected[j], viewer.value(j));
+            }
+        }
+    }
+}
+
 } // namespace starrocks
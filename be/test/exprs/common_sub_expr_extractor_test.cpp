@@ -0,0 +1,179 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "exprs/common_sub_expr_extractor.h"
+
+#include <gtest/gtest.h>
+
+#include "column/column_helper.h"
+#include "common/object_pool.h"
+#include "exprs/arithmetic_expr.h"
+#include "exprs/column_ref.h"
+#include "exprs/expr_context.h"
+#include "exprs/function_call_expr.h"
+#include "exprs/literal.h"
+#include "testutil/assert.h"
+
+namespace starrocks {
+
+class CommonSubExprExtractorTest : public ::testing::Test {
+protected:
+    Expr* slot_ref(SlotId slot_id) { return _pool.add(new ColumnRef(TypeDescriptor(TYPE_BIGINT), slot_id)); }
+
+    Expr* literal(int64_t value) {
+        return _pool.add(new VectorizedLiteral(ColumnHelper::create_const_column<TYPE_BIGINT>(value, 1),
+                                               TypeDescriptor(TYPE_BIGINT)));
+    }
+
+    Expr* double_literal(double value) {
+        return _pool.add(new VectorizedLiteral(ColumnHelper::create_const_column<TYPE_DOUBLE>(value, 1),
+                                               TypeDescriptor(TYPE_DOUBLE)));
+    }
+
+    Expr* function(int64_t fid, Expr* child, TFunctionBinaryType::type binary_type = TFunctionBinaryType::BUILTIN) {
+        TFunctionName fn_name;
+        fn_name.__set_function_name("fn");
+        TFunction fn;
+        fn.__set_name(fn_name);
+        fn.__set_binary_type(binary_type);
+        fn.__set_fid(fid);
+        TExprNode node;
+        node.node_type = TExprNodeType::FUNCTION_CALL;
+        node.type = gen_type_desc(TPrimitiveType::BIGINT);
+        node.__set_fn(fn);
+        Expr* expr = _pool.add(new VectorizedFunctionCallExpr(node));
+        expr->add_child(child);
+        return expr;
+    }
+
+    Expr* arithmetic(TExprOpcode::type opcode, Expr* left, Expr* right) {
+        TExprNode node;
+        node.node_type = TExprNodeType::ARITHMETIC_EXPR;
+        node.type = gen_type_desc(TPrimitiveType::BIGINT);
+        node.__set_opcode(opcode);
+        node.__set_child_type(TPrimitiveType::BIGINT);
+        Expr* expr = _pool.add(VectorizedArithmeticExprFactory::from_thrift(node));
+        expr->add_child(left);
+        expr->add_child(right);
+        return expr;
+    }
+
+    ExprContext* context(Expr* root) { return _pool.add(new ExprContext(root)); }
+
+    static SlotId slot_id_of(Expr* expr) {
+        auto* ref = dynamic_cast<ColumnRef*>(expr);
+        return ref == nullptr ? -1 : ref->slot_id();
+    }
+
+    ObjectPool _pool;
+};
+
+// fn(x) + 1, fn(x) * 2
+TEST_F(CommonSubExprExtractorTest, extract_identical_sub_trees) {
+    std::vector<ExprContext*> expr_ctxs = {
+            context(arithmetic(TExprOpcode::ADD, function(10001, slot_ref(1)), literal(1))),
+            context(arithmetic(TExprOpcode::MULTIPLY, function(10001, slot_ref(1)), literal(2)))};
+    auto original_ctxs = expr_ctxs;
+    std::vector<SlotId> common_sub_slot_ids;
+    std::vector<ExprContext*> common_sub_expr_ctxs;
+    ASSERT_OK(extract_common_sub_exprs(&_pool, 100, &expr_ctxs, &common_sub_slot_ids, &common_sub_expr_ctxs));
+
+    ASSERT_EQ(1, common_sub_expr_ctxs.size());
+    ASSERT_EQ(std::vector<SlotId>{100}, common_sub_slot_ids);
+    Expr* common = common_sub_expr_ctxs[0]->root();
+    ASSERT_EQ(TExprNodeType::FUNCTION_CALL, common->node_type());
+    ASSERT_EQ(1, slot_id_of(common->get_child(0)));
+    for (size_t i = 0; i < expr_ctxs.size(); i++) {
+        ASSERT_NE(original_ctxs[i], expr_ctxs[i]);
+        ASSERT_EQ(100, slot_id_of(expr_ctxs[i]->root()->get_child(0)));
+        // the original exprs are left unchanged
+        ASSERT_EQ(TExprNodeType::FUNCTION_CALL, original_ctxs[i]->root()->get_child(0)->node_type());
+    }
+}
+
+// fn(x), fn(x) + 1
+TEST_F(CommonSubExprExtractorTest, extract_identical_root) {
+    std::vector<ExprContext*> expr_ctxs = {
+            context(function(10001, slot_ref(1))),
+            context(arithmetic(TExprOpcode::ADD, function(10001, slot_ref(1)), literal(1)))};
+    std::vector<SlotId> common_sub_slot_ids;
+    std::vector<ExprContext*> common_sub_expr_ctxs;
+    ASSERT_OK(extract_common_sub_exprs(&_pool, 100, &expr_ctxs, &common_sub_slot_ids, &common_sub_expr_ctxs));
+
+    ASSERT_EQ(1, common_sub_expr_ctxs.size());
+    ASSERT_EQ(std::vector<SlotId>{100}, common_sub_slot_ids);
+    ASSERT_EQ(TExprNodeType::FUNCTION_CALL, common_sub_expr_ctxs[0]->root()->node_type());
+    ASSERT_EQ(100, slot_id_of(expr_ctxs[0]->root()));
+    ASSERT_EQ(100, slot_id_of(expr_ctxs[1]->root()->get_child(0)));
+}
+
+// fn(x) + 1, fn(y) + 1, rand(x) + 1, rand(x) + 2
+TEST_F(CommonSubExprExtractorTest, no_identical_sub_trees) {
+    std::vector<ExprContext*> expr_ctxs = {
+            context(arithmetic(TExprOpcode::ADD, function(10001, slot_ref(1)), literal(1))),
+            context(arithmetic(TExprOpcode::ADD, function(10001, slot_ref(2)), literal(1))),
+            context(arithmetic(TExprOpcode::ADD, function(10300, slot_ref(1)), literal(1))),
+            context(arithmetic(TExprOpcode::ADD, function(10300, slot_ref(1)), literal(2)))};
+    auto original_ctxs = expr_ctxs;
+    std::vector<SlotId> common_sub_slot_ids;
+    std::vector<ExprContext*> common_sub_expr_ctxs;
+    ASSERT_OK(extract_common_sub_exprs(&_pool, 100, &expr_ctxs, &common_sub_slot_ids, &common_sub_expr_ctxs));
+
+    ASSERT_TRUE(common_sub_expr_ctxs.empty());
+    ASSERT_EQ(original_ctxs, expr_ctxs);
+}
+
+// fn(x * 0.1234561) + 1, fn(x * 0.1234562) + 2, udf(x) + 1, udf(x) + 2
+TEST_F(CommonSubExprExtractorTest, no_identical_literals_or_udfs) {
+    // the literals only differ after the 6th significant digit
+    Expr* product1 = arithmetic(TExprOpcode::MULTIPLY, slot_ref(1), double_literal(0.1234561));
+    Expr* product2 = arithmetic(TExprOpcode::MULTIPLY, slot_ref(1), double_literal(0.1234562));
+    std::vector<ExprContext*> expr_ctxs = {
+            context(arithmetic(TExprOpcode::ADD, function(10001, product1), literal(1))),
+            context(arithmetic(TExprOpcode::ADD, function(10001, product2), literal(2))),
+            context(arithmetic(TExprOpcode::ADD, function(50001, slot_ref(1), TFunctionBinaryType::SRJAR), literal(1))),
+            context(arithmetic(TExprOpcode::ADD, function(50001, slot_ref(1), TFunctionBinaryType::SRJAR),
+                               literal(2)))};
+    auto original_ctxs = expr_ctxs;
+    std::vector<SlotId> common_sub_slot_ids;
+    std::vector<ExprContext*> common_sub_expr_ctxs;
+    ASSERT_OK(extract_common_sub_exprs(&_pool, 100, &expr_ctxs, &common_sub_slot_ids, &common_sub_expr_ctxs));
+
+    ASSERT_TRUE(common_sub_expr_ctxs.empty());
+    ASSERT_EQ(original_ctxs, expr_ctxs);
+}
+
+// common sub-expression 50: g(f(x)) + 3
+// exprs: g(f(x)) + 1, f(x) - 2
+TEST_F(CommonSubExprExtractorTest, extract_nested_sub_trees) {
+    std::vector<SlotId> common_sub_slot_ids = {50};
+    std::vector<ExprContext*> common_sub_expr_ctxs = {
+            context(arithmetic(TExprOpcode::ADD, function(10002, function(10001, slot_ref(1))), literal(3)))};
+    std::vector<ExprContext*> expr_ctxs = {
+            context(arithmetic(TExprOpcode::ADD, function(10002, function(10001, slot_ref(1))), literal(1))),
+            context(arithmetic(TExprOpcode::SUBTRACT, function(10001, slot_ref(1)), slot_ref(50)))};
+    ASSERT_OK(extract_common_sub_exprs(&_pool, 10, &expr_ctxs, &common_sub_slot_ids, &common_sub_expr_ctxs));
+
+    // g(f(x)) is extracted first, then f(x) from it, and both are evaluated before the one using them
+    ASSERT_EQ((std::vector<SlotId>{52, 51, 50}), common_sub_slot_ids);
+    ASSERT_EQ(3, common_sub_expr_ctxs.size());
+    ASSERT_EQ(1, slot_id_of(common_sub_expr_ctxs[0]->root()->get_child(0)));
+    ASSERT_EQ(52, slot_id_of(common_sub_expr_ctxs[1]->root()->get_child(0)));
+    ASSERT_EQ(51, slot_id_of(common_sub_expr_ctxs[2]->root()->get_child(0)));
+    ASSERT_EQ(51, slot_id_of(expr_ctxs[0]->root()->get_child(0)));
+    ASSERT_EQ(52, slot_id_of(expr_ctxs[1]->root()->get_child(0)));
+    ASSERT_EQ(50, slot_id_of(expr_ctxs[1]->root()->get_child(1)));
+}
+
+} // namespace starrocks
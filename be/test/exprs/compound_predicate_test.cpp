@@ -397,4 +397,42 @@ TEST_F(VectorizedCompoundPredicateTest, testOnlyNullAndZeroRow) {
     }
 }
 
+TEST_F(VectorizedCompoundPredicateTest, andExprWithFilter) {
+    expr_node.opcode = TExprOpcode::COMPOUND_AND;
+    std::unique_ptr<Expr> expr(VectorizedCompoundPredicateFactory::from_thrift(expr_node));
+
+    auto left = BooleanColumn::create();
+    left->append_numbers(std::vector<uint8_t>{1, 0, 1, 0, 1}.data(), 5);
+    auto right = BooleanColumn::create();
+    right->append_numbers(std::vector<uint8_t>{1, 1, 1, 0, 0}.data(), 5);
+    MockSelectiveExpr col1(expr_node, left);
+    MockSelectiveExpr col2(expr_node, right);
+
+    expr->_children.push_back(&col1);
+    expr->_children.push_back(&col2);
+
+    // the right is only evaluated on the rows selected where the left isn't false
+    {
+        std::vector<uint8_t> filter{1, 1, 0, 1, 1};
+        ColumnPtr ptr = expr->evaluate_with_filter(nullptr, nullptr, filter.data()).value();
+        ASSERT_EQ(5, ptr->size());
+        ASSERT_EQ((std::vector<uint8_t>{1, 1, 0, 1, 1}), col1.selection());
+        ASSERT_EQ((std::vector<uint8_t>{1, 0, 0, 0, 1}), col2.selection());
+
+        auto v = std::static_pointer_cast<BooleanColumn>(ptr);
+        ASSERT_EQ(1, v->get_data()[0]);
+        ASSERT_EQ(0, v->get_data()[1]);
+        ASSERT_EQ(0, v->get_data()[3]);
+        ASSERT_EQ(0, v->get_data()[4]);
+    }
+
+    // the right isn't evaluated if the left is false on all the rows selected
+    {
+        std::vector<uint8_t> filter{0, 1, 0, 1, 0};
+        ColumnPtr ptr = expr->evaluate_with_filter(nullptr, nullptr, filter.data()).value();
+        ASSERT_EQ(5, ptr->size());
+        ASSERT_EQ(1, col2.num_evaluations());
+    }
+}
+
 } // namespace starrocks
@@ -20,7 +20,9 @@
 #include <cmath>
 
 #include "butil/time.h"
+#include "column/chunk.h"
 #include "column/column_helper.h"
+#include "column/column_viewer.h"
 #include "column/fixed_length_column.h"
 #include "exprs/cast_expr.h"
 #include "exprs/mock_vectorized_expr.h"
@@ -280,4 +282,86 @@ TEST_F(VectorizedFunctionCallExprTest, prepareFaileCase) {
     exprContext.close(nullptr);
 }
 
+TEST_F(VectorizedFunctionCallExprTest, evaluateSelectedRows) {
+    TFunction function;
+    TFunctionName functionName;
+    functionName.__set_db_name("db");
+    functionName.__set_function_name("mod");
+
+    function.__set_name(functionName);
+    function.__set_binary_type(TFunctionBinaryType::BUILTIN);
+
+    std::vector<TTypeDesc> vec;
+    function.__set_arg_types(vec);
+    function.__set_has_var_args(false);
+    function.__set_fid(10252);
+
+    expr_node.__set_fn(function);
+
+    VectorizedFunctionCallExpr expr(expr_node);
+
+    // the divisors are 0, which makes the result null, except on the rows 0, 3 and 9
+    auto dividends = Int32Column::create();
+    auto divisors = Int32Column::create();
+    for (int32_t i = 0; i < 10; i++) {
+        dividends->append(i);
+        divisors->append(i == 0 || i == 3 || i == 9 ? 4 : 0);
+    }
+    MockSelectiveExpr col1(expr_node, dividends);
+    MockSelectiveExpr col2(expr_node, divisors);
+
+    expr.add_child(&col1);
+    expr.add_child(&col2);
+
+    ExprContext exprContext(&expr);
+    std::vector<ExprContext*> expr_ctxs = {&exprContext};
+
+    ASSERT_OK(Expr::prepare(expr_ctxs, &_runtime_state));
+    ASSERT_OK(Expr::open(expr_ctxs, &_runtime_state));
+
+    auto chunk = std::make_shared<Chunk>();
+    chunk->append_column(Int32Column::create(10, 0), 1);
+
+    // few rows are selected, the arguments are compacted to them and the results are expanded back
+    {
+        std::vector<uint8_t> filter{1, 0, 0, 1, 0, 0, 0, 0, 0, 1};
+        ASSIGN_OR_ABORT(ColumnPtr result, exprContext.evaluate(&expr, chunk.get(), filter.data()));
+        ASSERT_EQ(filter, col1.selection());
+        ASSERT_EQ(filter, col2.selection());
+        ASSERT_EQ(10, result->size());
+
+        ColumnViewer<TYPE_INT> viewer(result);
+        // the rows not selected take the result of a selected row, so none of them is evaluated
+        for (int j = 0; j < result->size(); ++j) {
+            ASSERT_FALSE(viewer.is_null(j));
+        }
+        ASSERT_EQ(0, viewer.value(0));
+        ASSERT_EQ(3, viewer.value(3));
+        ASSERT_EQ(1, viewer.value(9));
+    }
+
+    // most rows are selected, the function is evaluated on all the rows
+    {
+        std::vector<uint8_t> filter{1, 1, 1, 1, 1, 1, 0, 0, 0, 1};
+        ASSIGN_OR_ABORT(ColumnPtr result, exprContext.evaluate(&expr, chunk.get(), filter.data()));
+        ASSERT_EQ(10, result->size());
+
+        ColumnViewer<TYPE_INT> viewer(result);
+        ASSERT_TRUE(viewer.is_null(7));
+        ASSERT_EQ(3, viewer.value(3));
+        ASSERT_EQ(1, viewer.value(9));
+    }
+
+    // no row is selected, the arguments aren't evaluated
+    {
+        std::vector<uint8_t> filter(10, 0);
+        ASSIGN_OR_ABORT(ColumnPtr result, exprContext.evaluate(&expr, chunk.get(), filter.data()));
+        ASSERT_EQ(10, result->size());
+        ASSERT_TRUE(result->only_null());
+        ASSERT_EQ(2, col1.num_evaluations());
+    }
+
+    Expr::close(expr_ctxs, &_runtime_state);
+}
+
 } // namespace starrocks
@@ -111,4 +111,30 @@ TEST_F(VectorizedIfExprTest, ifNull) {
     }
 }
 
+TEST_F(VectorizedIfExprTest, ifEvaluateBranchesSelectively) {
+    auto expr = VectorizedConditionExprFactory::create_if_expr(expr_node);
+    std::unique_ptr<Expr> expr_ptr(expr);
+
+    auto cond = BooleanColumn::create();
+    cond->append_numbers(std::vector<uint8_t>{1, 0, 1, 0}.data(), 4);
+    MockSelectiveExpr bol(expr_node, cond);
+    MockSelectiveExpr col1(expr_node, Int64Column::create(4, 10));
+    MockSelectiveExpr col2(expr_node, Int64Column::create(4, 20));
+
+    expr->_children.push_back(&bol);
+    expr->_children.push_back(&col1);
+    expr->_children.push_back(&col2);
+    {
+        ColumnPtr ptr = expr->evaluate(nullptr, nullptr);
+        ASSERT_EQ((std::vector<uint8_t>{1, 0, 1, 0}), col1.selection());
+        ASSERT_EQ((std::vector<uint8_t>{0, 1, 0, 1}), col2.selection());
+
+        auto v = ColumnHelper::cast_to_raw<TYPE_BIGINT>(ptr);
+        ASSERT_EQ(4, v->size());
+        for (int j = 0; j < v->size(); ++j) {
+            ASSERT_EQ(j % 2 == 0 ? 10 : 20, v->get_data()[j]);
+        }
+    }
+}
+
 } // namespace starrocks
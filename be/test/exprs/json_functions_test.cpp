@@ -22,6 +22,9 @@
 #include <string>
 
 #include "butil/time.h"
+#include "column/column_builder.h"
+#include "column/json_column.h"
+#include "column/nullable_column.h"
 #include "column/vectorized_fwd.h"
 #include "common/status.h"
 #include "common/statusor.h"
@@ -328,6 +331,77 @@ TEST_F(JsonFunctionsTest, json_float_double) {
     ASSERT_EQ("1.2", json_str.value());
 }
 
+TEST_F(JsonFunctionsTest, json_query_flat_column) {
+    std::string values[] = {R"({"k1": 1, "k2": 1.5, "k3": "a"})", R"({"k2": 2.5, "k4": [1]})",
+                            R"({"k1": 3, "k3": "c"})", R"({"k1": 4, "k2": 4.5, "k3": "d"})"};
+    auto json_column = JsonColumn::create();
+    for (const auto& value : values) {
+        ASSIGN_OR_ABORT(auto json, JsonValue::parse(value));
+        json_column->append(std::move(json));
+    }
+    ColumnPtr plain_column = json_column->clone();
+
+    auto k1 = NullableColumn::create(Int64Column::create(), NullColumn::create());
+    auto k2 = NullableColumn::create(DoubleColumn::create(), NullColumn::create());
+    auto k3 = NullableColumn::create(BinaryColumn::create(), NullColumn::create());
+    k1->append_datum(Datum(int64_t(1)));
+    k1->append_nulls(1);
+    k1->append_datum(Datum(int64_t(3)));
+    k1->append_datum(Datum(int64_t(4)));
+    k2->append_datum(Datum(1.5));
+    k2->append_datum(Datum(2.5));
+    k2->append_nulls(1);
+    k2->append_datum(Datum(4.5));
+    k3->append_datum(Datum(Slice("a")));
+    k3->append_nulls(1);
+    k3->append_datum(Datum(Slice("c")));
+    k3->append_datum(Datum(Slice("d")));
+    json_column->set_flat_column("k1", TYPE_BIGINT, k1);
+    json_column->set_flat_column("k2", TYPE_DOUBLE, k2);
+    json_column->set_flat_column("k3", TYPE_VARCHAR, k3);
+
+    using JsonFunction = StatusOr<ColumnPtr> (*)(FunctionContext*, const Columns&);
+    std::vector<JsonFunction> functions{JsonFunctions::json_query, JsonFunctions::get_native_json_int,
+                                        JsonFunctions::get_native_json_double, JsonFunctions::get_native_json_string};
+    std::vector<std::string> paths{"$.k1", "$.k2", "$.k3", "k1", "$.k4", "$.k4[0]", "$"};
+    auto check_same_results = [&]() {
+        for (const auto& path : paths) {
+            for (auto function : functions) {
+                std::unique_ptr<FunctionContext> ctx(FunctionContext::create_test_context());
+                ColumnBuilder<TYPE_VARCHAR> builder(1);
+                builder.append(path);
+                ColumnPtr path_column = builder.build(true);
+                Columns flat_columns{json_column, path_column};
+                ctx->set_constant_columns(flat_columns);
+                ASSERT_OK(JsonFunctions::native_json_path_prepare(ctx.get(),
+                                                                  FunctionContext::FunctionStateScope::FRAGMENT_LOCAL));
+                ASSIGN_OR_ABORT(auto expected, function(ctx.get(), Columns{plain_column, path_column}));
+                ASSIGN_OR_ABORT(auto actual, function(ctx.get(), flat_columns));
+                ASSERT_EQ(expected->size(), actual->size());
+                for (size_t i = 0; i < expected->size(); i++) {
+                    ASSERT_EQ(expected->debug_item(i), actual->debug_item(i)) << path << " row " << i;
+                }
+                ASSERT_OK(JsonFunctions::native_json_path_close(ctx.get(),
+                                                                FunctionContext::FunctionStateScope::FRAGMENT_LOCAL));
+            }
+        }
+    };
+    check_same_results();
+
+    // the flat columns are filtered along with the JSON values
+    Filter filter{1, 0, 1, 1};
+    json_column->filter(filter);
+    plain_column->filter(filter);
+    LogicalType type;
+    ASSERT_TRUE(json_column->get_flat_column("k1", &type) != nullptr);
+    ASSERT_EQ(TYPE_BIGINT, type);
+    check_same_results();
+
+    // and dropped by other modifications
+    json_column->append_default();
+    ASSERT_FALSE(json_column->has_flat_columns());
+}
+
 class JsonQueryTestFixture : public ::testing::TestWithParam<std::tuple<std::string, std::string, std::string>> {};
 
 TEST_P(JsonQueryTestFixture, json_query) {
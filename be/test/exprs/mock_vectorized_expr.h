@@ -38,6 +38,37 @@ private:
     ColumnPtr _column;
 };
 
+// Return the result column and record the rows selected to evaluate
+class MockSelectiveExpr final : public Expr {
+public:
+    explicit MockSelectiveExpr(const TExprNode& dummy, ColumnPtr result) : Expr(dummy), _column(std::move(result)) {}
+
+    StatusOr<ColumnPtr> evaluate_checked(ExprContext* context, Chunk* ptr) override {
+        return evaluate_with_filter(context, ptr, nullptr);
+    }
+
+    StatusOr<ColumnPtr> evaluate_with_filter(ExprContext*, Chunk*, uint8_t* filter) override {
+        _num_evaluations++;
+        if (filter == nullptr) {
+            _selection.assign(_column->size(), 1);
+        } else {
+            _selection.assign(filter, filter + _column->size());
+        }
+        return _column;
+    }
+
+    Expr* clone(ObjectPool* pool) const override { return pool->add(new MockSelectiveExpr(*this)); }
+
+    int num_evaluations() const { return _num_evaluations; }
+
+    std::vector<uint8_t> selection() const { return {_selection.begin(), _selection.end()}; }
+
+private:
+    ColumnPtr _column;
+    int _num_evaluations = 0;
+    Filter _selection;
+};
+
 class MockCostExpr : public Expr {
 public:
     explicit MockCostExpr(const TExprNode& t) : Expr(t) {}
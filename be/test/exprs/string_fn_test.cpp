@@ -1110,6 +1110,36 @@ PARALLEL_TEST(VecStringFunctionsTest, utf8LengthChineseTest) {
     }
 }
 
+PARALLEL_TEST(VecStringFunctionsTest, utf8LengthNullableTest) {
+    std::unique_ptr<FunctionContext> ctx(FunctionContext::create_test_context());
+    std::string strs[] = {"", "abc", "", "中文abc", std::string(100, 'x')};
+    int lengths[] = {0, 3, 0, 5, 100};
+    // the non-ascii string is replaced with a null in the first column, so that all its bytes are ascii
+    for (bool ascii : {true, false}) {
+        auto str = BinaryColumn::create();
+        auto null = NullColumn::create();
+        for (int i = 0; i < 5; ++i) {
+            if (ascii && i == 3) {
+                str->append(Slice());
+                null->append(1);
+            } else {
+                str->append(strs[i]);
+                null->append(0);
+            }
+        }
+        Columns columns{NullableColumn::create(str, null)};
+        ColumnPtr result = StringFunctions::utf8_length(ctx.get(), columns).value();
+        ASSERT_EQ(5, result->size());
+        for (int i = 0; i < 5; ++i) {
+            if (ascii && i == 3) {
+                ASSERT_TRUE(result->is_null(i));
+            } else {
+                ASSERT_EQ(lengths[i], result->get(i).get_int32());
+            }
+        }
+    }
+}
+
 PARALLEL_TEST(VecStringFunctionsTest, upperTest) {
     std::unique_ptr<FunctionContext> ctx(FunctionContext::create_test_context());
     Columns columns;
@@ -1620,6 +1650,69 @@ PARALLEL_TEST(VecStringFunctionsTest, regexpExtractConstPattern) {
                     .ok());
 }
 
+PARALLEL_TEST(VecStringFunctionsTest, regexpWithHyperscanPrefilter) {
+    // extract
+    {
+        std::unique_ptr<FunctionContext> ctx(FunctionContext::create_test_context());
+        auto context = ctx.get();
+
+        auto str = BinaryColumn::create();
+        auto pattern = ColumnHelper::create_const_column<TYPE_VARCHAR>("([[:lower:]]+)C([[:lower:]]+)", 1);
+        auto index = Int64Column::create();
+        std::string strs[] = {"AbCdE", "ABCDE", "", "xyzCabc"};
+        int indexs[] = {1, 1, 1, 2};
+        std::string res[] = {"b", "", "", "abc"};
+        for (int i = 0; i < sizeof(strs) / sizeof(strs[0]); ++i) {
+            str->append(strs[i]);
+            index->append(indexs[i]);
+        }
+        Columns columns{str, pattern, index};
+        context->set_constant_columns(columns);
+
+        ASSERT_OK(StringFunctions::regexp_extract_prepare(context, FunctionContext::FRAGMENT_LOCAL));
+        ASSERT_TRUE(context->get_function_state(FunctionContext::FRAGMENT_LOCAL) != nullptr);
+        ASSERT_OK(StringFunctions::regexp_extract_prepare(context, FunctionContext::THREAD_LOCAL));
+
+        auto result = StringFunctions::regexp_extract(context, columns).value();
+        auto v = ColumnHelper::cast_to<TYPE_VARCHAR>(result);
+        for (int i = 0; i < sizeof(res) / sizeof(res[0]); ++i) {
+            ASSERT_EQ(res[i], v->get_data()[i].to_string());
+        }
+
+        ASSERT_OK(StringFunctions::regexp_close(context, FunctionContext::THREAD_LOCAL));
+        ASSERT_OK(StringFunctions::regexp_close(context, FunctionContext::FRAGMENT_LOCAL));
+    }
+    // replace
+    {
+        std::unique_ptr<FunctionContext> ctx(FunctionContext::create_test_context());
+        auto context = ctx.get();
+
+        auto str = BinaryColumn::create();
+        auto pattern = ColumnHelper::create_const_column<TYPE_VARCHAR>("(\\d+)-(\\d+)", 1);
+        auto replace = ColumnHelper::create_const_column<TYPE_VARCHAR>("\\2-\\1", 1);
+        std::string strs[] = {"10-20 x", "no digits", "", "a1-2b3-4"};
+        std::string res[] = {"20-10 x", "no digits", "", "a2-1b4-3"};
+        for (const auto& s : strs) {
+            str->append(s);
+        }
+        Columns columns{str, pattern, replace};
+        context->set_constant_columns(columns);
+
+        ASSERT_OK(StringFunctions::regexp_replace_prepare(context, FunctionContext::FRAGMENT_LOCAL));
+        ASSERT_TRUE(context->get_function_state(FunctionContext::FRAGMENT_LOCAL) != nullptr);
+        ASSERT_OK(StringFunctions::regexp_replace_prepare(context, FunctionContext::THREAD_LOCAL));
+
+        auto result = StringFunctions::regexp_replace(context, columns).value();
+        auto v = ColumnHelper::cast_to<TYPE_VARCHAR>(result);
+        for (int i = 0; i < sizeof(res) / sizeof(res[0]); ++i) {
+            ASSERT_EQ(res[i], v->get_data()[i].to_string());
+        }
+
+        ASSERT_OK(StringFunctions::regexp_close(context, FunctionContext::THREAD_LOCAL));
+        ASSERT_OK(StringFunctions::regexp_close(context, FunctionContext::FRAGMENT_LOCAL));
+    }
+}
+
 PARALLEL_TEST(VecStringFunctionsTest, regexpExtract) {
     std::unique_ptr<FunctionContext> ctx(FunctionContext::create_test_context());
     auto context = ctx.get();
@@ -0,0 +1,172 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "formats/csv/csv_reader.h"
+
+#include <gtest/gtest.h>
+
+#include <random>
+
+#include "formats/csv/csv_structural_index.h"
+
+namespace starrocks {
+
+class StringCSVReader final : public CSVReader {
+public:
+    StringCSVReader(const CSVParseOptions& options, std::string data, size_t buffer_size)
+            : CSVReader(options, buffer_size), _data(std::move(data)) {}
+
+protected:
+    Status _fill_buffer() override {
+        size_t n = std::min(_buff.free_space(), _data.size() - _offset);
+        memcpy(_buff.limit(), _data.data() + _offset, n);
+        _buff.add_limit(n);
+        _offset += n;
+        if (n == 0) {
+            if (_buff.available() == 0) {
+                return Status::EndOfFile("");
+            }
+            if (_buff.find(_parse_options.row_delimiter, _buff.available() - _row_delimiter_length) == nullptr) {
+                for (char ch : _parse_options.row_delimiter) {
+                    _buff.append(ch);
+                }
+            }
+        }
+        return Status::OK();
+    }
+
+private:
+    std::string _data;
+    size_t _offset = 0;
+};
+
+class CSVReaderTest : public ::testing::Test {
+protected:
+    static std::vector<std::vector<std::string>> parse(const CSVParseOptions& options, const std::string& data,
+                                                       bool enable_simd, size_t buffer_size = 256) {
+        StringCSVReader reader(options, data, buffer_size);
+        reader.set_enable_simd_tokenizer(enable_simd);
+        std::vector<std::vector<std::string>> rows;
+        CSVRow row;
+        while (reader.next_record(row).ok()) {
+            auto& fields = rows.emplace_back();
+            for (const auto& column : row.columns) {
+                const char* base = column.is_escaped_column ? reader.escapeDataPtr() : reader.buffBasePtr();
+                fields.emplace_back(base + column.start_pos, column.length);
+            }
+        }
+        return rows;
+    }
+};
+
+TEST_F(CSVReaderTest, test_structural_chars) {
+    std::string data(1000, 'x');
+    std::vector<size_t> expected;
+    for (size_t i = 3; i < data.size(); i += 7) {
+        data[i] = (i % 2 == 0) ? ',' : '\n';
+        expected.push_back(i);
+    }
+    std::vector<size_t> positions;
+    for_each_structural_char(data.data(), data.size(), std::array<char, 2>{',', '\n'},
+                             [&](size_t i) { positions.push_back(i); });
+    ASSERT_EQ(expected, positions);
+
+    CSVStructuralIndex index(data.data(), 10, data.size(), {',', '\n', '\\', '"'});
+    ASSERT_EQ(10, index.next(10));
+    ASSERT_EQ(17, index.next(11));
+    ASSERT_EQ(997, index.next(995));
+    ASSERT_EQ(data.size(), index.next(998));
+}
+
+TEST_F(CSVReaderTest, test_enclose_and_escape) {
+    CSVParseOptions options("\n", ",", 0, false, '\\', '"');
+    std::string data = "1,\"a,b\",c\n\n2,\"x\"\"y\",\"\"\n3,a\\,b,\"p\\\"q\"\n4,\"multi\nline\",z";
+    auto rows = parse(options, data, true);
+    ASSERT_EQ(4, rows.size());
+    ASSERT_EQ((std::vector<std::string>{"1", "a,b", "c"}), rows[0]);
+    ASSERT_EQ((std::vector<std::string>{"2", "x\"y", ""}), rows[1]);
+    ASSERT_EQ((std::vector<std::string>{"3", "a,b", "p\"q"}), rows[2]);
+    ASSERT_EQ((std::vector<std::string>{"4", "multi\nline", "z"}), rows[3]);
+    ASSERT_EQ(rows, parse(options, data, false));
+}
+
+TEST_F(CSVReaderTest, test_trim_space) {
+    CSVParseOptions options("\n", "|", 0, true, 0, '"');
+    std::string data = "  a |  \"b c\"|c  \n   \n d|e|f\n";
+    auto rows = parse(options, data, true);
+    ASSERT_EQ(2, rows.size());
+    ASSERT_EQ((std::vector<std::string>{"a", "b c", "c"}), rows[0]);
+    ASSERT_EQ((std::vector<std::string>{"d", "e", "f"}), rows[1]);
+    ASSERT_EQ(rows, parse(options, data, false));
+}
+
+// The SIMD tokenizer must produce exactly the same rows as the state machine.
+TEST_F(CSVReaderTest, test_same_as_state_machine) {
+    std::mt19937 rng(0);
+    auto random_chars = [&](const std::string& alphabet, bool with_escape) {
+        std::string chars;
+        for (size_t i = 0, n = rng() % 20; i < n; i++) {
+            if (with_escape && rng() % 8 == 0) {
+                chars.push_back('\\');
+                chars.push_back("a,\n\"\\"[rng() % 5]);
+            } else {
+                chars.push_back(alphabet[rng() % alphabet.size()]);
+            }
+        }
+        return chars;
+    };
+    for (int round = 0; round < 200; round++) {
+        for (bool with_escape : {true, false}) {
+            std::string data;
+            for (size_t row = 0, num_rows = rng() % 100; row < num_rows; row++) {
+                for (size_t field = 0, num_fields = rng() % 5; field < num_fields; field++) {
+                    if (field > 0) {
+                        data.push_back(',');
+                    }
+                    if (rng() % 3 == 0) {
+                        // enclosed field which may contain delimiters and doubled enclose characters
+                        std::string value = random_chars("ab ,\n", with_escape);
+                        if (rng() % 4 == 0) {
+                            value += "\"\"";
+                        }
+                        data += "\"" + value + "\"";
+                    } else {
+                        data += random_chars("abc ", with_escape);
+                    }
+                }
+                data.push_back('\n');
+            }
+            CSVParseOptions options("\n", ",", 0, false, with_escape ? '\\' : '\0', '"');
+            size_t buffer_size = 64 << (round % 4);
+            auto expected = parse(options, data, false, buffer_size);
+            ASSERT_EQ(expected, parse(options, data, true, buffer_size)) << "data: " << data;
+            ASSERT_EQ(expected, parse(options, data, true, data.size() + 1)) << "data: " << data;
+        }
+    }
+}
+
+TEST_F(CSVReaderTest, test_split_record) {
+    StringCSVReader reader(CSVParseOptions("\n", ","), "", 256);
+    std::string record = "a,,bcd,efghijklmnopqrstuvwxyz0123456789abcdefghij,k,";
+    CSVReader::Fields fields;
+    reader.split_record(Slice(record), &fields);
+    std::vector<std::string> values;
+    for (const auto& field : fields) {
+        values.emplace_back(field.to_string());
+    }
+    ASSERT_EQ((std::vector<std::string>{"a", "", "bcd", "efghijklmnopqrstuvwxyz0123456789abcdefghij", "k", ""}),
+              values);
+}
+
+} // namespace starrocks
@@ -57,6 +57,7 @@ public:
         options.mem_space_size = 20 * 1024 * 1024;
         options.disk_spaces.push_back({.path = "./ut_dir/block_disk_cache", .size = 50 * 1024 * 1024});
         options.block_size = block_size;
+        options.engine = "cachelib";
         ASSERT_OK(cache->init(options));
     }
 
@@ -101,13 +102,13 @@ TEST_F(CacheInputStreamTest, test_aligned_read) {
     gen_test_data(data, data_size, block_size);
 
     std::shared_ptr<io::SeekableInputStream> stream(new MockSeekableInputStream(data, data_size));
-    io::CacheInputStream cache_stream("test_file1", stream);
-    auto& stats = cache_stream.stats();
+    ASSIGN_OR_ABORT(auto cache_stream, io::CacheInputStream::create("test_file1", stream));
+    auto& stats = cache_stream->stats();
 
     // first read from backend
     for (int i = 0; i < block_count; ++i) {
         char buffer[block_size];
-        read_stream_data(&cache_stream, i * block_size, block_size, buffer);
+        read_stream_data(cache_stream.get(), i * block_size, block_size, buffer);
         ASSERT_TRUE(check_data_content(buffer, block_size, 'a' + i));
     }
     ASSERT_EQ(stats.read_cache_count, 0);
@@ -116,7 +117,7 @@ TEST_F(CacheInputStreamTest, test_aligned_read) {
     // first read from cache
     for (int i = 0; i < block_count; ++i) {
         char buffer[block_size];
-        read_stream_data(&cache_stream, i * block_size, block_size, buffer);
+        read_stream_data(cache_stream.get(), i * block_size, block_size, buffer);
         ASSERT_TRUE(check_data_content(buffer, block_size, 'a' + i));
     }
     ASSERT_EQ(stats.read_cache_count, block_count);
@@ -130,13 +131,13 @@ TEST_F(CacheInputStreamTest, test_random_read) {
     gen_test_data(data, data_size, block_size);
 
     std::shared_ptr<io::SeekableInputStream> stream(new MockSeekableInputStream(data, data_size));
-    io::CacheInputStream cache_stream("test_file2", stream);
-    auto& stats = cache_stream.stats();
+    ASSIGN_OR_ABORT(auto cache_stream, io::CacheInputStream::create("test_file2", stream));
+    auto& stats = cache_stream->stats();
 
     // first read from backend
     for (int i = 0; i < block_count; ++i) {
         char buffer[block_size];
-        read_stream_data(&cache_stream, i * block_size, block_size, buffer);
+        read_stream_data(cache_stream.get(), i * block_size, block_size, buffer);
         ASSERT_TRUE(check_data_content(buffer, block_size, 'a' + i));
     }
     ASSERT_EQ(stats.read_cache_count, 0);
@@ -144,11 +145,11 @@ TEST_F(CacheInputStreamTest, test_random_read) {
 
     // seek to a custom postion in second block, and read multiple block
     int64_t off_in_block = 100;
-    ASSERT_OK(cache_stream.seek(block_size + off_in_block));
-    ASSERT_EQ(cache_stream.position().value(), block_size + off_in_block);
+    ASSERT_OK(cache_stream->seek(block_size + off_in_block));
+    ASSERT_EQ(cache_stream->position().value(), block_size + off_in_block);
 
     char buffer[block_size * 2];
-    auto res = cache_stream.read(buffer, block_size * 2);
+    auto res = cache_stream->read(buffer, block_size * 2);
     ASSERT_TRUE(res.ok());
 
     ASSERT_TRUE(check_data_content(buffer, block_size - off_in_block, 'a' + 1));
@@ -158,4 +159,25 @@ TEST_F(CacheInputStreamTest, test_random_read) {
     ASSERT_EQ(stats.read_cache_count, 3);
 }
 
+TEST_F(CacheInputStreamTest, test_files_of_same_size) {
+    const int64_t data_size = block_size;
+    std::vector<char> data1(data_size, 'x');
+    std::vector<char> data2(data_size, 'y');
+
+    std::shared_ptr<io::SeekableInputStream> stream1(new MockSeekableInputStream(data1.data(), data_size));
+    std::shared_ptr<io::SeekableInputStream> stream2(new MockSeekableInputStream(data2.data(), data_size));
+    ASSIGN_OR_ABORT(auto cache_stream1, io::CacheInputStream::create("test_file3", stream1));
+    ASSIGN_OR_ABORT(auto cache_stream2, io::CacheInputStream::create("test_file4", stream2));
+    cache_stream1->set_enable_populate_cache(true);
+    cache_stream2->set_enable_populate_cache(true);
+
+    // the blocks of a file must not be returned for another file of the same size
+    std::vector<char> buffer(data_size);
+    read_stream_data(cache_stream1.get(), 0, data_size, buffer.data());
+    ASSERT_TRUE(check_data_content(buffer.data(), data_size, 'x'));
+    read_stream_data(cache_stream2.get(), 0, data_size, buffer.data());
+    ASSERT_TRUE(check_data_content(buffer.data(), data_size, 'y'));
+    ASSERT_EQ(0, cache_stream2->stats().read_cache_count);
+}
+
 } // namespace starrocks::io
@@ -36,6 +36,7 @@
 
 #include <gtest/gtest.h>
 
+#include <map>
 #include <thread>
 
 #include "testutil/assert.h"
@@ -234,4 +235,54 @@ PARALLEL_TEST(StreamLoadPipeTest, append_large_chunk) {
     producer.join();
 }
 
+PARALLEL_TEST(StreamLoadPipeTest, split_by_rows) {
+    auto pipe = std::make_shared<StreamLoadPipe>(/*max_buffered_bytes=*/1024, /*min_chunk_size=*/64);
+    std::string data;
+    for (int i = 0; i < 1000; i++) {
+        data += "row" + std::to_string(i) + "," + std::string(i % 50, 'x') + "\n";
+    }
+    // the last row has no row delimiter
+    data += "last";
+
+    auto producer = std::thread([&]() {
+        for (size_t pos = 0; pos < data.size(); pos += 37) {
+            ASSERT_OK(pipe->append(data.data() + pos, std::min<size_t>(37, data.size() - pos)));
+        }
+        ASSERT_OK(pipe->finish());
+    });
+
+    StreamLoadPipeSplitter splitter(pipe, '\n', /*block_size=*/100);
+    std::mutex mutex;
+    std::map<int64_t, std::string> blocks;
+    auto consumer = [&]() {
+        while (true) {
+            int64_t seq = -1;
+            auto res = splitter.next_block(&seq);
+            if (res.status().is_end_of_file()) {
+                break;
+            }
+            ASSERT_OK(res.status());
+            std::lock_guard<std::mutex> l(mutex);
+            blocks.emplace(seq, std::string(res.value()->ptr, res.value()->remaining()));
+        }
+    };
+    std::thread t1(consumer);
+    std::thread t2(consumer);
+    t1.join();
+    t2.join();
+    producer.join();
+
+    std::string result;
+    int64_t expected_seq = 0;
+    for (const auto& [seq, block] : blocks) {
+        ASSERT_EQ(expected_seq++, seq);
+        if (seq + 1 < static_cast<int64_t>(blocks.size())) {
+            ASSERT_GE(block.size(), 100);
+            ASSERT_EQ('\n', block.back());
+        }
+        result += block;
+    }
+    ASSERT_EQ(data, result);
+}
+
 } // namespace starrocks
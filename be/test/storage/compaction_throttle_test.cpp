@@ -0,0 +1,85 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "storage/compaction_throttle.h"
+
+#include <gtest/gtest.h>
+
+#include "common/config.h"
+#include "util/time.h"
+
+namespace starrocks {
+
+class CompactionThrottleTest : public testing::Test {
+public:
+    void SetUp() override {
+        _max_io_bytes_per_second = config::compaction_max_io_bytes_per_second;
+        _max_cpu_cores = config::compaction_max_cpu_cores;
+        _busy_query_num = config::compaction_busy_query_num;
+    }
+
+    void TearDown() override {
+        config::compaction_max_io_bytes_per_second = _max_io_bytes_per_second;
+        config::compaction_max_cpu_cores = _max_cpu_cores;
+        config::compaction_busy_query_num = _busy_query_num;
+    }
+
+private:
+    int64_t _max_io_bytes_per_second = 0;
+    double _max_cpu_cores = 0;
+    int32_t _busy_query_num = 0;
+};
+
+TEST_F(CompactionThrottleTest, test_unlimited) {
+    config::compaction_max_io_bytes_per_second = 0;
+    config::compaction_max_cpu_cores = 0;
+    config::compaction_busy_query_num = 0;
+    CompactionThrottle throttle;
+    CompactionRateLimiter limiter(&throttle, COMPACTION_PRIORITY_LOW);
+    for (int i = 0; i < 100; i++) {
+        ASSERT_TRUE(limiter.charge(1L << 30).ok());
+    }
+    ASSERT_FALSE(throttle.is_paused(COMPACTION_PRIORITY_LOW));
+    ASSERT_LT(limiter.wait_ns(), 1000L * 1000 * 1000);
+}
+
+TEST_F(CompactionThrottleTest, test_io_limit) {
+    config::compaction_max_io_bytes_per_second = 100L * 1024 * 1024;
+    config::compaction_max_cpu_cores = 0;
+    config::compaction_busy_query_num = 0;
+    CompactionThrottle throttle;
+    // the first charge goes into debt of 0.2 second, which the second charge has to wait for
+    int64_t start_ns = MonotonicNanos();
+    ASSERT_TRUE(throttle.acquire(COMPACTION_PRIORITY_NORMAL, 20L * 1024 * 1024, 0).ok());
+    ASSERT_TRUE(throttle.acquire(COMPACTION_PRIORITY_NORMAL, 1, 0).ok());
+    ASSERT_GE(MonotonicNanos() - start_ns, 150L * 1000 * 1000);
+}
+
+TEST_F(CompactionThrottleTest, test_pause_low_priority_when_busy) {
+    config::compaction_max_io_bytes_per_second = 0;
+    config::compaction_max_cpu_cores = 0;
+    config::compaction_busy_query_num = 4;
+    CompactionThrottle throttle;
+    throttle.set_running_query_num_getter([] { return 8; });
+    ASSERT_TRUE(throttle.is_paused(COMPACTION_PRIORITY_LOW));
+    ASSERT_FALSE(throttle.is_paused(COMPACTION_PRIORITY_NORMAL));
+    ASSERT_FALSE(throttle.is_paused(COMPACTION_PRIORITY_HIGH));
+
+    ASSERT_TRUE(throttle.acquire(COMPACTION_PRIORITY_HIGH, 1024, 0).ok());
+    int num_checks = 0;
+    auto st = throttle.acquire(COMPACTION_PRIORITY_LOW, 1024, 0, [&] { return ++num_checks > 2; });
+    ASSERT_TRUE(st.is_cancelled());
+}
+
+} // namespace starrocks
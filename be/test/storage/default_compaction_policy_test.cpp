@@ -48,14 +48,14 @@ public:
             _engine = nullptr;
         }
     }
-    void write_new_version(const TabletMetaSharedPtr& tablet_meta) {
+    void write_new_version(const TabletMetaSharedPtr& tablet_meta, int32_t key_offset = 0) {
         RowsetWriterContext rowset_writer_context;
         create_rowset_writer_context(&rowset_writer_context, _version);
         _version++;
         std::unique_ptr<RowsetWriter> rowset_writer;
         ASSERT_TRUE(RowsetFactory::create_rowset_writer(rowset_writer_context, &rowset_writer).ok());
 
-        rowset_writer_add_rows(rowset_writer);
+        rowset_writer_add_rows(rowset_writer, key_offset);
 
         rowset_writer->flush();
         RowsetSharedPtr src_rowset = *rowset_writer->build();
@@ -175,7 +175,7 @@ public:
         tablet_meta->init_from_pb(&tablet_meta_pb);
     }
 
-    void rowset_writer_add_rows(std::unique_ptr<RowsetWriter>& writer) {
+    void rowset_writer_add_rows(std::unique_ptr<RowsetWriter>& writer, int32_t key_offset = 0) {
         std::vector<std::string> test_data;
         auto schema = ChunkHelper::convert_schema(*_tablet_schema);
         for (size_t j = 0; j < 8; ++j) {
@@ -183,7 +183,7 @@ public:
             for (size_t i = 0; i < 128; ++i) {
                 test_data.push_back("well" + std::to_string(i));
                 auto& cols = chunk->columns();
-                cols[0]->append_datum(Datum(static_cast<int32_t>(i)));
+                cols[0]->append_datum(Datum(static_cast<int32_t>(key_offset + i)));
                 Slice field_1(test_data[i]);
                 cols[1]->append_datum(Datum(field_1));
                 cols[2]->append_datum(Datum(static_cast<int32_t>(10000 + i)));
@@ -354,6 +354,96 @@ TEST_F(DefaultCompactionPolicyTest, test_max_cumulative_compaction) {
     ASSERT_EQ(5, versions[1].second);
 }
 
+TEST_F(DefaultCompactionPolicyTest, test_link_non_overlapping_segments) {
+    LOG(INFO) << "test_link_non_overlapping_segments";
+    auto min_size_ratio = config::compaction_link_segment_min_size_ratio;
+    config::compaction_link_segment_min_size_ratio = 0;
+    DeferOp defer([&] { config::compaction_link_segment_min_size_ratio = min_size_ratio; });
+    create_tablet_schema(DUP_KEYS);
+
+    TabletMetaSharedPtr tablet_meta = std::make_shared<TabletMeta>();
+    create_tablet_meta(tablet_meta.get());
+
+    // the key ranges of the versions are [0, 128), [1024, 1152), ...
+    for (int i = 0; i < 6; ++i) {
+        write_new_version(tablet_meta, i * 1024);
+    }
+
+    TabletSharedPtr tablet =
+            Tablet::create_tablet_from_meta(tablet_meta, starrocks::StorageEngine::instance()->get_stores()[0]);
+    tablet->init();
+    init_compaction_context(tablet);
+
+    auto res = compact(tablet);
+    ASSERT_TRUE(res.ok());
+
+    ASSERT_EQ(2, tablet->version_count());
+    auto output_rowset = tablet->get_rowset_by_version(Version(0, 4));
+    ASSERT_TRUE(output_rowset != nullptr);
+    ASSERT_EQ(5 * 1024, output_rowset->num_rows());
+    // every input segment is linked into the output rowset
+    ASSERT_EQ(5, output_rowset->num_segments());
+    ASSERT_EQ(NONOVERLAPPING, output_rowset->rowset_meta()->segments_overlap());
+}
+
+TEST_F(DefaultCompactionPolicyTest, test_merge_small_non_overlapping_segments) {
+    LOG(INFO) << "test_merge_small_non_overlapping_segments";
+    create_tablet_schema(DUP_KEYS);
+
+    TabletMetaSharedPtr tablet_meta = std::make_shared<TabletMeta>();
+    create_tablet_meta(tablet_meta.get());
+
+    // the key ranges of the versions are [0, 128), [1024, 1152), ...
+    for (int i = 0; i < 6; ++i) {
+        write_new_version(tablet_meta, i * 1024);
+    }
+
+    TabletSharedPtr tablet =
+            Tablet::create_tablet_from_meta(tablet_meta, starrocks::StorageEngine::instance()->get_stores()[0]);
+    tablet->init();
+    init_compaction_context(tablet);
+
+    auto res = compact(tablet);
+    ASSERT_TRUE(res.ok());
+
+    ASSERT_EQ(2, tablet->version_count());
+    auto output_rowset = tablet->get_rowset_by_version(Version(0, 4));
+    ASSERT_TRUE(output_rowset != nullptr);
+    ASSERT_EQ(5 * 1024, output_rowset->num_rows());
+    // the input segments are far smaller than max_segment_file_size, so they are merged into one segment
+    ASSERT_EQ(1, output_rowset->num_segments());
+    ASSERT_EQ(NONOVERLAPPING, output_rowset->rowset_meta()->segments_overlap());
+
+    // the rows of the input segments are kept in the order of their key ranges
+    auto schema = ChunkHelper::convert_schema(*_tablet_schema);
+    RowsetReadOptions rs_opts;
+    rs_opts.sorted = false;
+    rs_opts.use_page_cache = false;
+    rs_opts.tablet_schema = _tablet_schema.get();
+    OlapReaderStatistics stats;
+    rs_opts.stats = &stats;
+    auto iter = *output_rowset->new_iterator(schema, rs_opts);
+    auto chunk = ChunkHelper::new_chunk(schema, 1024);
+    int32_t last_range = -1;
+    size_t num_rows = 0;
+    while (true) {
+        chunk->reset();
+        auto st = iter->get_next(chunk.get());
+        if (st.is_end_of_file()) {
+            break;
+        }
+        ASSERT_TRUE(st.ok()) << st;
+        for (size_t i = 0; i < chunk->num_rows(); ++i) {
+            auto range = chunk->get(i)[0].get_int32() / 1024;
+            ASSERT_GE(range, last_range);
+            last_range = range;
+        }
+        num_rows += chunk->num_rows();
+    }
+    iter->close();
+    ASSERT_EQ(5 * 1024, num_rows);
+}
+
 TEST_F(DefaultCompactionPolicyTest, test_missed_first_version) {
     LOG(INFO) << "test_missed_first_version";
     create_tablet_schema(UNIQUE_KEYS);
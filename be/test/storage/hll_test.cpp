@@ -205,4 +205,63 @@ TEST_F(TestHll, InvalidPtr) {
     }
 }
 
+TEST_F(TestHll, UpdateBatch) {
+    // empty -> explicit -> full in one batch
+    for (size_t num_values : {0, 10, 160, 161, 10000}) {
+        std::vector<uint64_t> hash_values;
+        HyperLogLog expected;
+        for (size_t i = 0; i < num_values; i++) {
+            hash_values.push_back(hash(i));
+            expected.update(hash(i));
+        }
+        HyperLogLog hll;
+        hll.update_batch(hash_values.data(), hash_values.size());
+        ASSERT_EQ(expected.estimate_cardinality(), hll.estimate_cardinality());
+
+        // batches on non-empty values
+        hll.update_batch(hash_values.data(), hash_values.size() / 2);
+        ASSERT_EQ(expected.estimate_cardinality(), hll.estimate_cardinality());
+    }
+}
+
+TEST_F(TestHll, DeserializeAndMerge) {
+    auto make_hll = [](size_t from, size_t to) {
+        HyperLogLog hll;
+        for (size_t i = from; i < to; i++) {
+            hll.update(hash(i));
+        }
+        return hll;
+    };
+    // empty, explicit, sparse, full
+    std::vector<HyperLogLog> hlls = {make_hll(0, 0), make_hll(0, 100), make_hll(50, 200), make_hll(100, 3000),
+                                     make_hll(1000, 100000)};
+    uint8_t buf[HLL_REGISTERS_COUNT + 1];
+    for (auto& lhs : hlls) {
+        for (auto& rhs : hlls) {
+            HyperLogLog expected(lhs);
+            expected.merge(rhs);
+
+            HyperLogLog hll(lhs);
+            size_t len = rhs.serialize(buf);
+            hll.deserialize_and_merge(Slice(buf, len));
+            ASSERT_EQ(expected.estimate_cardinality(), hll.estimate_cardinality());
+
+            // the order of the explicit values is not deterministic
+            uint8_t expected_buf[HLL_REGISTERS_COUNT + 1];
+            size_t expected_len = expected.serialize(expected_buf);
+            ASSERT_EQ(expected_len, hll.serialize(buf));
+            if (expected_buf[0] != HLL_DATA_EXPLICIT) {
+                ASSERT_EQ(0, memcmp(expected_buf, buf, expected_len));
+            }
+        }
+    }
+
+    // invalid binaries are merged as empty values
+    HyperLogLog hll(hlls[1]);
+    hll.deserialize_and_merge(Slice((char*)nullptr, 0));
+    buf[0] = 60;
+    hll.deserialize_and_merge(Slice(buf, 1));
+    ASSERT_EQ(hlls[1].estimate_cardinality(), hll.estimate_cardinality());
+}
+
 } // namespace starrocks
@@ -25,10 +25,12 @@
 #include "column/fixed_length_column.h"
 #include "column/schema.h"
 #include "column/vectorized_fwd.h"
+#include "common/config.h"
 #include "common/logging.h"
 #include "fs/fs_util.h"
 #include "runtime/mem_tracker.h"
 #include "storage/chunk_helper.h"
+#include "storage/lake/compaction_staging_area.h"
 #include "storage/lake/delta_writer.h"
 #include "storage/lake/fixed_location_provider.h"
 #include "storage/lake/join_path.h"
@@ -38,6 +40,7 @@
 #include "storage/tablet_schema.h"
 #include "testutil/assert.h"
 #include "testutil/id_generator.h"
+#include "util/defer_op.h"
 
 namespace starrocks::lake {
 
@@ -205,6 +208,69 @@ TEST_F(DuplicateKeyHorizontalCompactionTest, test1) {
     ASSERT_EQ(1, new_tablet_metadata->rowsets_size());
 }
 
+TEST_F(DuplicateKeyHorizontalCompactionTest, test_staging) {
+    const std::string staging_dir = lake::join_path(kTestGroupPath, "staging");
+    auto orig_dir = config::lake_compaction_staging_dir;
+    auto orig_max_bytes = config::lake_compaction_staging_max_bytes;
+    config::lake_compaction_staging_dir = staging_dir;
+    DeferOp unset_config([&] {
+        config::lake_compaction_staging_dir = orig_dir;
+        config::lake_compaction_staging_max_bytes = orig_max_bytes;
+    });
+
+    auto chunk0 = generate_data(kChunkSize);
+    auto indexes = std::vector<uint32_t>(kChunkSize);
+    for (int i = 0; i < kChunkSize; i++) {
+        indexes[i] = i;
+    }
+
+    auto version = 1;
+    auto tablet_id = _tablet_metadata->id();
+    for (int i = 0; i < 3; i++) {
+        _txn_id++;
+        auto delta_writer = DeltaWriter::create(_tablet_manager.get(), tablet_id, _txn_id, _partition_id, nullptr,
+                                                _mem_tracker.get());
+        ASSERT_OK(delta_writer->open());
+        ASSERT_OK(delta_writer->write(chunk0, indexes.data(), indexes.size()));
+        ASSERT_OK(delta_writer->finish());
+        delta_writer->close();
+        ASSERT_OK(_tablet_manager->publish_version(tablet_id, version, version + 1, &_txn_id, 1).status());
+        version++;
+    }
+
+    ASSIGN_OR_ABORT(auto tablet, _tablet_manager->get_tablet(tablet_id));
+    ASSIGN_OR_ABORT(auto rowsets, tablet.get_rowsets(version));
+    {
+        CompactionStagingArea staging_area(lake::join_path(staging_dir, "all"),
+                                           _tablet_manager->compaction_download_pool());
+        ASSERT_OK(staging_area.stage(tablet, rowsets, 2));
+        ASSERT_EQ(3, staging_area.staged_files().size());
+        ASSERT_EQ(staging_area.staged_bytes(), CompactionStagingArea::total_staged_bytes());
+        for (const auto& [src, dst] : staging_area.staged_files()) {
+            ASSERT_TRUE(fs::path_exist(dst));
+        }
+    }
+    ASSERT_EQ(0, CompactionStagingArea::total_staged_bytes());
+    ASSERT_FALSE(fs::path_exist(lake::join_path(staging_dir, "all")));
+    {
+        // no segment fits into the budget
+        config::lake_compaction_staging_max_bytes = 1;
+        CompactionStagingArea staging_area(lake::join_path(staging_dir, "none"),
+                                           _tablet_manager->compaction_download_pool());
+        ASSERT_OK(staging_area.stage(tablet, rowsets, 2));
+        ASSERT_EQ(0, staging_area.staged_files().size());
+        config::lake_compaction_staging_max_bytes = orig_max_bytes;
+    }
+
+    _txn_id++;
+    ASSIGN_OR_ABORT(auto task, _tablet_manager->compact(tablet_id, version, _txn_id));
+    ASSERT_OK(task->execute(nullptr));
+    ASSERT_OK(_tablet_manager->publish_version(tablet_id, version, version + 1, &_txn_id, 1).status());
+    version++;
+    ASSERT_EQ(kChunkSize * 3, read(version));
+    ASSERT_EQ(0, CompactionStagingArea::total_staged_bytes());
+}
+
 class DuplicateKeyOverlapSegmentsHorizontalCompactionTest : public LakeCompactionTest {
 public:
     DuplicateKeyOverlapSegmentsHorizontalCompactionTest() : LakeCompactionTest(kTestGroupPath) {
@@ -17,6 +17,7 @@
 #include <gtest/gtest.h>
 
 #include <algorithm>
+#include <map>
 #include <memory>
 #include <random>
 
@@ -335,6 +336,68 @@ TEST_F(MemTableTest, testUniqKeysInsertFlushRead) {
     ASSERT_EQ(n, pkey_read);
 }
 
+TEST_F(MemTableTest, testUniqKeysHighlyDuplicated) {
+    const string path = "./ut_dir/MemTableTest_testUniqKeysHighlyDuplicated";
+    int64_t old_write_buffer_size = config::write_buffer_size;
+    config::write_buffer_size = 16 * 1024;
+    MySetUp(create_tablet_schema("pk int,name varchar,pv int", 1, KeysType::UNIQUE_KEYS), "pk int,name varchar,pv int",
+            path);
+    config::write_buffer_size = old_write_buffer_size;
+    const int n = 100;
+    // insert every key many times in small batches, so that the runs are grouped by hash and compacted,
+    // every insert with a distinct pv
+    std::mt19937 rng(std::random_device{}());
+    std::map<int32_t, int32_t> last_pv;
+    int32_t pv = 0;
+    const string name = "name";
+    for (int round = 0; round < 50; round++) {
+        auto pchunk = ChunkHelper::new_chunk(*_slots, 4 * n);
+        vector<uint32_t> indexes;
+        for (int i = 0; i < 4 * n; i++) {
+            int32_t pk = static_cast<int32_t>(rng() % n);
+            pchunk->get_column_by_index(0)->append_datum(Datum(pk));
+            pchunk->get_column_by_index(1)->append_datum(Datum(Slice(name)));
+            pchunk->get_column_by_index(2)->append_datum(Datum(pv));
+            last_pv[pk] = pv++;
+            indexes.emplace_back(i);
+        }
+        _mem_table->insert(*pchunk, indexes.data(), 0, indexes.size());
+    }
+    ASSERT_GT(_mem_table->num_hash_grouped_runs(), 0);
+    ASSERT_TRUE(_mem_table->finalize().ok());
+    ASSERT_OK(_mem_table->flush());
+    RowsetSharedPtr rowset = *_writer->build();
+    unique_ptr<Schema> read_schema = create_schema("pk int,name varchar,pv int", 1);
+    OlapReaderStatistics stats;
+    RowsetReadOptions rs_opts;
+    rs_opts.sorted = false;
+    rs_opts.use_page_cache = false;
+    rs_opts.stats = &stats;
+    auto itr = rowset->new_iterator(*read_schema, rs_opts);
+    ASSERT_TRUE(itr.ok()) << itr.status().to_string();
+    std::shared_ptr<Chunk> chunk = ChunkHelper::new_chunk(*read_schema, 4096);
+    size_t pkey_read = 0;
+    int last_key = -1;
+    while (true) {
+        Status st = (*itr)->get_next(chunk.get());
+        if (st.is_end_of_file()) {
+            break;
+        }
+        auto pk_column = chunk->get_column_by_name("pk");
+        auto pv_column = chunk->get_column_by_name("pv");
+        for (size_t i = 0; i < pk_column->size(); i++) {
+            int key = pk_column->get(i).get_int32();
+            ASSERT_LT(last_key, key);
+            last_key = key;
+            // REPLACE keeps the value of the last insert of every key
+            ASSERT_EQ(last_pv[key], pv_column->get(i).get_int32()) << "pk: " << key;
+        }
+        pkey_read += chunk->num_rows();
+        chunk->reset();
+    }
+    ASSERT_EQ(last_pv.size(), pkey_read);
+}
+
 TEST_F(MemTableTest, testPrimaryKeysWithDeletes) {
     const string path = "./ut_dir/MemTableTest_testPrimaryKeysWithDeletes";
     MySetUp(create_tablet_schema("pk bigint,v1 int", 1, KeysType::PRIMARY_KEYS), "pk bigint,v1 int,__op tinyint", path);
@@ -229,4 +229,46 @@ TEST_F(RowSourceMaskTest, memory_masks_with_persistence) {
     ASSERT_FALSE(buffer.has_same_source(mask.get_source_num(), 4));
 }
 
+TEST_F(RowSourceMaskTest, clone_for_read) {
+    for (int64_t max_memory_bytes : {1L, 1024L * 1024}) {
+        config::max_row_source_mask_memory_bytes = max_memory_bytes;
+        RowSourceMaskBuffer buffer(1, config::storage_root_path);
+        std::vector<RowSourceMask> source_masks;
+        for (uint16_t i = 0; i < 10; ++i) {
+            source_masks.emplace_back(RowSourceMask(i, i % 2 == 0));
+            if (i % 3 == 2) {
+                ASSERT_TRUE(buffer.write(source_masks).ok());
+                source_masks.clear();
+            }
+        }
+        ASSERT_TRUE(buffer.write(source_masks).ok());
+        ASSERT_TRUE(buffer.flush().ok());
+
+        auto clone1 = buffer.clone_for_read();
+        ASSERT_TRUE(clone1.ok());
+        auto clone2 = buffer.clone_for_read();
+        ASSERT_TRUE(clone2.ok());
+
+        // the clones are read independently
+        for (uint16_t i = 0; i < 10; ++i) {
+            for (auto* reader : {clone1.value().get(), clone2.value().get()}) {
+                auto st = reader->has_remaining();
+                ASSERT_TRUE(st.ok());
+                ASSERT_TRUE(st.value());
+                RowSourceMask mask = reader->current();
+                ASSERT_EQ(i, mask.get_source_num());
+                ASSERT_EQ(i % 2 == 0, mask.get_agg_flag());
+                reader->advance();
+            }
+        }
+        ASSERT_FALSE(clone1.value()->has_remaining().value());
+        ASSERT_FALSE(clone2.value()->has_remaining().value());
+
+        // the origin buffer can still be read
+        ASSERT_TRUE(buffer.flip_to_read().ok());
+        ASSERT_TRUE(buffer.has_remaining().value());
+        ASSERT_EQ(0, buffer.current().get_source_num());
+    }
+}
+
 } // namespace starrocks
@@ -0,0 +1,96 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "storage/rowset/adaptive_page.h"
+
+#include <gtest/gtest.h>
+
+#include <memory>
+
+#include "storage/rowset/options.h"
+#include "storage/rowset/page_test_helper.h"
+#include "storage/rowset/storage_page_decoder.h"
+
+namespace starrocks {
+
+class AdaptivePageTest : public testing::Test {
+public:
+    template <LogicalType Type>
+    EncodingTypePB test_encode_decode(const std::vector<typename TypeTraits<Type>::CppType>& src) {
+        PageBuilderOptions options;
+        options.data_page_size = 256 * 1024;
+        AdaptivePageBuilder<Type> builder(options);
+        OwnedSlice s = build_page<Type>(&builder, src);
+
+        PageFooterPB footer;
+        footer.set_type(DATA_PAGE);
+        footer.mutable_data_page_footer()->set_nullmap_size(0);
+        std::unique_ptr<char[]> page;
+        Slice encoded_data = s.slice();
+        EXPECT_TRUE(StoragePageDecoder::decode_page(&footer, 0, ADAPTIVE_ENCODING, &page, &encoded_data).ok());
+
+        PageDecoderOptions decoder_options;
+        AdaptivePageDecoder<Type> decoder(encoded_data, decoder_options);
+        EXPECT_TRUE(decoder.init().ok());
+        EXPECT_EQ(builder.selected_encoding(), decoder.encoding_type());
+        check_decode_page<Type>(&decoder, src);
+        return builder.selected_encoding();
+    }
+};
+
+TEST_F(AdaptivePageTest, test_constant_values) {
+    std::vector<int32_t> src(10000, 12345);
+    EncodingTypePB encoding = test_encode_decode<TYPE_INT>(src);
+    ASSERT_NE(PLAIN_ENCODING, encoding);
+}
+
+TEST_F(AdaptivePageTest, test_sequence_values) {
+    std::vector<int64_t> src(20000);
+    for (size_t i = 0; i < src.size(); i++) {
+        src[i] = 1600000000000L + i * 3;
+    }
+    EncodingTypePB encoding = test_encode_decode<TYPE_BIGINT>(src);
+    ASSERT_NE(PLAIN_ENCODING, encoding);
+}
+
+TEST_F(AdaptivePageTest, test_random_values) {
+    std::vector<int32_t> src(10000);
+    for (auto& v : src) {
+        v = random();
+    }
+    test_encode_decode<TYPE_INT>(src);
+}
+
+TEST_F(AdaptivePageTest, test_small_page) {
+    std::vector<int16_t> src{3, 1, 4, 1, 5, 9, 2, 6};
+    test_encode_decode<TYPE_SMALLINT>(src);
+}
+
+TEST_F(AdaptivePageTest, test_date_values) {
+    std::vector<int32_t> src(5000);
+    for (size_t i = 0; i < src.size(); i++) {
+        src[i] = 2459000 + i / 100;
+    }
+    EncodingTypePB encoding = test_encode_decode<TYPE_DATE>(src);
+    ASSERT_NE(PLAIN_ENCODING, encoding);
+}
+
+TEST_F(AdaptivePageTest, test_candidates) {
+    const auto& int_candidates = AdaptivePageBuilder<TYPE_INT>::candidate_encodings();
+    ASSERT_NE(int_candidates.end(), std::find(int_candidates.begin(), int_candidates.end(), RLE));
+    const auto& bigint_candidates = AdaptivePageBuilder<TYPE_BIGINT>::candidate_encodings();
+    ASSERT_EQ(bigint_candidates.end(), std::find(bigint_candidates.begin(), bigint_candidates.end(), RLE));
+}
+
+} // namespace starrocks
@@ -0,0 +1,168 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "storage/rowset/delta_page.h"
+
+#include <gtest/gtest.h>
+
+#include <limits>
+#include <memory>
+
+#include "storage/rowset/options.h"
+#include "storage/rowset/page_test_helper.h"
+
+namespace starrocks {
+
+class DeltaPageTest : public testing::Test {
+public:
+    template <LogicalType Type, EncodingTypePB Encoding>
+    size_t test_encode_decode(const std::vector<typename TypeTraits<Type>::CppType>& src) {
+        PageBuilderOptions options;
+        options.data_page_size = 256 * 1024;
+        DeltaPageBuilder<Type, Encoding> builder(options);
+        OwnedSlice s = build_page<Type>(&builder, src);
+
+        PageDecoderOptions decoder_options;
+        DeltaPageDecoder<Type, Encoding> decoder(s.slice(), decoder_options);
+        EXPECT_TRUE(decoder.init().ok());
+        EXPECT_EQ(Encoding, decoder.encoding_type());
+        check_decode_page<Type>(&decoder, src);
+        return s.slice().size;
+    }
+};
+
+TEST_F(DeltaPageTest, test_sequence) {
+    std::vector<int64_t> src(10000);
+    for (size_t i = 0; i < src.size(); i++) {
+        src[i] = 1000000007L + i * 7 + (i % 3);
+    }
+    size_t delta_size = test_encode_decode<TYPE_BIGINT, DELTA_ENCODING>(src);
+    test_encode_decode<TYPE_BIGINT, DELTA_OF_DELTA_ENCODING>(src);
+    // 7 + [-2, 2] needs 3 bits
+    ASSERT_LT(delta_size, src.size());
+}
+
+TEST_F(DeltaPageTest, test_regular_interval) {
+    std::vector<int32_t> src(10000);
+    for (size_t i = 0; i < src.size(); i++) {
+        src[i] = -5000 + i * 10;
+    }
+    test_encode_decode<TYPE_INT, DELTA_ENCODING>(src);
+    size_t dod_size = test_encode_decode<TYPE_INT, DELTA_OF_DELTA_ENCODING>(src);
+    // every delta-of-delta is 0, only the block headers are stored
+    ASSERT_LT(dod_size, 10000 / DELTA_PAGE_BLOCK_SIZE * 40);
+}
+
+TEST_F(DeltaPageTest, test_random_and_extreme_values) {
+    std::vector<int64_t> src(3000);
+    for (size_t i = 0; i < src.size(); i++) {
+        switch (i % 5) {
+        case 0:
+            src[i] = std::numeric_limits<int64_t>::max();
+            break;
+        case 1:
+            src[i] = std::numeric_limits<int64_t>::min();
+            break;
+        default:
+            src[i] = (static_cast<int64_t>(random()) << 32) | random();
+        }
+    }
+    test_encode_decode<TYPE_BIGINT, DELTA_ENCODING>(src);
+    test_encode_decode<TYPE_BIGINT, DELTA_OF_DELTA_ENCODING>(src);
+
+    std::vector<int8_t> tiny(1000);
+    for (auto& v : tiny) {
+        v = static_cast<int8_t>(random());
+    }
+    test_encode_decode<TYPE_TINYINT, DELTA_ENCODING>(tiny);
+    test_encode_decode<TYPE_TINYINT, DELTA_OF_DELTA_ENCODING>(tiny);
+}
+
+TEST_F(DeltaPageTest, test_small_pages) {
+    for (size_t n = 1; n <= 5; n++) {
+        std::vector<int16_t> src(n);
+        for (size_t i = 0; i < n; i++) {
+            src[i] = 100 - i * i;
+        }
+        test_encode_decode<TYPE_SMALLINT, DELTA_ENCODING>(src);
+        test_encode_decode<TYPE_SMALLINT, DELTA_OF_DELTA_ENCODING>(src);
+    }
+}
+
+TEST_F(DeltaPageTest, test_datetime) {
+    std::vector<int64_t> src(5000);
+    // one value every 30 seconds, crossing several day boundaries
+    Timestamp start = timestamp::from_datetime(2023, 3, 1, 22, 0, 0, 0);
+    for (size_t i = 0; i < src.size(); i++) {
+        src[i] = timestamp::add<TimeUnit::SECOND>(start, i * 30);
+    }
+    size_t dod_size = test_encode_decode<TYPE_DATETIME, DELTA_OF_DELTA_ENCODING>(src);
+    ASSERT_LT(dod_size, src.size() / DELTA_PAGE_BLOCK_SIZE * 40 + 40);
+    test_encode_decode<TYPE_DATETIME, DELTA_ENCODING>(src);
+
+    std::vector<int32_t> dates(2000);
+    for (size_t i = 0; i < dates.size(); i++) {
+        dates[i] = date::from_date(2020, 1, 1) + i / 7;
+    }
+    test_encode_decode<TYPE_DATE, DELTA_ENCODING>(dates);
+    test_encode_decode<TYPE_DATE, DELTA_OF_DELTA_ENCODING>(dates);
+}
+
+TEST_F(DeltaPageTest, test_seek_at_or_after_value) {
+    std::vector<int32_t> src(1000);
+    for (size_t i = 0; i < src.size(); i++) {
+        src[i] = i * 2;
+    }
+    PageBuilderOptions options;
+    DeltaPageBuilder<TYPE_INT, DELTA_ENCODING> builder(options);
+    builder.add(reinterpret_cast<const uint8_t*>(src.data()), src.size());
+    OwnedSlice s = builder.finish()->build();
+
+    PageDecoderOptions decoder_options;
+    DeltaPageDecoder<TYPE_INT, DELTA_ENCODING> decoder(s.slice(), decoder_options);
+    ASSERT_TRUE(decoder.init().ok());
+
+    bool exact_match = false;
+    int32_t target = 600;
+    ASSERT_TRUE(decoder.seek_at_or_after_value(&target, &exact_match).ok());
+    ASSERT_TRUE(exact_match);
+    ASSERT_EQ(300, decoder.current_index());
+
+    target = 601;
+    ASSERT_TRUE(decoder.seek_at_or_after_value(&target, &exact_match).ok());
+    ASSERT_FALSE(exact_match);
+    ASSERT_EQ(301, decoder.current_index());
+
+    target = -1;
+    ASSERT_TRUE(decoder.seek_at_or_after_value(&target, &exact_match).ok());
+    ASSERT_FALSE(exact_match);
+    ASSERT_EQ(0, decoder.current_index());
+
+    target = 2000;
+    ASSERT_TRUE(decoder.seek_at_or_after_value(&target, &exact_match).is_not_found());
+}
+
+TEST_F(DeltaPageTest, test_prefix_sum) {
+    std::vector<uint64_t> values(37);
+    for (size_t i = 0; i < values.size(); i++) {
+        values[i] = i + 1;
+    }
+    uint64_t last = delta_prefix_sum(values.data(), values.size(), 100);
+    for (size_t i = 0; i < values.size(); i++) {
+        ASSERT_EQ(100 + (i + 1) * (i + 2) / 2, values[i]);
+    }
+    ASSERT_EQ(values.back(), last);
+}
+
+} // namespace starrocks
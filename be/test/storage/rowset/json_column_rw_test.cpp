@@ -0,0 +1,203 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <fmt/format.h>
+#include <gtest/gtest.h>
+
+#include <map>
+#include <numeric>
+
+#include "column/json_column.h"
+#include "column/nullable_column.h"
+#include "common/config.h"
+#include "fs/fs_memory.h"
+#include "storage/chunk_helper.h"
+#include "storage/range.h"
+#include "storage/rowset/column_iterator.h"
+#include "storage/rowset/column_reader.h"
+#include "storage/rowset/column_writer.h"
+#include "storage/rowset/segment.h"
+#include "testutil/assert.h"
+#include "util/defer_op.h"
+#include "util/json.h"
+
+namespace starrocks {
+
+// NOLINTNEXTLINE
+static const std::string TEST_DIR = "/json_column_rw_test";
+
+class JsonColumnRWTest : public testing::Test {
+public:
+    JsonColumnRWTest() = default;
+
+    ~JsonColumnRWTest() override = default;
+
+protected:
+    void SetUp() override {
+        _fs = std::make_shared<MemoryFileSystem>();
+        ASSERT_OK(_fs->create_dir(TEST_DIR));
+    }
+
+    void TearDown() override {}
+
+    std::shared_ptr<Segment> create_dummy_segment(const std::string& fname) {
+        return std::make_shared<Segment>(Segment::private_type(0), _fs, fname, 1, _dummy_segment_schema.get());
+    }
+
+    // Write |src| to |fname| with the flat columns enabled
+    void write_json_column(const Column& src, const std::string& fname, ColumnMetaPB* meta) {
+        bool old_enable_json_flat = config::enable_json_flat;
+        config::enable_json_flat = true;
+        DeferOp defer([&]() { config::enable_json_flat = old_enable_json_flat; });
+
+        ASSIGN_OR_ABORT(auto wfile, _fs->new_writable_file(fname));
+        ColumnWriterOptions writer_opts;
+        writer_opts.meta = meta;
+        writer_opts.meta->set_column_id(0);
+        writer_opts.meta->set_unique_id(0);
+        writer_opts.meta->set_type(TYPE_JSON);
+        writer_opts.meta->set_length(0);
+        writer_opts.meta->set_encoding(DEFAULT_ENCODING);
+        writer_opts.meta->set_compression(LZ4_FRAME);
+        writer_opts.meta->set_is_nullable(true);
+        writer_opts.meta->mutable_json_meta()->set_format_version(kJsonMetaDefaultFormatVersion);
+
+        TabletColumn column(STORAGE_AGGREGATE_NONE, TYPE_JSON, true);
+        ASSIGN_OR_ABORT(auto writer, ColumnWriter::create(writer_opts, &column, wfile.get()));
+        ASSERT_OK(writer->init());
+        // append in multiple batches
+        for (size_t offset = 0; offset < src.size(); offset += 1000) {
+            auto batch = src.clone_empty();
+            batch->append(src, offset, std::min<size_t>(1000, src.size() - offset));
+            ASSERT_OK(writer->append(*batch));
+        }
+        ASSERT_OK(writer->finish());
+        ASSERT_OK(writer->write_data());
+        ASSERT_OK(writer->write_ordinal_index());
+        ASSERT_OK(writer->write_zone_map());
+        ASSERT_OK(wfile->close());
+    }
+
+    std::shared_ptr<FileSystem> _fs;
+    std::shared_ptr<TabletSchema> _dummy_segment_schema;
+};
+
+TEST_F(JsonColumnRWTest, test_flat_columns) {
+    const size_t num_rows = 4096;
+    auto src = ChunkHelper::column_from_field_type(TYPE_JSON, true);
+    for (size_t i = 0; i < num_rows; i++) {
+        if (i % 100 == 7) {
+            src->append_nulls(1);
+            continue;
+        }
+        // "a", "b" and "c" are extracted, "d" is of mixed types in the sampled values,
+        // "e" is changed to strings after the sampled values so is dropped when finished.
+        auto str = fmt::format(R"({{"a": {}, "b": "s{}", "c": {}.5, "d": {}, "e": {}}})", i, i, i,
+                               i % 2 ? "1" : "\"x\"", i < 2000 ? std::to_string(i) : "\"e\"");
+        ASSIGN_OR_ABORT(auto json, JsonValue::parse(str));
+        src->append_datum(Datum(&json));
+    }
+
+    ColumnMetaPB meta;
+    const std::string fname = TEST_DIR + "/test_flat_columns.data";
+    write_json_column(*src, fname, &meta);
+
+    ASSERT_EQ(3, meta.json_meta().flat_paths_size());
+    ASSERT_EQ(3, meta.children_columns_size());
+    std::map<std::string, LogicalType> flat_types;
+    for (int i = 0; i < meta.json_meta().flat_paths_size(); i++) {
+        flat_types[meta.json_meta().flat_paths(i)] = static_cast<LogicalType>(meta.children_columns(i).type());
+    }
+    ASSERT_EQ(TYPE_BIGINT, flat_types["a"]);
+    ASSERT_EQ(TYPE_VARCHAR, flat_types["b"]);
+    ASSERT_EQ(TYPE_DOUBLE, flat_types["c"]);
+
+    auto segment = create_dummy_segment(fname);
+    ASSIGN_OR_ABORT(auto reader, ColumnReader::create(&meta, segment.get()));
+    ASSIGN_OR_ABORT(auto iter, reader->new_iterator());
+    ASSIGN_OR_ABORT(auto read_file, _fs->new_random_access_file(fname));
+    ColumnIteratorOptions iter_opts;
+    OlapReaderStatistics stats;
+    iter_opts.stats = &stats;
+    iter_opts.read_file = read_file.get();
+    ASSERT_OK(iter->init(iter_opts));
+
+    auto check_rows = [&](const Column& dst, const std::vector<size_t>& rowids) {
+        ASSERT_EQ(rowids.size(), dst.size());
+        const auto& nullable_column = down_cast<const NullableColumn&>(dst);
+        const auto* json_column = down_cast<const JsonColumn*>(nullable_column.data_column().get());
+        LogicalType type;
+        auto a = json_column->get_flat_column("a", &type);
+        auto b = json_column->get_flat_column("b", &type);
+        ASSERT_TRUE(a != nullptr);
+        ASSERT_TRUE(b != nullptr);
+        ASSERT_TRUE(json_column->get_flat_column("d", &type) == nullptr);
+        for (size_t i = 0; i < rowids.size(); i++) {
+            size_t rowid = rowids[i];
+            ASSERT_EQ(src->debug_item(rowid), dst.debug_item(i));
+            if (rowid % 100 == 7) {
+                ASSERT_TRUE(a->is_null(i));
+                ASSERT_TRUE(b->is_null(i));
+            } else {
+                ASSERT_EQ(static_cast<int64_t>(rowid), a->get(i).get_int64());
+                ASSERT_EQ(fmt::format("s{}", rowid), b->get(i).get_slice().to_string());
+            }
+        }
+    };
+
+    // sequential read in two batches
+    {
+        ASSERT_OK(iter->seek_to_first());
+        auto dst = ChunkHelper::column_from_field_type(TYPE_JSON, true);
+        size_t rows_read = 1000;
+        ASSERT_OK(iter->next_batch(&rows_read, dst.get()));
+        rows_read = num_rows - 1000;
+        ASSERT_OK(iter->next_batch(&rows_read, dst.get()));
+        std::vector<size_t> rowids(num_rows);
+        std::iota(rowids.begin(), rowids.end(), 0);
+        check_rows(*dst, rowids);
+    }
+    // read by ranges after seeking
+    {
+        ASSERT_OK(iter->seek_to_ordinal(100));
+        auto dst = ChunkHelper::column_from_field_type(TYPE_JSON, true);
+        SparseRange range;
+        range.add(Range(100, 300));
+        range.add(Range(2500, 3000));
+        ASSERT_OK(iter->next_batch(range, dst.get()));
+        std::vector<size_t> rowids;
+        for (size_t i = 100; i < 300; i++) {
+            rowids.push_back(i);
+        }
+        for (size_t i = 2500; i < 3000; i++) {
+            rowids.push_back(i);
+        }
+        check_rows(*dst, rowids);
+    }
+    // random reads don't read the flat columns
+    {
+        auto dst = ChunkHelper::column_from_field_type(TYPE_JSON, true);
+        rowid_t rowids[] = {1, 107, 3000};
+        ASSERT_OK(iter->fetch_values_by_rowid(rowids, 3, dst.get()));
+        ASSERT_EQ(3, dst->size());
+        for (size_t i = 0; i < 3; i++) {
+            ASSERT_EQ(src->debug_item(rowids[i]), dst->debug_item(i));
+        }
+        const auto* nullable_column = down_cast<const NullableColumn*>(dst.get());
+        const auto* json_column = down_cast<const JsonColumn*>(nullable_column->data_column().get());
+        ASSERT_FALSE(json_column->has_flat_columns());
+    }
+}
+
+} // namespace starrocks
@@ -0,0 +1,93 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "storage/chunk_helper.h"
+#include "storage/range.h"
+#include "storage/rowset/page_builder.h"
+#include "storage/rowset/page_decoder.h"
+#include "storage/type_traits.h"
+#include "util/faststring.h"
+
+namespace starrocks {
+
+// Add |src| to |builder|, check its first and last values and return the page built.
+template <LogicalType Type>
+OwnedSlice build_page(PageBuilder* builder, const std::vector<typename TypeTraits<Type>::CppType>& src) {
+    using CppType = typename TypeTraits<Type>::CppType;
+    size_t size = builder->add(reinterpret_cast<const uint8_t*>(src.data()), src.size());
+    EXPECT_EQ(src.size(), size);
+    OwnedSlice page = builder->finish()->build();
+
+    CppType first_value;
+    CppType last_value;
+    EXPECT_TRUE(builder->get_first_value(&first_value).ok());
+    EXPECT_TRUE(builder->get_last_value(&last_value).ok());
+    EXPECT_EQ(src.front(), first_value);
+    EXPECT_EQ(src.back(), last_value);
+    return page;
+}
+
+// Check that the initialized |decoder| decodes |src| as a whole, from random positions and in sparse ranges.
+template <LogicalType Type>
+void check_decode_page(PageDecoder* decoder, const std::vector<typename TypeTraits<Type>::CppType>& src) {
+    using CppType = typename TypeTraits<Type>::CppType;
+    const size_t size = src.size();
+    EXPECT_EQ(size, decoder->count());
+
+    auto column = ChunkHelper::column_from_field_type(Type, false);
+    size_t n = size;
+    EXPECT_TRUE(decoder->next_batch(&n, column.get()).ok());
+    EXPECT_EQ(size, n);
+    const auto* values = reinterpret_cast<const CppType*>(column->raw_data());
+    for (size_t i = 0; i < size; i++) {
+        EXPECT_EQ(src[i], values[i]) << "index " << i;
+    }
+
+    for (int i = 0; i < 100; i++) {
+        uint32_t pos = random() % size;
+        EXPECT_TRUE(decoder->seek_to_position_in_page(pos).ok());
+        EXPECT_EQ(pos, decoder->current_index());
+        auto one = ChunkHelper::column_from_field_type(Type, false);
+        size_t one_row = 1;
+        EXPECT_TRUE(decoder->next_batch(&one_row, one.get()).ok());
+        EXPECT_EQ(src[pos], *reinterpret_cast<const CppType*>(one->raw_data()));
+    }
+
+    EXPECT_TRUE(decoder->seek_to_position_in_page(0).ok());
+    SparseRange read_range;
+    read_range.add(Range(0, size / 3));
+    read_range.add(Range(size / 2, (size * 2 / 3)));
+    read_range.add(Range((size * 3 / 4), size));
+    auto sparse_column = ChunkHelper::column_from_field_type(Type, false);
+    EXPECT_TRUE(decoder->next_batch(read_range, sparse_column.get()).ok());
+    EXPECT_EQ(read_range.span_size(), sparse_column->size());
+    SparseRangeIterator iter = read_range.new_iterator();
+    size_t offset = 0;
+    const auto* sparse_values = reinterpret_cast<const CppType*>(sparse_column->raw_data());
+    while (iter.has_more()) {
+        Range r = iter.next(size);
+        for (size_t i = 0; i < r.span_size(); i++) {
+            EXPECT_EQ(src[r.begin() + i], sparse_values[offset + i]);
+        }
+        offset += r.span_size();
+    }
+}
+
+} // namespace starrocks
@@ -37,6 +37,7 @@
 #include <butil/iobuf.h>
 
 #include <string>
+#include <thread>
 #include <vector>
 
 #include "column/datum_tuple.h"
@@ -773,6 +774,102 @@ TEST_F(RowsetTest, VerticalWriteTest) {
     EXPECT_EQ(count, num_rows);
 }
 
+TEST_F(RowsetTest, VerticalColumnGroupWriteTest) {
+    auto tablet_schema = TabletSchemaHelper::create_tablet_schema();
+
+    RowsetWriterContext writer_context;
+    create_rowset_writer_context(12346, tablet_schema.get(), &writer_context);
+    writer_context.max_rows_per_segment = 5000;
+    writer_context.writer_type = kVertical;
+
+    std::unique_ptr<RowsetWriter> rowset_writer;
+    ASSERT_TRUE(RowsetFactory::create_rowset_writer(writer_context, &rowset_writer).ok());
+
+    int32_t chunk_size = 3000;
+    size_t num_rows = 10000;
+
+    {
+        // k1 k2
+        std::vector<uint32_t> column_indexes{0, 1};
+        auto schema = ChunkHelper::convert_schema(*tablet_schema, column_indexes);
+        auto chunk = ChunkHelper::new_chunk(schema, chunk_size);
+        for (size_t i = 0; i * chunk_size < num_rows; ++i) {
+            chunk->reset();
+            auto& cols = chunk->columns();
+            for (size_t j = 0; j < chunk_size && i * chunk_size + j < num_rows; ++j) {
+                cols[0]->append_datum(Datum(static_cast<int32_t>(i * chunk_size + j)));
+                cols[1]->append_datum(Datum(static_cast<int32_t>(i * chunk_size + j + 1)));
+            }
+            ASSERT_OK(rowset_writer->add_columns(*chunk, column_indexes, true));
+        }
+        ASSERT_OK(rowset_writer->flush_columns());
+    }
+
+    {
+        // v1 is written in another thread by a column group writer, and split into the segments of the keys
+        std::vector<uint32_t> column_indexes{2};
+        Status st;
+        std::thread t([&]() {
+            auto group_writer = rowset_writer->new_column_group_writer(column_indexes);
+            if (!group_writer.ok()) {
+                st = group_writer.status();
+                return;
+            }
+            // chunks are not aligned with the segments
+            int32_t value_chunk_size = 2000;
+            auto schema = ChunkHelper::convert_schema(*tablet_schema, column_indexes);
+            auto chunk = ChunkHelper::new_chunk(schema, value_chunk_size);
+            for (size_t i = 0; i * value_chunk_size < num_rows && st.ok(); ++i) {
+                chunk->reset();
+                auto& cols = chunk->columns();
+                for (size_t j = 0; j < value_chunk_size && i * value_chunk_size + j < num_rows; ++j) {
+                    cols[0]->append_datum(Datum(static_cast<int32_t>(i * value_chunk_size + j + 2)));
+                }
+                st = group_writer.value()->add_columns(*chunk);
+            }
+            if (st.ok()) {
+                st = group_writer.value()->flush_columns();
+            }
+        });
+        t.join();
+        ASSERT_OK(st);
+    }
+    ASSERT_OK(rowset_writer->final_flush());
+
+    // check rowset
+    RowsetSharedPtr rowset = rowset_writer->build().value();
+    ASSERT_EQ(num_rows, rowset->rowset_meta()->num_rows());
+    ASSERT_EQ(3, rowset->rowset_meta()->num_segments());
+
+    RowsetReadOptions rs_opts;
+    rs_opts.is_primary_keys = false;
+    rs_opts.sorted = true;
+    rs_opts.version = 0;
+    rs_opts.stats = &_stats;
+    auto schema = ChunkHelper::convert_schema(*tablet_schema);
+    auto res = rowset->new_iterator(schema, rs_opts);
+    ASSERT_TRUE(res.ok());
+
+    auto iterator = res.value();
+    int count = 0;
+    auto chunk = ChunkHelper::new_chunk(schema, chunk_size);
+    while (true) {
+        chunk->reset();
+        auto st = iterator->get_next(chunk.get());
+        if (st.is_end_of_file()) {
+            break;
+        }
+        ASSERT_OK(st);
+        for (auto i = 0; i < chunk->num_rows(); ++i) {
+            EXPECT_EQ(count, chunk->get(i)[0].get_int32());
+            EXPECT_EQ(count + 1, chunk->get(i)[1].get_int32());
+            EXPECT_EQ(count + 2, chunk->get(i)[2].get_int32());
+            ++count;
+        }
+    }
+    EXPECT_EQ(count, num_rows);
+}
+
 TEST_F(RowsetTest, SegmentWriteTest) {
     auto tablet_schema = TabletSchemaHelper::create_tablet_schema();
 
@@ -284,4 +284,107 @@ TEST_F(SegmentIteratorTest, TestGlobalDictNoLocalDict) {
     res_chunk->reset();
 }
 
+// NOLINTNEXTLINE
+TEST_F(SegmentIteratorTest, TestPushDownPredicatesOnDictOverflowColumn) {
+    std::vector<std::string> values;
+    for (int i = 0; i < 64; ++i) {
+        values.push_back("lowcard-" + std::to_string(i));
+    }
+    const Slice target(values[3]);
+
+    // the first half of the rows is low cardinality, the second half is made of long distinct values which
+    // overflow the dictionary, so the column has both dictionary encoded and plain encoded pages.
+    const size_t num_rows = 8192;
+    std::vector<std::string> rows;
+    size_t expected = 0;
+    for (size_t i = 0; i < num_rows; ++i) {
+        if (i < num_rows / 2 || i % 100 == 0) {
+            rows.push_back(values[i % values.size()]);
+        } else {
+            rows.push_back(std::to_string(i) + std::string(400, 'x'));
+        }
+        expected += (Slice(rows.back()) == target);
+    }
+
+    ColumnPB c1 = create_int_key_pb(1);
+    ColumnPB c2 = create_with_default_value_pb("VARCHAR", "");
+    c2.set_length(512);
+    std::unique_ptr<TabletSchema> tablet_schema = TabletSchemaHelper::create_tablet_schema({c1, c2});
+
+    SegmentWriterOptions opts;
+    opts.num_rows_per_block = 1024;
+    std::string file_name = kSegmentDir + "/dict_overflow";
+    ASSIGN_OR_ABORT(auto wfile, _fs->new_writable_file(file_name));
+    SegmentWriter writer(std::move(wfile), 0, tablet_schema.get(), opts);
+
+    const int32_t chunk_size = config::vector_chunk_size;
+    uint64_t file_size = 0;
+    uint64_t index_size = 0;
+    for (uint32_t cid : {0, 1}) {
+        std::vector<uint32_t> column_indexes{cid};
+        ASSERT_OK(writer.init(column_indexes, cid == 0));
+        auto schema = ChunkHelper::convert_schema(*tablet_schema, column_indexes);
+        auto chunk = ChunkHelper::new_chunk(schema, chunk_size);
+        for (size_t i = 0; i < num_rows; i += chunk_size) {
+            chunk->reset();
+            auto& cols = chunk->columns();
+            for (size_t j = i; j < std::min<size_t>(i + chunk_size, num_rows); ++j) {
+                if (cid == 0) {
+                    cols[0]->append_datum(Datum(static_cast<int32_t>(j)));
+                } else {
+                    cols[0]->append_datum(Datum(Slice(rows[j])));
+                }
+            }
+            ASSERT_OK(writer.append_chunk(*chunk));
+        }
+        ASSERT_OK(writer.finalize_columns(&index_size));
+    }
+    ASSERT_OK(writer.finalize_footer(&file_size));
+
+    auto segment = *Segment::open(_fs, file_name, 0, tablet_schema.get());
+    ASSERT_EQ(segment->num_rows(), num_rows);
+
+    OlapReaderStatistics stats;
+    ColumnIteratorOptions iter_opts;
+    ASSIGN_OR_ABORT(auto read_file, _fs->new_random_access_file(segment->file_name()));
+    iter_opts.stats = &stats;
+    iter_opts.read_file = read_file.get();
+    iter_opts.check_dict_encoding = true;
+    ASSIGN_OR_ABORT(auto scalar_iter, segment->new_column_iterator(1));
+    ASSERT_OK(scalar_iter->init(iter_opts));
+    ASSERT_FALSE(scalar_iter->all_page_dict_encoded());
+
+    Schema vec_schema;
+    vec_schema.append(std::make_shared<Field>(0, "c1", TYPE_INT, -1, -1, false));
+    vec_schema.append(std::make_shared<Field>(1, "c2", TYPE_VARCHAR, -1, -1, false));
+
+    ObjectPool pool;
+    SegmentReadOptions seg_opts;
+    seg_opts.fs = _fs;
+    seg_opts.stats = &stats;
+    seg_opts.predicates[1].push_back(pool.add(new_column_eq_predicate(get_type_info(TYPE_VARCHAR), 1, target)));
+
+    auto chunk_iter = new_segment_iterator(segment, vec_schema, seg_opts);
+    ASSERT_OK(chunk_iter->init_output_schema(std::unordered_set<uint32_t>()));
+    auto res_chunk = ChunkHelper::new_chunk(chunk_iter->output_schema(), chunk_size);
+
+    size_t count = 0;
+    while (true) {
+        res_chunk->reset();
+        auto st = chunk_iter->get_next(res_chunk.get());
+        if (st.is_end_of_file()) {
+            break;
+        }
+        ASSERT_OK(st);
+        for (size_t i = 0; i < res_chunk->num_rows(); ++i) {
+            int32_t row = res_chunk->get_column_by_index(0)->get(i).get_int32();
+            ASSERT_EQ(target, res_chunk->get_column_by_index(1)->get(i).get_slice());
+            ASSERT_EQ(Slice(rows[row]), target);
+        }
+        count += res_chunk->num_rows();
+    }
+    ASSERT_EQ(expected, count);
+    chunk_iter->close();
+}
+
 } // namespace starrocks
@@ -1551,6 +1551,14 @@ TEST_F(TabletUpdatesTest, horizontal_compaction_with_persistent_index) {
     test_horizontal_compaction(true);
 }
 
+TEST_F(TabletUpdatesTest, horizontal_compaction_without_merged_keys) {
+    // the keys collected while merging exceed the limit, so they are read back from the output segments
+    auto orig = config::update_compaction_merged_keys_max_bytes;
+    config::update_compaction_merged_keys_max_bytes = 1;
+    DeferOp unset_config([&] { config::update_compaction_merged_keys_max_bytes = orig; });
+    test_horizontal_compaction(true);
+}
+
 TEST_F(TabletUpdatesTest, horizontal_compaction_with_sort_key) {
     auto orig = config::vertical_compaction_max_columns_per_group;
     config::vertical_compaction_max_columns_per_group = 5;
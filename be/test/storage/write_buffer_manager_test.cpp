@@ -0,0 +1,110 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "storage/write_buffer_manager.h"
+
+#include <gtest/gtest.h>
+
+#include "common/config.h"
+#include "runtime/mem_tracker.h"
+
+namespace starrocks {
+
+class FakeWriteBufferOwner final : public WriteBufferOwner {
+public:
+    void flush_write_buffer() override { flush_requests++; }
+
+    int flush_requests = 0;
+};
+
+TEST(WriteBufferManagerTest, test_flush_largest_first) {
+    MemTracker mem_tracker(1000, "load");
+    WriteBufferManager manager(&mem_tracker);
+    config::load_write_buffer_soft_limit_percent = 70;
+    ASSERT_EQ(700, manager.budget());
+
+    FakeWriteBufferOwner owners[4];
+    manager.register_owner(&owners[0], 1);
+    manager.register_owner(&owners[1], 1);
+    manager.register_owner(&owners[2], 2);
+    manager.register_owner(&owners[3], 2);
+    manager.update_usage(&owners[0], 100);
+    manager.update_usage(&owners[1], 300);
+    manager.update_usage(&owners[2], 200);
+    ASSERT_EQ(600, manager.total_bytes());
+    ASSERT_EQ(400, manager.table_bytes(1));
+    ASSERT_EQ(200, manager.table_bytes(2));
+    for (auto& owner : owners) {
+        ASSERT_EQ(0, owner.flush_requests);
+    }
+
+    // 800 > 700, flush the largest buffers until the total is at most 525
+    manager.update_usage(&owners[3], 200);
+    ASSERT_EQ(0, owners[0].flush_requests);
+    ASSERT_EQ(1, owners[1].flush_requests);
+    ASSERT_EQ(0, owners[2].flush_requests);
+    ASSERT_EQ(0, owners[3].flush_requests);
+
+    // the buffer being flushed is not counted
+    manager.update_usage(&owners[0], 250);
+    ASSERT_EQ(0, owners[0].flush_requests);
+
+    // and not flushed again
+    manager.update_usage(&owners[0], 400);
+    ASSERT_EQ(1, owners[0].flush_requests);
+    ASSERT_EQ(1, owners[1].flush_requests);
+    ASSERT_EQ(0, owners[2].flush_requests);
+    ASSERT_EQ(0, owners[3].flush_requests);
+
+    // the buffer handed over to be flushed is still counted until its flush finishes
+    manager.start_flush(&owners[1]);
+    manager.update_usage(&owners[1], 0);
+    ASSERT_EQ(1100, manager.total_bytes());
+    ASSERT_EQ(700, manager.table_bytes(1));
+    manager.update_usage(&owners[1], 50);
+    ASSERT_EQ(1150, manager.total_bytes());
+    manager.finish_flush(&owners[1]);
+    ASSERT_EQ(850, manager.total_bytes());
+    ASSERT_EQ(450, manager.table_bytes(1));
+
+    manager.start_flush(&owners[0]);
+    manager.update_usage(&owners[0], 0);
+    manager.finish_flush(&owners[0]);
+    // no flush to finish
+    manager.finish_flush(&owners[0]);
+    ASSERT_EQ(450, manager.total_bytes());
+    ASSERT_EQ(50, manager.table_bytes(1));
+    ASSERT_EQ(400, manager.table_bytes(2));
+
+    for (auto& owner : owners) {
+        manager.unregister_owner(&owner);
+    }
+    // a flush may finish after its owner is unregistered
+    manager.finish_flush(&owners[0]);
+    ASSERT_EQ(0, manager.total_bytes());
+    ASSERT_EQ(0, manager.table_bytes(2));
+}
+
+TEST(WriteBufferManagerTest, test_no_limit) {
+    MemTracker mem_tracker(-1, "load");
+    WriteBufferManager manager(&mem_tracker);
+    ASSERT_EQ(-1, manager.budget());
+    FakeWriteBufferOwner owner;
+    manager.register_owner(&owner, 1);
+    manager.update_usage(&owner, 1L << 40);
+    ASSERT_EQ(0, owner.flush_requests);
+    manager.unregister_owner(&owner);
+}
+
+} // namespace starrocks
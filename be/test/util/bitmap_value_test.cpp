@@ -419,4 +419,61 @@ TEST(BitmapValueTest, bitmap_xor) {
     }
 }
 
+TEST(BitmapValueTest, bitmap_add_many) {
+    // empty -> single -> set -> bitmap in one batch, on both sides of the 32-bit boundary
+    for (size_t num_values : {0, 1, 10, 33, 10000}) {
+        std::vector<uint64_t> values;
+        BitmapValue expected;
+        for (size_t i = 0; i < num_values; i++) {
+            uint64_t value = (i % 2 == 0) ? i * 7 : (uint64_t(i) << 32) + i;
+            values.push_back(value);
+            expected.add(value);
+        }
+        BitmapValue bitmap;
+        bitmap.add_many(values.size(), values.data());
+        ASSERT_EQ(expected.cardinality(), bitmap.cardinality());
+        ASSERT_EQ(expected.to_string(), bitmap.to_string());
+
+        // the duplicated values on a non-empty bitmap
+        bitmap.add_many(values.size() / 2, values.data());
+        ASSERT_EQ(expected.cardinality(), bitmap.cardinality());
+    }
+}
+
+TEST(BitmapValueTest, bitmap_fast_union) {
+    auto make_bitmap = [](uint64_t from, uint64_t to, uint64_t step) {
+        BitmapValue bitmap;
+        for (uint64_t i = from; i < to; i += step) {
+            bitmap.add(i);
+        }
+        return bitmap;
+    };
+    // empty, single, set, bitmaps of arrays, bitmaps of bitsets, and a 64-bit bitmap
+    std::vector<BitmapValue> bitmaps = {make_bitmap(0, 0, 1),          make_bitmap(5, 6, 1),
+                                        make_bitmap(0, 20, 1),         make_bitmap(0, 100000, 7),
+                                        make_bitmap(50000, 200000, 3), make_bitmap(0, 70000, 1),
+                                        make_bitmap(1UL << 40, (1UL << 40) + 100, 1)};
+    for (auto& lhs : bitmaps) {
+        BitmapValue expected(lhs);
+        std::vector<const BitmapValue*> values;
+        for (auto& rhs : bitmaps) {
+            expected |= rhs;
+            values.push_back(&rhs);
+        }
+        BitmapValue bitmap(lhs);
+        bitmap.fast_union(values);
+        ASSERT_EQ(expected.cardinality(), bitmap.cardinality());
+        BitmapValue intersection(expected);
+        intersection &= bitmap;
+        ASSERT_EQ(expected.cardinality(), intersection.cardinality());
+        ASSERT_EQ(expected.min(), bitmap.min());
+        ASSERT_EQ(expected.max(), bitmap.max());
+
+        // the repaired bitmap can be updated as usual
+        bitmap.add(1UL << 50);
+        bitmap |= bitmaps[3];
+        ASSERT_EQ(expected.cardinality() + 1, bitmap.cardinality());
+    }
+}
+
 } // namespace starrocks
@@ -36,6 +36,7 @@
 
 #include <gtest/gtest.h>
 
+#include <memory>
 #include <vector>
 
 using namespace starrocks;
@@ -348,4 +349,178 @@ TEST_F(CacheTest, SetCapacity) {
     ASSERT_EQ(32, _cache->get_memory_usage());
 }
 
+TEST_F(CacheTest, CachePolicyFromString) {
+    ASSERT_EQ(CachePolicy::LRU, cache_policy_from_string("lru"));
+    ASSERT_EQ(CachePolicy::SLRU, cache_policy_from_string("SLRU"));
+    ASSERT_EQ(CachePolicy::LRU, cache_policy_from_string("unknown"));
+}
+
+TEST_F(CacheTest, FrequencySketch) {
+    FrequencySketch sketch;
+    CacheKey hot("hot");
+    CacheKey cold("cold");
+    uint32_t hot_hash = hot.hash(hot.data(), hot.size(), 0);
+    uint32_t cold_hash = cold.hash(cold.data(), cold.size(), 0);
+    for (int i = 0; i < 10; i++) {
+        sketch.increment(hot_hash);
+    }
+    sketch.increment(cold_hash);
+    ASSERT_GE(sketch.frequency(hot_hash), 10);
+    ASSERT_LT(sketch.frequency(cold_hash), 10);
+    // counters saturate at 15
+    for (int i = 0; i < 100; i++) {
+        sketch.increment(hot_hash);
+    }
+    ASSERT_EQ(15, sketch.frequency(hot_hash));
+}
+
+static void insert_SLRUCache(LRUCache& cache, int key, int charge) {
+    std::string result;
+    CacheKey k = EncodeKey(&result, key);
+    uint32_t hash = k.hash(k.data(), k.size(), 0);
+    cache.release(cache.insert(k, hash, EncodeValue(key), charge, &deleter));
+}
+
+static bool lookup_SLRUCache(LRUCache& cache, int key) {
+    std::string result;
+    CacheKey k = EncodeKey(&result, key);
+    uint32_t hash = k.hash(k.data(), k.size(), 0);
+    Cache::Handle* handle = cache.lookup(k, hash);
+    if (handle == nullptr) {
+        return false;
+    }
+    cache.release(handle);
+    return true;
+}
+
+TEST_F(CacheTest, SegmentedLRUIsScanResistant) {
+    LRUCache cache;
+    cache.set_policy(CachePolicy::SLRU);
+    cache.set_capacity(100);
+
+    // the working set is accessed twice, so it's promoted into the protected segment.
+    for (int i = 0; i < 50; i++) {
+        ASSERT_FALSE(lookup_SLRUCache(cache, i));
+        insert_SLRUCache(cache, i, 1);
+        ASSERT_TRUE(lookup_SLRUCache(cache, i));
+    }
+    ASSERT_EQ(50, cache.get_protected_usage());
+
+    // a large scan which accesses every key once.
+    for (int i = 1000; i < 3000; i++) {
+        if (!lookup_SLRUCache(cache, i)) {
+            insert_SLRUCache(cache, i, 1);
+        }
+    }
+    ASSERT_LE(cache.get_usage(), 100);
+    for (int i = 0; i < 50; i++) {
+        ASSERT_TRUE(lookup_SLRUCache(cache, i)) << i;
+    }
+    ASSERT_GT(cache.get_evict_count(), 0);
+}
+
+TEST_F(CacheTest, SegmentedLRUAdmission) {
+    LRUCache cache;
+    cache.set_policy(CachePolicy::SLRU);
+    cache.set_capacity(10);
+
+    // key 1 is accessed frequently but never hit twice, so it stays in the probation segment.
+    for (int i = 0; i < 5; i++) {
+        lookup_SLRUCache(cache, 1);
+    }
+    insert_SLRUCache(cache, 1, 10);
+    ASSERT_EQ(10, cache.get_usage());
+
+    // key 2 is accessed less frequently than key 1, it's not admitted.
+    ASSERT_FALSE(lookup_SLRUCache(cache, 2));
+    insert_SLRUCache(cache, 2, 10);
+    ASSERT_EQ(1, cache.get_reject_count());
+    ASSERT_EQ(10, cache.get_usage());
+    ASSERT_FALSE(lookup_SLRUCache(cache, 2));
+
+    // after being accessed more often than key 1, key 2 is admitted and key 1 is evicted.
+    for (int i = 0; i < 5; i++) {
+        lookup_SLRUCache(cache, 2);
+    }
+    insert_SLRUCache(cache, 2, 10);
+    ASSERT_EQ(1, cache.get_reject_count());
+    ASSERT_TRUE(lookup_SLRUCache(cache, 2));
+    ASSERT_EQ(10, cache.get_usage());
+}
+
+TEST_F(CacheTest, SegmentedLRURejectedScanKeepsProtected) {
+    LRUCache cache;
+    cache.set_policy(CachePolicy::SLRU);
+    cache.set_capacity(100);
+
+    // 80 entries in the protected segment
+    for (int i = 0; i < 80; i++) {
+        ASSERT_FALSE(lookup_SLRUCache(cache, i));
+        insert_SLRUCache(cache, i, 1);
+        ASSERT_TRUE(lookup_SLRUCache(cache, i));
+    }
+    // 20 frequently accessed entries in the probation segment, the cache is full
+    for (int i = 80; i < 100; i++) {
+        for (int j = 0; j < 5; j++) {
+            ASSERT_FALSE(lookup_SLRUCache(cache, i));
+        }
+        insert_SLRUCache(cache, i, 1);
+    }
+    ASSERT_EQ(80, cache.get_protected_usage());
+    ASSERT_EQ(100, cache.get_usage());
+
+    // a scan of keys accessed once, they are all rejected, and held while the protected
+    // entries are hit and released
+    std::vector<Cache::Handle*> handles;
+    for (int i = 1000; i < 1100; i++) {
+        std::string result;
+        CacheKey k = EncodeKey(&result, i);
+        uint32_t hash = k.hash(k.data(), k.size(), 0);
+        ASSERT_EQ(nullptr, cache.lookup(k, hash));
+        handles.push_back(cache.insert(k, hash, EncodeValue(i), 1, &deleter));
+        ASSERT_EQ(i, DecodeValue(cache.value(handles.back())));
+    }
+    ASSERT_EQ(100, cache.get_reject_count());
+    ASSERT_EQ(100, cache.get_usage());
+    for (int i = 0; i < 80; i++) {
+        ASSERT_TRUE(lookup_SLRUCache(cache, i)) << i;
+    }
+    for (auto* handle : handles) {
+        cache.release(handle);
+    }
+
+    ASSERT_EQ(100, cache.get_usage());
+    ASSERT_EQ(0, cache.get_evict_count());
+    for (int i = 0; i < 100; i++) {
+        ASSERT_TRUE(lookup_SLRUCache(cache, i)) << i;
+    }
+    for (int i = 1000; i < 1100; i++) {
+        ASSERT_FALSE(lookup_SLRUCache(cache, i)) << i;
+    }
+}
+
+TEST_F(CacheTest, SegmentedLRUShardedCache) {
+    std::unique_ptr<Cache> cache(new_lru_cache(kCacheSize, CachePolicy::SLRU));
+    std::string result;
+    for (int i = 0; i < 2 * kCacheSize; i++) {
+        result.clear();
+        CacheKey key = EncodeKey(&result, i);
+        Cache::Handle* handle = cache->lookup(key);
+        if (handle == nullptr) {
+            handle = cache->insert(key, EncodeValue(i), 1, [](const CacheKey& key, void* value) {});
+        }
+        ASSERT_EQ(i, DecodeValue(cache->value(handle)));
+        cache->release(handle);
+    }
+    ASSERT_LE(cache->get_memory_usage(), kCacheSize);
+    ASSERT_EQ(2 * kCacheSize, cache->get_lookup_count());
+
+    rapidjson::Document document;
+    document.SetArray();
+    cache->get_cache_status(&document);
+    ASSERT_EQ(kNumShards, document.Size());
+    ASSERT_TRUE(document[0].HasMember("protected_usage"));
+    ASSERT_TRUE(document[0].HasMember("reject_count"));
+}
+
 } // namespace starrocks
@@ -307,6 +307,22 @@ TEST(StringToInt, Overflow) {
                             StringParser::PARSE_OVERFLOW);
 }
 
+TEST(StringToInt, EightDigitsAtATime) {
+    test_int_value<int32_t>("123456789", 123456789, StringParser::PARSE_SUCCESS);
+    test_int_value<int32_t>("-000000012", -12, StringParser::PARSE_SUCCESS);
+    test_int_value<int64_t>("123456789012345678", 123456789012345678LL, StringParser::PARSE_SUCCESS);
+    test_int_value<int64_t>("-123456789012345678", -123456789012345678LL, StringParser::PARSE_SUCCESS);
+
+    // a non-digit in any position of the eight digits
+    for (int i = 1; i < 9; i++) {
+        std::string str = "1234567890";
+        str[i] = 'x';
+        test_int_value<int64_t>(str.c_str(), 0, StringParser::PARSE_FAILURE);
+        str[i] = ' ';
+        test_int_value<int64_t>(str.c_str(), 0, StringParser::PARSE_FAILURE);
+    }
+}
+
 TEST(StringToInt, Int8_Exhaustive) {
     char buffer[5];
     for (int i = -256; i <= 256; ++i) {
@@ -1140,6 +1140,16 @@ public class Config extends ConfigBase {
     @ConfField(mutable = true)
     public static boolean enable_replicated_storage_as_default_engine = true;
 
+    /**
+     * Load the bulk loads (broker load, stream load and INSERT INTO SELECT) of multi-replica tables with the
+     * replicated storage even if the table doesn't enable it: the sink only sends the rows to the primary replica,
+     * which sorts and encodes the segments once and ships the segment files to the secondaries.
+     * It's decided once when the load is planned, so all the senders of a load use the same mode.
+     * The BE still loads the colocate mv index with every replica.
+     */
+    @ConfField(mutable = true)
+    public static boolean enable_replicated_storage_for_bulk_load = false;
+
     /**
      * FOR BeLoadBalancer:
      * the threshold of cluster balance score, if a backend's load score is 10% lower than average score,
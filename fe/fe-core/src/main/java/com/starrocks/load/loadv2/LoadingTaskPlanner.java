@@ -207,7 +207,7 @@ public class LoadingTaskPlanner {
         // 2. Olap table sink
         List<Long> partitionIds = getAllPartitionIds();
         OlapTableSink olapTableSink = new OlapTableSink(table, tupleDesc, partitionIds, true,
-                table.writeQuorum(), table.enableReplicatedStorage());
+                table.writeQuorum(), OlapTableSink.enableReplicatedStorageForBulkLoad(table));
         olapTableSink.init(loadId, txnId, dbId, timeoutS);
         Load.checkMergeCondition(mergeConditionStr, table);
         olapTableSink.complete(mergeConditionStr);
@@ -281,7 +281,7 @@ public class LoadingTaskPlanner {
         // 4. Olap table sink
         List<Long> partitionIds = getAllPartitionIds();
         OlapTableSink olapTableSink = new OlapTableSink(table, tupleDesc, partitionIds, true,
-                table.writeQuorum(), table.enableReplicatedStorage());
+                table.writeQuorum(), OlapTableSink.enableReplicatedStorageForBulkLoad(table));
         olapTableSink.init(loadId, txnId, dbId, timeoutS);
         Load.checkMergeCondition(mergeConditionStr, table);
         olapTableSink.complete(mergeConditionStr);
@@ -323,6 +323,8 @@ public class LoadingTaskPlanner {
             return false;
         }
 
+        // The rows are still shuffled if only the bulk load enables the replicated storage, the BE may load
+        // the colocate mv index with every replica and then the senders must agree on the order of the keys.
         if (table.enableReplicatedStorage()) {
             return false;
         }
@@ -77,6 +77,7 @@ public class StreamLoadInfo {
     private TCompressionType compressionType = TCompressionType.NO_COMPRESSION;
     private int loadParallelRequestNum = 0;
     private boolean enableReplicatedStorage = false;
+    private boolean isRoutineLoad = false;
 
     public StreamLoadInfo(TUniqueId id, long txnId, TFileType fileType, TFileFormatType formatType) {
         this.id = id;
@@ -213,6 +214,10 @@ public class StreamLoadInfo {
         return enableReplicatedStorage;
     }
 
+    public boolean isRoutineLoad() {
+        return isRoutineLoad;
+    }
+
     public int getLoadParallelRequestNum() {
         return loadParallelRequestNum;
     }
@@ -390,6 +395,7 @@ public class StreamLoadInfo {
         StreamLoadInfo streamLoadInfo = new StreamLoadInfo(dummyId, -1L /* dummy txn id */,
                 TFileType.FILE_STREAM, fileFormatType);
         streamLoadInfo.setOptionalFromRoutineLoadJob(routineLoadJob);
+        streamLoadInfo.isRoutineLoad = true;
         return streamLoadInfo;
     }
 
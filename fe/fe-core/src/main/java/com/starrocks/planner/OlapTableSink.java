@@ -119,6 +119,8 @@ public class OlapTableSink extends DataSink {
     private final boolean enablePipelineLoad;
     private final TWriteQuorumType writeQuorum;
     private final boolean enableReplicatedStorage;
+    // the replicated storage is enabled for the bulk load rather than by the table
+    private final boolean replicatedStorageForBulkLoad;
 
     public OlapTableSink(OlapTable dstTable, TupleDescriptor tupleDescriptor, List<Long> partitionIds,
             TWriteQuorumType writeQuorum, boolean enableReplicatedStorage) {
@@ -135,6 +137,18 @@ public class OlapTableSink extends DataSink {
         this.enablePipelineLoad = enablePipelineLoad;
         this.writeQuorum = writeQuorum;
         this.enableReplicatedStorage = enableReplicatedStorage;
+        this.replicatedStorageForBulkLoad = enableReplicatedStorage && !dstTable.enableReplicatedStorage();
+    }
+
+    // Whether to load a bulk load (INSERT SELECT, broker load or stream load) into |table| with the replicated
+    // storage, though the table may not enable it. INSERT VALUES and routine loads keep the table's mode, they
+    // write few rows per load and the secondaries can't write their segments until the primary has flushed them.
+    public static boolean enableReplicatedStorageForBulkLoad(OlapTable table) {
+        if (table.enableReplicatedStorage()) {
+            return true;
+        }
+        return Config.enable_replicated_storage_for_bulk_load && !table.isLakeTable()
+                && table.getDefaultReplicationNum() > 1;
     }
 
     public void init(TUniqueId loadId, long txnId, long dbId, long loadChannelTimeoutS)
@@ -154,6 +168,7 @@ public class OlapTableSink extends DataSink {
         tSink.setKeys_type(dstTable.getKeysType().toThrift());
         tSink.setWrite_quorum_type(writeQuorum);
         tSink.setEnable_replicated_storage(enableReplicatedStorage);
+        tSink.setReplicated_storage_for_bulk_load(replicatedStorageForBulkLoad);
         tDataSink = new TDataSink(TDataSinkType.DATA_SPLIT_SINK);
         tDataSink.setType(TDataSinkType.OLAP_TABLE_SINK);
         tDataSink.setOlap_table_sink(tSink);
@@ -174,7 +174,7 @@ public class StreamLoadPlanner {
 
         List<Long> partitionIds = getAllPartitionIds();
         OlapTableSink olapTableSink = new OlapTableSink(destTable, tupleDesc, partitionIds, writeQuorum,
-                destTable.enableReplicatedStorage());
+                enableReplicatedStorage());
         olapTableSink.init(loadId, streamLoadInfo.getTxnId(), db.getId(), streamLoadInfo.getTimeout());
         Load.checkMergeCondition(streamLoadInfo.getMergeConditionStr(), destTable);
         olapTableSink.complete(streamLoadInfo.getMergeConditionStr());
@@ -251,6 +251,14 @@ public class StreamLoadPlanner {
         return params;
     }
 
+    // Routine loads keep the table's mode, every task of them writes a few rows.
+    private boolean enableReplicatedStorage() {
+        if (streamLoadInfo.isRoutineLoad()) {
+            return destTable.enableReplicatedStorage();
+        }
+        return OlapTableSink.enableReplicatedStorageForBulkLoad(destTable);
+    }
+
     // get all specified partition ids.
     // if no partition specified, return all partitions
     private List<Long> getAllPartitionIds() throws DdlException {
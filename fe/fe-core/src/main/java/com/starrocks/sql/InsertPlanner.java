@@ -184,7 +184,7 @@ public class InsertPlanner {
 
                 dataSink = new OlapTableSink((OlapTable) insertStmt.getTargetTable(), olapTuple,
                         insertStmt.getTargetPartitionIds(), canUsePipeline, olapTable.writeQuorum(),
-                        olapTable.enableReplicatedStorage());
+                        enableReplicatedStorage(insertStmt, olapTable));
             } else if (insertStmt.getTargetTable() instanceof MysqlTable) {
                 dataSink = new MysqlTableSink((MysqlTable) insertStmt.getTargetTable());
             } else {
@@ -404,6 +404,14 @@ public class InsertPlanner {
         return root.withNewRoot(new LogicalProjectOperator(new HashMap<>(columnRefMap)));
     }
 
+    // Only INSERT SELECT is loaded as a bulk load, INSERT VALUES writes a few rows.
+    private static boolean enableReplicatedStorage(InsertStmt insertStmt, OlapTable table) {
+        if (insertStmt.getQueryStatement().getQueryRelation() instanceof ValuesRelation) {
+            return table.enableReplicatedStorage();
+        }
+        return OlapTableSink.enableReplicatedStorageForBulkLoad(table);
+    }
+
     /**
      * OlapTableSink may be executed in multiply fragment instances of different machines
      * For non-duplicate key types, we must guarantee that the orders of the same key are
@@ -434,6 +442,8 @@ public class InsertPlanner {
             return new PhysicalPropertySet();
         }
 
+        // The rows are still shuffled if only the bulk load enables the replicated storage, the BE may load
+        // the colocate mv index with every replica and then the senders must agree on the order of the keys.
         if (table.enableReplicatedStorage()) {
             return new PhysicalPropertySet();
         }
@@ -383,7 +383,7 @@ public class LoadPlanner {
         if (destTable instanceof OlapTable) {
             // 4. Olap table sink
             dataSink = new OlapTableSink((OlapTable) destTable, tupleDesc, partitionIds, canUsePipeLine,
-                    ((OlapTable) destTable).writeQuorum(), ((OlapTable) destTable).enableReplicatedStorage());
+                    ((OlapTable) destTable).writeQuorum(), enableReplicatedStorage());
             if (completeTabletSink) {
                 ((OlapTableSink) dataSink).init(loadId, txnId, dbId, timeoutS);
                 ((OlapTableSink) dataSink).complete();
@@ -473,6 +473,14 @@ public class LoadPlanner {
         }
     }
 
+    private boolean enableReplicatedStorage() {
+        OlapTable olapDestTable = (OlapTable) destTable;
+        if (etlJobType == EtlJobType.BROKER || etlJobType == EtlJobType.STREAM_LOAD) {
+            return OlapTableSink.enableReplicatedStorageForBulkLoad(olapDestTable);
+        }
+        return olapDestTable.enableReplicatedStorage();
+    }
+
     public Boolean needShufflePlan() {
         OlapTable olapDestTable = (OlapTable) destTable;
         if (KeysType.DUP_KEYS.equals(olapDestTable.getKeysType())) {
@@ -483,6 +491,8 @@ public class LoadPlanner {
             return false;
         }
 
+        // The rows are still shuffled if only the bulk load enables the replicated storage, the BE may load
+        // the colocate mv index with every replica and then the senders must agree on the order of the keys.
         if (olapDestTable.enableReplicatedStorage()) {
             return false;
         }
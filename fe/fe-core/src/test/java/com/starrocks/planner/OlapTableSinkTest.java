@@ -43,6 +43,7 @@ import com.starrocks.catalog.ScalarType;
 import com.starrocks.catalog.SinglePartitionInfo;
 import com.starrocks.catalog.TabletMeta;
 import com.starrocks.catalog.Type;
+import com.starrocks.common.Config;
 import com.starrocks.common.Status;
 import com.starrocks.common.UserException;
 import com.starrocks.common.jmockit.Deencapsulation;
@@ -106,6 +107,28 @@ public class OlapTableSinkTest {
         return tuple;
     }
 
+    @Test
+    public void testEnableReplicatedStorageForBulkLoad() {
+        new Expectations() {{
+            dstTable.enableReplicatedStorage();
+            result = false;
+            dstTable.isLakeTable();
+            result = false;
+            dstTable.getDefaultReplicationNum();
+            result = (short) 3;
+        }};
+
+        boolean oldValue = Config.enable_replicated_storage_for_bulk_load;
+        try {
+            Config.enable_replicated_storage_for_bulk_load = false;
+            Assert.assertFalse(OlapTableSink.enableReplicatedStorageForBulkLoad(dstTable));
+            Config.enable_replicated_storage_for_bulk_load = true;
+            Assert.assertTrue(OlapTableSink.enableReplicatedStorageForBulkLoad(dstTable));
+        } finally {
+            Config.enable_replicated_storage_for_bulk_load = oldValue;
+        }
+    }
+
     @Test
     public void testSinglePartition() throws UserException {
         TupleDescriptor tuple = getTuple();
@@ -182,6 +182,8 @@ struct TOlapTableSink {
     18: optional Types.TWriteQuorumType write_quorum_type
     19: optional bool enable_replicated_storage
     20: optional string merge_condition
+    // enable_replicated_storage is set for the bulk load rather than by the table
+    21: optional bool replicated_storage_for_bulk_load
 }
 
 struct TDataSink {